@@ -40,7 +40,6 @@
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h"
 #include "../3d_rendering/3d_render_raytracing/shapes3D/ccylinder.h"
 #include "../3d_rendering/3d_render_raytracing/shapes3D/clayeritem.h"
-#include <openmp_mutex.h>
 #include <class_board.h>
 #include <class_module.h>
 #include <class_pad.h>
@@ -51,6 +50,7 @@
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
 #include <drawtxt.h>
+#include <task_scheduler.h>
 #include <utility>
 #include <vector>
 
@@ -1905,22 +1905,24 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        const int nLayers = layer_id.size();
+        TASK_GROUP group;
 
-        #pragma omp parallel for
-        for( signed int lIdx = 0; lIdx < nLayers; ++lIdx )
+        group.ParallelFor( 0, layer_id.size(), [&]( int lIdx )
         {
             const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
+            // find() rather than operator[], the map is shared by the parallel tasks
+            auto layerIt = m_layers_poly.find( curr_layer_id );
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
+            wxASSERT( layerIt != m_layers_poly.end() );
+
+            SHAPE_POLY_SET *layerPoly = layerIt->second;
 
             wxASSERT( layerPoly != NULL );
 
             // This will make a union of all added contourns
             layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
-        }
+        } );
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -30,6 +30,7 @@
 
 #include "clayer_triangles.h"
 #include <wx/debug.h>   // For the wxASSERT
+#include <task_scheduler.h>
 
 
 CLAYER_TRIANGLE_CONTAINER::CLAYER_TRIANGLE_CONTAINER( unsigned int aNrReservedTriangles,
@@ -219,8 +220,9 @@ void CLAYER_TRIANGLES::AddToMiddleContourns( const std::vector< SFVEC2F > &aCont
             const SFVEC2F &v0 = aContournPoints[i + 0];
             const SFVEC2F &v1 = aContournPoints[i + 1];
 
-            #pragma omp critical
             {
+                std::lock_guard<std::mutex> lock( m_middle_layer_lock );
+
                 m_layer_middle_contourns_quads->AddQuad( SFVEC3F( v0.x, v0.y, zTop ),
                                                          SFVEC3F( v1.x, v1.y, zTop ),
                                                          SFVEC3F( v1.x, v1.y, zBot ),
@@ -305,8 +307,9 @@ void CLAYER_TRIANGLES::AddToMiddleContourns( const SHAPE_POLY_SET &aPolySet,
     m_layer_middle_contourns_quads->Reserve_More( nrContournPointsToReserve * 2,
                                                   true );
 
-    #pragma omp parallel for
-    for( signed int i = 0; i < aPolySet.OutlineCount(); ++i )
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, aPolySet.OutlineCount(), [&]( int i )
     {
         // Add outline
         const SHAPE_LINE_CHAIN& pathOutline = aPolySet.COutline( i );
@@ -319,7 +322,7 @@ void CLAYER_TRIANGLES::AddToMiddleContourns( const SHAPE_POLY_SET &aPolySet,
             const SHAPE_LINE_CHAIN &hole = aPolySet.CHole( i, h );
             AddToMiddleContourns( hole, zBot, zTop, aBiuTo3Du, aInvertFaceDirection );
         }
-    }
+    } );
 }
 
 
@@ -34,6 +34,7 @@
 #include <plugins/3dapi/xv3d_types.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
+#include <mutex>
 #include <vector>
 
 
@@ -179,6 +180,10 @@ public:
     CLAYER_TRIANGLE_CONTAINER *m_layer_middle_contourns_quads;
     CLAYER_TRIANGLE_CONTAINER *m_layer_bot_triangles;
     CLAYER_TRIANGLE_CONTAINER *m_layer_bot_segment_ends;
+
+private:
+    /// Guards m_layer_middle_contourns_quads, the contours are added from parallel tasks
+    std::mutex m_middle_layer_lock;
 };
 
 
@@ -33,6 +33,7 @@
  *  - Code style to match KiCad
  *  - Asserts converted
  *  - Use compare functions/structures for std::partition and std::nth_element
+ *  - Build the BVH on the threads of the TASK_SCHEDULER
  *
  * The original source code has the following licence:
  *
@@ -68,6 +69,7 @@
 
 #include "cbvh_pbrt.h"
 #include "../../../3d_fastmath.h"
+#include <algorithm>
 #include <vector>
 #include <boost/range/algorithm/partition.hpp>
 #include <boost/range/algorithm/nth_element.hpp>
@@ -75,11 +77,23 @@
 
 #include <stack>
 #include <wx/debug.h>
+#include <task_scheduler.h>
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
 #include <stdio.h>
+#include <profile.h>
 #endif
 
+
+/// Number of items processed by a task in the parallel loops of the build
+static const int BUILD_CHUNK_SIZE = 16384;
+
+/// The SAH nodes with more primitives are split by tasks
+static const int PARALLEL_SAH_MIN_PRIMS = 4096;
+
+/// The upper HLBVH nodes with more treelets are split by tasks
+static const int PARALLEL_UPPER_SAH_MIN_NODES = 64;
+
 // BVHAccel Local Declarations
 struct BVHPrimitiveInfo
 {
@@ -183,6 +197,16 @@ static void RadixSort( std::vector<MortonPrimitive> *v )
     wxASSERT( (nBits % bitsPerPass) == 0 );
 
     const int nPasses = nBits / bitsPerPass;
+    const int nBuckets = 1 << bitsPerPass;
+    const int bitMask = (1 << bitsPerPass) - 1;
+
+    // Each chunk of the vector is counted and scattered by its own task. In each bucket,
+    // the chunks write their primitives one after the other, so the sort stays stable
+    const int nItems = (int)v->size();
+    const int nChunks = std::max( 1, (nItems + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE );
+
+    // Number of primitives, then starting index in output array, by chunk and bucket
+    std::vector<int> startIndex( nChunks * nBuckets );
 
     for( int pass = 0; pass < nPasses; ++pass )
     {
@@ -193,35 +217,55 @@ static void RadixSort( std::vector<MortonPrimitive> *v )
         std::vector<MortonPrimitive> &in  = (pass & 1) ? tempVector : *v;
         std::vector<MortonPrimitive> &out = (pass & 1) ? *v : tempVector;
 
-        // Count number of zero bits in array for current radix sort bit
-        const int nBuckets = 1 << bitsPerPass;
-        int bucketCount[nBuckets] = {0};
-        const int bitMask = (1 << bitsPerPass) - 1;
+        // Count number of primitives of each chunk in each bucket
+        TASK_GROUP countGroup;
 
-        for( uint32_t i = 0; i < in.size(); ++i )
+        countGroup.ParallelFor( 0, nChunks, [&]( int aChunk )
         {
-            const MortonPrimitive &mp = in[i];
-            int bucket = (mp.mortonCode >> lowBit) & bitMask;
+            int *bucketCount = &startIndex[aChunk * nBuckets];
+            const int end = std::min( nItems, (aChunk + 1) * BUILD_CHUNK_SIZE );
 
-            wxASSERT( (bucket >= 0) && (bucket < nBuckets) );
+            std::fill( bucketCount, bucketCount + nBuckets, 0 );
 
-            ++bucketCount[bucket];
-        }
+            for( int i = aChunk * BUILD_CHUNK_SIZE; i < end; ++i )
+            {
+                int bucket = (in[i].mortonCode >> lowBit) & bitMask;
 
-        // Compute starting index in output array for each bucket
-        int startIndex[nBuckets];
-        startIndex[0] = 0;
+                wxASSERT( (bucket >= 0) && (bucket < nBuckets) );
 
-        for( int i = 1; i < nBuckets; ++i )
-            startIndex[i] = startIndex[i - 1] + bucketCount[i - 1];
+                ++bucketCount[bucket];
+            }
+        } );
 
-        // Store sorted values in output array
-        for( uint32_t i = 0; i < in.size(); ++i )
+        // Compute starting index in output array for each bucket of each chunk
+        int start = 0;
+
+        for( int bucket = 0; bucket < nBuckets; ++bucket )
         {
-            const MortonPrimitive &mp = in[i];
-            int bucket = (mp.mortonCode >> lowBit) & bitMask;
-            out[startIndex[bucket]++] = mp;
+            for( int chunk = 0; chunk < nChunks; ++chunk )
+            {
+                const int count = startIndex[chunk * nBuckets + bucket];
+
+                startIndex[chunk * nBuckets + bucket] = start;
+                start += count;
+            }
         }
+
+        // Store sorted values in output array
+        TASK_GROUP scatterGroup;
+
+        scatterGroup.ParallelFor( 0, nChunks, [&]( int aChunk )
+        {
+            int *chunkStartIndex = &startIndex[aChunk * nBuckets];
+            const int end = std::min( nItems, (aChunk + 1) * BUILD_CHUNK_SIZE );
+
+            for( int i = aChunk * BUILD_CHUNK_SIZE; i < end; ++i )
+            {
+                const MortonPrimitive &mp = in[i];
+                int bucket = (mp.mortonCode >> lowBit) & bitMask;
+                out[chunkStartIndex[bucket]++] = mp;
+            }
+        } );
     }
 
     // Copy final result from _tempVector_, if needed
@@ -230,6 +274,59 @@ static void RadixSort( std::vector<MortonPrimitive> *v )
 }
 
 
+/**
+ * Computes the bounds and the centroid bounds of primitiveInfo[start, end). The large
+ * ranges are computed by chunks in parallel, the result does not depend on the order of
+ * the unions.
+ */
+static void ComputeBounds( const std::vector<BVHPrimitiveInfo> &primitiveInfo,
+                           int start, int end,
+                           CBBOX &bounds, CBBOX &centroidBounds )
+{
+    bounds.Reset();
+    centroidBounds.Reset();
+
+    if( (end - start) < PARALLEL_SAH_MIN_PRIMS )
+    {
+        for( int i = start; i < end; ++i )
+        {
+            bounds.Union( primitiveInfo[i].bounds );
+            centroidBounds.Union( primitiveInfo[i].centroid );
+        }
+
+        return;
+    }
+
+    const int nChunks = (end - start + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE;
+
+    std::vector<CBBOX> chunkBounds( nChunks );
+    std::vector<CBBOX> chunkCentroidBounds( nChunks );
+
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, nChunks, [&]( int aChunk )
+    {
+        const int first = start + aChunk * BUILD_CHUNK_SIZE;
+        const int last = std::min( end, first + BUILD_CHUNK_SIZE );
+
+        chunkBounds[aChunk].Reset();
+        chunkCentroidBounds[aChunk].Reset();
+
+        for( int i = first; i < last; ++i )
+        {
+            chunkBounds[aChunk].Union( primitiveInfo[i].bounds );
+            chunkCentroidBounds[aChunk].Union( primitiveInfo[i].centroid );
+        }
+    } );
+
+    for( int i = 0; i < nChunks; ++i )
+    {
+        bounds.Union( chunkBounds[i] );
+        centroidBounds.Union( chunkCentroidBounds[i] );
+    }
+}
+
+
 CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
                       int aMaxPrimsInNode,
                       SPLITMETHOD aSplitMethod ) :
@@ -243,6 +340,10 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
         return;
     }
 
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_startTime = GetRunningMicroSecs();
+#endif
+
     // Initialize the indexes of ray packet for partition traversal
     for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
     {
@@ -259,19 +360,26 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
     // /////////////////////////////////////////////////////////////////////////
     std::vector<BVHPrimitiveInfo> primitiveInfo( m_primitives.size() );
 
-    for( size_t i = 0; i < m_primitives.size(); ++i )
     {
-        wxASSERT( m_primitives[i]->GetBBox().IsInitialized() );
+        TASK_GROUP group;
+
+        group.ParallelFor( 0, (int)m_primitives.size(), [&]( int i )
+        {
+            wxASSERT( m_primitives[i]->GetBBox().IsInitialized() );
 
-        primitiveInfo[i] = BVHPrimitiveInfo( i, m_primitives[i]->GetBBox() );
+            primitiveInfo[i] = BVHPrimitiveInfo( i, m_primitives[i]->GetBBox() );
+        }, BUILD_CHUNK_SIZE );
     }
 
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_startBuildTime = GetRunningMicroSecs();
+#endif
+
     // Build BVH tree for primitives using _primitiveInfo_
     int totalNodes = 0;
 
-    CONST_VECTOR_OBJECT orderedPrims;
-    orderedPrims.clear();
-    orderedPrims.reserve( m_primitives.size() );
+    // The leaves store their primitives at their final place, from any thread
+    CONST_VECTOR_OBJECT orderedPrims( m_primitives.size() );
 
     BVHBuildNode *root;
 
@@ -285,6 +393,10 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
 
     m_primitives.swap( orderedPrims );
 
+#ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_endBuildTime = GetRunningMicroSecs();
+#endif
+
     // Compute representation of depth-first traversal of BVH tree
     m_nodes = static_cast<LinearBVHNode *>( malloc( sizeof( LinearBVHNode ) *
                                                     totalNodes ) );
@@ -305,6 +417,8 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
     wxASSERT( offset == (unsigned int)totalNodes );
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
+    unsigned stats_endTime = GetRunningMicroSecs();
+
     uint32_t treeBytes = totalNodes * sizeof( LinearBVHNode ) + sizeof( *this ) +
                          m_primitives.size() * sizeof( m_primitives[0] ) +
                          m_addresses_pointer_to_mm_free.size() * sizeof( void * );
@@ -322,6 +436,15 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
 
     printf( "  BVH created with %d nodes (%.2f MB)\n",
             totalNodes, float(treeBytes) / (1024.f * 1024.f) );
+    printf( "  Primitives info:  %.3f ms\n", (float)( stats_startBuildTime -
+                                                      stats_startTime ) / 1000.0f );
+    printf( "  Build tree:       %.3f ms\n", (float)( stats_endBuildTime -
+                                                      stats_startBuildTime ) / 1000.0f );
+    printf( "  Flatten tree:     %.3f ms\n", (float)( stats_endTime -
+                                                      stats_endBuildTime ) / 1000.0f );
+    printf( "  Total build time: %.3f ms (%u threads)\n",
+            (float)( stats_endTime - stats_startTime ) / 1000.0f,
+            DefaultTaskScheduler().WorkerCount() + 1 );
     printf( "////////////////////////////////////////////////////////////////////////////////\n\n" );
 #endif
 }
@@ -344,6 +467,18 @@ CBVH_PBRT::~CBVH_PBRT()
 }
 
 
+void *CBVH_PBRT::allocate( size_t aSize )
+{
+    // !TODO: implement a memory arena
+    void *block = malloc( aSize );
+
+    std::lock_guard<std::mutex> lock( m_allocMutex );
+    m_addresses_pointer_to_mm_free.push_back( block );
+
+    return block;
+}
+
+
 struct ComparePoints
 {
     explicit ComparePoints(int d) { dim = d; }
@@ -442,6 +577,79 @@ struct BucketInfo
 };
 
 
+/// Adds the primitives primitiveInfo[start, end) to the SAH buckets along dim
+static void FillBuckets( const std::vector<BVHPrimitiveInfo> &primitiveInfo,
+                         int start, int end, int dim, const CBBOX &centroidBounds,
+                         BucketInfo *buckets, int nBuckets )
+{
+    for( int i = start; i < end; ++i )
+    {
+        int b = nBuckets * centroidBounds.Offset( primitiveInfo[i].centroid )[dim];
+
+        if( b == nBuckets )
+            b = nBuckets - 1;
+
+        wxASSERT( b >= 0 && b < nBuckets );
+
+        buckets[b].count++;
+        buckets[b].bounds.Union( primitiveInfo[i].bounds );
+    }
+}
+
+
+/**
+ * Initializes the SAH buckets of primitiveInfo[start, end) along dim. The large ranges are
+ * computed by chunks in parallel, the result does not depend on the order of the merge.
+ */
+static void ComputeBuckets( const std::vector<BVHPrimitiveInfo> &primitiveInfo,
+                            int start, int end, int dim, const CBBOX &centroidBounds,
+                            BucketInfo *buckets, int nBuckets )
+{
+    for( int i = 0; i < nBuckets; ++i )
+    {
+        buckets[i].count = 0;
+        buckets[i].bounds.Reset();
+    }
+
+    if( (end - start) < PARALLEL_SAH_MIN_PRIMS )
+    {
+        FillBuckets( primitiveInfo, start, end, dim, centroidBounds, buckets, nBuckets );
+
+        return;
+    }
+
+    const int nChunks = (end - start + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE;
+
+    std::vector<BucketInfo> chunkBuckets( nChunks * nBuckets );
+
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, nChunks, [&]( int aChunk )
+    {
+        BucketInfo *chunk = &chunkBuckets[aChunk * nBuckets];
+        const int first = start + aChunk * BUILD_CHUNK_SIZE;
+        const int last = std::min( end, first + BUILD_CHUNK_SIZE );
+
+        for( int i = 0; i < nBuckets; ++i )
+        {
+            chunk[i].count = 0;
+            chunk[i].bounds.Reset();
+        }
+
+        FillBuckets( primitiveInfo, first, last, dim, centroidBounds, chunk, nBuckets );
+    } );
+
+    for( int chunk = 0; chunk < nChunks; ++chunk )
+    {
+        for( int i = 0; i < nBuckets; ++i )
+        {
+            buckets[i].count += chunkBuckets[chunk * nBuckets + i].count;
+            buckets[i].bounds.Union( chunkBuckets[chunk * nBuckets + i].bounds );
+        }
+    }
+}
+
+
 BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primitiveInfo,
                                           int start,
                                           int end,
@@ -458,9 +666,7 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
 
     (*totalNodes)++;
 
-    // !TODO: implement an memory Arena
-    BVHBuildNode *node = static_cast<BVHBuildNode *>( malloc( sizeof( BVHBuildNode ) ) );
-    m_addresses_pointer_to_mm_free.push_back( node );
+    BVHBuildNode *node = static_cast<BVHBuildNode *>( allocate( sizeof( BVHBuildNode ) ) );
 
     node->bounds.Reset();
     node->firstPrimOffset = 0;
@@ -469,38 +675,33 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
     node->children[0] = NULL;
     node->children[1] = NULL;
 
-    // Compute bounds of all primitives in BVH node
+    // Compute bounds of all primitives in BVH node, and bound of primitive centroids
     CBBOX bounds;
-    bounds.Reset();
+    CBBOX centroidBounds;
 
-    for( int i = start; i < end; ++i )
-        bounds.Union( primitiveInfo[i].bounds );
+    ComputeBounds( primitiveInfo, start, end, bounds, centroidBounds );
 
     int nPrimitives = end - start;
 
+    // The leaves are created from left to right by a serial build, so the primitives of a
+    // leaf are ordered at the same place as in _primitiveInfo_: [start, end)
     if( nPrimitives == 1 )
     {
         // Create leaf _BVHBuildNode_
-        int firstPrimOffset = orderedPrims.size();
+        int firstPrimOffset = start;
 
         for( int i = start; i < end; ++i )
         {
             int primitiveNr = primitiveInfo[i].primitiveNumber;
             wxASSERT( primitiveNr < (int)m_primitives.size() );
-            orderedPrims.push_back( m_primitives[ primitiveNr ] );
+            orderedPrims[i] = m_primitives[ primitiveNr ];
         }
 
         node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
     }
     else
     {
-        // Compute bound of primitive centroids, choose split dimension _dim_
-        CBBOX centroidBounds;
-        centroidBounds.Reset();
-
-        for( int i = start; i < end; ++i )
-            centroidBounds.Union( primitiveInfo[i].centroid );
-
+        // Choose split dimension _dim_
         const int dim = centroidBounds.MaxDimension();
 
         // Partition primitives into two sets and build children
@@ -510,7 +711,7 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
                   centroidBounds.Min()[dim] ) < (FLT_EPSILON + FLT_EPSILON) )
         {
             // Create leaf _BVHBuildNode_
-            const int firstPrimOffset = orderedPrims.size();
+            const int firstPrimOffset = start;
 
             for( int i = start; i < end; ++i )
             {
@@ -523,7 +724,7 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
 
                 wxASSERT( obj != NULL );
 
-                orderedPrims.push_back( obj );
+                orderedPrims[i] = obj;
             }
 
             node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
@@ -587,26 +788,9 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
 
                     BucketInfo buckets[nBuckets];
 
-                    for( int i = 0; i < nBuckets; ++i )
-                    {
-                        buckets[i].count = 0;
-                        buckets[i].bounds.Reset();
-                    }
-
                     // Initialize _BucketInfo_ for SAH partition buckets
-                    for( int i = start; i < end; ++i )
-                    {
-                        int b = nBuckets *
-                                centroidBounds.Offset( primitiveInfo[i].centroid )[dim];
-
-                        if( b == nBuckets )
-                            b = nBuckets - 1;
-
-                        wxASSERT( b >= 0 && b < nBuckets );
-
-                        buckets[b].count++;
-                        buckets[b].bounds.Union( primitiveInfo[i].bounds );
-                    }
+                    ComputeBuckets( primitiveInfo, start, end, dim, centroidBounds,
+                                    buckets, nBuckets );
 
                     // Compute costs for splitting after each bucket
                     float cost[nBuckets - 1];
@@ -678,7 +862,7 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
                     else
                     {
                         // Create leaf _BVHBuildNode_
-                        const int firstPrimOffset = orderedPrims.size();
+                        const int firstPrimOffset = start;
 
                         for( int i = start; i < end; ++i )
                         {
@@ -686,7 +870,7 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
 
                             wxASSERT( primitiveNr < (int)m_primitives.size() );
 
-                            orderedPrims.push_back( m_primitives[ primitiveNr ] );
+                            orderedPrims[i] = m_primitives[ primitiveNr ];
                         }
 
                         node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
@@ -698,17 +882,38 @@ BVHBuildNode *CBVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo> &primiti
             }
             }
 
-            node->InitInterior( dim,
-                                recursiveBuild( primitiveInfo,
-                                                start,
-                                                mid,
-                                                totalNodes,
-                                                orderedPrims ),
-                                recursiveBuild( primitiveInfo,
-                                                mid,
-                                                end,
-                                                totalNodes,
-                                                orderedPrims) );
+            BVHBuildNode *children[2];
+
+            if( nPrimitives >= PARALLEL_SAH_MIN_PRIMS )
+            {
+                // The children use disjoint ranges of _primitiveInfo_ and _orderedPrims_:
+                // build the first one by a task while this thread builds the second one
+                int firstChildNodes = 0;
+
+                TASK_GROUP group;
+
+                group.Run( [&]()
+                {
+                    children[0] = recursiveBuild( primitiveInfo, start, mid,
+                                                  &firstChildNodes, orderedPrims );
+                } );
+
+                children[1] = recursiveBuild( primitiveInfo, mid, end,
+                                              totalNodes, orderedPrims );
+
+                group.Wait();
+
+                *totalNodes += firstChildNodes;
+            }
+            else
+            {
+                children[0] = recursiveBuild( primitiveInfo, start, mid,
+                                              totalNodes, orderedPrims );
+                children[1] = recursiveBuild( primitiveInfo, mid, end,
+                                              totalNodes, orderedPrims );
+            }
+
+            node->InitInterior( dim, children[0], children[1] );
         }
     }
 
@@ -721,16 +926,17 @@ BVHBuildNode *CBVH_PBRT::HLBVHBuild( const std::vector<BVHPrimitiveInfo> &primit
                                      CONST_VECTOR_OBJECT &orderedPrims )
 {
     // Compute bounding box of all primitive centroids
+    CBBOX primitivesBounds;
     CBBOX bounds;
-    bounds.Reset();
 
-    for( unsigned int i = 0; i < primitiveInfo.size(); ++i )
-        bounds.Union( primitiveInfo[i].centroid );
+    ComputeBounds( primitiveInfo, 0, primitiveInfo.size(), primitivesBounds, bounds );
 
     // Compute Morton indices of primitives
     std::vector<MortonPrimitive> mortonPrims( primitiveInfo.size() );
 
-    for( int i = 0; i < (int)primitiveInfo.size(); ++i )
+    TASK_GROUP mortonGroup;
+
+    mortonGroup.ParallelFor( 0, (int)primitiveInfo.size(), [&]( int i )
     {
         // Initialize _mortonPrims[i]_ for _i_th primitive
         const int mortonBits  = 10;
@@ -748,7 +954,7 @@ BVHBuildNode *CBVH_PBRT::HLBVHBuild( const std::vector<BVHPrimitiveInfo> &primit
 
         mortonPrims[i].mortonCode = EncodeMorton3( centroidOffset *
                                                    SFVEC3F( (float)mortonScale ) );
-    }
+    }, BUILD_CHUNK_SIZE );
 
     // Radix sort primitive Morton indices
     RadixSort( &mortonPrims );
@@ -766,31 +972,13 @@ BVHBuildNode *CBVH_PBRT::HLBVHBuild( const std::vector<BVHPrimitiveInfo> &primit
             ( (mortonPrims[start].mortonCode & mask) !=
               (mortonPrims[end].mortonCode & mask) ) )
         {
-            // Add entry to _treeletsToBuild_ for this treelet
-            const int numPrimitives = end - start;
-            const int maxBVHNodes = 2 * numPrimitives;
-
-            // !TODO: implement a memory arena
-            BVHBuildNode *nodes = static_cast<BVHBuildNode *>( malloc( maxBVHNodes *
-                                                                           sizeof( BVHBuildNode ) ) );
-
-            m_addresses_pointer_to_mm_free.push_back( nodes );
-
-            for( int i = 0; i < maxBVHNodes; ++i )
-            {
-                nodes[i].bounds.Reset();
-                nodes[i].firstPrimOffset = 0;
-                nodes[i].nPrimitives = 0;
-                nodes[i].splitAxis = 0;
-                nodes[i].children[0] = NULL;
-                nodes[i].children[1] = NULL;
-            }
-
+            // Add entry to _treeletsToBuild_ for this treelet, its nodes are allocated
+            // by the task building it
             LBVHTreelet tmpTreelet;
 
             tmpTreelet.startIndex = start;
-            tmpTreelet.numPrimitives = numPrimitives;
-            tmpTreelet.buildNodes = nodes;
+            tmpTreelet.numPrimitives = end - start;
+            tmpTreelet.buildNodes = NULL;
 
             treeletsToBuild.push_back( tmpTreelet );
 
@@ -799,34 +987,54 @@ BVHBuildNode *CBVH_PBRT::HLBVHBuild( const std::vector<BVHPrimitiveInfo> &primit
     }
 
     // Create LBVHs for treelets in parallel
-    int atomicTotal = 0;
-    int orderedPrimsOffset = 0;
+    // The treelets are sorted, so the primitives of a treelet are ordered at the same place
+    // as its Morton codes: [startIndex, startIndex + numPrimitives)
+    std::vector<int> nodesCreated( treeletsToBuild.size(), 0 );
 
-    orderedPrims.resize( m_primitives.size() );
+    wxASSERT( orderedPrims.size() == m_primitives.size() );
 
-    for( int index = 0; index < (int)treeletsToBuild.size(); ++index )
+    TASK_GROUP treeletsGroup;
+
+    treeletsGroup.ParallelFor( 0, (int)treeletsToBuild.size(), [&]( int index )
     {
         // Generate _index_th LBVH treelet
-        int nodesCreated = 0;
         const int firstBit = 29 - 12;
 
         LBVHTreelet &tr = treeletsToBuild[index];
 
         wxASSERT( tr.startIndex < (int)mortonPrims.size() );
 
-        tr.buildNodes = emitLBVH( tr.buildNodes,
+        const int maxBVHNodes = 2 * tr.numPrimitives;
+
+        BVHBuildNode *nodes = static_cast<BVHBuildNode *>( allocate( maxBVHNodes *
+                                                                     sizeof( BVHBuildNode ) ) );
+
+        for( int i = 0; i < maxBVHNodes; ++i )
+        {
+            nodes[i].bounds.Reset();
+            nodes[i].firstPrimOffset = 0;
+            nodes[i].nPrimitives = 0;
+            nodes[i].splitAxis = 0;
+            nodes[i].children[0] = NULL;
+            nodes[i].children[1] = NULL;
+        }
+
+        int orderedPrimsOffset = tr.startIndex;
+
+        tr.buildNodes = emitLBVH( nodes,
                                   primitiveInfo,
                                   &mortonPrims[tr.startIndex],
                                   tr.numPrimitives,
-                                  &nodesCreated,
+                                  &nodesCreated[index],
                                   orderedPrims,
                                   &orderedPrimsOffset,
                                   firstBit );
+    } );
 
-        atomicTotal += nodesCreated;
-    }
+    *totalNodes = 0;
 
-    *totalNodes = atomicTotal;
+    for( int index = 0; index < (int)treeletsToBuild.size(); ++index )
+        *totalNodes += nodesCreated[index];
 
     // Initialize _finishedTreelets_ with treelet root node pointers
     std::vector<BVHBuildNode *> finishedTreelets;
@@ -961,9 +1169,7 @@ BVHBuildNode *CBVH_PBRT::buildUpperSAH(
 
     (*totalNodes)++;
 
-    BVHBuildNode *node = static_cast<BVHBuildNode *>( malloc( sizeof( BVHBuildNode ) ) );
-
-    m_addresses_pointer_to_mm_free.push_back( node );
+    BVHBuildNode *node = static_cast<BVHBuildNode *>( allocate( sizeof( BVHBuildNode ) ) );
 
     node->bounds.Reset();
     node->firstPrimOffset = 0;
@@ -1087,9 +1293,33 @@ BVHBuildNode *CBVH_PBRT::buildUpperSAH(
 
     wxASSERT( (mid > start) && (mid < end) );
 
-    node->InitInterior( dim,
-                        buildUpperSAH( treeletRoots, start, mid, totalNodes ),
-                        buildUpperSAH( treeletRoots, mid,   end, totalNodes ) );
+    BVHBuildNode *children[2];
+
+    if( nNodes >= PARALLEL_UPPER_SAH_MIN_NODES )
+    {
+        // Build the first child by a task while this thread builds the second one
+        int firstChildNodes = 0;
+
+        TASK_GROUP group;
+
+        group.Run( [&]()
+        {
+            children[0] = buildUpperSAH( treeletRoots, start, mid, &firstChildNodes );
+        } );
+
+        children[1] = buildUpperSAH( treeletRoots, mid, end, totalNodes );
+
+        group.Wait();
+
+        *totalNodes += firstChildNodes;
+    }
+    else
+    {
+        children[0] = buildUpperSAH( treeletRoots, start, mid, totalNodes );
+        children[1] = buildUpperSAH( treeletRoots, mid,   end, totalNodes );
+    }
+
+    node->InitInterior( dim, children[0], children[1] );
 
     return node;
 }
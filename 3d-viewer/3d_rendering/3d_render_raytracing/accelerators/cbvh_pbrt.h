@@ -72,6 +72,7 @@
 
 #include "caccelerator.h"
 #include <list>
+#include <mutex>
 #include <stdint.h>
 
 // Forward Declarations
@@ -107,6 +108,15 @@ enum SPLITMETHOD
 };
 
 
+/**
+ * Class CBVH_PBRT
+ * is the bounding volume hierarchy of the raytracer.
+ *
+ * The hierarchy is built on the threads of the default TASK_SCHEDULER: the large nodes of
+ * the SAH build and of the upper levels of the HLBVH build are split by tasks, the Morton
+ * codes, their radix sort and the LBVH treelets are computed in parallel.  The build is
+ * deterministic, the flattened nodes are the same as the ones of a serial build.
+ */
 class  CBVH_PBRT : public CGENERICACCELERATOR
 {
 
@@ -153,6 +163,9 @@ private:
     int flattenBVHTree( BVHBuildNode *node,
                         uint32_t *offset );
 
+    /// Allocates a memory block freed by the destructor, can be called from any thread
+    void *allocate( size_t aSize );
+
     // BVH Private Data
     const int           m_maxPrimsInNode;
     SPLITMETHOD         m_splitMethod;
@@ -160,6 +173,7 @@ private:
     LinearBVHNode       *m_nodes;
 
     std::list<void *> m_addresses_pointer_to_mm_free;
+    std::mutex        m_allocMutex;     ///< guards m_addresses_pointer_to_mm_free
 
     // Partition traversal
     unsigned int m_I[RAYPACKET_RAYS_PER_PACKET];
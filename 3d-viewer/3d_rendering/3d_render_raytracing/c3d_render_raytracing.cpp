@@ -37,15 +37,12 @@
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
 #include <profile.h>        // To use GetRunningMicroSecs or an other profiling utility
+#include <task_scheduler.h>
 
 // This should be used in future for the function
 // convertLinearToSRGB
 //#include <glm/gtc/color_space.hpp>
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
 C3D_RENDER_RAYTRACING::C3D_RENDER_RAYTRACING( CINFO3D_VISU &aSettings ) :
                        C3D_RENDER_BASE( aSettings ),
                        m_postshader_ssao( aSettings.CameraGet() )
@@ -367,48 +364,37 @@ void C3D_RENDER_RAYTRACING::rt_render_tracing( GLubyte *ptrPBO ,
 
     const long nrBlocks = (long) m_blockPositions.size();
     const unsigned startTime = GetRunningMicroSecs();
-    bool breakLoop = false;
-    int numBlocksRendered = 0;
+    std::atomic<int> numBlocksRendered( 0 );
+    std::mutex processedMutex;
+    TASK_GROUP group;
 
-    #pragma omp parallel for schedule(dynamic) shared(breakLoop) \
-        firstprivate(ptrPBO, nrBlocks, startTime) reduction(+:numBlocksRendered) default(none)
-    for( long iBlock = 0; iBlock < nrBlocks; iBlock++ )
+    // The group is cancelled once some time has been spent rendering, to display the progress;
+    // the blocks not yet started are picked up by the next call.
+    group.ParallelFor( 0, nrBlocks, [&]( int iBlock )
     {
+        bool process_block;
 
-        #pragma omp flush(breakLoop)
-        if( !breakLoop )
         {
-            bool process_block;
-
             // std::vector<bool> stuffs eight bools to each byte, so access to
             // them can never be natively atomic.
-            #pragma omp critical(checkProcessBlock)
-            {
-                process_block = !m_blockPositionsWasProcessed[iBlock];
-                m_blockPositionsWasProcessed[iBlock] = true;
-            }
-
-            if( process_block )
-            {
-                rt_render_trace_block( ptrPBO, iBlock );
-                numBlocksRendered++;
+            std::lock_guard<std::mutex> lock( processedMutex );
+            process_block = !m_blockPositionsWasProcessed[iBlock];
+            m_blockPositionsWasProcessed[iBlock] = true;
+        }
 
+        if( process_block )
+        {
+            rt_render_trace_block( ptrPBO, iBlock );
+            numBlocksRendered++;
 
-                // Check if it spend already some time render and request to exit
-                // to display the progress
-                #ifdef _OPENMP
-                if( omp_get_thread_num() == 0 )
-                #endif
-                    if( (GetRunningMicroSecs() - startTime) > 150000 )
-                    {
-                        breakLoop = true;
-                        #pragma omp flush(breakLoop)
-                    }
-            }
+            // Check if it spend already some time render and request to exit
+            // to display the progress
+            if( (GetRunningMicroSecs() - startTime) > 150000 )
+                group.Cancel();
         }
-    }
+    } );
 
-    m_nrBlocksRenderProgress += numBlocksRendered;
+    m_nrBlocksRenderProgress += numBlocksRendered.load();
 
     if( aStatusTextReporter )
         aStatusTextReporter->Report( wxString::Format( _( "Rendering: %.0f %%" ),
@@ -925,8 +911,9 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
             aStatusTextReporter->Report( _("Rendering: Post processing shader") );
 
         // Compute the shader value
-        #pragma omp parallel for schedule(dynamic)
-        for( signed int y = 0; y < (int)m_realBufferSize.y; ++y )
+        TASK_GROUP group;
+
+        group.ParallelFor( 0, m_realBufferSize.y, [&]( int y )
         {
             SFVEC3F *ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
 
@@ -935,10 +922,7 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_shade( GLubyte *ptrPBO,
                 *ptr = m_postshader_ssao.Shade( SFVEC2I( x, y ) );
                 ptr++;
             }
-        }
-
-        // Wait for all threads to finish
-        #pragma omp barrier
+        } );
 
         // Set next state
         m_rt_render_state = RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH;
@@ -959,122 +943,102 @@ void C3D_RENDER_RAYTRACING::rt_render_post_process_blur_finish( GLubyte *ptrPBO,
     if( m_settings.GetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING ) )
     {
         // Now blurs the shader result and compute the final color
-        #pragma omp parallel for schedule(dynamic)
-        for( signed int y = 0; y < (int)m_realBufferSize.y; ++y )
-        {
-            GLubyte *ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
-
-            SFVEC3F *ptrShaderY0 =
-                    &m_shaderBuffer[ glm::max((int)y - 2, 0) * m_realBufferSize.x ];
-            SFVEC3F *ptrShaderY1 =
-                    &m_shaderBuffer[ glm::max((int)y - 1, 0) * m_realBufferSize.x ];
-            SFVEC3F *ptrShaderY2 =
-                    &m_shaderBuffer[ y * m_realBufferSize.x ];
-            SFVEC3F *ptrShaderY3 =
-                    &m_shaderBuffer[ glm::min((int)y + 1, (int)(m_realBufferSize.y - 1)) *
-                                     m_realBufferSize.x ];
-            SFVEC3F *ptrShaderY4 =
-                    &m_shaderBuffer[ glm::min((int)y + 2, (int)(m_realBufferSize.y - 1)) *
-                                     m_realBufferSize.x ];
+        const int width  = (int)m_realBufferSize.x;
+        const int height = (int)m_realBufferSize.y;
 
-            for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
-            {
-// This #if should be 1, it is here that can be used for debug proposes during development
-#if 1
+        TASK_GROUP group;
 
-                SFVEC3F bluredShadeColor = (*ptrShaderY0) * 1.0f / 273.0f +
-                                           (*ptrShaderY1) * 4.0f / 273.0f +
-                                           (*ptrShaderY2) * 7.0f / 273.0f +
-                                           (*ptrShaderY3) * 4.0f / 273.0f +
-                                           (*ptrShaderY4) * 1.0f / 273.0f;
-                if( x > 1 )
-                {
-                    ptrShaderY0++;
-                    ptrShaderY1++;
-                    ptrShaderY2++;
-                    ptrShaderY3++;
-                    ptrShaderY4++;
-                }
+        // The rows are blurred in bands, each one using a single line buffer
+        const int bandHeight = 16;
+        const int bandCount  = ( height + bandHeight - 1 ) / bandHeight;
 
-                bluredShadeColor += (*ptrShaderY0) * 4.0f / 273.0f +
-                                    (*ptrShaderY1) *16.0f / 273.0f +
-                                    (*ptrShaderY2) *26.0f / 273.0f +
-                                    (*ptrShaderY3) *16.0f / 273.0f +
-                                    (*ptrShaderY4) * 4.0f / 273.0f;
+        group.ParallelFor( 0, bandCount, [&]( int aBand )
+        {
+            std::vector<SFVEC3F> lines( width * 4 );
 
-                if( x > 0 )
-                {
-                    ptrShaderY0++;
-                    ptrShaderY1++;
-                    ptrShaderY2++;
-                    ptrShaderY3++;
-                    ptrShaderY4++;
-                }
+            SFVEC3F *colA = &lines[0];
+            SFVEC3F *colB = &lines[width];
+            SFVEC3F *colC = &lines[width * 2];
+            SFVEC3F *blured = &lines[width * 3];
 
-                bluredShadeColor += (*ptrShaderY0) * 7.0f / 273.0f +
-                                    (*ptrShaderY1) *26.0f / 273.0f +
-                                    (*ptrShaderY2) *41.0f / 273.0f +
-                                    (*ptrShaderY3) *26.0f / 273.0f +
-                                    (*ptrShaderY4) * 7.0f / 273.0f;
+            const int yEnd = glm::min( ( aBand + 1 ) * bandHeight, height );
 
-                if( x < ((int)m_realBufferSize.x - 1) )
+            for( int y = aBand * bandHeight; y < yEnd; ++y )
+            {
+                GLubyte *ptr = &ptrPBO[ y * width * 4 ];
+
+                const SFVEC3F *ptrShaderY0 = &m_shaderBuffer[ glm::max( y - 2, 0 ) * width ];
+                const SFVEC3F *ptrShaderY1 = &m_shaderBuffer[ glm::max( y - 1, 0 ) * width ];
+                const SFVEC3F *ptrShaderY2 = &m_shaderBuffer[ y * width ];
+                const SFVEC3F *ptrShaderY3 = &m_shaderBuffer[ glm::min( y + 1, height - 1 ) * width ];
+                const SFVEC3F *ptrShaderY4 = &m_shaderBuffer[ glm::min( y + 2, height - 1 ) * width ];
+
+                // The 5x5 gaussian kernel (/273) has only three different columns:
+                // (1 4 7 4 1), (4 16 26 16 4) and (7 26 41 26 7).
+                // The vertical pass filters the 5 rows with each of them, then the horizontal
+                // pass adds 5 filtered values: A[x-2] + B[x-1] + C[x] + B[x+1] + A[x+2]
+                for( int x = 0; x < width; ++x )
                 {
-                    ptrShaderY0++;
-                    ptrShaderY1++;
-                    ptrShaderY2++;
-                    ptrShaderY3++;
-                    ptrShaderY4++;
+                    const SFVEC3F outer  = ptrShaderY0[x] + ptrShaderY4[x];
+                    const SFVEC3F inner  = ptrShaderY1[x] + ptrShaderY3[x];
+                    const SFVEC3F center = ptrShaderY2[x];
+
+                    colA[x] = outer * ( 1.0f / 273.0f ) + inner * ( 4.0f / 273.0f ) +
+                              center * ( 7.0f / 273.0f );
+                    colB[x] = outer * ( 4.0f / 273.0f ) + inner * ( 16.0f / 273.0f ) +
+                              center * ( 26.0f / 273.0f );
+                    colC[x] = outer * ( 7.0f / 273.0f ) + inner * ( 26.0f / 273.0f ) +
+                              center * ( 41.0f / 273.0f );
                 }
 
-                bluredShadeColor += (*ptrShaderY0) * 4.0f / 273.0f +
-                                    (*ptrShaderY1) *16.0f / 273.0f +
-                                    (*ptrShaderY2) *26.0f / 273.0f +
-                                    (*ptrShaderY3) *16.0f / 273.0f +
-                                    (*ptrShaderY4) * 4.0f / 273.0f;
-
-                if( x < ((int)m_realBufferSize.x - 2) )
+                // Columns are clamped to the image only for the 2 pixels on each border
+                auto blurBorder = [&]( int x )
                 {
-                    ptrShaderY0++;
-                    ptrShaderY1++;
-                    ptrShaderY2++;
-                    ptrShaderY3++;
-                    ptrShaderY4++;
-                }
+                    blured[x] = colA[ glm::max( x - 2, 0 ) ] +
+                                colB[ glm::max( x - 1, 0 ) ] +
+                                colC[ x ] +
+                                colB[ glm::min( x + 1, width - 1 ) ] +
+                                colA[ glm::min( x + 2, width - 1 ) ];
+                };
+
+                const int interiorStart = glm::min( 2, width );
+                const int interiorEnd   = glm::max( width - 2, interiorStart );
 
-                bluredShadeColor += (*ptrShaderY0) * 1.0f / 273.0f +
-                                    (*ptrShaderY1) * 4.0f / 273.0f +
-                                    (*ptrShaderY2) * 7.0f / 273.0f +
-                                    (*ptrShaderY3) * 4.0f / 273.0f +
-                                    (*ptrShaderY4) * 1.0f / 273.0f;
+                for( int x = 0; x < interiorStart; ++x )
+                    blurBorder( x );
 
-                ptrShaderY0-= 3;
-                ptrShaderY1-= 3;
-                ptrShaderY2-= 3;
-                ptrShaderY3-= 3;
-                ptrShaderY4-= 3;
+                for( int x = interiorStart; x < interiorEnd; ++x )
+                    blured[x] = colA[x - 2] + colB[x - 1] + colC[x] + colB[x + 1] + colA[x + 2];
+
+                for( int x = interiorEnd; x < width; ++x )
+                    blurBorder( x );
+
+                for( int x = 0; x < width; ++x )
+                {
+// This #if should be 1, it is here that can be used for debug proposes during development
+#if 1
+                    const SFVEC3F &bluredShadeColor = blured[x];
 
 #ifdef USE_SRGB_SPACE
-                const SFVEC3F originColor = convertLinearToSRGB( m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) ) );
+                    const SFVEC3F originColor = convertLinearToSRGB( m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) ) );
 #else
-                const SFVEC3F originColor = m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) );
+                    const SFVEC3F originColor = m_postshader_ssao.GetColorAtNotProtected( SFVEC2I( x,y ) );
 #endif
 
-                const SFVEC3F shadedColor = m_postshader_ssao.ApplyShadeColor( SFVEC2I( x,y ), originColor, bluredShadeColor );
+                    const SFVEC3F shadedColor = m_postshader_ssao.ApplyShadeColor( SFVEC2I( x,y ), originColor, bluredShadeColor );
 #else
-                // Debug code
-                //const SFVEC3F shadedColor =  SFVEC3F( 1.0f ) -
-                //                             m_shaderBuffer[ y * m_realBufferSize.x + x];
-                const SFVEC3F shadedColor =  m_shaderBuffer[ y * m_realBufferSize.x + x ];
+                    // Debug code
+                    //const SFVEC3F shadedColor =  SFVEC3F( 1.0f ) -
+                    //                             m_shaderBuffer[ y * m_realBufferSize.x + x];
+                    const SFVEC3F shadedColor =  m_shaderBuffer[ y * m_realBufferSize.x + x ];
 #endif
 
-                rt_final_color( ptr, shadedColor, false );
+                    rt_final_color( ptr, shadedColor, false );
 
-                ptr += 4;
+                    ptr += 4;
+                }
             }
-        }
-
-        // Wait for all threads to finish
-        #pragma omp barrier
+        } );
 
         // Debug code
         //m_postshader_ssao.DebugBuffersOutputAsImages();
@@ -1091,8 +1055,9 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
 
     unsigned int nrBlocks = m_blockPositionsFast.size();
 
-    #pragma omp parallel for schedule(dynamic)
-    for( signed int iBlock = 0; iBlock < (int)nrBlocks; iBlock++ )
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, nrBlocks, [&]( int iBlock )
     {
         const SFVEC2UI &windowPosUI = m_blockPositionsFast[ iBlock ];
         const SFVEC2I windowsPos = SFVEC2I( windowPosUI.x + m_xoffset,
@@ -1693,10 +1658,7 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
                 SetPixel( ptr + 12, BlendColor( cRBC, BlendColor( cRB , cC ) ) );
             }
         }
-    }
-
-    // Wait for all threads to finish (not sure if this is need)
-    #pragma omp barrier
+    } );
 }
 
 
@@ -30,6 +30,8 @@
 #include "cimage.h"
 #include "buffers_debug.h"
 #include <string.h> // For memcpy
+#include <algorithm>
+#include <task_scheduler.h>
 
 #ifndef CLAMP
 #define CLAMP(n, min, max) {if( n < min ) n=min; else if( n > max ) n = max;}
@@ -458,10 +460,6 @@ static const S_FILTER FILTERS[] =   {
 };// Filters
 
 
-// !TODO: This functions can be optimized slipting it between the edges and
-//        do it without use the getpixel function.
-//        Optimization can be done to m_pixels[ix + iy * m_width]
-//        but keep in mind the parallel process of the algorithm
 void CIMAGE::EfxFilter( CIMAGE *aInImg, E_FILTER aFilterType )
 {
     S_FILTER filter = FILTERS[aFilterType];
@@ -469,34 +467,81 @@ void CIMAGE::EfxFilter( CIMAGE *aInImg, E_FILTER aFilterType )
     aInImg->m_wraping = WRAP_CLAMP;
     m_wraping = WRAP_CLAMP;
 
-    #pragma omp parallel for
-    for( int iy = 0; iy < (int)m_height; iy++)
+    const int width  = m_width;
+    const int height = m_height;
+    const unsigned char* src = aInImg->m_pixels;
+
+    TASK_GROUP group;
+
+    // The rows of the 5x5 window are clamped once per line, the columns are clamped
+    // only for the 2 pixels on each border. The result is the same as sampling
+    // aInImg with Getpixel() (WRAP_CLAMP).
+    group.ParallelFor( 0, m_height, [&]( int iy )
     {
-        for( int ix = 0; ix < (int)m_width; ix++ )
+        const unsigned char* rows[5];
+
+        for( int sy = 0; sy < 5; sy++ )
         {
-            int v = 0;
+            int y = iy + sy - 2;
 
-            for( int sy = 0; sy < 5; sy++ )
-            {
-                for( int sx = 0; sx < 5; sx++ )
-                {
-                    int factor = filter.kernel[sx][sy];
-                    unsigned char pixelv = aInImg->Getpixel( ix + sx - 2,
-                                                             iy + sy - 2 );
-
-                    v += pixelv * factor;
-                }
-            }
+            CLAMP( y, 0, height - 1 );
+            rows[sy] = &src[y * width];
+        }
+
+        unsigned char* dst = &m_pixels[iy * width];
 
+        auto storePixel = [&]( int ix, int v )
+        {
             v /= filter.div;
 
             v += filter.offset;
 
             CLAMP(v, 0, 255);
 
-            m_pixels[ix + iy * m_width] = v;
+            dst[ix] = v;
+        };
+
+        auto filterBorderPixel = [&]( int ix )
+        {
+            int v = 0;
+
+            for( int sx = 0; sx < 5; sx++ )
+            {
+                int x = ix + sx - 2;
+
+                CLAMP( x, 0, width - 1 );
+
+                for( int sy = 0; sy < 5; sy++ )
+                    v += rows[sy][x] * filter.kernel[sx][sy];
+            }
+
+            storePixel( ix, v );
+        };
+
+        const int interiorStart = std::min( 2, width );
+        const int interiorEnd = std::max( width - 2, interiorStart );
+
+        for( int ix = 0; ix < interiorStart; ix++ )
+            filterBorderPixel( ix );
+
+        for( int ix = interiorStart; ix < interiorEnd; ix++ )
+        {
+            int v = 0;
+
+            for( int sx = 0; sx < 5; sx++ )
+            {
+                const int x = ix + sx - 2;
+
+                for( int sy = 0; sy < 5; sy++ )
+                    v += rows[sy][x] * filter.kernel[sx][sy];
+            }
+
+            storePixel( ix, v );
         }
-    }
+
+        for( int ix = interiorEnd; ix < width; ix++ )
+            filterBorderPixel( ix );
+    } );
 }
 
 
@@ -97,6 +97,12 @@ private:
         return glm::min( idx, m_size.x * m_size.y );
     }
 
+protected:
+    /**
+     * @brief getIndex - index of a pixel in the buffers
+     * @param aPos - pixel position, it is clamped to the buffers size
+     * @return the index to use with m_normals, m_color, m_wc_hitposition, ...
+     */
     inline unsigned int getIndex( const SFVEC2I &aPos ) const
     {
         SFVEC2I clampPos;
@@ -106,7 +112,6 @@ private:
         return (unsigned int)( clampPos.x + m_size.x * clampPos.y );
     }
 
-protected:
     const CCAMERA &m_camera;
 
     SFVEC2UI m_size;
@@ -42,11 +42,9 @@ CPOSTSHADER_SSAO::CPOSTSHADER_SSAO( const CCAMERA &aCamera ) : CPOSTSHADER( aCam
 //http://www.gamedev.net/topic/556187-the-best-ssao-ive-seen/
 //http://www.gamedev.net/topic/556187-the-best-ssao-ive-seen/?view=findpost&p=4632208
 
-float CPOSTSHADER_SSAO::aoFF( const SFVEC2I &aShaderPos,
+float CPOSTSHADER_SSAO::aoFF( unsigned int aSampleIdx,
                               const SFVEC3F &ddiff,
-                              const SFVEC3F &cnorm,
-                              int c1,
-                              int c2 ) const
+                              const SFVEC3F &cnorm ) const
 {
     const float shadowGain = 0.5f;
     const float aoGain = 1.0f;
@@ -59,9 +57,8 @@ float CPOSTSHADER_SSAO::aoFF( const SFVEC2I &aShaderPos,
     // This limits the zero of the function (see below)
     if( rd < 1.0f )
     {
-        const SFVEC2I vr = aShaderPos + SFVEC2I( c1, c2 );
-
-        const float shadow_factor_at_sample = ( 1.0f - GetShadowFactorAt( vr ) ) * shadowGain;
+        const float shadow_factor_at_sample = ( 1.0f - m_shadow_att_factor[aSampleIdx] ) *
+                                              shadowGain;
 
         if( rd > FLT_EPSILON )
         {
@@ -94,7 +91,7 @@ float CPOSTSHADER_SSAO::aoFF( const SFVEC2I &aShaderPos,
 
             // This is the normal factor using the normal at the sampled point (of the shader)
             // agaisnt the vector from the center to the position at sampled point
-            const float sampledNormalFactor = glm::dot( GetNormalAt( vr ), -vv );
+            const float sampledNormalFactor = glm::dot( m_normals[aSampleIdx], -vv );
 
             // http://www.fooplot.com/#W3sidHlwZSI6MCwiZXEiOiIobWF4KHgsMC4zKS0wLjMpLygxLTAuMykiLCJjb2xvciI6IiMwMDAwMDAifSx7InR5cGUiOjEwMDAsIndpbmRvdyI6WyItMC42ODY3NDc3NDcxMDg0MTQyIiwiMy44ODcyMjA2MjQ0Mzk3MzM0IiwiLTAuOTA5NTYyNzcyOTMyNDk2IiwiMS45MDUxODY5OTQxNzQwNTczIl19XQ--
 
@@ -132,11 +129,9 @@ float CPOSTSHADER_SSAO::aoFF( const SFVEC2I &aShaderPos,
 }
 
 
-float CPOSTSHADER_SSAO::giFF( const SFVEC2I &aShaderPos,
+float CPOSTSHADER_SSAO::giFF( unsigned int aSampleIdx,
                               const SFVEC3F &ddiff,
-                              const SFVEC3F &cnorm,
-                              int c1,
-                              int c2 ) const
+                              const SFVEC3F &cnorm ) const
 {
     if( (ddiff.x > FLT_EPSILON) ||
         (ddiff.y > FLT_EPSILON) ||
@@ -144,9 +139,8 @@ float CPOSTSHADER_SSAO::giFF( const SFVEC2I &aShaderPos,
     {
         const SFVEC3F vv = glm::normalize( ddiff );
         const float rd = glm::length( ddiff );
-        const SFVEC2I vr = aShaderPos + SFVEC2I( c1, c2 );
 
-        return glm::clamp( glm::dot( GetNormalAt( vr ), -vv), 0.0f, 1.0f ) *
+        return glm::clamp( glm::dot( m_normals[aSampleIdx], -vv), 0.0f, 1.0f ) *
                glm::clamp( glm::dot( cnorm, vv ), 0.0f, 1.0f ) / ( rd * rd + 1.0f );
     }
 
@@ -165,7 +159,8 @@ SFVEC3F CPOSTSHADER_SSAO::Shade( const SFVEC2I &aShaderPos ) const
     //                (1.0f / GetDepthAt( aShaderPos )) * 0.5f );
 
 #if 1
-    float cdepth = GetDepthAt( aShaderPos );
+    const unsigned int centerIdx = getIndex( aShaderPos );
+    float cdepth = m_depth[centerIdx];
 
     if( cdepth > FLT_EPSILON )
     {
@@ -177,8 +172,8 @@ SFVEC3F CPOSTSHADER_SSAO::Shade( const SFVEC2I &aShaderPos ) const
         cdepth = (10.0f / (cdepth + 1.0f) );
 
         // read current normal,position and color.
-        const SFVEC3F n = GetNormalAt( aShaderPos );
-        const SFVEC3F p = GetPositionAt( aShaderPos );
+        const SFVEC3F n = m_normals[centerIdx];
+        const SFVEC3F p = m_wc_hitposition[centerIdx];
         //const SFVEC3F col = GetColorAt( aShaderPos );
 
         // initialize variables:
@@ -190,6 +185,15 @@ SFVEC3F CPOSTSHADER_SSAO::Shade( const SFVEC2I &aShaderPos ) const
         const int incx = 2;
         const int incy = 2;
 
+        // Farthest sample offset of the 3 rounds (pw and ph are at most 3).
+        // Pixels farther than that from the borders are sampled without clamping.
+        const int reach = (int)( ( 3 + glm::max( incx, incy ) * 2 ) * cdepth ) + 3;
+
+        const bool inside = ( aShaderPos.x >= reach ) &&
+                            ( aShaderPos.y >= reach ) &&
+                            ( aShaderPos.x + reach < (int)m_size.x ) &&
+                            ( aShaderPos.y + reach < (int)m_size.y );
+
         //3 rounds of 8 samples each.
         for( unsigned int i = 0; i < 3; ++i )
         {
@@ -200,40 +204,31 @@ SFVEC3F CPOSTSHADER_SSAO::Shade( const SFVEC2I &aShaderPos ) const
             const int npw = (int)((pw + incx * i) * cdepth ) + (i + 1);
             const int nph = (int)((ph + incy * i) * cdepth ) + (i + 1);
 
-            const SFVEC3F ddiff  = GetPositionAt( aShaderPos + SFVEC2I( npw, nph ) ) - p;
-            const SFVEC3F ddiff2 = GetPositionAt( aShaderPos + SFVEC2I( npw,-nph ) ) - p;
-            const SFVEC3F ddiff3 = GetPositionAt( aShaderPos + SFVEC2I(-npw, nph ) ) - p;
-            const SFVEC3F ddiff4 = GetPositionAt( aShaderPos + SFVEC2I(-npw,-nph ) ) - p;
-            const SFVEC3F ddiff5 = GetPositionAt( aShaderPos + SFVEC2I(  pw, nph ) ) - p;
-            const SFVEC3F ddiff6 = GetPositionAt( aShaderPos + SFVEC2I(  pw,-nph ) ) - p;
-            const SFVEC3F ddiff7 = GetPositionAt( aShaderPos + SFVEC2I( npw,  ph ) ) - p;
-            const SFVEC3F ddiff8 = GetPositionAt( aShaderPos + SFVEC2I(-npw,  ph ) ) - p;
-
-            ao+=  aoFF( aShaderPos, ddiff , n,  npw, nph );
-            ao+=  aoFF( aShaderPos, ddiff2, n,  npw,-nph );
-            ao+=  aoFF( aShaderPos, ddiff3, n, -npw, nph );
-            ao+=  aoFF( aShaderPos, ddiff4, n, -npw,-nph );
-            ao+=  aoFF( aShaderPos, ddiff5, n,   pw, nph );
-            ao+=  aoFF( aShaderPos, ddiff6, n,   pw,-nph );
-            ao+=  aoFF( aShaderPos, ddiff7, n,  npw,  ph );
-            ao+=  aoFF( aShaderPos, ddiff8, n, -npw,  ph );
-
-            gi+=  giFF( aShaderPos, ddiff , n, npw,  nph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I(  npw, nph ) ) );
-            gi+=  giFF( aShaderPos, ddiff2, n, npw, -nph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I(  npw,-nph ) ) );
-            gi+=  giFF( aShaderPos, ddiff3, n,-npw,  nph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I( -npw, nph ) ) );
-            gi+=  giFF( aShaderPos, ddiff4, n,-npw, -nph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I( -npw,-nph ) ) );
-            gi+=  giFF( aShaderPos, ddiff5, n, pw, nph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I(   pw, nph ) ) );
-            gi+=  giFF( aShaderPos, ddiff6, n, pw,-nph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I(   pw,-nph ) ) );
-            gi+=  giFF( aShaderPos, ddiff7, n, npw, ph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I(  npw,  ph ) ) );
-            gi+=  giFF( aShaderPos, ddiff8, n,-npw, ph) *
-                    giColorCurve( GetColorAt( aShaderPos + SFVEC2I( -npw,  ph ) ) );
+            const SFVEC2I offsets[8] =
+            {
+                SFVEC2I( npw, nph ),
+                SFVEC2I( npw,-nph ),
+                SFVEC2I(-npw, nph ),
+                SFVEC2I(-npw,-nph ),
+                SFVEC2I(  pw, nph ),
+                SFVEC2I(  pw,-nph ),
+                SFVEC2I( npw,  ph ),
+                SFVEC2I(-npw,  ph )
+            };
+
+            // Each sample is fetched once from all the buffers, the index is only
+            // clamped near the borders
+            for( unsigned int j = 0; j < 8; ++j )
+            {
+                const unsigned int idx = inside ?
+                                         centerIdx + offsets[j].x + offsets[j].y * (int)m_size.x :
+                                         getIndex( aShaderPos + offsets[j] );
+
+                const SFVEC3F ddiff = m_wc_hitposition[idx] - p;
+
+                ao += aoFF( idx, ddiff, n );
+                gi += giFF( idx, ddiff, n ) * giColorCurve( m_color[idx] );
+            }
         }
         ao = (ao / 24.0f) + 0.0f; // Apply a bias for the ambient oclusion
         gi = (gi * 5.0f / 24.0f); // Apply a bias for the global illumination
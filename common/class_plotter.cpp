@@ -47,6 +47,7 @@
 #include <macros.h>
 #include <class_base_screen.h>
 #include <drawtxt.h>
+#include <basic_gal.h>
 
 PLOTTER::PLOTTER( )
 {
@@ -76,6 +77,18 @@ PLOTTER::~PLOTTER()
 }
 
 
+BASIC_GAL& PLOTTER::GetTextGal()
+{
+    if( !m_textGal )
+    {
+        m_textGalOptions.reset( new KIGFX::GAL_DISPLAY_OPTIONS );
+        m_textGal.reset( new BASIC_GAL( *m_textGalOptions ) );
+    }
+
+    return *m_textGal;
+}
+
+
 bool PLOTTER::OpenFile( const wxString& aFullFilename )
 {
     filename = aFullFilename;
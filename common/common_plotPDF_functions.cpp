@@ -431,6 +431,21 @@ void PDF_PLOTTER::closePdfObject()
  * content.
  */
 int PDF_PLOTTER::startPdfStream(int handle)
+{
+    handle = beginStreamObject( handle );
+
+    // Open a temporary file to accumulate the stream
+    workFilename = filename + wxT(".tmp");
+    workFile = wxFopen( workFilename, wxT( "w+b" ));
+    wxASSERT( workFile );
+    return handle;
+}
+
+
+/**
+ * Opens the object of a compressed stream, its length is a deferred object
+ */
+int PDF_PLOTTER::beginStreamObject( int handle )
 {
     wxASSERT( outputFile );
     wxASSERT( !workFile );
@@ -443,10 +458,6 @@ int PDF_PLOTTER::startPdfStream(int handle)
              "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
              "stream\n", handle + 1 );
 
-    // Open a temporary file to accumulate the stream
-    workFilename = filename + wxT(".tmp");
-    workFile = wxFopen( workFilename, wxT( "w+b" ));
-    wxASSERT( workFile );
     return handle;
 }
 
@@ -458,12 +469,24 @@ void PDF_PLOTTER::closePdfStream()
 {
     wxASSERT( workFile );
 
+    endStreamObject( compressWorkFile() );
+}
+
+
+/**
+ * Reads back the stream accumulated in the work file, junks the file and
+ * returns the stream DEFLATEd
+ */
+std::string PDF_PLOTTER::compressWorkFile()
+{
+    wxASSERT( workFile );
+
     long stream_len = ftell( workFile );
 
     if( stream_len < 0 )
     {
         wxASSERT( false );
-        return;
+        return std::string();
     }
 
     // Rewind the file, read in the page stream and DEFLATE it
@@ -477,7 +500,9 @@ void PDF_PLOTTER::closePdfStream()
     // We are done with the temporary file, junk it
     fclose( workFile );
     workFile = 0;
-    ::wxRemoveFile( workFilename );
+
+    if( !workFilename.IsEmpty() )
+        ::wxRemoveFile( workFilename );
 
     // NULL means memos owns the memory, but provide a hint on optimum size needed.
     wxMemoryOutputStream    memos( NULL, std::max( 2000l, stream_len ) ) ;
@@ -500,16 +525,24 @@ void PDF_PLOTTER::closePdfStream()
 
     wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
 
-    unsigned out_count = sb->Tell();
+    return std::string( (const char*) sb->GetBufferStart(), sb->Tell() );
+}
 
-    fwrite( sb->GetBufferStart(), 1, out_count, outputFile );
+
+/**
+ * Writes the compressed data of the stream opened by beginStreamObject
+ * and closes it
+ */
+void PDF_PLOTTER::endStreamObject( const std::string& aData )
+{
+    fwrite( aData.data(), 1, aData.size(), outputFile );
 
     fputs( "endstream\n", outputFile );
     closePdfObject();
 
     // Writing the deferred length as an indirect object
     startPdfObject( streamLengthHandle );
-    fprintf( outputFile, "%u\n", out_count );
+    fprintf( outputFile, "%u\n", (unsigned) aData.size() );
     closePdfObject();
 }
 
@@ -521,16 +554,24 @@ void PDF_PLOTTER::StartPage()
     wxASSERT( outputFile );
     wxASSERT( !workFile );
 
-    // Compute the paper size in IUs
-    paperSize = pageInfo.GetSizeMils();
-    paperSize.x *= 10.0 / iuPerDeviceUnit;
-    paperSize.y *= 10.0 / iuPerDeviceUnit;
-
     // Open the content stream; the page object will go later
     pageStreamHandle = startPdfStream();
 
     /* Now, until ClosePage *everything* must be wrote in workFile, to be
        compressed later in closePdfStream */
+    startPageContent();
+}
+
+/**
+ * Computes the paper size and emits the default graphic settings of the
+ * page in the work file
+ */
+void PDF_PLOTTER::startPageContent()
+{
+    // Compute the paper size in IUs
+    paperSize = pageInfo.GetSizeMils();
+    paperSize.x *= 10.0 / iuPerDeviceUnit;
+    paperSize.y *= 10.0 / iuPerDeviceUnit;
 
     // Default graphic settings (coordinate system, default color and line style)
     fprintf( workFile,
@@ -549,7 +590,15 @@ void PDF_PLOTTER::ClosePage()
     // Close the page stream (and compress it)
     closePdfStream();
 
-    // Emit the page object and put it in the page list for later
+    emitPageObject();
+}
+
+/**
+ * Emit the page object of the page stream just closed and put it in the
+ * page list for later
+ */
+void PDF_PLOTTER::emitPageObject()
+{
     pageHandles.push_back( startPdfObject() );
 
     /* Page size is in 1/72 of inch (default user space units)
@@ -582,12 +631,54 @@ void PDF_PLOTTER::ClosePage()
     pageStreamHandle = 0;
 }
 
+
+void PDF_PLOTTER::StartPageStream()
+{
+    wxASSERT( !workFile );
+
+    // No output file: the stream goes in an anonymous temporary file
+    workFilename.Clear();
+    workFile = tmpfile();
+    wxASSERT( workFile );
+
+    startPageContent();
+}
+
+
+std::string PDF_PLOTTER::ClosePageStream()
+{
+    return compressWorkFile();
+}
+
+
+void PDF_PLOTTER::AddPage( const std::string& aPageStream )
+{
+    wxASSERT( outputFile );
+    wxASSERT( !workFile );
+
+    pageStreamHandle = beginStreamObject( -1 );
+    endStreamObject( aPageStream );
+    emitPageObject();
+}
+
 /**
  * The PDF engine supports multiple pages; the first one is opened
  * 'for free' the following are to be closed and reopened. Between
  * each page parameters can be set
  */
 bool PDF_PLOTTER::StartPlot()
+{
+    StartDocument();
+
+    /* Now, the PDF is read from the end, (more or less)... so we start
+       with the page stream for page 1. Other more important stuff is written
+       at the end */
+    StartPage();
+    return true;
+}
+
+
+bool PDF_PLOTTER::StartDocument()
 {
     wxASSERT( outputFile );
 
@@ -608,10 +699,6 @@ bool PDF_PLOTTER::StartPlot()
        (it *could* be inherited via the Pages tree */
     fontResDictHandle = allocPdfObject();
 
-    /* Now, the PDF is read from the end, (more or less)... so we start
-       with the page stream for page 1. Other more important stuff is written
-       at the end */
-    StartPage();
     return true;
 }
 
@@ -620,8 +707,10 @@ bool PDF_PLOTTER::EndPlot()
 {
     wxASSERT( outputFile );
 
-    // Close the current page (often the only one)
-    ClosePage();
+    // Close the current page (often the only one), unless the pages were
+    // added with AddPage()
+    if( workFile )
+        ClosePage();
 
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
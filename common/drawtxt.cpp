@@ -145,8 +145,18 @@ void DrawGraphicText( EDA_RECT* aClipBox,
         fill_mode = false;
     }
 
-    basic_gal.SetIsFill( fill_mode );
-    basic_gal.SetLineWidth( aWidth );
+    // A plotter strokes the text with its own GAL, so sheets can be plotted in parallel.
+    // The shared one is set up and used by one thread at a time.
+    std::unique_lock<std::mutex> lock( basic_gal_mutex, std::defer_lock );
+    BASIC_GAL*                   gal = &basic_gal;
+
+    if( aPlotter )
+        gal = &aPlotter->GetTextGal();
+    else
+        lock.lock();
+
+    gal->SetIsFill( fill_mode );
+    gal->SetLineWidth( aWidth );
 
     EDA_TEXT dummy;
     dummy.SetItalic( aItalic );
@@ -162,14 +172,14 @@ void DrawGraphicText( EDA_RECT* aClipBox,
 
     dummy.SetTextSize( size );
 
-    basic_gal.SetTextAttributes( &dummy );
-    basic_gal.SetPlotter( aPlotter );
-    basic_gal.SetCallback( aCallback );
-    basic_gal.m_DC = aDC;
-    basic_gal.m_Color = aColor;
-    basic_gal.SetClipBox( aClipBox );
+    gal->SetTextAttributes( &dummy );
+    gal->SetPlotter( aPlotter );
+    gal->SetCallback( aCallback );
+    gal->m_DC = aDC;
+    gal->m_Color = aColor;
+    gal->SetClipBox( aClipBox );
 
-    basic_gal.StrokeText( aText, VECTOR2D( aPos ), aOrient * M_PI/1800 );
+    gal->StrokeText( aText, VECTOR2D( aPos ), aOrient * M_PI/1800 );
 }
 
 
@@ -28,6 +28,11 @@
 #include <cstdio>
 #include <cstdlib>         // bsearch()
 #include <cctype>
+#include <climits>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include <macros.h>
 #include <fctsys.h>
@@ -39,6 +44,132 @@
 #define FMT_CLIPBOARD       _( "clipboard" )
 
 
+//-----<KEYWORD_PERFECT_HASH>-------------------------------------------------
+
+KEYWORD_PERFECT_HASH::KEYWORD_PERFECT_HASH( const KEYWORD* aKeywords, unsigned aCount )
+{
+    if( aCount == 0 )
+        return;
+
+    // Keywords are spread over aCount buckets by their hash.  Each bucket then gets a
+    // displacement sending all its members to free slots, the biggest buckets first while
+    // most slots are still free.  Single member buckets simply take the remaining free slots.
+    const size_t size = aCount;
+
+    std::vector<uint64_t>               hashes( size );
+    std::vector< std::vector<unsigned> > buckets( size );
+
+    for( unsigned i = 0; i < aCount; ++i )
+    {
+        hashes[i] = hashText( aKeywords[i].name, strlen( aKeywords[i].name ) );
+
+        std::vector<unsigned>& bucket = buckets[ hashes[i] % size ];
+        bool duplicate = false;
+
+        for( unsigned other : bucket )
+        {
+            if( hashes[other] == hashes[i] )
+            {
+                // only a duplicated keyword may collide on 64 bits, keep its first entry
+                wxASSERT( !strcmp( aKeywords[other].name, aKeywords[i].name ) );
+                duplicate = true;
+            }
+        }
+
+        if( !duplicate )
+            bucket.push_back( i );
+    }
+
+    std::vector<unsigned> order( size );
+
+    for( unsigned i = 0; i < size; ++i )
+        order[i] = i;
+
+    std::stable_sort( order.begin(), order.end(), [&buckets]( unsigned a, unsigned b ) {
+        return buckets[a].size() > buckets[b].size();
+    } );
+
+    m_seeds.assign( size, 0 );
+    m_slots.assign( size, nullptr );
+    m_lengths.assign( size, 0 );
+
+    std::vector<unsigned> slots;
+    unsigned              freeSlot = 0;
+
+    for( unsigned b : order )
+    {
+        const std::vector<unsigned>& bucket = buckets[b];
+
+        if( bucket.empty() )
+            break;
+
+        if( bucket.size() == 1 )
+        {
+            while( m_slots[freeSlot] )
+                ++freeSlot;
+
+            m_seeds[b] = -(int32_t) freeSlot - 1;
+            m_slots[freeSlot] = &aKeywords[ bucket[0] ];
+            continue;
+        }
+
+        for( int32_t seed = 0; ; ++seed )
+        {
+            slots.clear();
+
+            for( unsigned k : bucket )
+            {
+                unsigned slot = displace( hashes[k], seed ) % size;
+
+                if( m_slots[slot] || std::find( slots.begin(), slots.end(), slot ) != slots.end() )
+                    break;
+
+                slots.push_back( slot );
+            }
+
+            if( slots.size() == bucket.size() )
+            {
+                m_seeds[b] = seed;
+
+                for( unsigned i = 0; i < slots.size(); ++i )
+                    m_slots[ slots[i] ] = &aKeywords[ bucket[i] ];
+
+                break;
+            }
+        }
+    }
+
+    // Slots left over by duplicated keywords point to any keyword: Find() compares the text.
+    for( unsigned i = 0; i < size; ++i )
+    {
+        if( !m_slots[i] )
+            m_slots[i] = &aKeywords[0];
+
+        m_lengths[i] = strlen( m_slots[i]->name );
+    }
+}
+
+
+const KEYWORD_PERFECT_HASH* KEYWORD_PERFECT_HASH::Get( const KEYWORD* aKeywords, unsigned aCount )
+{
+    typedef std::map< const KEYWORD*, std::unique_ptr<KEYWORD_PERFECT_HASH> > TABLES;
+
+    static std::mutex mutex;
+    static TABLES     tables;
+
+    std::lock_guard<std::mutex> lock( mutex );
+
+    std::unique_ptr<KEYWORD_PERFECT_HASH>& table = tables[aKeywords];
+
+    if( !table )
+        table.reset( new KEYWORD_PERFECT_HASH( aKeywords, aCount ) );
+
+    return table.get();
+}
+
+
+
+
 //-----<DSNLEXER>-------------------------------------------------------------
 
 void DSNLEXER::init()
@@ -54,22 +185,10 @@ void DSNLEXER::init()
 
     curOffset = 0;
 
-#if 1
-    if( keywordCount > 11 )
-    {
-        // resize the hashtable bucket count
-        keyword_hash.reserve( keywordCount );
-    }
-
-    // fill the specialized "C string" hashtable from keywords[]
-    const KEYWORD*  it  = keywords;
-    const KEYWORD*  end = it + keywordCount;
+    curNumberValid = false;
+    curIntegerValid = false;
 
-    for( ; it < end; ++it )
-    {
-        keyword_hash[it->name] = it->token;
-    }
-#endif
+    keywordHash = KEYWORD_PERFECT_HASH::Get( keywords, keywordCount );
 }
 
 
@@ -230,44 +349,6 @@ LINE_READER* DSNLEXER::PopReader()
 }
 
 
-#if 0
-static int compare( const void* a1, const void* a2 )
-{
-    const KEYWORD* k1 = (const KEYWORD*) a1;
-    const KEYWORD* k2 = (const KEYWORD*) a2;
-
-    int ret = strcmp( k1->name, k2->name );
-    return ret;
-}
-
-int DSNLEXER::findToken( const std::string& tok )
-{
-    KEYWORD search;
-
-    search.name = tok.c_str();
-
-    const KEYWORD* findings = (const KEYWORD*) bsearch( &search,
-                                   keywords, keywordCount,
-                                   sizeof(KEYWORD), compare );
-    if( findings )
-        return findings->token;
-    else
-        return DSN_SYMBOL;      // not a keyword, some arbitrary symbol.
-}
-
-#else
-
-inline int DSNLEXER::findToken( const std::string& tok )
-{
-    KEYWORD_MAP::const_iterator it = keyword_hash.find( tok.c_str() );
-    if( it != keyword_hash.end() )
-        return it->second;
-
-    return DSN_SYMBOL;      // not a keyword, some arbitrary symbol.
-}
-#endif
-
-
 const char* DSNLEXER::Syntax( int aTok )
 {
     const char* ret;
@@ -537,6 +618,119 @@ static bool isNumber( const char* cp, const char* limit )
 }
 
 
+/// The powers of ten which are exactly represented by a double.
+static const double exactPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/**
+ * Function convertNumber
+ * converts a token accepted by isNumber() straight from the input line, without the
+ * locale dependent strtod().  Only exact conversions are made: with at most 19 significant
+ * digits, a mantissa below 2^53 and a power of ten below 1e23, a single multiplication or
+ * division of two exact doubles is correctly rounded, i.e. gives the result of strtod().
+ *
+ * @param cp is the start of the token.
+ * @param limit is the end of the token.
+ * @param aValue receives the value, if true is returned.
+ * @param aInteger receives the value of an integer which fits a long.
+ * @param aIsInteger is set true if @a aInteger was set.
+ * @return bool - false if the token needs a full strtod() conversion.
+ */
+static bool convertNumber( const char* cp, const char* limit, double& aValue,
+                           long& aInteger, bool& aIsInteger )
+{
+    const uint64_t maxExactMantissa = 1ULL << 53;
+
+    bool        negative = false;
+    bool        integral = true;
+    uint64_t    mantissa = 0;
+    int         digits = 0;         // significant digits in mantissa
+    int         exponent = 0;
+
+    aIsInteger = false;
+
+    if( *cp == '-' || *cp == '+' )
+        negative = *cp++ == '-';
+
+    for( ; cp < limit && isDigit( *cp ); ++cp )
+    {
+        if( mantissa || *cp != '0' )
+        {
+            if( ++digits > 19 )
+                return false;
+
+            mantissa = mantissa * 10 + ( *cp - '0' );
+        }
+    }
+
+    if( cp < limit && *cp == '.' )
+    {
+        integral = false;
+
+        for( ++cp; cp < limit && isDigit( *cp ); ++cp )
+        {
+            if( mantissa || *cp != '0' )
+            {
+                if( ++digits > 19 )
+                    return false;
+
+                mantissa = mantissa * 10 + ( *cp - '0' );
+            }
+
+            --exponent;
+        }
+    }
+
+    if( cp < limit )    // [eE][-+]?[0-9]+, checked by isNumber()
+    {
+        integral = false;
+
+        bool negativeExp = false;
+        int  exp = 0;
+
+        if( *++cp == '-' || *cp == '+' )
+            negativeExp = *cp++ == '-';
+
+        for( ; cp < limit; ++cp )
+        {
+            if( exp > 10000 )
+                return false;
+
+            exp = exp * 10 + ( *cp - '0' );
+        }
+
+        exponent += negativeExp ? -exp : exp;
+    }
+
+    if( integral && mantissa <= (uint64_t) LONG_MAX )
+    {
+        aInteger = negative ? -(long) mantissa : (long) mantissa;
+        aIsInteger = true;
+    }
+
+    if( mantissa > maxExactMantissa )
+        return false;
+
+    if( mantissa == 0 )
+        aValue = 0.0;
+    else if( exponent < -22 || exponent > 22 )
+        return false;
+    else if( exponent < 0 )
+        aValue = (double) mantissa / exactPowersOf10[-exponent];
+    else
+        aValue = (double) mantissa * exactPowersOf10[exponent];
+
+    if( negative )
+        aValue = -aValue;
+
+    return true;
+}
+
+
 int DSNLEXER::NextTok()
 {
     const char*   cur  = next;
@@ -544,6 +738,9 @@ int DSNLEXER::NextTok()
 
     prevTok = curTok;
 
+    curNumberValid  = false;
+    curIntegerValid = false;
+
     if( curTok == DSN_EOF )
         goto exit;
 
@@ -776,16 +973,18 @@ L_read:
         }
     }           // specctraMode
 
-    // non-quoted token, read it into curText.
-    curText.clear();
-
+    // non-quoted token, classified and converted in place in the line, then copied
+    // into curText in one go.
     head = cur;
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    if( isNumber( cur, head ) )
     {
         curTok = DSN_NUMBER;
+        curNumberValid = convertNumber( cur, head, curNumber, curInteger, curIntegerValid );
         goto exit;
     }
 
@@ -795,7 +994,7 @@ L_read:
         goto exit;
     }
 
-    curTok = findToken( curText );
+    curTok = findToken( cur, head - cur );
 
 exit:   // single point of exit, no returns elsewhere please.
 
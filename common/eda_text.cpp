@@ -79,6 +79,8 @@ void EDA_TEXT::SwapEffects( EDA_TEXT& aTradingPartner )
 
 int EDA_TEXT::LenSize( const wxString& aLine ) const
 {
+    std::lock_guard<std::mutex> lock( basic_gal_mutex );
+
     basic_gal.SetFontItalic( IsItalic() );
     basic_gal.SetFontBold( IsBold() );
     basic_gal.SetGlyphSize( VECTOR2D( GetTextSize() ) );
@@ -147,6 +149,10 @@ EDA_RECT EDA_TEXT::GetTextBox( int aLine, int aThickness, bool aInvertY ) const
         }
     }
 
+    // The font is shared with other threads, and the italic tilt is read from basic_gal
+    std::lock_guard<std::mutex> lock( basic_gal_mutex );
+    basic_gal.SetFontItalic( IsItalic() );
+
     // calculate the H and V size
     int dx = KiROUND( basic_gal.GetStrokeFont().ComputeStringBoundaryLimits(
                             text, VECTOR2D( GetTextSize() ), double( thickness ) ).x );
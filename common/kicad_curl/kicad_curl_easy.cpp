@@ -24,6 +24,7 @@
 
 #include <kicad_curl/kicad_curl_easy.h>
 
+#include <cctype>
 #include <cstddef>
 #include <exception>
 #include <stdarg.h>
@@ -61,6 +62,10 @@ KICAD_CURL_EASY::KICAD_CURL_EASY() :
 
     curl_easy_setopt( m_CURL, CURLOPT_WRITEFUNCTION, write_callback );
     curl_easy_setopt( m_CURL, CURLOPT_WRITEDATA, (void*) &m_buffer );
+
+    // Same callback, the headers are kept as received and parsed on demand
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERFUNCTION, write_callback );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERDATA, (void*) &m_responseHeaders );
 }
 
 
@@ -82,6 +87,7 @@ void KICAD_CURL_EASY::Perform()
 
     // bonus: retain worst case memory allocation, should re-use occur
     m_buffer.clear();
+    m_responseHeaders.clear();
 
     CURLcode res = curl_easy_perform( m_CURL );
 
@@ -92,3 +98,53 @@ void KICAD_CURL_EASY::Perform()
         THROW_IO_ERROR( msg );
     }
 }
+
+
+std::string KICAD_CURL_EASY::GetResponseHeader( const std::string& aName ) const
+{
+    std::string value;
+    size_t      start = 0;
+
+    // Redirections append the headers of each response, only the last response counts
+    while( start < m_responseHeaders.size() )
+    {
+        size_t end = m_responseHeaders.find( '\n', start );
+
+        if( end == std::string::npos )
+            end = m_responseHeaders.size();
+
+        if( m_responseHeaders.compare( start, 5, "HTTP/" ) == 0 )
+            value.clear();
+
+        size_t colon = start + aName.size();
+
+        if( colon < end && m_responseHeaders[colon] == ':' )
+        {
+            bool match = true;
+
+            for( size_t i = 0; i < aName.size() && match; ++i )
+            {
+                match = tolower( (unsigned char) m_responseHeaders[start + i] )
+                        == tolower( (unsigned char) aName[i] );
+            }
+
+            if( match )
+            {
+                size_t first = colon + 1;
+                size_t last = end;
+
+                while( first < last && isspace( (unsigned char) m_responseHeaders[first] ) )
+                    ++first;
+
+                while( last > first && isspace( (unsigned char) m_responseHeaders[last - 1] ) )
+                    --last;
+
+                value = m_responseHeaders.substr( first, last - first );
+            }
+        }
+
+        start = end + 1;
+    }
+
+    return value;
+}
@@ -730,7 +730,10 @@ int PAGE_LAYOUT_READER_PARSER::parseInt( int aMin, int aMax )
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    int val = atoi( CurText() );
+    long val;
+
+    if( !CurInteger( val ) )
+        val = atoi( CurText() );
 
     if( val < aMin )
         val = aMin;
@@ -748,7 +751,10 @@ double PAGE_LAYOUT_READER_PARSER::parseDouble()
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    double val = strtod( CurText(), NULL );
+    double val;
+
+    if( !CurNumber( val ) )
+        val = strtod( CurText(), NULL );
 
     return val;
 }
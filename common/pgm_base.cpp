@@ -53,6 +53,7 @@
 #include <dialog_env_var_config.h>
 #include <lockfile.h>
 #include <systemdirsappend.h>
+#include <task_scheduler.h>
 
 
 #define KICAD_COMMON                     wxT( "kicad_common" )
@@ -288,6 +289,7 @@ PGM_BASE::PGM_BASE()
     m_pgm_checker = NULL;
     m_locale = NULL;
     m_common_settings = NULL;
+    m_task_scheduler = NULL;
 
     m_show_env_var_dialog = true;
 
@@ -307,6 +309,13 @@ void PGM_BASE::Destroy()
 {
     // unlike a normal destructor, this is designed to be called more than once safely:
 
+    // Joins the workers, so do it first: running jobs may still use the other members.
+    {
+        std::lock_guard<std::mutex> lock( m_task_scheduler_mutex );
+        delete m_task_scheduler;
+        m_task_scheduler = 0;
+    }
+
     delete m_common_settings;
     m_common_settings = 0;
 
@@ -325,6 +334,17 @@ wxApp& PGM_BASE::App()
 }
 
 
+TASK_SCHEDULER& PGM_BASE::GetTaskScheduler()
+{
+    std::lock_guard<std::mutex> lock( m_task_scheduler_mutex );
+
+    if( !m_task_scheduler )
+        m_task_scheduler = new TASK_SCHEDULER();
+
+    return *m_task_scheduler;
+}
+
+
 void PGM_BASE::SetEditorName( const wxString& aFileName )
 {
     m_editor_name = aFileName;
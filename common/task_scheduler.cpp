@@ -0,0 +1,384 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <task_scheduler.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <pgm_base.h>
+
+
+TASK_SCHEDULER::TASK_SCHEDULER( unsigned aWorkerCount ) :
+    m_pending( 0 ),
+    m_quit( false )
+{
+    if( aWorkerCount == 0 )
+        aWorkerCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+    // All the deques must exist before the first worker starts stealing
+    for( unsigned i = 0; i < aWorkerCount; ++i )
+        m_workers.push_back( std::unique_ptr<WORKER>( new WORKER ) );
+
+    for( unsigned i = 0; i < aWorkerCount; ++i )
+    {
+        m_workers[i]->m_thread = std::thread( &TASK_SCHEDULER::workerLoop, this, i );
+        m_workerIds.push_back( m_workers[i]->m_thread.get_id() );
+    }
+}
+
+
+TASK_SCHEDULER::~TASK_SCHEDULER()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_sleepMutex );
+        m_quit.store( true );
+    }
+
+    m_wakeUp.notify_all();
+
+    for( auto& worker : m_workers )
+        worker->m_thread.join();
+}
+
+
+int TASK_SCHEDULER::CurrentWorker() const
+{
+    // The worker identity is looked up rather than stored in a thread_local variable: each
+    // KIFACE links its own copy of this code, and a thread_local would not be shared.
+    const std::thread::id self = std::this_thread::get_id();
+
+    for( unsigned i = 0; i < m_workerIds.size(); ++i )
+    {
+        if( m_workerIds[i] == self )
+            return i;
+    }
+
+    return -1;
+}
+
+
+void TASK_SCHEDULER::Submit( TASK aTask )
+{
+    {
+        // Counted first so a sleeping worker woken up early just retries
+        std::lock_guard<std::mutex> lock( m_sleepMutex );
+        m_pending.fetch_add( 1 );
+    }
+
+    int self = CurrentWorker();
+
+    if( self >= 0 )
+    {
+        std::lock_guard<std::mutex> lock( m_workers[self]->m_mutex );
+        m_workers[self]->m_tasks.push_back( std::move( aTask ) );
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock( m_injectedMutex );
+        m_injected.push_back( std::move( aTask ) );
+    }
+
+    m_wakeUp.notify_one();
+}
+
+
+bool TASK_SCHEDULER::popTask( int aWorker, TASK& aTask )
+{
+    // Own tasks first, newest first: they are the most likely to be hot in the cache
+    if( aWorker >= 0 )
+    {
+        WORKER* worker = m_workers[aWorker].get();
+        std::lock_guard<std::mutex> lock( worker->m_mutex );
+
+        if( !worker->m_tasks.empty() )
+        {
+            aTask = std::move( worker->m_tasks.back() );
+            worker->m_tasks.pop_back();
+            m_pending.fetch_sub( 1 );
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m_injectedMutex );
+
+        if( !m_injected.empty() )
+        {
+            aTask = std::move( m_injected.front() );
+            m_injected.pop_front();
+            m_pending.fetch_sub( 1 );
+            return true;
+        }
+    }
+
+    // Steal the oldest task of another worker
+    const int count = m_workers.size();
+
+    for( int i = 1; i <= count; ++i )
+    {
+        const int victim = ( std::max( aWorker, 0 ) + i ) % count;
+
+        if( victim == aWorker )
+            continue;
+
+        WORKER* worker = m_workers[victim].get();
+        std::lock_guard<std::mutex> lock( worker->m_mutex );
+
+        if( !worker->m_tasks.empty() )
+        {
+            aTask = std::move( worker->m_tasks.front() );
+            worker->m_tasks.pop_front();
+            m_pending.fetch_sub( 1 );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void TASK_SCHEDULER::workerLoop( unsigned aWorker )
+{
+    TASK task;
+
+    while( true )
+    {
+        if( popTask( aWorker, task ) )
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( m_sleepMutex );
+
+        if( m_quit.load() && m_pending.load() <= 0 )
+            return;
+
+        m_wakeUp.wait( lock, [this]() {
+            return m_quit.load() || m_pending.load() > 0;
+        } );
+    }
+}
+
+
+TASK_SCHEDULER& DefaultTaskScheduler()
+{
+    return Pgm().GetTaskScheduler();
+}
+
+
+bool TASK_GROUP::QUEUE::Pop( std::function<void()>& aTask )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_tasks.empty() )
+        return false;
+
+    aTask = std::move( m_tasks.front() );
+    m_tasks.pop_front();
+    return true;
+}
+
+
+TASK_GROUP::TASK_GROUP( TASK_SCHEDULER& aScheduler ) :
+    m_scheduler( aScheduler ),
+    m_queue( std::make_shared<QUEUE>() ),
+    m_running( 0 ),
+    m_cancelled( false ),
+    m_done( 0 ),
+    m_total( 0 )
+{
+}
+
+
+TASK_GROUP::~TASK_GROUP()
+{
+    try
+    {
+        Wait();
+    }
+    catch( ... )
+    {
+    }
+}
+
+
+void TASK_GROUP::spawn( std::function<void()> aTask )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_running++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m_queue->m_mutex );
+
+        m_queue->m_tasks.push_back( [this, aTask]() {
+            if( !IsCancelled() )
+            {
+                try
+                {
+                    aTask();
+                }
+                catch( ... )
+                {
+                    setException( std::current_exception() );
+                }
+            }
+
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( --m_running == 0 )
+                m_finished.notify_all();
+        } );
+    }
+
+    // The scheduler runs one task of the queue, unless a waiting thread took it first.  The
+    // queue is shared: the group may be gone when the scheduler finds it empty.
+    std::shared_ptr<QUEUE> queue = m_queue;
+
+    m_scheduler.Submit( [queue]() {
+        std::function<void()> task;
+
+        if( queue->Pop( task ) )
+            task();
+    } );
+}
+
+
+void TASK_GROUP::setException( std::exception_ptr aException )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_exception )
+        m_exception = aException;
+
+    m_cancelled.store( true );
+}
+
+
+void TASK_GROUP::unitsDone( size_t aCount )
+{
+    size_t done = m_done.fetch_add( aCount ) + aCount;
+
+    if( m_progressCallback )
+        m_progressCallback( done, m_total.load() );
+}
+
+
+void TASK_GROUP::Run( std::function<void()> aTask )
+{
+    m_total.fetch_add( 1 );
+
+    spawn( [this, aTask]() {
+        aTask();
+        unitsDone( 1 );
+    } );
+}
+
+
+void TASK_GROUP::ParallelFor( int aBegin, int aEnd, const std::function<void( int )>& aFunc,
+                              int aGrain )
+{
+    if( aEnd <= aBegin )
+        return;
+
+    const int grain = std::max( aGrain, 1 );
+    const int chunks = ( aEnd - aBegin + grain - 1 ) / grain;
+    std::atomic<int> next( aBegin );
+
+    m_total.fetch_add( aEnd - aBegin );
+
+    // Runners pull chunks until the range is exhausted, so the load balances itself whatever
+    // the cost of each index.  Everything captured by reference outlives the Wait() below.
+    auto runner = [this, &next, &aFunc, grain, aEnd]() {
+        while( !IsCancelled() )
+        {
+            const int first = next.fetch_add( grain );
+
+            if( first >= aEnd )
+                break;
+
+            const int last = std::min( first + grain, aEnd );
+
+            for( int i = first; i < last; ++i )
+                aFunc( i );
+
+            unitsDone( last - first );
+        }
+    };
+
+    const int runners = std::min<int>( chunks, m_scheduler.WorkerCount() + 1 );
+
+    for( int i = 1; i < runners; ++i )
+        spawn( runner );
+
+    try
+    {
+        runner();
+    }
+    catch( ... )
+    {
+        setException( std::current_exception() );
+    }
+
+    Wait();
+}
+
+
+void TASK_GROUP::Wait()
+{
+    while( true )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( m_running == 0 )
+                break;
+        }
+
+        // Help with the pending tasks of this group rather than blocking a thread.  When they
+        // are all started, sleep until they finish or a short while passes, as the running
+        // tasks may queue new ones.
+        std::function<void()> task;
+
+        if( m_queue->Pop( task ) )
+        {
+            task();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_finished.wait_for( lock, std::chrono::milliseconds( 1 ),
+                                 [this]() { return m_running == 0; } );
+        }
+    }
+
+    std::exception_ptr exception;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        std::swap( exception, m_exception );
+    }
+
+    if( exception )
+        std::rethrow_exception( exception );
+}
@@ -852,10 +852,8 @@ void TOOL_MANAGER::processEvent( const TOOL_EVENT& aEvent )
     dispatchContextMenu( aEvent );
 
     // Dispatch queue
-    while( !m_eventQueue.empty() )
-    {
-        TOOL_EVENT event = m_eventQueue.front();
-        m_eventQueue.pop_front();
+    TOOL_EVENT event;
+
+    while( m_eventQueue.Pop( event ) )
         processEvent( event );
-    }
 }
@@ -35,6 +35,8 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <painter.h>
 
+#include <unordered_set>
+
 #ifdef __WXDEBUG__
 #include <profile.h>
 #endif /* __WXDEBUG__  */
@@ -51,6 +53,7 @@ public:
         m_flags( KIGFX::VISIBLE ),
         m_requiredUpdate( KIGFX::NONE ),
         m_drawPriority( 0 ),
+        m_geometryRevision( 0 ),
         m_groups( nullptr ),
         m_groupsSize( 0 ) {}
 
@@ -91,6 +94,7 @@ private:
     int     m_flags;            ///< Visibility flags
     int     m_requiredUpdate;   ///< Flag required for updating
     int     m_drawPriority;     ///< Order to draw this item in a layer, lowest first
+    unsigned int m_geometryRevision;    ///< Changed on every geometry update
 
     ///> Helper for storing cached items group ids
     typedef std::pair<int, int> GroupPair;
@@ -267,7 +271,8 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_gal( NULL ),
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
-    m_nextDrawPriority( 0 )
+    m_nextDrawPriority( 0 ),
+    m_geometryRevision( 0 )
 {
     m_boundary.SetMaximum();
     m_allItems.reserve( 32768 );
@@ -338,6 +343,15 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 }
 
 
+void VIEW::AddItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    m_allItems.reserve( m_allItems.size() + aItems.size() );
+
+    for( VIEW_ITEM* item : aItems )
+        Add( item );
+}
+
+
 void VIEW::Remove( VIEW_ITEM* aItem )
 {
     if( !aItem )
@@ -357,6 +371,44 @@ void VIEW::Remove( VIEW_ITEM* aItem )
         viewData->clearUpdateFlags();
     }
 
+    removeFromLayers( aItem );
+}
+
+
+void VIEW::RemoveItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    std::unordered_set<VIEW_ITEM*> removed;
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        if( item && item->viewPrivData() && item->viewPrivData()->m_view == this )
+            removed.insert( item );
+    }
+
+    if( removed.empty() )
+        return;
+
+    auto last = std::remove_if( m_allItems.begin(), m_allItems.end(),
+                                [&removed]( VIEW_ITEM* aItem )
+    {
+        if( removed.count( aItem ) == 0 )
+            return false;
+
+        aItem->viewPrivData()->clearUpdateFlags();
+        return true;
+    } );
+
+    m_allItems.erase( last, m_allItems.end() );
+
+    for( VIEW_ITEM* item : removed )
+        removeFromLayers( item );
+}
+
+
+void VIEW::removeFromLayers( VIEW_ITEM* aItem )
+{
+    auto viewData = aItem->viewPrivData();
+
     int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
     viewData->getLayers( layers, layers_count );
 
@@ -415,6 +467,13 @@ struct queryVisitor
 
 
 int VIEW::Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) const
+{
+    return Query( aRect, aResult, std::function<bool( int )>() );
+}
+
+
+int VIEW::Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult,
+                 const std::function<bool( int )>& aLayerFilter ) const
 {
     if( m_orderedLayers.empty() )
         return 0;
@@ -429,6 +488,9 @@ int VIEW::Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) con
         if( ( *i )->displayOnly )
             continue;
 
+        if( aLayerFilter && !aLayerFilter( ( *i )->id ) )
+            continue;
+
         queryVisitor<std::vector<LAYER_ITEM_PAIR> > visitor( aResult, ( *i )->id );
         ( *i )->items->Query( aRect, visitor );
     }
@@ -1376,6 +1438,14 @@ bool VIEW::IsVisible( const VIEW_ITEM* aItem ) const
 }
 
 
+unsigned int VIEW::GetGeometryRevision( const VIEW_ITEM* aItem ) const
+{
+    const auto viewData = aItem->viewPrivData();
+
+    return viewData ? viewData->m_geometryRevision : 0;
+}
+
+
 void VIEW::Update( VIEW_ITEM* aItem )
 {
     Update( aItem, ALL );
@@ -1393,6 +1463,9 @@ void VIEW::Update( VIEW_ITEM* aItem, int aUpdateFlags )
 
     viewData->m_requiredUpdate |= aUpdateFlags;
 
+    if( aUpdateFlags & GEOMETRY )
+        viewData->m_geometryRevision = ++m_geometryRevision;
+
 }
 
 const int VIEW::TOP_LAYER_MODIFIER = -VIEW_MAX_LAYERS;
@@ -41,7 +41,8 @@
 using namespace KIGFX;
 
 VIEW_GROUP::VIEW_GROUP( VIEW* aView ) :
-    m_layer( LAYER_GP_OVERLAY )
+    m_layer( LAYER_GP_OVERLAY ),
+    m_offset( 0, 0 )
 {
 }
 
@@ -105,6 +106,15 @@ void VIEW_GROUP::ViewDraw( int aLayer, VIEW* aView ) const
 
     const auto drawList = updateDrawList();
 
+    // The offset is applied by the GAL, so the items do not have to be moved and recached
+    const bool translated = ( m_offset.x != 0 || m_offset.y != 0 );
+
+    if( translated )
+    {
+        gal->Save();
+        gal->Translate( VECTOR2D( m_offset ) );
+    }
+
     // Draw all items immediately (without caching)
     for( auto item : drawList )
     {
@@ -127,6 +137,9 @@ void VIEW_GROUP::ViewDraw( int aLayer, VIEW* aView ) const
 
         gal->PopDepth();
     }
+
+    if( translated )
+        gal->Restore();
 }
 
 
@@ -331,6 +331,63 @@ void DIALOG_PLOT_SCHEMATIC::PlotSchematic( bool aPlotAll )
     }
 }
 
+
+SCH_SHEET_LIST DIALOG_PLOT_SCHEMATIC::getSheetList( bool aPlotAll )
+{
+    SCH_SHEET_LIST sheetList;
+
+    if( aPlotAll )
+        sheetList.BuildSheetList( g_RootSheet );
+    else
+        sheetList.push_back( m_parent->GetCurrentSheet() );
+
+    return sheetList;
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::plotSheetFiles( PlotFormat aFormat, bool aPlotAll,
+                                            const SCH_PLOT_OPTIONS& aOptions )
+{
+    SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
+    SCH_PLOT_JOB    job( getSheetList( aPlotAll ), aOptions );
+    REPORTER&       reporter = m_MessagesBox->Reporter();
+    wxString        ext = GetDefaultPlotExtension( aFormat );
+    std::vector<wxString> fileNames;
+
+    // File names are built (and their directory created) here, before the plot
+    try
+    {
+        for( const SCH_PLOT_PAGE& page : job.GetPages() )
+        {
+            wxString fname = page.m_FileName;
+            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName, fname,
+                                                          ext, &reporter );
+
+            fileNames.push_back( plotFileName.GetFullPath() );
+        }
+    }
+    catch( const IO_ERROR& e )
+    {
+        wxString msg;
+        msg.Printf( wxT( "Plotter exception: %s" ), GetChars( e.What() ) );
+        reporter.Report( msg, REPORTER::RPT_ERROR );
+        return;
+    }
+
+    job.PlotFiles( aFormat, fileNames, &reporter );
+
+    restoreCurrentSheet( oldsheetpath );
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::restoreCurrentSheet( const SCH_SHEET_PATH& aOldsheetpath )
+{
+    m_parent->SetCurrentSheet( aOldsheetpath );
+    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
+    m_parent->SetSheetNumberAndCount();
+}
+
+
 wxFileName DIALOG_PLOT_SCHEMATIC::createPlotFileName( wxTextCtrl* aOutputDirectoryName,
                                                       wxString& aPlotFileName,
                                                       wxString& aExtension,
@@ -34,13 +34,7 @@
 #include <schframe.h>
 #include <dialog_plot_schematic_base.h>
 #include <reporter.h>
-
-
-enum PageFormatReq {
-    PAGE_SIZE_AUTO,
-    PAGE_SIZE_A4,
-    PAGE_SIZE_A
-};
+#include <sch_plot_job.h>
 
 
 class DIALOG_PLOT_SCHEMATIC : public DIALOG_PLOT_SCHEMATIC_BASE
@@ -91,22 +85,28 @@ private:
 
     void PlotSchematic( bool aPlotAll );
 
-    // PDF
-    void    createPDFFile( bool aPlotAll, bool aPlotFrameRef );
-    void    plotOneSheetPDF( PLOTTER* aPlotter, SCH_SCREEN* aScreen, bool aPlotFrameRef);
-    void    setupPlotPagePDF( PLOTTER* aPlotter, SCH_SCREEN* aScreen );
+    /// @return the sheets to plot, all the hierarchy or the current sheet
+    SCH_SHEET_LIST getSheetList( bool aPlotAll );
+
+    /**
+     * Plots each sheet in its own file, the sheets being plotted on the worker threads.
+     * @param aFormat the plot format
+     * @param aPlotAll true to plot all the hierarchy, false for the current sheet only
+     * @param aOptions the plot options, read from the dialog by the caller
+     */
+    void    plotSheetFiles( PlotFormat aFormat, bool aPlotAll, const SCH_PLOT_OPTIONS& aOptions );
 
     /**
-    * Everything done, close the plot and restore the environment
-    * @param aPlotter the plotter to close and destroy
-    * @param aOldsheetpath the stored old sheet path for the current sheet before the plot started
-    */
-    void    restoreEnvironment( PDF_PLOTTER* aPlotter, SCH_SHEET_PATH& aOldsheetpath );
+     * Restore the current sheet and its references after a plot
+     * @param aOldsheetpath the stored old sheet path for the current sheet before the plot started
+     */
+    void    restoreCurrentSheet( const SCH_SHEET_PATH& aOldsheetpath );
+
+    // PDF
+    void    createPDFFile( bool aPlotAll, bool aPlotFrameRef );
 
     // DXF
     void    CreateDXFFile( bool aPlotAll, bool aPlotFrameRef );
-    bool    PlotOneSheetDXF( const wxString& aFileName, SCH_SCREEN* aScreen,
-                             wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
     // HPGL
     bool    GetPlotOriginCenter()
@@ -121,15 +121,9 @@ private:
 
     void    createHPGLFile( bool aPlotAll, bool aPlotFrameRef );
     void    SetHPGLPenWidth();
-    bool    Plot_1_Page_HPGL( const wxString& aFileName, SCH_SCREEN* aScreen,
-                              const PAGE_INFO& aPageInfo,
-                              wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
     // PS
     void    createPSFile( bool aPlotAll, bool aPlotFrameRef );
-    bool    plotOneSheetPS( const wxString& aFileName, SCH_SCREEN* aScreen,
-                            const PAGE_INFO& aPageInfo,
-                            wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
     // SVG
     void    createSVGFile( bool aPlotAll, bool aPlotFrameRef );
@@ -147,11 +141,4 @@ private:
     wxFileName createPlotFileName( wxTextCtrl* aOutputDirectoryName,
                                    wxString& aPlotFileName,
                                    wxString& aExtension, REPORTER* aReporter = NULL );
-
-public:
-    // This function is static because it is called by libedit
-    // outside a dialog. This is the reason we need aFrame as parameter
-    static bool plotOneSheetSVG( EDA_DRAW_FRAME* aFrame, const wxString& aFileName,
-                                 SCH_SCREEN* aScreen,
-                                 bool aPlotBlackAndWhite, bool aPlotFrameRef );
 };
@@ -30,7 +30,11 @@
 
 #include <fctsys.h>
 #include <pgm_base.h>
+#include <common.h>
 #include <kiface_i.h>
+#include <kiface_ids.h>
+#include <project_preloader.h>
+#include <task_scheduler.h>
 #include <class_drawpanel.h>
 #include <confirm.h>
 #include <gestfich.h>
@@ -59,6 +63,100 @@ TRANSFORM DefaultTransform = TRANSFORM( 1, 0, 0, -1 );
 
 namespace SCH {
 
+/**
+ * Class SCH_PROJECT_PRELOADER
+ * loads the symbol library table of the project and fills the caches of its rows in
+ * parallel.
+ *
+ * The part libraries of the project are not preloaded: PART_LIBS::LoadAllLibraries() reads
+ * the project file through wxConfig and reports errors with wxLogError(), neither of which
+ * may be used from a worker thread.
+ */
+static class SCH_PROJECT_PRELOADER : public PROJECT_PRELOADER
+{
+public:
+    SCH_PROJECT_PRELOADER() :
+        m_table( NULL ),
+        m_tableTime( 0 ),
+        m_preloaded( NULL )
+    {}
+
+    void PreloadProject( KIWAY& aKiway, TASK_GROUP& aTasks ) override
+    {
+        PROJECT&          prj = aKiway.Prj();
+        SYMBOL_LIB_TABLE* tbl = prj.SchSymbolLibTable();
+
+        m_table = tbl;
+        m_tableProject = prj.GetProjectFullName();
+        m_tableTime = tableFileTime( prj );
+        m_preloaded = NULL;
+
+        // The "C" locale is held in this image until PreloadFinish(), so the LOCALE_IOs of
+        // the parsers only count and never switch the locale while another task parses.
+        m_locale.reset( new LOCALE_IO );
+
+        for( const wxString& nickname : tbl->GetLogicalLibs() )
+        {
+            aTasks.Run( [tbl, nickname]() {
+                wxArrayString aliases;
+
+                try
+                {
+                    tbl->EnumerateSymbolLib( nickname, aliases );
+                }
+                catch( const IO_ERROR& )
+                {
+                    // reported when an editor reads this library
+                }
+            } );
+        }
+    }
+
+    void PreloadFinish( KIWAY& aKiway, bool aCancelled ) override
+    {
+        m_preloaded = aCancelled ? NULL : m_table;
+        m_table = NULL;
+        m_locale.reset();
+    }
+
+    /**
+     * Function TakeSymbolLibTable
+     * tells if the symbol library table of @a aProject is the one just preloaded, and if
+     * its file did not change since.  Answers true only once per preload: afterwards the
+     * schematic editor reloads the table each time it opens the project, as it always did.
+     */
+    bool TakeSymbolLibTable( PROJECT& aProject )
+    {
+        SYMBOL_LIB_TABLE* preloaded = m_preloaded;
+
+        m_preloaded = NULL;
+
+        return preloaded
+                && aProject.GetProjectFullName() == m_tableProject
+                && aProject.GetElem( PROJECT::ELEM_SYMBOL_LIB_TABLE ) == preloaded
+                && tableFileTime( aProject ) == m_tableTime;
+    }
+
+private:
+    /// @return the modification time of the project symbol library table file, or -1.
+    static wxLongLong tableFileTime( PROJECT& aProject )
+    {
+        wxFileName fn( aProject.GetProjectPath(), SYMBOL_LIB_TABLE::GetSymbolLibTableFileName() );
+
+        if( !fn.FileExists() )
+            return -1;
+
+        return fn.GetModificationTime().GetValue();
+    }
+
+    SYMBOL_LIB_TABLE*           m_table;        ///< the table being preloaded
+    wxString                    m_tableProject; ///< the project it belongs to
+    wxLongLong                  m_tableTime;    ///< the modification time of its file when loaded
+    SYMBOL_LIB_TABLE*           m_preloaded;    ///< the table of the last completed preload
+    std::unique_ptr<LOCALE_IO>  m_locale;       ///< "C" locale held while the tasks run
+} projectPreloader;
+
+
 static struct IFACE : public KIFACE_I
 {
     // Of course all are virtual overloads, implementations of the KIFACE.
@@ -130,7 +228,14 @@ static struct IFACE : public KIFACE_I
      */
     void* IfaceOrAddress( int aDataId ) override
     {
-        return NULL;
+        switch( aDataId )
+        {
+        case KIFACE_PROJECT_PRELOADER:
+            return (void*) static_cast<PROJECT_PRELOADER*>( &projectPreloader );
+
+        default:
+            return NULL;
+        }
     }
 
 } kiface( "eeschema", KIWAY::FACE_SCH );
@@ -161,6 +266,12 @@ PGM_BASE& Pgm()
 }
 
 
+bool ReusePreloadedSymbolLibTable( PROJECT& aProject )
+{
+    return projectPreloader.TakeSymbolLibTable( aProject );
+}
+
+
 static COLOR4D s_layerColor[SCH_LAYER_ID_COUNT];
 
 COLOR4D GetLayerColor( SCH_LAYER_ID aLayer )
@@ -29,6 +29,7 @@
  */
 
 #include <fctsys.h>
+#include <general.h>
 #include <class_drawpanel.h>
 #include <confirm.h>
 #include <gestfich.h>
@@ -301,8 +302,11 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
         Prj().SchLibs();
     }
 
-    // Load the symbol library table, this will be used forever more.
-    Prj().SetElem( PROJECT::ELEM_SYMBOL_LIB_TABLE, NULL );
+    // Load the symbol library table, this will be used forever more.  The table just
+    // preloaded by KiCad for this project is kept, with its library caches.
+    if( !ReusePreloadedSymbolLibTable( Prj() ) )
+        Prj().SetElem( PROJECT::ELEM_SYMBOL_LIB_TABLE, NULL );
+
     Prj().SchSymbolLibTable();
 
     if( is_new )
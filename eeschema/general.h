@@ -36,6 +36,7 @@ using KIGFX::COLOR4D;
 
 class TRANSFORM;
 class SCH_SHEET;
+class PROJECT;
 
 #define EESCHEMA_VERSION 2
 #define SCHEMATIC_HEAD_STRING "Schematic File Version"
@@ -108,4 +109,12 @@ COLOR4D GetItemSelectedColor();
 // Color to draw items flagged invisible, in libedit (they are invisible in Eeschema
 COLOR4D GetInvisibleItemColor();
 
+/**
+ * Function ReusePreloadedSymbolLibTable
+ * @return true if the symbol library table of @a aProject was just loaded by the KiCad
+ * project manager preload and its file was not modified since, so the schematic editor may
+ * keep it with its library caches.  Returns true at most once per preload.
+ */
+bool ReusePreloadedSymbolLibTable( PROJECT& aProject );
+
 #endif    // _GENERAL_H_
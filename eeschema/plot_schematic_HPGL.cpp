@@ -110,136 +110,14 @@ void DIALOG_PLOT_SCHEMATIC::SetHPGLPenWidth()
 
 void DIALOG_PLOT_SCHEMATIC::createHPGLFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
-    SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
-
-    /* When printing all pages, the printed page is not the current page.
-     *  In complex hierarchies, we must setup references and other parameters
-     *  in the printed SCH_SCREEN
-     *  because in complex hierarchies a SCH_SCREEN (a schematic drawings)
-     *  is shared between many sheets
-     */
-    SCH_SHEET_LIST  sheetList;
-
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
-
-    REPORTER& reporter = m_MessagesBox->Reporter();
+    SCH_PLOT_OPTIONS options;
 
     SetHPGLPenWidth();
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-
-        screen = m_parent->GetCurrentSheet().LastScreen();
-
-        if( !screen ) // LastScreen() may return NULL
-            screen = m_parent->GetScreen();
-
-        const PAGE_INFO&    curPage = screen->GetPageSettings();
-
-        PAGE_INFO           plotPage = curPage;
-
-        // if plotting on a page size other than curPage
-        if( m_HPGLPaperSizeOption->GetSelection() != PAGE_DEFAULT )
-            plotPage.SetType( plot_sheet_list( m_HPGLPaperSizeOption->GetSelection() ) );
-
-        // Calculation of conversion scales.
-        double  plot_scale = (double) plotPage.GetWidthMils() / curPage.GetWidthMils();
-
-        // Calculate offsets
-        wxPoint plotOffset;
-        wxString msg;
-
-        if( GetPlotOriginCenter() )
-        {
-            plotOffset.x    = plotPage.GetWidthIU() / 2;
-            plotOffset.y    = -plotPage.GetHeightIU() / 2;
-        }
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = HPGL_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName, fname,
-                                                          ext, &reporter );
-
-            LOCALE_IO toggle;
-
-            if( Plot_1_Page_HPGL( plotFileName.GetFullPath(), screen, plotPage, plotOffset,
-                                  plot_scale, aPlotFrameRef ) )
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-            else
-            {
-                msg.Printf( _( "Unable to create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-        }
-        catch( IO_ERROR& e )
-        {
-            msg.Printf( wxT( "HPGL Plotter exception: %s"), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-        }
-
-    }
-
-    m_parent->SetCurrentSheet( oldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
-}
-
-
-bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
-                                              SCH_SCREEN*       aScreen,
-                                              const PAGE_INFO&  aPageInfo,
-                                              wxPoint           aPlot0ffset,
-                                              double            aScale,
-                                              bool              aPlotFrameRef )
-{
-    HPGL_PLOTTER* plotter = new HPGL_PLOTTER();
-
-    plotter->SetPageSettings( aPageInfo );
-    // Currently, plot units are in decimil
-    plotter->SetViewport( aPlot0ffset, IU_PER_MILS/10, aScale, false );
-
-    // Init :
-    plotter->SetCreator( wxT( "Eeschema-HPGL" ) );
-
-    if( ! plotter->OpenFile( aFileName ) )
-    {
-        delete plotter;
-        return false;
-    }
-
-    LOCALE_IO toggle;
-
-    // Pen num and pen speed are not initialized here.
-    // Default HPGL driver values are used
-    plotter->SetPenDiameter( m_HPGLPenSize );
-    plotter->StartPlot();
-
-    plotter->SetColor( BLACK );
-
-    if( getPlotFrameRef() )
-        PlotWorkSheet( plotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
-
-    aScreen->Plot( plotter );
-
-    plotter->EndPlot();
-    delete plotter;
+    options.m_PlotFrameRef = aPlotFrameRef;
+    options.m_HPGLPageSize = plot_sheet_list( m_HPGLPaperSizeOption->GetSelection() );
+    options.m_HPGLOriginCenter = GetPlotOriginCenter();
+    options.m_HPGLPenSize = m_HPGLPenSize;
 
-    return true;
+    plotSheetFiles( PLOT_FORMAT_HPGL, aPlotAll, options );
 }
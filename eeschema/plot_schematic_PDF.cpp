@@ -40,156 +40,37 @@
 
 void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
-    SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();     // sheetpath is saved here
+    SCH_SHEET_PATH      oldsheetpath = m_parent->GetCurrentSheet();     // sheetpath is saved here
+    SCH_PLOT_OPTIONS    options;
 
-    /* When printing all pages, the printed page is not the current page.  In
-     * complex hierarchies, we must update component references and others
-     * parameters in the given printed SCH_SCREEN, accordint to the sheet path
-     * because in complex hierarchies a SCH_SCREEN (a drawing ) is shared
-     * between many sheets and component references depend on the actual sheet
-     * path used
-     */
-    SCH_SHEET_LIST sheetList;
+    options.m_PlotFrameRef = aPlotFrameRef;
+    options.m_Color = getModeColor();
+    options.m_PageSize = (PageFormatReq) m_pageSizeSelect;
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    // The sheets are plotted on the worker threads, then merged in a single file
+    SCH_PLOT_JOB job( getSheetList( aPlotAll ), options );
 
-    // Allocate the plotter and set the job level parameter
-    PDF_PLOTTER* plotter = new PDF_PLOTTER();
-    plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
-    plotter->SetColorMode( getModeColor() );
-    plotter->SetCreator( wxT( "Eeschema-PDF" ) );
-    plotter->SetTitle( m_parent->GetTitleBlock().GetTitle() );
+    if( job.GetPages().empty() )
+        return;
 
     wxString msg;
-    wxFileName plotFileName;
     REPORTER& reporter = m_MessagesBox->Reporter();
-    LOCALE_IO toggle;       // Switch the locale to standard C
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
+    try
     {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
+        wxString fname = job.GetPages()[0].m_FileName;
+        wxString ext = PDF_PLOTTER::GetDefaultFileExtension();
+        wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
+                                                      fname, ext, &reporter );
 
-        if( i == 0 )
-        {
-
-            try
-            {
-                wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-                wxString ext = PDF_PLOTTER::GetDefaultFileExtension();
-                plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                   fname, ext, &reporter );
-
-                if( !plotter->OpenFile( plotFileName.GetFullPath() ) )
-                {
-                    msg.Printf( _( "Unable to create file '%s'.\n" ),
-                                GetChars( plotFileName.GetFullPath() ) );
-                    reporter.Report( msg, REPORTER::RPT_ERROR );
-                    delete plotter;
-                    return;
-                }
-
-                // Open the plotter and do the first page
-                setupPlotPagePDF( plotter, screen );
-                plotter->StartPlot();
-            }
-            catch( const IO_ERROR& e )
-            {
-                // Cannot plot PDF file
-                msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( e.What() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-
-                restoreEnvironment( plotter, oldsheetpath );
-                return;
-            }
-
-        }
-        else
-        {
-            /* For the following pages you need to close the (finished) page,
-             *  reconfigure, and then start a new one */
-            plotter->ClosePage();
-            setupPlotPagePDF( plotter, screen );
-            plotter->StartPage();
-        }
-
-        plotOneSheetPDF( plotter, screen, aPlotFrameRef );
-    }
-
-    // Everything done, close the plot and restore the environment
-    msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-    reporter.Report( msg, REPORTER::RPT_ACTION );
-
-    restoreEnvironment( plotter, oldsheetpath );
-}
-
-
-void DIALOG_PLOT_SCHEMATIC::restoreEnvironment( PDF_PLOTTER* aPlotter,
-                                                SCH_SHEET_PATH& aOldsheetpath )
-{
-    aPlotter->EndPlot();
-    delete aPlotter;
-
-    // Restore the previous sheet
-    m_parent->SetCurrentSheet( aOldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
-}
-
-
-void DIALOG_PLOT_SCHEMATIC::plotOneSheetPDF( PLOTTER* aPlotter,
-                                             SCH_SCREEN* aScreen,
-                                             bool aPlotFrameRef )
-{
-    if( aPlotFrameRef )
-    {
-        aPlotter->SetColor( BLACK );
-        PlotWorkSheet( aPlotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
+        job.PlotPDF( plotFileName.GetFullPath(), &reporter );
     }
-
-    aScreen->Plot( aPlotter );
-}
-
-
-void DIALOG_PLOT_SCHEMATIC::setupPlotPagePDF( PLOTTER * aPlotter, SCH_SCREEN* aScreen )
-{
-    PAGE_INFO   plotPage;                               // page size selected to plot
-    // Considerations on page size and scaling requests
-    PAGE_INFO   actualPage = aScreen->GetPageSettings(); // page size selected in schematic
-
-    switch( m_pageSizeSelect )
+    catch( const IO_ERROR& e )
     {
-    case PAGE_SIZE_A:
-        plotPage.SetType( wxT( "A" ) );
-        plotPage.SetPortrait( actualPage.IsPortrait() );
-        break;
-
-    case PAGE_SIZE_A4:
-        plotPage.SetType( wxT( "A4" ) );
-        plotPage.SetPortrait( actualPage.IsPortrait() );
-        break;
-
-    case PAGE_SIZE_AUTO:
-    default:
-        plotPage = actualPage;
-        break;
+        // Cannot plot PDF file
+        msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( e.What() ) );
+        reporter.Report( msg, REPORTER::RPT_ERROR );
     }
 
-    double  scalex  = (double) plotPage.GetWidthMils() / actualPage.GetWidthMils();
-    double  scaley  = (double) plotPage.GetHeightMils() / actualPage.GetHeightMils();
-    double  scale   = std::min( scalex, scaley );
-    aPlotter->SetPageSettings( plotPage );
-    // Currently, plot units are in decimil
-    aPlotter->SetViewport( wxPoint( 0, 0 ), IU_PER_MILS/10, scale, false );
+    restoreCurrentSheet( oldsheetpath );
 }
-
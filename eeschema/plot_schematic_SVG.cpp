@@ -43,107 +43,10 @@
 
 void DIALOG_PLOT_SCHEMATIC::createSVGFile( bool aPrintAll, bool aPrintFrameRef )
 {
-    wxString        msg;
-    REPORTER&       reporter = m_MessagesBox->Reporter();
-    SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
-    SCH_SHEET_LIST  sheetList;
+    SCH_PLOT_OPTIONS options;
 
-    if( aPrintAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    options.m_PlotFrameRef = aPrintFrameRef;
+    options.m_Color = getModeColor();
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        SCH_SCREEN*  screen;
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = SVG_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                          fname, ext, &reporter );
-
-            bool success = plotOneSheetSVG( m_parent, plotFileName.GetFullPath(), screen,
-                                            getModeColor() ? false : true,
-                                            aPrintFrameRef );
-
-            if( !success )
-            {
-                msg.Printf( _( "Cannot create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-            else
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-        }
-        catch( const IO_ERROR& e )
-        {
-            // Cannot plot SVG file
-            msg.Printf( wxT( "SVG Plotter exception: %s" ), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-            break;
-        }
-    }
-
-    m_parent->SetCurrentSheet( oldsheetpath );
-    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-    m_parent->SetSheetNumberAndCount();
-}
-
-
-bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( EDA_DRAW_FRAME*    aFrame,
-                                             const wxString&    aFileName,
-                                             SCH_SCREEN*        aScreen,
-                                             bool               aPlotBlackAndWhite,
-                                             bool               aPlotFrameRef )
-{
-    SVG_PLOTTER* plotter = new SVG_PLOTTER();
-
-    const PAGE_INFO&   pageInfo = aScreen->GetPageSettings();
-    plotter->SetPageSettings( pageInfo );
-    plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
-    plotter->SetColorMode( aPlotBlackAndWhite ? false : true );
-    wxPoint plot_offset;
-    double scale = 1.0;
-    // Currently, plot units are in decimil
-    plotter->SetViewport( plot_offset, IU_PER_MILS/10, scale, false );
-
-    // Init :
-    plotter->SetCreator( wxT( "Eeschema-SVG" ) );
-
-    if( ! plotter->OpenFile( aFileName ) )
-    {
-        delete plotter;
-        return false;
-    }
-
-    LOCALE_IO   toggle;
-
-    plotter->StartPlot();
-
-    if( aPlotFrameRef )
-    {
-        plotter->SetColor( BLACK );
-        PlotWorkSheet( plotter, aFrame->GetTitleBlock(),
-                       aFrame->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       aFrame->GetScreenDesc(),
-                       aScreen->GetFileName() );
-    }
-
-    aScreen->Plot( plotter );
-
-    plotter->EndPlot();
-    delete plotter;
-
-    return true;
+    plotSheetFiles( PLOT_FORMAT_SVG, aPrintAll, options );
 }
@@ -212,7 +212,8 @@ SCH_COMPONENT::SCH_COMPONENT( const SCH_COMPONENT& aComponent ) :
 
     m_transform = aComponent.m_transform;
     m_prefix = aComponent.m_prefix;
-    m_PathsAndReferences = aComponent.m_PathsAndReferences;
+    m_instances = aComponent.m_instances;
+    m_instanceIndex = aComponent.m_instanceIndex;
     m_Fields = aComponent.m_Fields;
 
     // Re-parent the fields, which before this had aComponent as parent
@@ -513,30 +514,41 @@ void SCH_COMPONENT::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDC, const wxPoint& aOff
 }
 
 
+SCH_COMPONENT_INSTANCE* SCH_COMPONENT::findInstance( const wxString& aPath )
+{
+    auto it = m_instanceIndex.find( aPath );
+
+    if( it == m_instanceIndex.end() )
+        return NULL;
+
+    return &m_instances[it->second];
+}
+
+
+void SCH_COMPONENT::rebuildInstanceIndex()
+{
+    m_instanceIndex.clear();
+
+    for( unsigned ii = 0; ii < m_instances.size(); ii++ )
+        m_instanceIndex[m_instances[ii].m_Path] = ii;
+}
+
+
 void SCH_COMPONENT::AddHierarchicalReference( const wxString& aPath,
                                               const wxString& aRef,
                                               int             aMulti )
 {
-    wxString          h_path, h_ref;
-    wxStringTokenizer tokenizer;
-    wxString          separators( wxT( " " ) );
-
     // Search for an existing path and remove it if found (should not occur)
-    for( unsigned ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
-    {
-        tokenizer.SetString( m_PathsAndReferences[ii], separators );
-        h_path = tokenizer.GetNextToken();
+    auto it = m_instanceIndex.find( aPath );
 
-        if( h_path.Cmp( aPath ) == 0 )
-        {
-            m_PathsAndReferences.RemoveAt( ii );
-            ii--;
-        }
+    if( it != m_instanceIndex.end() )
+    {
+        m_instances.erase( m_instances.begin() + it->second );
+        rebuildInstanceIndex();
     }
 
-    h_ref = aPath + wxT( " " ) + aRef;
-    h_ref << wxT( " " ) << aMulti;
-    m_PathsAndReferences.Add( h_ref );
+    m_instanceIndex[aPath] = m_instances.size();
+    m_instances.push_back( SCH_COMPONENT_INSTANCE( aPath, aRef, aMulti ) );
 }
 
 
@@ -554,25 +566,10 @@ wxString SCH_COMPONENT::GetPath( const SCH_SHEET_PATH* sheet ) const
 
 const wxString SCH_COMPONENT::GetRef( const SCH_SHEET_PATH* sheet )
 {
-    wxString          path = GetPath( sheet );
-    wxString          h_path, h_ref;
-    wxStringTokenizer tokenizer;
-    wxString          separators( wxT( " " ) );
+    SCH_COMPONENT_INSTANCE* instance = findInstance( GetPath( sheet ) );
 
-    for( unsigned ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
-    {
-        tokenizer.SetString( m_PathsAndReferences[ii], separators );
-        h_path = tokenizer.GetNextToken();
-
-        if( h_path.Cmp( path ) == 0 )
-        {
-            h_ref = tokenizer.GetNextToken();
-
-            /* printf( "GetRef hpath: %s\n",
-             *       TO_UTF8( m_PathsAndReferences[ii] ) ); */
-            return h_ref;
-        }
-    }
+    if( instance )
+        return instance->m_Reference;
 
     // if it was not found in m_Paths array, then see if it is in
     // m_Field[REFERENCE] -- if so, use this as a default for this path.
@@ -616,35 +613,13 @@ bool SCH_COMPONENT::IsReferenceStringValid( const wxString& aReferenceString )
 
 void SCH_COMPONENT::SetRef( const SCH_SHEET_PATH* sheet, const wxString& ref )
 {
-    wxString          path = GetPath( sheet );
-
-    bool              notInArray = true;
-
-    wxString          h_path, h_ref;
-    wxStringTokenizer tokenizer;
-    wxString          separators( wxT( " " ) );
+    wxString                path = GetPath( sheet );
+    SCH_COMPONENT_INSTANCE* instance = findInstance( path );
 
     // check to see if it is already there before inserting it
-    for( unsigned ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
-    {
-        tokenizer.SetString( m_PathsAndReferences[ii], separators );
-        h_path = tokenizer.GetNextToken();
-
-        if( h_path.Cmp( path ) == 0 )
-        {
-            // just update the reference text, not the timestamp.
-            h_ref  = h_path + wxT( " " ) + ref;
-            h_ref += wxT( " " );
-            tokenizer.GetNextToken();               // Skip old reference
-            h_ref += tokenizer.GetNextToken();      // Add part selection
-
-            // Add the part selection
-            m_PathsAndReferences[ii] = h_ref;
-            notInArray = false;
-        }
-    }
-
-    if( notInArray )
+    if( instance )
+        instance->m_Reference = ref;    // just update the reference text, not the timestamp.
+    else
         AddHierarchicalReference( path, ref, m_unit );
 
     SCH_FIELD* rf = GetField( REFERENCE );
@@ -685,35 +660,25 @@ void SCH_COMPONENT::SetTimeStamp( time_t aNewTimeStamp )
     string_oldtimestamp.Printf( wxT( "%08lX" ), (long unsigned) m_TimeStamp );
     EDA_ITEM::SetTimeStamp( aNewTimeStamp );
 
-    for( unsigned ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
+    if( m_instances.empty() )
+        return;
+
+    for( SCH_COMPONENT_INSTANCE& instance : m_instances )
     {
-        m_PathsAndReferences[ii].Replace( string_oldtimestamp.GetData(),
-                                          string_timestamp.GetData() );
+        instance.m_Path.Replace( string_oldtimestamp.GetData(),
+                                 string_timestamp.GetData() );
     }
+
+    rebuildInstanceIndex();
 }
 
 
 int SCH_COMPONENT::GetUnitSelection( SCH_SHEET_PATH* aSheet )
 {
-    wxString          path = GetPath( aSheet );
-    wxString          h_path, h_multi;
-    wxStringTokenizer tokenizer;
-    wxString          separators( wxT( " " ) );
+    SCH_COMPONENT_INSTANCE* instance = findInstance( GetPath( aSheet ) );
 
-    for( unsigned ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
-    {
-        tokenizer.SetString( m_PathsAndReferences[ii], separators );
-        h_path = tokenizer.GetNextToken();
-
-        if( h_path.Cmp( path ) == 0 )
-        {
-            tokenizer.GetNextToken();   // Skip reference
-            h_multi = tokenizer.GetNextToken();
-            long imulti = 1;
-            h_multi.ToLong( &imulti );
-            return imulti;
-        }
-    }
+    if( instance )
+        return instance->m_Unit;
 
     // if it was not found in m_Paths array, then use m_unit.
     // this will happen if we load a version 1 schematic file.
@@ -723,35 +688,13 @@ int SCH_COMPONENT::GetUnitSelection( SCH_SHEET_PATH* aSheet )
 
 void SCH_COMPONENT::SetUnitSelection( SCH_SHEET_PATH* aSheet, int aUnitSelection )
 {
-    wxString          path = GetPath( aSheet );
-
-    bool              notInArray = true;
-
-    wxString          h_path, h_ref;
-    wxStringTokenizer tokenizer;
-    wxString          separators( wxT( " " ) );
+    wxString                path = GetPath( aSheet );
+    SCH_COMPONENT_INSTANCE* instance = findInstance( path );
 
     //check to see if it is already there before inserting it
-    for( unsigned ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
-    {
-        tokenizer.SetString( m_PathsAndReferences[ii], separators );
-        h_path = tokenizer.GetNextToken();
-
-        if( h_path.Cmp( path ) == 0 )
-        {
-            //just update the unit selection.
-            h_ref  = h_path + wxT( " " );
-            h_ref += tokenizer.GetNextToken();      // Add reference
-            h_ref += wxT( " " );
-            h_ref << aUnitSelection;                // Add part selection
-
-            // Ann the part selection
-            m_PathsAndReferences[ii] = h_ref;
-            notInArray = false;
-        }
-    }
-
-    if( notInArray )
+    if( instance )
+        instance->m_Unit = aUnitSelection;      // just update the unit selection.
+    else
         AddHierarchicalReference( path, m_prefix, aUnitSelection );
 }
 
@@ -898,16 +841,14 @@ void SCH_COMPONENT::SwapData( SCH_ITEM* aItem )
         GetField( ii )->SetParent( this );
     }
 
-    std::swap( m_PathsAndReferences, component->m_PathsAndReferences );
+    std::swap( m_instances, component->m_instances );
+    std::swap( m_instanceIndex, component->m_instanceIndex );
 }
 
 
 void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
 {
     bool           keepMulti = false;
-    wxArrayString  reference_fields;
-
-    static const wxChar separators[] = wxT( " " );
 
     PART_SPTR part = m_part.lock();
 
@@ -930,33 +871,25 @@ void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
 
     defRef.Append( wxT( "?" ) );
 
-    wxString multi = wxT( "1" );
-
     // For components with units locked,
     // we cannot remove all annotations: part selection must be kept
     // For all components: if aSheetPath is not NULL,
     // remove annotation only for the given path
     if( keepMulti || aSheetPath )
     {
-        wxString NewHref;
         wxString path;
 
         if( aSheetPath )
             path = GetPath( aSheetPath );
 
-        for( unsigned int ii = 0; ii < m_PathsAndReferences.GetCount(); ii++ )
+        for( SCH_COMPONENT_INSTANCE& instance : m_instances )
         {
-            // Break hierarchical reference in path, ref and multi selection:
-            reference_fields = wxStringTokenize( m_PathsAndReferences[ii], separators );
-
-            if( aSheetPath == NULL || reference_fields[0].Cmp( path ) == 0 )
+            if( aSheetPath == NULL || instance.m_Path == path )
             {
-                if( keepMulti )  // Get and keep part selection
-                    multi = reference_fields[2];
+                instance.m_Reference = defRef;
 
-                NewHref = reference_fields[0];
-                NewHref << wxT( " " ) << defRef << wxT( " " ) << multi;
-                m_PathsAndReferences[ii] = NewHref;
+                if( !keepMulti )  // Else get and keep part selection
+                    instance.m_Unit = 1;
             }
         }
     }
@@ -964,7 +897,8 @@ void SCH_COMPONENT::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
     {
         // Clear reference strings, but does not free memory because a new annotation
         // will reuse it
-        m_PathsAndReferences.Empty();
+        m_instances.clear();
+        m_instanceIndex.clear();
         m_unit = 1;
     }
 
@@ -1186,17 +1120,12 @@ bool SCH_COMPONENT::Save( FILE* f ) const
 {
     std::string     name1;
     std::string     name2;
-    wxArrayString   reference_fields;
-
-    static wxString delimiters( wxT( " " ) );
 
     // this is redundant with the AR entries below, but it makes the
     // files backwards-compatible.
-    if( m_PathsAndReferences.GetCount() > 0 )
+    if( !m_instances.empty() )
     {
-        reference_fields = wxStringTokenize( m_PathsAndReferences[0], delimiters );
-
-        name1 = toUTFTildaText( reference_fields[1] );
+        name1 = toUTFTildaText( m_instances[0].m_Reference );
     }
     else
     {
@@ -1236,9 +1165,9 @@ bool SCH_COMPONENT::Save( FILE* f ) const
      * the reference inf is already saved
      * this is useful for old Eeschema version compatibility
      */
-    if( m_PathsAndReferences.GetCount() > 1 )
+    if( m_instances.size() > 1 )
     {
-        for( unsigned int ii = 0; ii <  m_PathsAndReferences.GetCount(); ii++ )
+        for( const SCH_COMPONENT_INSTANCE& instance : m_instances )
         {
             /*format:
              * AR Path="/140/2" Ref="C99"   Part="1"
@@ -1248,12 +1177,10 @@ bool SCH_COMPONENT::Save( FILE* f ) const
              * Ref is the conventional component reference for this 'path'
              * Part is the conventional component part selection for this 'path'
              */
-            reference_fields = wxStringTokenize( m_PathsAndReferences[ii], delimiters );
-
-            if( fprintf( f, "AR Path=\"%s\" Ref=\"%s\"  Part=\"%s\" \n",
-                         TO_UTF8( reference_fields[0] ),
-                         TO_UTF8( reference_fields[1] ),
-                         TO_UTF8( reference_fields[2] ) ) == EOF )
+            if( fprintf( f, "AR Path=\"%s\" Ref=\"%s\"  Part=\"%d\" \n",
+                         TO_UTF8( instance.m_Path ),
+                         TO_UTF8( instance.m_Reference ),
+                         instance.m_Unit ) == EOF )
                 return false;
         }
     }
@@ -2148,7 +2075,8 @@ SCH_ITEM& SCH_COMPONENT::operator=( const SCH_ITEM& aItem )
         m_convert   = c->m_convert;
         m_transform = c->m_transform;
 
-        m_PathsAndReferences = c->m_PathsAndReferences;
+        m_instances = c->m_instances;
+        m_instanceIndex = c->m_instanceIndex;
 
         m_Fields = c->m_Fields;    // std::vector's assignment operator.
 
@@ -37,9 +37,12 @@
 #include <sch_field.h>
 #include <transform.h>
 #include <general.h>
+#include <unordered_map>
 #include <vector>
 #include <lib_draw_item.h>
 
+#include <wx/hashmap.h>
+
 class SCH_SCREEN;
 class SCH_SHEET_PATH;
 class LIB_ITEM;
@@ -59,6 +62,26 @@ typedef std::vector<SCH_FIELD>    SCH_FIELDS;
 typedef std::weak_ptr<LIB_PART>   PART_REF;
 
 
+/**
+ * Struct SCH_COMPONENT_INSTANCE
+ * is the reference and the unit selection of a component in one of the sheet paths
+ * using its screen (the "AR" lines of the schematic files).
+ */
+struct SCH_COMPONENT_INSTANCE
+{
+    SCH_COMPONENT_INSTANCE( const wxString& aPath, const wxString& aReference, int aUnit ) :
+        m_Path( aPath ),
+        m_Reference( aReference ),
+        m_Unit( aUnit )
+    {
+    }
+
+    wxString    m_Path;         ///< /&ltsheet time stamp&gt/.../&ltcomponent time stamp&gt
+    wxString    m_Reference;
+    int         m_Unit;
+};
+
+
 extern std::string toUTFTildaText( const wxString& txt );
 
 
@@ -108,12 +131,20 @@ private:
      * Defines the hierarchical path and reference of the component.  This allows support
      * for hierarchical sheets that reference the same schematic.  The format for the path
      * is /&ltsheet time stamp&gt/&ltsheet time stamp&gt/.../&lscomponent time stamp&gt.
-     * A single / denotes the root sheet.
+     * A single / denotes the root sheet.  The instances are kept in the file order.
      */
-    wxArrayString m_PathsAndReferences;
+    std::vector<SCH_COMPONENT_INSTANCE> m_instances;
+
+    /// The index in m_instances of each path
+    std::unordered_map<wxString, unsigned, wxStringHash, wxStringEqual> m_instanceIndex;
 
     void Init( const wxPoint& pos = wxPoint( 0, 0 ) );
 
+    /// @return the instance of aPath, or NULL if the component has no reference for aPath
+    SCH_COMPONENT_INSTANCE* findInstance( const wxString& aPath );
+
+    void rebuildInstanceIndex();
+
 public:
     SCH_COMPONENT( const wxPoint& pos = wxPoint( 0, 0 ), SCH_ITEM* aParent = NULL );
 
@@ -150,7 +181,7 @@ public:
         return wxT( "SCH_COMPONENT" );
     }
 
-    const wxArrayString& GetPathsAndReferences() const { return m_PathsAndReferences; }
+    const std::vector<SCH_COMPONENT_INSTANCE>& GetInstances() const { return m_instances; }
 
     /**
      * Virtual function IsMovableFromAnchorPoint
@@ -274,7 +305,7 @@ public:
     /**
      * Function SetTimeStamp
      * changes the time stamp to \a aNewTimeStamp updates the reference path.
-     * @see m_PathsAndReferences
+     * @see m_instances
      * @param aNewTimeStamp = new time stamp
      */
     void SetTimeStamp( time_t aNewTimeStamp );
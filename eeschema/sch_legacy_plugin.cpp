@@ -1664,15 +1664,13 @@ void SCH_LEGACY_PLUGIN::saveComponent( SCH_COMPONENT* aComponent )
 {
     std::string     name1;
     std::string     name2;
-    wxArrayString   reference_fields;
 
-    static wxString delimiters( wxT( " " ) );
+    const std::vector<SCH_COMPONENT_INSTANCE>& instances = aComponent->GetInstances();
 
     // This is redundant with the AR entries below, but it makes the files backwards-compatible.
-    if( aComponent->GetPathsAndReferences().GetCount() > 0 )
+    if( !instances.empty() )
     {
-        reference_fields = wxStringTokenize( aComponent->GetPathsAndReferences()[0], delimiters );
-        name1 = toUTFTildaText( reference_fields[1] );
+        name1 = toUTFTildaText( instances[0].m_Reference );
     }
     else
     {
@@ -1708,9 +1706,9 @@ void SCH_LEGACY_PLUGIN::saveComponent( SCH_COMPONENT* aComponent )
      * the reference inf is already saved
      * this is useful for old Eeschema version compatibility
      */
-    if( aComponent->GetPathsAndReferences().GetCount() > 1 )
+    if( instances.size() > 1 )
     {
-        for( unsigned int ii = 0; ii <  aComponent->GetPathsAndReferences().GetCount(); ii++ )
+        for( const SCH_COMPONENT_INSTANCE& instance : instances )
         {
             /*format:
              * AR Path="/140/2" Ref="C99"   Part="1"
@@ -1720,13 +1718,10 @@ void SCH_LEGACY_PLUGIN::saveComponent( SCH_COMPONENT* aComponent )
              * Ref is the conventional component reference for this 'path'
              * Part is the conventional component part selection for this 'path'
              */
-            reference_fields = wxStringTokenize( aComponent->GetPathsAndReferences()[ii],
-                                                 delimiters );
-
-            m_out->Print( 0, "AR Path=\"%s\" Ref=\"%s\"  Part=\"%s\" \n",
-                          TO_UTF8( reference_fields[0] ),
-                          TO_UTF8( reference_fields[1] ),
-                          TO_UTF8( reference_fields[2] ) );
+            m_out->Print( 0, "AR Path=\"%s\" Ref=\"%s\"  Part=\"%d\" \n",
+                          TO_UTF8( instance.m_Path ),
+                          TO_UTF8( instance.m_Reference ),
+                          instance.m_Unit );
         }
     }
 
@@ -0,0 +1,395 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_plot_job.cpp
+ */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <fctsys.h>
+#include <common.h>
+#include <base_units.h>
+#include <general.h>
+#include <class_sch_screen.h>
+#include <sch_sheet.h>
+#include <reporter.h>
+#include <task_scheduler.h>
+#include <sch_plot_job.h>
+
+#include <wx/filename.h>
+
+
+// The page layout is a singleton and building the drawing list of a frame reference
+// updates it: frame references are plotted one at a time
+static std::mutex worksheetMutex;
+
+
+static PLOTTER* createPlotter( PlotFormat aFormat )
+{
+    switch( aFormat )
+    {
+    case PLOT_FORMAT_HPGL:  return new HPGL_PLOTTER();
+    case PLOT_FORMAT_POST:  return new PS_PLOTTER();
+    case PLOT_FORMAT_DXF:   return new DXF_PLOTTER();
+    case PLOT_FORMAT_PDF:   return new PDF_PLOTTER();
+    case PLOT_FORMAT_SVG:   return new SVG_PLOTTER();
+    default:                break;
+    }
+
+    wxFAIL_MSG( wxT( "Unsupported schematic plot format" ) );
+    return NULL;
+}
+
+
+SCH_PLOT_JOB::SCH_PLOT_JOB( const SCH_SHEET_LIST& aSheets, const SCH_PLOT_OPTIONS& aOptions ) :
+    m_options( aOptions )
+{
+    // Sheets are numbered in the order of the whole hierarchy, 1 for the root sheet
+    SCH_SHEET_LIST          hierarchy( g_RootSheet );
+    std::map<wxString, int> sheetNumbers;
+    int                     sheetCount = g_RootSheet->CountSheets();
+
+    for( unsigned i = 0; i < hierarchy.size(); i++ )
+        sheetNumbers[ hierarchy[i].Path() ] = i + 1;
+
+    // The n-th sheet path of a screen goes in the n-th round
+    std::map<SCH_SCREEN*, unsigned> screenUses;
+
+    for( const SCH_SHEET_PATH& sheetPath : aSheets )
+    {
+        SCH_PLOT_PAGE page;
+
+        page.m_SheetPath = sheetPath;
+        page.m_Screen = sheetPath.LastScreen();
+
+        if( !page.m_Screen )    // LastScreen() may return NULL
+            continue;
+
+        page.m_SheetNumber = sheetNumbers[ sheetPath.Path() ];
+        page.m_SheetCount = sheetCount;
+        page.m_SheetDesc = sheetPath.PathHumanReadable();
+        page.m_FileName = GetUniqueFileName( sheetPath, page.m_SheetNumber );
+
+        unsigned round = screenUses[ page.m_Screen ]++;
+
+        if( round == m_rounds.size() )
+            m_rounds.emplace_back();
+
+        m_rounds[round].push_back( (int) m_pages.size() );
+        m_pages.push_back( page );
+    }
+}
+
+
+wxString SCH_PLOT_JOB::GetUniqueFileName( const SCH_SHEET_PATH& aSheetPath, int aSheetNumber )
+{
+    wxFileName fn = aSheetPath.LastScreen()->GetFileName();
+
+    #define FN_LEN_MAX 80   // A reasonable value for the short filename len
+
+    wxString filename = fn.GetName();
+    wxString sheetFullName = aSheetPath.PathHumanReadable();
+
+    // Remove the last '/' of the path human readable
+    // (and for the root sheet, make sheetFullName empty):
+    sheetFullName.RemoveLast();
+
+    sheetFullName.Trim( true );
+    sheetFullName.Trim( false );
+
+    // Convert path human readable separator to '-'
+    sheetFullName.Replace( wxT( "/" ), wxT( "-" ) );
+
+    if( ( filename.Len() + sheetFullName.Len() ) < FN_LEN_MAX )
+        filename += sheetFullName;
+    else
+        filename << wxT( "-" ) << aSheetNumber;
+
+    return filename;
+}
+
+
+void SCH_PLOT_JOB::Run( const std::function<void( const SCH_PLOT_PAGE& aPage, int aIndex )>& aFunc )
+{
+    // The locale is global: it is switched once here, while the workers run, and the
+    // LOCALE_IO instances of the plot functions do nothing
+    LOCALE_IO toggle;
+
+    for( const std::vector<int>& round : m_rounds )
+    {
+        // Set up the screens of the round for their sheet path, as SetCurrentSheet(),
+        // UpdateAllScreenReferences() and SetSheetNumberAndCount() do in the editor
+        for( int index : round )
+        {
+            SCH_PLOT_PAGE& page = m_pages[index];
+
+            page.m_SheetPath.UpdateAllScreenReferences();
+            page.m_Screen->m_ScreenNumber = page.m_SheetNumber;
+            page.m_Screen->m_NumberOfScreens = page.m_SheetCount;
+        }
+
+        TASK_GROUP group;
+
+        group.ParallelFor( 0, round.size(), [this, &round, &aFunc]( int i )
+        {
+            aFunc( m_pages[ round[i] ], round[i] );
+        } );
+    }
+}
+
+
+void SCH_PLOT_JOB::setupPlotter( PLOTTER* aPlotter, const SCH_PLOT_PAGE& aPage ) const
+{
+    const PAGE_INFO& actualPage = aPage.m_Screen->GetPageSettings(); // page size selected in schematic
+    PAGE_INFO        plotPage = actualPage;                          // page size selected to plot
+    wxPoint          plotOffset;
+    double           scale = 1.0;
+
+    switch( aPlotter->GetPlotterType() )
+    {
+    case PLOT_FORMAT_POST:
+    case PLOT_FORMAT_PDF:
+        switch( m_options.m_PageSize )
+        {
+        case PAGE_SIZE_A:
+            plotPage = PAGE_INFO();
+            plotPage.SetType( wxT( "A" ) );
+            plotPage.SetPortrait( actualPage.IsPortrait() );
+            break;
+
+        case PAGE_SIZE_A4:
+            plotPage = PAGE_INFO();
+            plotPage.SetType( wxT( "A4" ) );
+            plotPage.SetPortrait( actualPage.IsPortrait() );
+            break;
+
+        case PAGE_SIZE_AUTO:
+        default:
+            break;
+        }
+
+        scale = std::min( (double) plotPage.GetWidthMils() / actualPage.GetWidthMils(),
+                          (double) plotPage.GetHeightMils() / actualPage.GetHeightMils() );
+
+        aPlotter->SetDefaultLineWidth( GetDefaultLineThickness() );
+        aPlotter->SetColorMode( m_options.m_Color );
+        aPlotter->SetCreator( aPlotter->GetPlotterType() == PLOT_FORMAT_PDF ?
+                              wxT( "Eeschema-PDF" ) : wxT( "Eeschema-PS" ) );
+        break;
+
+    case PLOT_FORMAT_HPGL:
+        // if plotting on a page size other than the schematic page
+        if( m_options.m_HPGLPageSize )
+            plotPage.SetType( m_options.m_HPGLPageSize );
+
+        scale = (double) plotPage.GetWidthMils() / actualPage.GetWidthMils();
+
+        if( m_options.m_HPGLOriginCenter )
+        {
+            plotOffset.x = plotPage.GetWidthIU() / 2;
+            plotOffset.y = -plotPage.GetHeightIU() / 2;
+        }
+
+        // Pen num and pen speed are not initialized here.
+        // Default HPGL driver values are used
+        static_cast<HPGL_PLOTTER*>( aPlotter )->SetPenDiameter( m_options.m_HPGLPenSize );
+        aPlotter->SetCreator( wxT( "Eeschema-HPGL" ) );
+        break;
+
+    case PLOT_FORMAT_DXF:
+        aPlotter->SetColorMode( m_options.m_Color );
+        aPlotter->SetCreator( wxT( "Eeschema-DXF" ) );
+        break;
+
+    case PLOT_FORMAT_SVG:
+        aPlotter->SetDefaultLineWidth( GetDefaultLineThickness() );
+        aPlotter->SetColorMode( m_options.m_Color );
+        aPlotter->SetCreator( wxT( "Eeschema-SVG" ) );
+        break;
+
+    default:
+        break;
+    }
+
+    aPlotter->SetPageSettings( plotPage );
+    // Currently, plot units are in decimil
+    aPlotter->SetViewport( plotOffset, IU_PER_MILS/10, scale, false );
+}
+
+
+void SCH_PLOT_JOB::plotPage( PLOTTER* aPlotter, const SCH_PLOT_PAGE& aPage ) const
+{
+    if( aPlotter->GetPlotterType() == PLOT_FORMAT_HPGL )
+        aPlotter->SetColor( BLACK );
+
+    if( m_options.m_PlotFrameRef )
+    {
+        std::lock_guard<std::mutex> lock( worksheetMutex );
+
+        PlotWorkSheet( aPlotter, aPage.m_Screen->GetTitleBlock(),
+                       aPage.m_Screen->GetPageSettings(),
+                       aPage.m_SheetNumber, aPage.m_SheetCount,
+                       aPage.m_SheetDesc,
+                       aPage.m_Screen->GetFileName() );
+    }
+
+    // Texts are stroked by the GAL of aPlotter, not by the shared one (see PLOTTER::GetTextGal())
+    aPage.m_Screen->Plot( aPlotter );
+}
+
+
+bool SCH_PLOT_JOB::plotFile( PlotFormat aFormat, const SCH_PLOT_PAGE& aPage,
+                             const wxString& aFileName ) const
+{
+    std::unique_ptr<PLOTTER> plotter( createPlotter( aFormat ) );
+
+    if( !plotter )
+        return false;
+
+    setupPlotter( plotter.get(), aPage );
+
+    if( !plotter->OpenFile( aFileName ) )
+        return false;
+
+    plotter->StartPlot();
+    plotPage( plotter.get(), aPage );
+    plotter->EndPlot();
+
+    return true;
+}
+
+
+bool SCH_PLOT_JOB::PlotFiles( PlotFormat aFormat, const std::vector<wxString>& aFileNames,
+                              REPORTER* aReporter )
+{
+    wxCHECK( aFileNames.size() == m_pages.size(), false );
+
+    // Written by the workers, one entry per page; reported in the page order afterwards
+    std::vector<char>       plotted( m_pages.size(), 0 );
+    std::vector<wxString>   errors( m_pages.size() );
+
+    Run( [&]( const SCH_PLOT_PAGE& aPage, int aIndex )
+    {
+        try
+        {
+            plotted[aIndex] = plotFile( aFormat, aPage, aFileNames[aIndex] );
+        }
+        catch( const IO_ERROR& e )
+        {
+            errors[aIndex] = e.What();
+        }
+    } );
+
+    bool     success = true;
+    wxString msg;
+
+    for( unsigned i = 0; i < m_pages.size(); i++ )
+    {
+        if( !errors[i].IsEmpty() )
+            msg.Printf( wxT( "Plotter exception: %s" ), GetChars( errors[i] ) );
+        else if( !plotted[i] )
+            msg.Printf( _( "Unable to create file '%s'.\n" ), GetChars( aFileNames[i] ) );
+        else
+            msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( aFileNames[i] ) );
+
+        success &= plotted[i] != 0;
+
+        if( aReporter )
+            aReporter->Report( msg, plotted[i] ? REPORTER::RPT_ACTION : REPORTER::RPT_ERROR );
+    }
+
+    return success;
+}
+
+
+bool SCH_PLOT_JOB::PlotPDF( const wxString& aFileName, REPORTER* aReporter )
+{
+    PDF_PLOTTER plotter;
+    wxString    msg;
+
+    plotter.SetCreator( wxT( "Eeschema-PDF" ) );
+
+    if( !m_pages.empty() )
+        plotter.SetTitle( m_pages[0].m_Screen->GetTitleBlock().GetTitle() );
+
+    if( !plotter.OpenFile( aFileName ) )
+    {
+        msg.Printf( _( "Unable to create file '%s'.\n" ), GetChars( aFileName ) );
+
+        if( aReporter )
+            aReporter->Report( msg, REPORTER::RPT_ERROR );
+
+        return false;
+    }
+
+    // Each page is plotted and compressed by its own plotter, then the pages are written in
+    // order in the document
+    std::vector<std::string> pageStreams( m_pages.size() );
+
+    try
+    {
+        Run( [&]( const SCH_PLOT_PAGE& aPage, int aIndex )
+        {
+            PDF_PLOTTER pagePlotter;
+
+            setupPlotter( &pagePlotter, aPage );
+            pagePlotter.StartPageStream();
+            plotPage( &pagePlotter, aPage );
+            pageStreams[aIndex] = pagePlotter.ClosePageStream();
+        } );
+
+        LOCALE_IO toggle;       // Switch the locale to standard C
+
+        plotter.StartDocument();
+
+        for( unsigned i = 0; i < m_pages.size(); i++ )
+        {
+            // Sets the page size of the page object
+            setupPlotter( &plotter, m_pages[i] );
+            plotter.AddPage( pageStreams[i] );
+        }
+
+        plotter.EndPlot();
+    }
+    catch( const IO_ERROR& e )
+    {
+        // Cannot plot PDF file
+        msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( e.What() ) );
+
+        if( aReporter )
+            aReporter->Report( msg, REPORTER::RPT_ERROR );
+
+        return false;
+    }
+
+    msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( aFileName ) );
+
+    if( aReporter )
+        aReporter->Report( msg, REPORTER::RPT_ACTION );
+
+    return true;
+}
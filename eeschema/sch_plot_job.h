@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_plot_job.h
+ * @brief Plot of schematic sheets, each sheet by its own plotter on the worker threads.
+ */
+
+#ifndef SCH_PLOT_JOB_H
+#define SCH_PLOT_JOB_H
+
+#include <functional>
+#include <vector>
+
+#include <plot_common.h>
+#include <sch_sheet_path.h>
+
+class SCH_SCREEN;
+class REPORTER;
+
+
+enum PageFormatReq {
+    PAGE_SIZE_AUTO,
+    PAGE_SIZE_A4,
+    PAGE_SIZE_A
+};
+
+
+/**
+ * Struct SCH_PLOT_OPTIONS
+ * holds the options of a schematic plot, as set in the plot dialog.
+ */
+struct SCH_PLOT_OPTIONS
+{
+    SCH_PLOT_OPTIONS() :
+        m_PlotFrameRef( true ),
+        m_Color( true ),
+        m_PageSize( PAGE_SIZE_AUTO ),
+        m_HPGLPageSize( NULL ),
+        m_HPGLOriginCenter( false ),
+        m_HPGLPenSize( 0.0 )
+    {
+    }
+
+    bool            m_PlotFrameRef;     ///< plot the frame references and the title block
+    bool            m_Color;
+    PageFormatReq   m_PageSize;         ///< PDF and PS only: the paper size
+    const wxChar*   m_HPGLPageSize;     ///< HPGL only: the paper name, NULL for the sheet size
+    bool            m_HPGLOriginCenter; ///< HPGL only: the origin is the center of the page
+    double          m_HPGLPenSize;      ///< HPGL only, in IU
+};
+
+
+/**
+ * Struct SCH_PLOT_PAGE
+ * is a sheet to plot, with all it needs to be plotted without the schematic frame.
+ */
+struct SCH_PLOT_PAGE
+{
+    SCH_SHEET_PATH  m_SheetPath;
+    SCH_SCREEN*     m_Screen;
+    int             m_SheetNumber;      ///< 1 for the root sheet
+    int             m_SheetCount;
+    wxString        m_SheetDesc;        ///< the human readable sheet path
+    wxString        m_FileName;         ///< a unique file name for the sheet, without extension
+};
+
+
+/**
+ * Class SCH_PLOT_JOB
+ * plots a list of schematic sheets.
+ *
+ * Each sheet is plotted by its own PLOTTER, on the threads of the default TASK_SCHEDULER.
+ * A SCH_SCREEN is shared by all the sheet paths using it in complex hierarchies, and the
+ * component references of a screen depend on the sheet path: the sheets using an already
+ * plotted screen are plotted by a next round, after their references are set.  The
+ * references are left as set for the last plotted sheets, the caller restores them for its
+ * current sheet.
+ *
+ * The job does not use the schematic frame, so it can be used without GUI.
+ */
+class SCH_PLOT_JOB
+{
+public:
+    SCH_PLOT_JOB( const SCH_SHEET_LIST& aSheets,
+                  const SCH_PLOT_OPTIONS& aOptions = SCH_PLOT_OPTIONS() );
+
+    const std::vector<SCH_PLOT_PAGE>& GetPages() const { return m_pages; }
+
+    /**
+     * Function PlotFiles
+     * plots each page in its own file.
+     * @param aFormat the plot format, all but PLOT_FORMAT_GERBER
+     * @param aFileNames the full file names of the pages, in the order of GetPages()
+     * @param aReporter receives the messages of the plot, can be NULL
+     * @return true if all the files were plotted
+     */
+    bool PlotFiles( PlotFormat aFormat, const std::vector<wxString>& aFileNames,
+                    REPORTER* aReporter );
+
+    /**
+     * Function PlotPDF
+     * plots all the pages in a single PDF file, in the order of GetPages().
+     * @return true if the file was plotted
+     */
+    bool PlotPDF( const wxString& aFileName, REPORTER* aReporter );
+
+    /**
+     * Function Run
+     * calls aFunc for every page, with the component references of the page set, from the
+     * worker threads.  aFunc must not modify the schematic.
+     */
+    void Run( const std::function<void( const SCH_PLOT_PAGE& aPage, int aIndex )>& aFunc );
+
+    /**
+     * Function GetUniqueFileName
+     * @return a file name for the plot of a sheet, unique in the hierarchy.
+     * Name is &ltroot sheet filename&gt-&ltsheet path&gt and has no extension.
+     * However if filename is too long name is &ltsheet filename&gt-&ltsheet number&gt
+     */
+    static wxString GetUniqueFileName( const SCH_SHEET_PATH& aSheetPath, int aSheetNumber );
+
+private:
+    /// Sets the page size, scale and options of the plotter for aPage
+    void setupPlotter( PLOTTER* aPlotter, const SCH_PLOT_PAGE& aPage ) const;
+
+    /// Plots the frame references (if enabled) and the items of aPage
+    void plotPage( PLOTTER* aPlotter, const SCH_PLOT_PAGE& aPage ) const;
+
+    /// Plots aPage in aFileName, returns false if the file cannot be created
+    bool plotFile( PlotFormat aFormat, const SCH_PLOT_PAGE& aPage,
+                   const wxString& aFileName ) const;
+
+    SCH_PLOT_OPTIONS                m_options;
+    std::vector<SCH_PLOT_PAGE>      m_pages;
+    std::vector<std::vector<int>>   m_rounds;   ///< pages by round, no screen twice in a round
+};
+
+#endif  // SCH_PLOT_JOB_H
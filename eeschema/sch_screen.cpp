@@ -1443,7 +1443,7 @@ int SCH_SCREENS::ReplaceDuplicateTimeStamps()
             count++;
 
             // for a component, update its Time stamp and its paths
-            // (m_PathsAndReferences field)
+            // (instances table)
             if( item->Type() == SCH_COMPONENT_T )
                 ( (SCH_COMPONENT*) item )->SetTimeStamp( GetNewTimeStamp() );
 
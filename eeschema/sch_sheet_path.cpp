@@ -130,17 +130,20 @@ SCH_ITEM* SCH_SHEET_PATH::FirstDrawList() const
 
 wxString SCH_SHEET_PATH::Path() const
 {
-    wxString s, t;
+    wxString s;
+    char     t[16];
 
     s = wxT( "/" );     // This is the root path
 
     // start at 1 to avoid the root sheet,
     // which does not need to be added to the path
     // it's timestamp changes anyway.
+    // The time stamps are plain hex numbers, so skip the translation lookup and the
+    // wxString formatting which show up when searching large hierarchies.
     for( unsigned i = 1; i < size(); i++ )
     {
-        t.Printf( _( "%8.8lX/" ), (long unsigned) at( i )->GetTimeStamp() );
-        s = s + t;
+        snprintf( t, sizeof( t ), "%8.8lX/", (long unsigned) at( i )->GetTimeStamp() );
+        s += t;
     }
 
     return s;
@@ -467,25 +470,67 @@ SCH_SHEET* SCH_SHEET_PATH::FindSheetByName( const wxString& aSheetName )
 SCH_SHEET_LIST::SCH_SHEET_LIST( SCH_SHEET* aSheet )
 {
     m_isRootSheet = false;
+    m_pathIndexCount = 0;
+    m_humanReadableIndexCount = 0;
 
     if( aSheet != NULL )
         BuildSheetList( aSheet );
 }
 
 
-SCH_SHEET_PATH* SCH_SHEET_LIST::GetSheetByPath( const wxString aPath, bool aHumanReadable )
+void SCH_SHEET_LIST::buildPathIndex( bool aHumanReadable )
 {
-    wxString sheetPath;
+    PATH_INDEX& index = aHumanReadable ? m_humanReadableIndex : m_pathIndex;
+
+    index.clear();
 
+    // emplace() keeps the first sheet of duplicated paths, as the linear search did.
     for( unsigned i = 0; i < size(); i++ )
+        index.emplace( aHumanReadable ? at( i ).PathHumanReadable() : at( i ).Path(), i );
+
+    if( aHumanReadable )
+        m_humanReadableIndexCount = size();
+    else
+        m_pathIndexCount = size();
+}
+
+
+SCH_SHEET_PATH* SCH_SHEET_LIST::GetSheetByPath( const wxString aPath, bool aHumanReadable )
+{
+    // Each index is built on its first use: most lists are searched by one kind of path only
+    const PATH_INDEX& index = aHumanReadable ? m_humanReadableIndex : m_pathIndex;
+    unsigned indexedCount = aHumanReadable ? m_humanReadableIndexCount : m_pathIndexCount;
+    bool     rebuilt = false;
+
+    if( indexedCount != size() )
     {
-        sheetPath = ( aHumanReadable ) ? at( i ).PathHumanReadable() : at( i ).Path();
+        buildPathIndex( aHumanReadable );
+        rebuilt = true;
+    }
+
+    PATH_INDEX::const_iterator it = index.find( aPath );
+
+    if( rebuilt )
+        return ( it != index.end() ) ? &at( it->second ) : NULL;
+
+    // A sheet renamed or re-stamped after the index was built is still indexed by its old
+    // path: a miss, or a hit on a sheet whose path changed, is checked on a fresh index.
+    bool stale = ( it == index.end() );
+
+    if( !stale )
+    {
+        const SCH_SHEET_PATH& sheet = at( it->second );
 
-        if( sheetPath == aPath )
-            return &at( i );
+        stale = ( aHumanReadable ? sheet.PathHumanReadable() : sheet.Path() ) != aPath;
     }
 
-    return NULL;
+    if( stale )
+    {
+        buildPathIndex( aHumanReadable );
+        it = index.find( aPath );
+    }
+
+    return ( it != index.end() ) ? &at( it->second ) : NULL;
 }
 
 
@@ -496,6 +541,7 @@ void SCH_SHEET_LIST::BuildSheetList( SCH_SHEET* aSheet )
     if( aSheet == g_RootSheet )
         m_isRootSheet = true;
 
+    m_indexedCount = 0;
     m_currentSheetPath.push_back( aSheet );
 
     /**
@@ -34,6 +34,9 @@
 #include <base_struct.h>
 
 #include <map>
+#include <unordered_map>
+
+#include <wx/hashmap.h>
 
 
 /** Info about complex hierarchies handling:
@@ -334,9 +337,19 @@ typedef SCH_SHEET_PATHS::const_reverse_iterator  SCH_SHEET_PATHS_CRITER;
 class SCH_SHEET_LIST : public SCH_SHEET_PATHS
 {
 private:
+    typedef std::unordered_map<wxString, unsigned, wxStringHash, wxStringEqual> PATH_INDEX;
+
     bool            m_isRootSheet;
     SCH_SHEET_PATH  m_currentSheetPath;
 
+    PATH_INDEX      m_pathIndex;                ///< sheet index by Path()
+    PATH_INDEX      m_humanReadableIndex;       ///< sheet index by PathHumanReadable()
+    unsigned        m_pathIndexCount;           ///< number of sheets in m_pathIndex
+    unsigned        m_humanReadableIndexCount;  ///< number of sheets in m_humanReadableIndex
+
+    /// Builds the path index used by GetSheetByPath() for @a aHumanReadable paths, or not
+    void buildPathIndex( bool aHumanReadable );
+
 public:
 
     /**
@@ -353,6 +366,10 @@ public:
      * Function GetSheetByPath
      * returns a sheet matching the path name in \a aPath.
      *
+     * The paths of the sheets are hashed on the first search by this kind of path, and
+     * again when sheets were added to the list.  A path which is not found, or is found
+     * on a sheet whose path changed (renamed sheet), is searched again in a fresh index.
+     *
      * @param aPath A wxString object containing path of the sheet to get.
      * @param aHumanReadable True uses the human readable path for comparison.
      *                       False uses the timestamp generated path.
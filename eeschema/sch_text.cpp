@@ -675,7 +675,7 @@ bool SCH_TEXT::HitTest( const EDA_RECT& aRect, bool aContained, int aAccuracy )
 
 void SCH_TEXT::Plot( PLOTTER* aPlotter )
 {
-    static std::vector <wxPoint> Poly;
+    std::vector <wxPoint> Poly;
     COLOR4D  color = GetLayerColor( GetLayer() );
     int      thickness = GetPenSize();
 
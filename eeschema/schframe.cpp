@@ -53,6 +53,7 @@
 #include <eeschema_config.h>
 #include <sch_sheet.h>
 #include <sch_sheet_path.h>
+#include <sch_plot_job.h>
 #include "sim/sim_plot_frame.h"
 
 #include <invoke_sch_dialog.h>
@@ -730,32 +731,7 @@ double SCH_EDIT_FRAME::BestZoom()
 
 wxString SCH_EDIT_FRAME::GetUniqueFilenameForCurrentSheet()
 {
-    wxFileName fn = GetScreen()->GetFileName();
-
-    // Name is <root sheet filename>-<sheet path> and has no extension.
-    // However if filename is too long name is <sheet filename>-<sheet number>
-
-    #define FN_LEN_MAX 80   // A reasonable value for the short filename len
-
-    wxString filename = fn.GetName();
-    wxString sheetFullName =  m_CurrentSheet->PathHumanReadable();
-
-    // Remove the last '/' of the path human readable
-    // (and for the root sheet, make sheetFullName empty):
-    sheetFullName.RemoveLast();
-
-    sheetFullName.Trim( true );
-    sheetFullName.Trim( false );
-
-    // Convert path human readable separator to '-'
-    sheetFullName.Replace( wxT( "/" ), wxT( "-" ) );
-
-    if( ( filename.Len() + sheetFullName.Len() ) < FN_LEN_MAX )
-        filename += sheetFullName;
-    else
-        filename << wxT( "-" ) << GetScreen()->m_ScreenNumber;
-
-    return filename;
+    return SCH_PLOT_JOB::GetUniqueFileName( *m_CurrentSheet, GetScreen()->m_ScreenNumber );
 }
 
 
@@ -361,6 +361,164 @@ void CURSOR::UpdateReference()
 }
 
 
+void TRACE::SetData( const std::vector<double>& aX, const std::vector<double>& aY )
+{
+    if( m_cursor )
+        m_cursor->Update();
+
+    mpFXYVector::SetData( aX, aY );
+    buildEnvelope();
+}
+
+
+void TRACE::buildEnvelope()
+{
+    m_envelope.clear();
+
+    // The visible samples are found with a binary search, so the envelope is useful
+    // only for sorted X values (always the case for transient and AC analyses)
+    if( m_xs.size() < 2 * ENVELOPE_BLOCK || !std::is_sorted( m_xs.begin(), m_xs.end() ) )
+        return;
+
+    // Level 0 is computed from the samples
+    std::vector<ENVELOPE> level( ( m_ys.size() + ENVELOPE_BLOCK - 1 ) / ENVELOPE_BLOCK );
+
+    for( unsigned i = 0; i < level.size(); i++ )
+    {
+        unsigned first = i * ENVELOPE_BLOCK;
+        unsigned last = std::min<unsigned>( first + ENVELOPE_BLOCK, m_ys.size() );
+        ENVELOPE& entry = level[i];
+
+        entry.m_min = entry.m_max = first;
+
+        for( unsigned j = first + 1; j < last; j++ )
+        {
+            if( m_ys[j] < m_ys[entry.m_min] )
+                entry.m_min = j;
+
+            if( m_ys[j] > m_ys[entry.m_max] )
+                entry.m_max = j;
+        }
+    }
+
+    m_envelope.push_back( std::move( level ) );
+
+    // Each next level merges pairs of entries from the previous one
+    while( m_envelope.back().size() > 1 )
+    {
+        const std::vector<ENVELOPE>& prev = m_envelope.back();
+        std::vector<ENVELOPE> next( ( prev.size() + 1 ) / 2 );
+
+        for( unsigned i = 0; i < next.size(); i++ )
+        {
+            ENVELOPE& entry = next[i];
+            entry = prev[2 * i];
+
+            if( 2 * i + 1 < prev.size() )
+            {
+                const ENVELOPE& other = prev[2 * i + 1];
+
+                if( m_ys[other.m_min] < m_ys[entry.m_min] )
+                    entry.m_min = other.m_min;
+
+                if( m_ys[other.m_max] > m_ys[entry.m_max] )
+                    entry.m_max = other.m_max;
+            }
+        }
+
+        m_envelope.push_back( std::move( next ) );
+    }
+}
+
+
+void TRACE::Plot( wxDC& aDC, mpWindow& aWindow )
+{
+    if( !m_visible )
+        return;
+
+    if( m_envelope.empty() || !m_continuous )
+    {
+        mpFXYVector::Plot( aDC, aWindow );
+        return;
+    }
+
+    wxCoord startPx = m_drawOutsideMargins ? 0 : aWindow.GetMarginLeft();
+    wxCoord endPx   = m_drawOutsideMargins ? aWindow.GetScrX() : aWindow.GetScrX() - aWindow.GetMarginRight();
+    wxCoord minYpx  = m_drawOutsideMargins ? 0 : aWindow.GetMarginTop();
+    wxCoord maxYpx  = m_drawOutsideMargins ? aWindow.GetScrY() : aWindow.GetScrY() - aWindow.GetMarginBottom();
+
+    // Find the visible samples, plus one on each side to connect the trace to the plot borders
+    double minX = s2x( aWindow.p2x( startPx ) );
+    double maxX = s2x( aWindow.p2x( endPx ) );
+
+    if( minX > maxX )
+        std::swap( minX, maxX );
+
+    size_t first = std::lower_bound( m_xs.begin(), m_xs.end(), minX ) - m_xs.begin();
+    size_t last = std::upper_bound( m_xs.begin(), m_xs.end(), maxX ) - m_xs.begin();
+
+    if( first > 0 )
+        --first;
+
+    if( last < m_xs.size() )
+        ++last;
+
+    if( last - first < 2 )
+        return;
+
+    // Choose the coarsest envelope level that still has an entry for each pixel column,
+    // so there are 2 to 4 points drawn per pixel at any zoom level
+    const size_t width = std::max<wxCoord>( endPx - startPx, 1 );
+    int level = -1;
+
+    while( level + 1 < (int) m_envelope.size()
+            && ( last - first ) / ( (size_t) ENVELOPE_BLOCK << ( level + 1 ) ) >= width )
+    {
+        ++level;
+    }
+
+    std::vector<wxPoint> points;
+
+    auto addPoint = [&]( size_t aIdx )
+    {
+        points.emplace_back( aWindow.x2p( x2s( m_xs[aIdx] ) ), aWindow.y2p( y2s( m_ys[aIdx] ) ) );
+    };
+
+    if( level < 0 )
+    {
+        points.reserve( last - first );
+
+        for( size_t i = first; i < last; ++i )
+            addPoint( i );
+    }
+    else
+    {
+        const std::vector<ENVELOPE>& entries = m_envelope[level];
+        const size_t blockSize = (size_t) ENVELOPE_BLOCK << level;
+        const size_t firstEntry = first / blockSize;
+        const size_t lastEntry = ( last - 1 ) / blockSize;
+
+        points.reserve( 2 * ( lastEntry - firstEntry + 1 ) );
+
+        for( size_t i = firstEntry; i <= lastEntry; ++i )
+        {
+            const ENVELOPE& entry = entries[i];
+
+            // Keep the samples order, otherwise the trace would go back and forth
+            addPoint( std::min( entry.m_min, entry.m_max ) );
+
+            if( entry.m_min != entry.m_max )
+                addPoint( std::max( entry.m_min, entry.m_max ) );
+        }
+    }
+
+    aDC.SetPen( m_pen );
+    aDC.SetClippingRegion( startPx, minYpx, endPx - startPx + 1, maxYpx - minYpx + 1 );
+    aDC.DrawLines( points.size(), points.data() );
+    aDC.DestroyClippingRegion();
+}
+
+
 SIM_PLOT_PANEL::SIM_PLOT_PANEL( SIM_TYPE aType, wxWindow* parent, wxWindowID id, const wxPoint& pos,
                 const wxSize& size, long style, const wxString& name )
     : mpWindow( parent, id, pos, size, style ), m_colorIdx( 0 ),
@@ -100,13 +100,13 @@ public:
      * @param aX are the X axis values.
      * @param aY are the Y axis values.
      */
-    void SetData( const std::vector<double>& aX, const std::vector<double>& aY ) override
-    {
-        if( m_cursor )
-            m_cursor->Update();
+    void SetData( const std::vector<double>& aX, const std::vector<double>& aY ) override;
 
-        mpFXYVector::SetData( aX, aY );
-    }
+    /**
+     * @brief Draws the trace. Long traces are drawn from the min/max envelope, so there are
+     * only a few points per horizontal pixel regardless of the number of samples.
+     */
+    void Plot( wxDC& aDC, mpWindow& aWindow ) override;
 
     const std::vector<double>& GetDataX() const
     {
@@ -154,9 +154,25 @@ public:
     }
 
 protected:
+    ///> Indices of the lowest and the highest sample in a block of samples
+    struct ENVELOPE
+    {
+        unsigned m_min, m_max;
+    };
+
+    ///> Builds the min/max envelope pyramid for the current data set
+    void buildEnvelope();
+
     CURSOR* m_cursor;
     int m_flags;
     wxColour m_traceColour;
+
+    ///> Min/max envelope, level k groups ENVELOPE_BLOCK << k samples per entry.
+    ///> Empty if X values are not sorted, then the trace is drawn sample by sample.
+    std::vector<std::vector<ENVELOPE>> m_envelope;
+
+    ///> Number of samples in a level 0 envelope entry
+    static constexpr unsigned ENVELOPE_BLOCK = 8;
 };
 
 
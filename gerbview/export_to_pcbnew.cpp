@@ -27,6 +27,10 @@
  * @brief Export the layers to Pcbnew.
  */
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <fctsys.h>
@@ -41,6 +45,7 @@
 #include <select_layers_to_pcb.h>
 #include <build_version.h>
 #include <wildcards_and_files_ext.h>
+#include <profile.h>
 
 
 // Imported function
@@ -48,6 +53,22 @@ extern const wxString GetPCBDefaultLayerName( LAYER_NUM aLayerNumber );
 
 #define TO_PCB_UNIT( x ) ( x / IU_PER_MM)
 
+// Flashed items closer than this distance are exported as only one via
+#define VIA_SNAP_DISTANCE KiROUND( 0.001 * IU_PER_MM )
+
+
+/* A straight line (track or graphic line) waiting to be merged with
+ * the collinear lines of the same layer and width, before being written
+ */
+struct EXPORT_SEGMENT
+{
+    wxPoint     m_Start;
+    wxPoint     m_End;
+    int         m_Width;
+    LAYER_NUM   m_Layer;
+};
+
+
 /* A helper class to export a Gerber set of files to Pcbnew
  */
 class GBR_TO_PCB_EXPORTER
@@ -57,9 +78,17 @@ private:
     wxString                m_pcb_file_name;    // BOARD file to write to
     FILE*                   m_fp;               // the board file
     int                     m_pcbCopperLayersCount;
-    std::vector<wxPoint>    m_vias_coordinates; // list of already generated vias,
-                                                // used to export only once a via
-                                                // having a given coordinate
+
+    // already generated vias, hashed by cell of VIA_SNAP_DISTANCE size,
+    // used to export only once a via having a given coordinate
+    std::unordered_map<int64_t, std::vector<wxPoint>> m_viasGrid;
+
+    std::vector<EXPORT_SEGMENT> m_tracks;       // copper segments, merged before writing
+    std::vector<EXPORT_SEGMENT> m_lines;        // graphic lines, merged before writing
+
+    int                     m_gbrItemsCount;    // number of Gerber items read
+    int                     m_pcbItemsCount;    // number of items written to the board
+
 public:
     GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString& aFileName );
     ~GBR_TO_PCB_EXPORTER();
@@ -67,6 +96,9 @@ public:
     /**
      * Function ExportPcb
      * saves a board from a set of Gerber images.
+     * Collinear tracks and graphic lines are merged, and flashed items at the same
+     * position are exported as only one via. The export time and the number of
+     * exported items are shown in the status bar.
      */
     bool    ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLayers );
 
@@ -127,6 +159,27 @@ private:
     void    writeCopperLineItem( wxPoint& aStart, wxPoint& aEnd,
                                  int aWidth, LAYER_NUM aLayer );
 
+    /**
+     * function addCopperLineItem
+     * stores a track, to be merged with the other collinear tracks and written
+     * by writeMergedSegments()
+     */
+    void    addCopperLineItem( const wxPoint& aStart, const wxPoint& aEnd,
+                               int aWidth, LAYER_NUM aLayer );
+
+    /**
+     * function writeMergedSegments
+     * merges the stored tracks and graphic lines, and writes them to the board file
+     */
+    void    writeMergedSegments();
+
+    /**
+     * function hasViaAt
+     * @return true if a via was already exported at less than VIA_SNAP_DISTANCE
+     * from aPosition; otherwise stores aPosition as a new via and returns false.
+     */
+    bool    hasViaAt( const wxPoint& aPosition );
+
     /**
      * function writePcbHeader
      * Write a very basic header to the board file
@@ -141,6 +194,8 @@ GBR_TO_PCB_EXPORTER::GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString
     m_pcb_file_name     = aFileName;
     m_fp                = NULL;
     m_pcbCopperLayersCount = 2;
+    m_gbrItemsCount     = 0;
+    m_pcbItemsCount     = 0;
 }
 
 
@@ -204,6 +259,7 @@ void GERBVIEW_FRAME::ExportDataInPcbnewFormat( wxCommandEvent& event )
 bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLayers )
 {
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+    unsigned    startTime = GetRunningMicroSecs();
 
     m_fp = wxFopen( m_pcb_file_name, wxT( "wt" ) );
 
@@ -242,7 +298,10 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLa
         GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
 
         for( ; gerb_item; gerb_item = gerb_item->Next() )
+        {
             export_non_copper_item( gerb_item, pcb_layer_number );
+            m_gbrItemsCount++;
+        }
     }
 
     // Copper layers
@@ -261,13 +320,25 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLa
         GERBER_DRAW_ITEM* gerb_item = gerber->GetItemsList();
 
         for( ; gerb_item; gerb_item = gerb_item->Next() )
+        {
             export_copper_item( gerb_item, pcb_layer_number );
+            m_gbrItemsCount++;
+        }
     }
 
+    writeMergedSegments();
+
     fprintf( m_fp, ")\n" );
 
     fclose( m_fp );
     m_fp = NULL;
+
+    wxString msg;
+    msg.Printf( _( "Exported %d Gerber items as %d board items in %.3f s" ),
+                m_gbrItemsCount, m_pcbItemsCount,
+                (double) ( GetRunningMicroSecs() - startTime ) / 1e6 );
+    m_gerbview_frame->SetStatusText( msg, 0 );
+
     return true;
 }
 
@@ -299,7 +370,16 @@ void GBR_TO_PCB_EXPORTER::export_non_copper_item( GERBER_DRAW_ITEM* aGbrItem, LA
     // Reverse Y axis:
     seg_start.y = -seg_start.y;
     seg_end.y = -seg_end.y;
-    writePcbLineItem( isArc, seg_start, seg_end, aGbrItem->m_Size.x, aLayer, angle );
+
+    if( isArc )
+    {
+        writePcbLineItem( isArc, seg_start, seg_end, aGbrItem->m_Size.x, aLayer, angle );
+    }
+    else
+    {
+        EXPORT_SEGMENT line = { seg_start, seg_end, aGbrItem->m_Size.x, aLayer };
+        m_lines.push_back( line );
+    }
 }
 
 
@@ -336,7 +416,7 @@ void GBR_TO_PCB_EXPORTER::export_segline_copper_item( GERBER_DRAW_ITEM* aGbrItem
     seg_start.y = -seg_start.y;
     seg_end.y = -seg_end.y;
 
-    writeCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
+    addCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
 }
 
 
@@ -350,6 +430,140 @@ void GBR_TO_PCB_EXPORTER::writeCopperLineItem( wxPoint& aStart, wxPoint& aEnd,
                   Double2Str( TO_PCB_UNIT(aEnd.y) ).c_str(),
                   Double2Str( TO_PCB_UNIT( aWidth ) ).c_str(),
                   TO_UTF8( GetPCBDefaultLayerName( aLayer ) ) );
+    m_pcbItemsCount++;
+}
+
+
+void GBR_TO_PCB_EXPORTER::addCopperLineItem( const wxPoint& aStart, const wxPoint& aEnd,
+                                             int aWidth, LAYER_NUM aLayer )
+{
+    EXPORT_SEGMENT track = { aStart, aEnd, aWidth, aLayer };
+    m_tracks.push_back( track );
+}
+
+
+static int64_t gcd64( int64_t a, int64_t b )
+{
+    while( b )
+    {
+        int64_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+
+/* Merges the collinear segments of same layer and width which overlap or touch.
+ * Segments are grouped by their supporting line (a reduced direction vector and the
+ * cross product of a point with this direction, both exact integers), then merged
+ * as intervals along the direction.
+ */
+static void mergeCollinearSegments( std::vector<EXPORT_SEGMENT>& aSegments )
+{
+    typedef std::tuple<LAYER_NUM, int, int64_t, int64_t, int64_t> LINE_KEY;
+
+    struct INTERVAL
+    {
+        int64_t tStart, tEnd;       // position of the ends along the direction
+        wxPoint start, end;
+    };
+
+    std::map<LINE_KEY, std::vector<INTERVAL>> lines;
+    std::vector<EXPORT_SEGMENT> merged;
+
+    for( const EXPORT_SEGMENT& seg : aSegments )
+    {
+        int64_t dx = (int64_t) seg.m_End.x - seg.m_Start.x;
+        int64_t dy = (int64_t) seg.m_End.y - seg.m_Start.y;
+
+        if( dx == 0 && dy == 0 )    // a dot: nothing to merge
+        {
+            merged.push_back( seg );
+            continue;
+        }
+
+        int64_t g = gcd64( std::abs( dx ), std::abs( dy ) );
+        dx /= g;
+        dy /= g;
+
+        if( dx < 0 || ( dx == 0 && dy < 0 ) )
+        {
+            dx = -dx;
+            dy = -dy;
+        }
+
+        int64_t offset = dx * seg.m_Start.y - dy * seg.m_Start.x;
+
+        INTERVAL interval;
+        interval.tStart = dx * seg.m_Start.x + dy * seg.m_Start.y;
+        interval.tEnd   = dx * seg.m_End.x + dy * seg.m_End.y;
+        interval.start  = seg.m_Start;
+        interval.end    = seg.m_End;
+
+        if( interval.tStart > interval.tEnd )
+        {
+            std::swap( interval.tStart, interval.tEnd );
+            std::swap( interval.start, interval.end );
+        }
+
+        lines[ LINE_KEY( seg.m_Layer, seg.m_Width, dx, dy, offset ) ].push_back( interval );
+    }
+
+    for( auto& line : lines )
+    {
+        std::vector<INTERVAL>& intervals = line.second;
+
+        std::sort( intervals.begin(), intervals.end(),
+                   []( const INTERVAL& a, const INTERVAL& b ) { return a.tStart < b.tStart; } );
+
+        EXPORT_SEGMENT seg;
+        seg.m_Layer = std::get<0>( line.first );
+        seg.m_Width = std::get<1>( line.first );
+
+        INTERVAL current = intervals[0];
+
+        for( unsigned ii = 1; ii <= intervals.size(); ii++ )
+        {
+            if( ii < intervals.size() && intervals[ii].tStart <= current.tEnd )
+            {
+                if( intervals[ii].tEnd > current.tEnd )
+                {
+                    current.tEnd = intervals[ii].tEnd;
+                    current.end = intervals[ii].end;
+                }
+
+                continue;
+            }
+
+            seg.m_Start = current.start;
+            seg.m_End   = current.end;
+            merged.push_back( seg );
+
+            if( ii < intervals.size() )
+                current = intervals[ii];
+        }
+    }
+
+    aSegments.swap( merged );
+}
+
+
+void GBR_TO_PCB_EXPORTER::writeMergedSegments()
+{
+    mergeCollinearSegments( m_lines );
+
+    for( EXPORT_SEGMENT& line : m_lines )
+        writePcbLineItem( false, line.m_Start, line.m_End, line.m_Width, line.m_Layer );
+
+    mergeCollinearSegments( m_tracks );
+
+    for( EXPORT_SEGMENT& track : m_tracks )
+        writeCopperLineItem( track.m_Start, track.m_End, track.m_Width, track.m_Layer );
+
+    m_lines.clear();
+    m_tracks.clear();
 }
 
 
@@ -390,7 +604,7 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
         // Reverse Y axis:
         seg_start.y = -seg_start.y;
         seg_end.y = -seg_end.y;
-        writeCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
+        addCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
         curr_start = curr_end;
     }
 
@@ -401,7 +615,7 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
         // Reverse Y axis:
         seg_start.y = -seg_start.y;
         seg_end.y = -seg_end.y;
-        writeCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
+        addCopperLineItem( seg_start, seg_end, aGbrItem->m_Size.x, aLayer );
     }
 }
 
@@ -414,13 +628,8 @@ void GBR_TO_PCB_EXPORTER::export_segarc_copper_item( GERBER_DRAW_ITEM* aGbrItem,
 void GBR_TO_PCB_EXPORTER::export_flashed_copper_item( GERBER_DRAW_ITEM* aGbrItem )
 {
     // First, explore already created vias, before creating a new via
-    for( unsigned ii = 0; ii < m_vias_coordinates.size(); ii++ )
-    {
-        if( m_vias_coordinates[ii] == aGbrItem->m_Start ) // Already created
-            return;
-    }
-
-    m_vias_coordinates.push_back( aGbrItem->m_Start );
+    if( hasViaAt( aGbrItem->m_Start ) )     // Already created
+        return;
 
     wxPoint via_pos = aGbrItem->m_Start;
     int width   = (aGbrItem->m_Size.x + aGbrItem->m_Size.y) / 2;
@@ -436,6 +645,53 @@ void GBR_TO_PCB_EXPORTER::export_flashed_copper_item( GERBER_DRAW_ITEM* aGbrItem
     fprintf( m_fp, " (layers %s %s))\n",
                   TO_UTF8( GetPCBDefaultLayerName( F_Cu ) ),
                   TO_UTF8( GetPCBDefaultLayerName( B_Cu ) ) );
+    m_pcbItemsCount++;
+}
+
+
+bool GBR_TO_PCB_EXPORTER::hasViaAt( const wxPoint& aPosition )
+{
+    const int cellSize = std::max( VIA_SNAP_DISTANCE, 1 );
+
+    auto cellIndex = [cellSize]( int aCoord ) -> int64_t
+    {
+        // Floor division, so the cells do not change size around 0
+        return aCoord >= 0 ? aCoord / cellSize : -( ( cellSize - 1 - aCoord ) / cellSize );
+    };
+
+    auto cellKey = []( int64_t aCellX, int64_t aCellY ) -> int64_t
+    {
+        return ( aCellX << 32 ) ^ ( aCellY & 0xFFFFFFFF );
+    };
+
+    const int64_t cx = cellIndex( aPosition.x );
+    const int64_t cy = cellIndex( aPosition.y );
+    const double  snapDist2 = (double) VIA_SNAP_DISTANCE * VIA_SNAP_DISTANCE;
+
+    // A via closer than the cell size is in this cell or one of its neighbours
+    for( int64_t ix = cx - 1; ix <= cx + 1; ix++ )
+    {
+        for( int64_t iy = cy - 1; iy <= cy + 1; iy++ )
+        {
+            auto cell = m_viasGrid.find( cellKey( ix, iy ) );
+
+            if( cell == m_viasGrid.end() )
+                continue;
+
+            for( const wxPoint& via : cell->second )
+            {
+                double dx = via.x - aPosition.x;
+                double dy = via.y - aPosition.y;
+
+                if( dx * dx + dy * dy <= snapDist2 )
+                    return true;
+            }
+        }
+    }
+
+    m_viasGrid[ cellKey( cx, cy ) ].push_back( aPosition );
+
+    return false;
 }
 
 void GBR_TO_PCB_EXPORTER::writePcbHeader( LAYER_NUM* aLayerLookUpTable )
@@ -502,4 +758,6 @@ void GBR_TO_PCB_EXPORTER::writePcbLineItem( bool aIsArc, wxPoint& aStart, wxPoin
                  Double2Str( TO_PCB_UNIT( aWidth ) ).c_str()
                  );
     }
+
+    m_pcbItemsCount++;
 }
@@ -27,6 +27,8 @@
 
 #include <class_eda_rect.h>
 
+#include <mutex>
+
 #include <gal/stroke_font.h>
 #include <gal/graphics_abstraction_layer.h>
 #include <newstroke_font.h>
@@ -75,6 +77,7 @@ public:
         m_plotter = NULL;
         m_callback = NULL;
         m_isClipped = false;
+        m_transform.m_rotAngle = 0.0;
     }
 
     void SetPlotter( PLOTTER* aPlotter )
@@ -162,6 +165,10 @@ private:
 };
 
 
+/// basic_gal keeps the text attributes set by its last user: lock basic_gal_mutex around
+/// the code setting and using them, since texts are also sized by worker threads.
+/// A PLOTTER strokes its texts with its own BASIC_GAL (see PLOTTER::GetTextGal()).
 extern BASIC_GAL basic_gal;
+extern std::mutex basic_gal_mutex;
 
 #endif      // define BASIC_GAL_H
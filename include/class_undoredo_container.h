@@ -71,8 +71,10 @@ enum UNDO_REDO_T {
     UR_WIRE_IMAGE,          // Specific to Eeschema for handling wires changes.
     UR_LIBEDIT,             // Specific to the component editor (libedit creates a full copy
                             // of the current component when changed)
-    UR_EXCHANGE_T           ///< Use for changing the schematic text type where swapping
+    UR_EXCHANGE_T,          ///< Use for changing the schematic text type where swapping
                             ///< data structure is insufficient to restor the change.
+    UR_LAYER_REMAPPED       ///< Board items moved to other layers by a translation table
+                            ///< (PICKED_ITEMS_LIST status only), undo by the inverse table.
 };
 
 
@@ -133,6 +135,9 @@ public:
                                    * UR_UNSPECIFIED */
     wxPoint m_TransformPoint;     /* used to undo redo command by the same command: usually
                                    * need to know the rotate point or the move vector */
+    std::vector<int> m_LayerMap;  /* UR_LAYER_REMAPPED command: the new layer of each layer.
+                                   * The pickers are the items which cannot be restored by
+                                   * the inverse table */
 
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
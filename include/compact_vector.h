@@ -0,0 +1,185 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef COMPACT_VECTOR_H
+#define COMPACT_VECTOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Class COMPACT_VECTOR
+ * is a vector of trivially copyable elements taking a single pointer in the object holding
+ * it.  The size and the capacity are stored in front of the elements, in the same heap block,
+ * and an empty vector does not allocate anything.
+ *
+ * It is meant for members of items existing in large numbers (e.g. board items), which are
+ * usually empty or short: a std::vector costs three pointers per item even when empty.
+ * Only the subset of the std::vector interface used by these members is provided.
+ */
+template <typename T>
+class COMPACT_VECTOR
+{
+    static_assert( std::is_trivially_copyable<T>::value,
+                   "COMPACT_VECTOR elements are moved with memcpy" );
+
+public:
+    typedef T           value_type;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+
+    COMPACT_VECTOR() : m_block( nullptr ) {}
+
+    COMPACT_VECTOR( const COMPACT_VECTOR& aOther ) : m_block( nullptr )
+    {
+        assign( aOther.begin(), aOther.size() );
+    }
+
+    COMPACT_VECTOR( COMPACT_VECTOR&& aOther ) : m_block( aOther.m_block )
+    {
+        aOther.m_block = nullptr;
+    }
+
+    ~COMPACT_VECTOR()
+    {
+        free( m_block );
+    }
+
+    COMPACT_VECTOR& operator=( const COMPACT_VECTOR& aOther )
+    {
+        if( this != &aOther )
+            assign( aOther.begin(), aOther.size() );
+
+        return *this;
+    }
+
+    COMPACT_VECTOR& operator=( COMPACT_VECTOR&& aOther )
+    {
+        if( this != &aOther )
+        {
+            free( m_block );
+            m_block = aOther.m_block;
+            aOther.m_block = nullptr;
+        }
+
+        return *this;
+    }
+
+    COMPACT_VECTOR& operator=( const std::vector<T>& aOther )
+    {
+        assign( aOther.data(), aOther.size() );
+        return *this;
+    }
+
+    size_t size() const     { return m_block ? m_block->m_size : 0; }
+    bool empty() const      { return size() == 0; }
+
+    T& operator[]( size_t aIndex )              { return items()[aIndex]; }
+    const T& operator[]( size_t aIndex ) const  { return items()[aIndex]; }
+
+    iterator begin()                { return items(); }
+    iterator end()                  { return items() + size(); }
+    const_iterator begin() const    { return items(); }
+    const_iterator end() const      { return items() + size(); }
+
+    void push_back( const T& aItem )
+    {
+        size_t count = size();
+
+        // aItem may refer to one of our own elements, which reserve() would free
+        const T item = aItem;
+
+        if( !m_block || count == m_block->m_capacity )
+            reserve( count ? count * 2 : 2 );
+
+        items()[count] = item;
+        m_block->m_size = count + 1;
+    }
+
+    /// Releases the memory too: the lists are usually rebuilt from scratch or left empty.
+    void clear()
+    {
+        free( m_block );
+        m_block = nullptr;
+    }
+
+    void reserve( size_t aCapacity )
+    {
+        if( aCapacity <= ( m_block ? m_block->m_capacity : 0 ) )
+            return;
+
+        size_t count = size();
+        BLOCK* block = static_cast<BLOCK*>( realloc( m_block, blockSize( aCapacity ) ) );
+
+        if( !block )
+            throw std::bad_alloc();
+
+        block->m_size = count;
+        block->m_capacity = aCapacity;
+        m_block = block;
+    }
+
+private:
+    struct BLOCK
+    {
+        unsigned    m_size;
+        unsigned    m_capacity;
+    };
+
+    static size_t headerSize()
+    {
+        // Keep the elements aligned
+        return ( sizeof( BLOCK ) + alignof( T ) - 1 ) / alignof( T ) * alignof( T );
+    }
+
+    static size_t blockSize( size_t aCapacity )
+    {
+        return headerSize() + aCapacity * sizeof( T );
+    }
+
+    T* items() const
+    {
+        return m_block ? reinterpret_cast<T*>( reinterpret_cast<char*>( m_block ) + headerSize() )
+                       : nullptr;
+    }
+
+    void assign( const T* aItems, size_t aCount )
+    {
+        clear();
+
+        if( aCount == 0 )
+            return;
+
+        reserve( aCount );
+        memcpy( items(), aItems, aCount * sizeof( T ) );
+        m_block->m_size = aCount;
+    }
+
+    BLOCK*  m_block;
+};
+
+#endif  // COMPACT_VECTOR_H
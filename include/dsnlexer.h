@@ -26,6 +26,8 @@
 #define DSNLEXER_H_
 
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include <string>
 #include <vector>
 #include <hashtables.h>
@@ -42,6 +44,80 @@ struct KEYWORD
     const char* name;       ///< unique keyword.
     int         token;      ///< a zero based index into an array of KEYWORDs
 };
+
+
+/**
+ * Class KEYWORD_PERFECT_HASH
+ * is a minimal perfect hash of a KEYWORD table: any token text is looked up with one hash
+ * of the text, two table reads and at most one string comparison, with no allocation.
+ *
+ * The tables are built with the "hash and displace" method the first time a KEYWORD table is
+ * used and are then shared by every lexer of that table, see Get().  The KEYWORD tables
+ * generated by CMake are constant for the life of the process, which makes this safe.
+ */
+class KEYWORD_PERFECT_HASH
+{
+public:
+    KEYWORD_PERFECT_HASH( const KEYWORD* aKeywords, unsigned aCount );
+
+    /**
+     * Function Find
+     * @param aText is the token text, which does not need to be nul terminated.
+     * @param aLength is the length of @a aText.
+     * @return int - the token of the keyword matching the text, or -1 if none.
+     */
+    int Find( const char* aText, size_t aLength ) const
+    {
+        if( m_slots.empty() )
+            return -1;
+
+        uint64_t hash = hashText( aText, aLength );
+        int32_t  seed = m_seeds[ hash % m_seeds.size() ];
+        unsigned slot = seed < 0 ? -seed - 1 : displace( hash, seed ) % m_slots.size();
+
+        const KEYWORD* keyword = m_slots[slot];
+
+        if( m_lengths[slot] == aLength && !memcmp( keyword->name, aText, aLength ) )
+            return keyword->token;
+
+        return -1;
+    }
+
+    /**
+     * Function Get
+     * returns the perfect hash of @a aKeywords, building it on first use.  Thread safe.
+     */
+    static const KEYWORD_PERFECT_HASH* Get( const KEYWORD* aKeywords, unsigned aCount );
+
+private:
+    /// 64 bit FNV-1a, over a length rather than up to a nul.
+    static uint64_t hashText( const char* aText, size_t aLength )
+    {
+        uint64_t hash = 14695981039346656037ULL;
+
+        for( const char* end = aText + aLength; aText < end; ++aText )
+        {
+            hash ^= (unsigned char) *aText;
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    /// Rehash of a bucket member, for the displacement @a aSeed of its bucket.
+    static uint64_t displace( uint64_t aHash, int32_t aSeed )
+    {
+        uint64_t x = aHash + ( (uint64_t) aSeed + 1 ) * 0x9E3779B97F4A7C15ULL;
+
+        x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL;
+        return x ^ ( x >> 31 );
+    }
+
+    std::vector<int32_t>         m_seeds;   ///< per bucket: displacement, or -1 - slot if < 0
+    std::vector<const KEYWORD*>  m_slots;   ///< the keyword stored in each slot
+    std::vector<size_t>          m_lengths; ///< the length of the keyword in each slot
+};
 #endif
 
 // something like this macro can be used to help initialize a KEYWORD table.
@@ -108,9 +184,14 @@ protected:
     int                 curTok;                 ///< the current token obtained on last NextTok()
     std::string         curText;                ///< the text of the current token
 
+    double              curNumber;              ///< value of a DSN_NUMBER, if curNumberValid
+    long                curInteger;             ///< value of an integral DSN_NUMBER, if curIntegerValid
+    bool                curNumberValid;         ///< curNumber was converted in place by NextTok()
+    bool                curIntegerValid;        ///< curInteger was converted in place by NextTok()
+
     const KEYWORD*      keywords;               ///< table sorted by CMake for bsearch()
     unsigned            keywordCount;           ///< count of keywords table
-    KEYWORD_MAP         keyword_hash;           ///< fast, specialized "C string" hashtable
+    const KEYWORD_PERFECT_HASH* keywordHash;    ///< shared perfect hash of keywords[]
 
     void init();
 
@@ -136,13 +217,19 @@ protected:
 
     /**
      * Function findToken
-     * takes aToken string and looks up the string in the keywords table.
+     * takes aToken text and looks it up in the keywords table.
      *
-     * @param aToken is a string to lookup in the keywords table.
+     * @param aToken is the text to lookup in the keywords table, not nul terminated.
+     * @param aLength is the length of @a aToken.
      * @return int - with a value from the enum DSN_T matching the keyword text,
      *         or DSN_SYMBOL if @a aToken is not in the kewords table.
      */
-    int findToken( const std::string& aToken );
+    int findToken( const char* aToken, size_t aLength )
+    {
+        int tok = keywordHash->Find( aToken, aLength );
+
+        return tok < 0 ? DSN_SYMBOL : tok;
+    }
 
     bool isStringTerminator( char cc )
     {
@@ -481,6 +568,40 @@ public:
         return curText.c_str();
     }
 
+    /**
+     * Function CurNumber
+     * gives the value of the current token if it is a DSN_NUMBER converted by NextTok()
+     * straight from the input line.  NextTok() only converts the numbers it can convert
+     * exactly, i.e. with the same result as strtod() in the "C" locale, which is the case of
+     * all the numbers written by KiCad.  Callers fall back to strtod() on CurText() otherwise.
+     * @param aValue receives the value.
+     * @return bool - true if @a aValue was set.
+     */
+    bool CurNumber( double& aValue ) const
+    {
+        if( curTok != DSN_NUMBER || !curNumberValid )
+            return false;
+
+        aValue = curNumber;
+        return true;
+    }
+
+    /**
+     * Function CurInteger
+     * is the counterpart of CurNumber() for a DSN_NUMBER without fraction or exponent which
+     * fits a long, giving the same result as strtol( CurText(), NULL, 10 ).
+     * @param aValue receives the value.
+     * @return bool - true if @a aValue was set.
+     */
+    bool CurInteger( long& aValue ) const
+    {
+        if( curTok != DSN_NUMBER || !curIntegerValid )
+            return false;
+
+        aValue = curInteger;
+        return true;
+    }
+
     /**
      * Function CurStr
      * returns a reference to current token in std::string form.
@@ -42,6 +42,7 @@
 #endif
 
 
+#include <ctime>
 #include <string>
 #include <curl/curl.h>
 #include <kicad_curl/kicad_curl.h>
@@ -141,6 +142,85 @@ public:
         return false;
     }
 
+    /**
+     * Function SetIfModifiedSince
+     * makes the request conditional: the content is not transferred if it was not modified
+     * since aTime.  Works for HTTP(s) and file:// URLs, use IsConditionUnmet() to know if
+     * the content was transferred.
+     *
+     * @param aTime is the modification time of the copy of the content held by the caller
+     * @return bool - True if successful, false if not
+     */
+    bool SetIfModifiedSince( time_t aTime )
+    {
+        if( SetOption<long>( CURLOPT_TIMECONDITION, CURL_TIMECOND_IFMODSINCE ) == CURLE_OK &&
+            SetOption<long>( CURLOPT_TIMEVALUE, (long) aTime ) == CURLE_OK )
+        {
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Function SetFetchFileTime
+     * asks for the modification time of the requested content, see GetFileTime().
+     *
+     * @param aFetch is a boolean where true will request the modification time
+     * @return bool - True if successful, false if not
+     */
+    bool SetFetchFileTime( bool aFetch )
+    {
+        if( SetOption<long>( CURLOPT_FILETIME, (aFetch ? 1 : 0) ) == CURLE_OK )
+        {
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Function GetResponseCode
+     * returns the HTTP(s) status code of the last request, 0 for protocols without one.
+     */
+    long GetResponseCode()
+    {
+        long code = 0;
+        curl_easy_getinfo( m_CURL, CURLINFO_RESPONSE_CODE, &code );
+        return code;
+    }
+
+    /**
+     * Function IsConditionUnmet
+     * returns true if the last request was made conditional by SetIfModifiedSince() and
+     * the content was not transferred because it was not modified.
+     */
+    bool IsConditionUnmet()
+    {
+        long unmet = 0;
+        curl_easy_getinfo( m_CURL, CURLINFO_CONDITION_UNMET, &unmet );
+        return unmet != 0;
+    }
+
+    /**
+     * Function GetFileTime
+     * returns the modification time of the requested content, or -1 if it is unknown.
+     * SetFetchFileTime( true ) must be called before Perform().
+     */
+    time_t GetFileTime()
+    {
+        long filetime = -1;
+        curl_easy_getinfo( m_CURL, CURLINFO_FILETIME, &filetime );
+        return (time_t) filetime;
+    }
+
+    /**
+     * Function GetResponseHeader
+     * returns the value of a header of the last response, with the surrounding white space
+     * removed, or an empty string if the header was not received.
+     *
+     * @param aName is the header name without the colon, it is not case sensitive
+     */
+    std::string GetResponseHeader( const std::string& aName ) const;
+
     /**
      * Function GetErrorText
      * fetches CURL's "friendly" error string for a given error code
@@ -179,6 +259,7 @@ private:
     CURL*           m_CURL;
     curl_slist*     m_headers;
     std::string     m_buffer;
+    std::string     m_responseHeaders;  ///< raw headers of the last response
 };
 
 #endif // KICAD_CURL_EASY_H_
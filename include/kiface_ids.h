@@ -44,6 +44,13 @@ enum KIFACE_ADDR_ID : int
      * Caller takes ownership
      */
     KIFACE_G_FOOTPRINT_TABLE, ///<
+
+    /**
+     * Return the PROJECT_PRELOADER of the KIFACE, if it has one.
+     * Type is PROJECT_PRELOADER*
+     * Static instance, caller does not take ownership
+     */
+    KIFACE_PROJECT_PRELOADER,
 };
 
 #endif // KIFACE_IDS
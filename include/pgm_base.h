@@ -32,6 +32,7 @@
 #define  PGM_BASE_H_
 
 #include <map>
+#include <mutex>
 #include <wx/filename.h>
 #include <search_stack.h>
 #include <wx/gdicmn.h>
@@ -42,6 +43,7 @@ class wxSingleInstanceChecker;
 class wxApp;
 class wxMenu;
 class wxWindow;
+class TASK_SCHEDULER;
 
 
 // inter program module calling
@@ -292,6 +294,13 @@ public:
      */
     VTBL_ENTRY wxApp&   App();
 
+    /**
+     * Function GetTaskScheduler
+     * returns the thread pool shared by all the parallel jobs of the process, whatever
+     * KIFACE they run in.  It is created on first use.
+     */
+    VTBL_ENTRY TASK_SCHEDULER& GetTaskScheduler();
+
     //----</Cross Module API>----------------------------------------------------
 
     static const wxChar workingDirKey[];
@@ -383,6 +392,10 @@ protected:
 
     /// Flag to indicate if the environment variable overwrite warning dialog should be shown.
     bool            m_show_env_var_dialog;
+
+    /// The process-wide thread pool, see GetTaskScheduler().
+    TASK_SCHEDULER* m_task_scheduler;
+    std::mutex      m_task_scheduler_mutex;
 };
 
 
@@ -32,6 +32,7 @@
 #ifndef PLOT_COMMON_H_
 #define PLOT_COMMON_H_
 
+#include <memory>
 #include <vector>
 #include <math/box2.h>
 #include <drawtxt.h>
@@ -40,6 +41,12 @@
 
 class SHAPE_POLY_SET;
 class GBR_NETLIST_METADATA;
+class BASIC_GAL;
+
+namespace KIGFX
+{
+    class GAL_DISPLAY_OPTIONS;
+}
 
 /**
  * Enum PlotFormat
@@ -89,6 +96,11 @@ private:
     double m_dashMarkLength_mm ;     ///< Dashed line parameter in mm: segment
     double m_dashGapLength_mm;       ///< Dashed line parameter in mm: gap
 
+    /// The GAL stroking the texts of this plotter and its display options, created on
+    /// first use by GetTextGal().  The options must outlive the GAL, which observes them.
+    std::unique_ptr<KIGFX::GAL_DISPLAY_OPTIONS> m_textGalOptions;
+    std::unique_ptr<BASIC_GAL>                  m_textGal;
+
 public:
     // These values are used as flag for pen or aperture selection
     static const int DO_NOT_SET_LINE_WIDTH = -2;    // Skip selection
@@ -374,6 +386,13 @@ public:
                        bool                        aMultilineAllowed = false,
                        void* aData = NULL );
 
+    /**
+     * Function GetTextGal
+     * @return the BASIC_GAL used by DrawGraphicText() to stroke the texts of this plotter.
+     * Each plotter has its own one, so several plotters can plot texts in parallel threads.
+     */
+    BASIC_GAL& GetTextGal();
+
     /**
      * Draw a marker (used for the drill map)
      */
@@ -822,6 +841,28 @@ public:
     virtual void SetCurrentLineWidth( int width, void* aData = NULL ) override;
     virtual void SetDash( bool dashed ) override;
 
+    /**
+     * Like StartPlot(), but without opening the first page: the pages are
+     * then added with AddPage()
+     */
+    bool StartDocument();
+
+    /**
+     * Starts a page on a plotter without output file. The page is plotted as
+     * usual, then ClosePageStream() returns it compressed, ready to be added
+     * to the document of another plotter with AddPage().  The pages of a
+     * document can so be plotted and compressed in parallel, each one by its
+     * own plotter.
+     */
+    void StartPageStream();
+    std::string ClosePageStream();
+
+    /**
+     * Adds a page made by StartPageStream()/ClosePageStream() to the document,
+     * with the current page settings. No page must be open.
+     */
+    void AddPage( const std::string& aPageStream );
+
     /** PDF can have multiple pages, so SetPageSettings can be called
      * with the outputFile open (but not inside a page stream!) */
     virtual void SetPageSettings( const PAGE_INFO& aPageSettings ) override;
@@ -864,6 +905,11 @@ protected:
     void closePdfObject();
     int startPdfStream(int handle = -1);
     void closePdfStream();
+    int beginStreamObject( int handle );
+    void endStreamObject( const std::string& aData );
+    std::string compressWorkFile();
+    void startPageContent();
+    void emitPageObject();
     int pageTreeHandle;		 /// Handle to the root of the page tree object
     int fontResDictHandle;	 /// Font resource dictionary
     std::vector<int> pageHandles;/// Handles to the page objects
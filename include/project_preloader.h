@@ -0,0 +1,73 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PROJECT_PRELOADER_H
+#define PROJECT_PRELOADER_H
+
+class KIWAY;
+class TASK_GROUP;
+
+#define VTBL_ENTRY      virtual
+
+
+/**
+ * Class PROJECT_PRELOADER
+ * is implemented by the KIFACEs able to load ahead of time the project data their
+ * editors need: library tables, library caches...  The KiCad project manager runs them
+ * in the background as soon as a project is opened, so the editors open without having to
+ * read any library.  A KIFACE returns its PROJECT_PRELOADER through
+ * KIFACE::IfaceOrAddress( KIFACE_PROJECT_PRELOADER ).
+ *
+ * The project manager guarantees that no KIWAY_PLAYER of the project is opened and that
+ * the project does not change between PreloadProject() and PreloadFinish().
+ */
+class PROJECT_PRELOADER
+{
+public:
+    virtual ~PROJECT_PRELOADER() {}
+
+    /**
+     * Function PreloadProject
+     * is called from the main thread once the project is opened.  It loads what must be
+     * loaded from the main thread, typically the PROJECT elements, and queues the remaining
+     * work in @a aTasks.  The tasks run on worker threads: they must not use the UI, wxLog
+     * or wxConfig, and must not create nor delete PROJECT elements.  Errors are not
+     * reported: the editors report them when they load what could not be preloaded.
+     *
+     * Each KIFACE links its own LOCALE_IO counter, and a LOCALE_IO switching the locale
+     * while another task parses breaks the parse.  The tasks may parse files only if this
+     * function holds a LOCALE_IO, created in the KIFACE itself, until PreloadFinish().
+     */
+    VTBL_ENTRY void PreloadProject( KIWAY& aKiway, TASK_GROUP& aTasks ) = 0;
+
+    /**
+     * Function PreloadFinish
+     * is called from the main thread once all the tasks are done, before an editor opens or
+     * the project changes, to hand the results over to the PROJECT.  The preloaders are
+     * finished in the reverse order they were started, so their LOCALE_IOs nest.
+     * @param aCancelled is true if the tasks were cancelled (project closed, or skipped by
+     * the user), the results should be dropped.
+     */
+    VTBL_ENTRY void PreloadFinish( KIWAY& aKiway, bool aCancelled ) = 0;
+};
+
+#endif  // PROJECT_PRELOADER_H
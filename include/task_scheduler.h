@@ -0,0 +1,192 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Class TASK_SCHEDULER
+ * is a bounded pool of worker threads shared by all the parallel code paths of a process.
+ *
+ * Every worker owns a task deque: tasks submitted from a worker go to the back of its own
+ * deque and are popped LIFO, idle workers steal from the front of the other deques.  Tasks
+ * submitted from any other thread go to a shared injection queue.  Nested and concurrent jobs
+ * (library loading, 3D board conversion, zone filling...) therefore never run on more than
+ * WorkerCount() threads plus the threads waiting for them.
+ *
+ * The process-wide instance is owned by PGM_BASE, see DefaultTaskScheduler().  Tasks should
+ * be grouped in a TASK_GROUP rather than submitted directly.
+ */
+class TASK_SCHEDULER
+{
+public:
+    typedef std::function<void()> TASK;
+
+    /**
+     * @param aWorkerCount is the number of worker threads, 0 to use one per hardware thread.
+     */
+    TASK_SCHEDULER( unsigned aWorkerCount = 0 );
+    ~TASK_SCHEDULER();
+
+    TASK_SCHEDULER( const TASK_SCHEDULER& ) = delete;
+    TASK_SCHEDULER& operator=( const TASK_SCHEDULER& ) = delete;
+
+    unsigned WorkerCount() const { return m_workers.size(); }
+
+    /**
+     * Function Submit
+     * queues a task for execution by the pool.  The task must not throw.
+     */
+    void Submit( TASK aTask );
+
+    /**
+     * Function CurrentWorker
+     * @return the index of the worker running the calling thread, or -1 if the calling thread
+     * does not belong to this pool.
+     */
+    int CurrentWorker() const;
+
+private:
+    struct WORKER
+    {
+        std::deque<TASK> m_tasks;
+        std::mutex       m_mutex;
+        std::thread      m_thread;
+    };
+
+    bool popTask( int aWorker, TASK& aTask );
+    void workerLoop( unsigned aWorker );
+
+    std::vector<std::unique_ptr<WORKER>> m_workers;
+    std::vector<std::thread::id>         m_workerIds;
+
+    std::deque<TASK>        m_injected;
+    std::mutex              m_injectedMutex;
+
+    std::mutex              m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<int>        m_pending;      ///< number of queued (not yet started) tasks
+    std::atomic<bool>       m_quit;
+};
+
+
+/**
+ * Function DefaultTaskScheduler
+ * @return the process-wide scheduler, shared by all the KIFACEs.
+ */
+TASK_SCHEDULER& DefaultTaskScheduler();
+
+
+/**
+ * Class TASK_GROUP
+ * is a set of tasks run on a TASK_SCHEDULER which can be waited for, cancelled and
+ * monitored as a whole.
+ *
+ * The first exception thrown by a task cancels the group and is rethrown by Wait().  Once the
+ * group is cancelled, the tasks which did not start yet are skipped.
+ *
+ * The tasks of a group are queued in the group itself, the scheduler only runs them.  A thread
+ * waiting for a group executes the pending tasks of this group, and never the ones of other
+ * groups: a group may therefore be waited for from inside a task of another group without
+ * starving the pool, and the GUI thread never runs unrelated work while it waits.
+ */
+class TASK_GROUP
+{
+public:
+    /// Called after each task or ParallelFor() chunk completes, from the thread which ran it.
+    typedef std::function<void( size_t aDone, size_t aTotal )> PROGRESS_CALLBACK;
+
+    TASK_GROUP( TASK_SCHEDULER& aScheduler = DefaultTaskScheduler() );
+
+    /// Waits for the running tasks; exceptions not yet collected by Wait() are discarded.
+    ~TASK_GROUP();
+
+    TASK_GROUP( const TASK_GROUP& ) = delete;
+    TASK_GROUP& operator=( const TASK_GROUP& ) = delete;
+
+    /**
+     * Function Run
+     * queues a task in the group.
+     */
+    void Run( std::function<void()> aTask );
+
+    /**
+     * Function ParallelFor
+     * calls aFunc( i ) for every i in [aBegin, aEnd), spreading the indices over the pool in
+     * chunks of aGrain, and waits for completion.  The calling thread takes part in the work.
+     * Indices not yet started when the group is cancelled are skipped.
+     */
+    void ParallelFor( int aBegin, int aEnd, const std::function<void( int )>& aFunc,
+                      int aGrain = 1 );
+
+    /**
+     * Function Wait
+     * blocks until all the tasks of the group are done, executing its pending tasks meanwhile.
+     * Rethrows the first exception thrown by a task.
+     */
+    void Wait();
+
+    void Cancel() { m_cancelled.store( true ); }
+    bool IsCancelled() const { return m_cancelled.load(); }
+
+    void SetProgressCallback( PROGRESS_CALLBACK aCallback ) { m_progressCallback = aCallback; }
+
+    size_t GetDone() const  { return m_done.load(); }
+    size_t GetTotal() const { return m_total.load(); }
+
+private:
+    /// The tasks of the group not started yet, shared with the scheduler tasks which run them.
+    struct QUEUE
+    {
+        std::mutex                          m_mutex;
+        std::deque<std::function<void()>>   m_tasks;
+
+        bool Pop( std::function<void()>& aTask );
+    };
+
+    void spawn( std::function<void()> aTask );
+    void setException( std::exception_ptr aException );
+    void unitsDone( size_t aCount );
+
+    TASK_SCHEDULER&         m_scheduler;
+    std::shared_ptr<QUEUE>  m_queue;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_finished;
+    size_t                  m_running;      ///< tasks queued or running, guarded by m_mutex
+    std::exception_ptr      m_exception;    ///< first error, guarded by m_mutex
+
+    std::atomic<bool>       m_cancelled;
+    std::atomic<size_t>     m_done;         ///< work units done: one per Run(), one per index
+    std::atomic<size_t>     m_total;
+
+    PROGRESS_CALLBACK       m_progressCallback;
+};
+
+#endif  // TASK_SCHEDULER_H
@@ -26,12 +26,103 @@
 #ifndef __COROUTINE_H
 #define __COROUTINE_H
 
+#include <cassert>
 #include <cstdlib>
+#include <functional>
 
 #include <type_traits>
 
 #include <system/libcontext.h>
 #include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Class COROUTINE_STACK_POOL
+ * keeps the stacks of the destroyed coroutines for reuse.
+ *
+ * A coroutine is created every time a tool state handler is started, allocating and releasing
+ * a large stack each time is a noticeable cost for short handlers (e.g. actions run from
+ * a hotkey).  Only a few stacks are kept, the others are freed.
+ */
+class COROUTINE_STACK_POOL
+{
+public:
+    ///> Size of the coroutine stacks (fixme: make configurable)
+    static constexpr size_t StackSize = 2000000;
+
+    ///> Maximum number of unused stacks kept in the pool
+    static constexpr size_t MaxPooledStacks = 4;
+
+    static COROUTINE_STACK_POOL& Instance()
+    {
+        static COROUTINE_STACK_POOL pool;
+        return pool;
+    }
+
+    ~COROUTINE_STACK_POOL()
+    {
+        for( char* stack : m_stacks )
+            delete[] stack;
+    }
+
+    /**
+     * Function Acquire()
+     * @return a stack of StackSize bytes, from the pool if possible.
+     */
+    char* Acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( !m_stacks.empty() )
+            {
+                char* stack = m_stacks.back();
+                m_stacks.pop_back();
+                return stack;
+            }
+        }
+
+        return new char[StackSize];
+    }
+
+    /**
+     * Function Release()
+     * Returns a stack obtained with Acquire() to the pool, or frees it if the pool is full.
+     */
+    void Release( char* aStack )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( m_stacks.size() < MaxPooledStacks )
+            {
+                m_stacks.push_back( aStack );
+                return;
+            }
+        }
+
+        delete[] aStack;
+    }
+
+    ///> Deleter for the stacks owned by coroutines
+    struct RELEASER
+    {
+        void operator()( char* aStack ) const
+        {
+            COROUTINE_STACK_POOL::Instance().Release( aStack );
+        }
+    };
+
+private:
+    COROUTINE_STACK_POOL()
+    {
+        m_stacks.reserve( MaxPooledStacks );
+    }
+
+    std::mutex          m_mutex;
+    std::vector<char*>  m_stacks;
+};
 
 /**
  *  Class COROUNTINE.
@@ -292,8 +383,8 @@ private:
         assert( m_stack == nullptr );
 
         // fixme: Clean up stack stuff. Add a guard
-        size_t stackSize = c_defaultStackSize;
-        m_stack.reset( new char[stackSize] );
+        size_t stackSize = COROUTINE_STACK_POOL::StackSize;
+        m_stack.reset( COROUTINE_STACK_POOL::Instance().Acquire() );
 
         // align to 16 bytes
         void* sp = (void*)((((ptrdiff_t) m_stack.get()) + stackSize - 0xf) & (~0x0f));
@@ -359,10 +450,8 @@ private:
         }
     }
 
-    static constexpr int c_defaultStackSize = 2000000;    // fixme: make configurable
-
-    ///< coroutine stack
-    std::unique_ptr<char[]> m_stack;
+    ///< coroutine stack, returned to the pool when the coroutine is destroyed
+    std::unique_ptr<char[], COROUTINE_STACK_POOL::RELEASER> m_stack;
 
     std::function<ReturnType( ArgType )> m_func;
 
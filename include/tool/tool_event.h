@@ -26,8 +26,9 @@
 #define __TOOL_EVENT_H
 
 #include <cstdio>
-#include <deque>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 #include <math/vector2d.h>
 #include <cassert>
@@ -469,8 +470,8 @@ class TOOL_EVENT_LIST
 {
 public:
     typedef TOOL_EVENT value_type;
-    typedef std::deque<TOOL_EVENT>::iterator iterator;
-    typedef std::deque<TOOL_EVENT>::const_iterator const_iterator;
+    typedef std::vector<TOOL_EVENT>::iterator iterator;
+    typedef std::vector<TOOL_EVENT>::const_iterator const_iterator;
 
     ///> Default constructor. Creates an empty list.
     TOOL_EVENT_LIST()
@@ -541,14 +542,8 @@ public:
 
     TOOL_EVENT_LIST& operator=( const TOOL_EVENT_LIST& aEventList )
     {
-        m_events.clear();
-
-        for( std::deque<TOOL_EVENT>::const_iterator i = aEventList.m_events.begin();
-             i != aEventList.m_events.end(); ++i )
-        {
-            m_events.push_back( *i );
-        }
-
+        // Reuses the storage, the wait lists of the tools are reassigned on every Wait() call
+        m_events = aEventList.m_events;
         return *this;
     }
 
@@ -572,7 +567,7 @@ public:
     }
 
 private:
-    std::deque<TOOL_EVENT> m_events;
+    std::vector<TOOL_EVENT> m_events;
 };
 
 inline const TOOL_EVENT_LIST operator||( const TOOL_EVENT& aEventA, const TOOL_EVENT& aEventB )
@@ -594,4 +589,87 @@ inline const TOOL_EVENT_LIST operator||( const TOOL_EVENT& aEvent,
     return l;
 }
 
+
+/**
+ * Class TOOL_EVENT_QUEUE
+ *
+ * A FIFO of TOOL_EVENTs stored in a ring buffer.  Slots are reused once the events are popped,
+ * so queueing events does not allocate memory unless the queue has to grow.
+ */
+class TOOL_EVENT_QUEUE
+{
+public:
+    TOOL_EVENT_QUEUE( size_t aCapacity = 16 ) :
+        m_slots( aCapacity ),
+        m_head( 0 ),
+        m_count( 0 )
+    {
+        assert( aCapacity > 0 );
+    }
+
+    bool empty() const
+    {
+        return m_count == 0;
+    }
+
+    size_t size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Function Push()
+     * Adds an event at the end of the queue.
+     */
+    void Push( const TOOL_EVENT& aEvent )
+    {
+        if( m_count == m_slots.size() )
+            grow();
+
+        m_slots[( m_head + m_count ) % m_slots.size()] = aEvent;
+        ++m_count;
+    }
+
+    /**
+     * Function Pop()
+     * Removes the first event of the queue.
+     * @param aEvent receives the removed event.
+     * @return False if the queue was empty.
+     */
+    bool Pop( TOOL_EVENT& aEvent )
+    {
+        if( m_count == 0 )
+            return false;
+
+        std::swap( aEvent, m_slots[m_head] );
+        m_head = ( m_head + 1 ) % m_slots.size();
+        --m_count;
+
+        return true;
+    }
+
+    void clear()
+    {
+        m_head = 0;
+        m_count = 0;
+    }
+
+private:
+    ///> Doubles the capacity, moving the queued events to the beginning of the buffer.
+    void grow()
+    {
+        std::vector<TOOL_EVENT> slots( m_slots.size() * 2 );
+
+        for( size_t i = 0; i < m_count; ++i )
+            std::swap( slots[i], m_slots[( m_head + i ) % m_slots.size()] );
+
+        m_slots.swap( slots );
+        m_head = 0;
+    }
+
+    std::vector<TOOL_EVENT> m_slots;
+    size_t m_head;      ///< index of the first event
+    size_t m_count;     ///< number of queued events
+};
+
 #endif
@@ -228,7 +228,7 @@ public:
      */
     inline void PostEvent( const TOOL_EVENT& aEvent )
     {
-        m_eventQueue.push_back( aEvent );
+        m_eventQueue.Push( aEvent );
     }
 
     /**
@@ -506,7 +506,7 @@ private:
     wxWindow* m_editFrame;
 
     /// Queue that stores events to be processed at the end of the event processing cycle.
-    std::list<TOOL_EVENT> m_eventQueue;
+    TOOL_EVENT_QUEUE m_eventQueue;
 
     ///> VIEW_CONTROLS settings stack
     std::stack<KIGFX::VC_SETTINGS> m_vcStack;
@@ -25,6 +25,7 @@
 #ifndef __VIEW_H
 #define __VIEW_H
 
+#include <functional>
 #include <vector>
 #include <set>
 #include <unordered_map>
@@ -104,6 +105,18 @@ public:
      */
     int Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) const;
 
+    /**
+     * Function Query()
+     * Finds all visible items that touch or are within the rectangle aRect, searching only
+     * the layers accepted by a filter.  Items on several layers are reported once per layer.
+     * @param aRect area to search for items
+     * @param aResult result of the search, sorted as for the unfiltered version.
+     * @param aLayerFilter returns true for the layers to be searched.
+     * @return Number of found items.
+     */
+    int Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult,
+               const std::function<bool( int )>& aLayerFilter ) const;
+
     /**
      * Sets the item visibility.
      *
@@ -129,6 +142,15 @@ public:
      */
     bool IsVisible( const VIEW_ITEM* aItem ) const;
 
+    /**
+     * Function GetGeometryRevision()
+     * Returns a number which changes every time the item is added to the view or its geometry
+     * is updated, so data computed from the item geometry can be cached.
+     * @param aItem: the item to check.
+     * @return the revision, 0 if the item does not belong to a view.
+     */
+    unsigned int GetGeometryRevision( const VIEW_ITEM* aItem ) const;
+
     /**
      * For dynamic VIEWs, informs the associated VIEW that the graphical representation of
      * this item has changed. For static views calling has no effect.
@@ -156,11 +178,20 @@ public:
      */
     void CopySettings( const VIEW* aOtherView );
 
-    /*
-     *  Convenience wrappers for adding multiple items
-     *  template <class T> void AddItems( const T& aItems );
-     *  template <class T> void RemoveItems( const T& aItems );
+    /**
+     * Function AddItems()
+     * Adds a batch of VIEW_ITEMs to the view, with sequential draw priorities.
+     * @param aItems: items to be added. No ownership is given
      */
+    void AddItems( const std::vector<VIEW_ITEM*>& aItems );
+
+    /**
+     * Function RemoveItems()
+     * Removes a batch of VIEW_ITEMs from the view. The list of all items is scanned once,
+     * whatever the number of removed items, so prefer it to repeated Remove() calls.
+     * @param aItems: items to be removed. Caller must dispose the removed items if necessary
+     */
+    void RemoveItems( const std::vector<VIEW_ITEM*>& aItems );
 
     /**
      * Function SetGAL()
@@ -718,6 +749,10 @@ private:
     ///* used by GAL)
     void clearGroupCache();
 
+    ///* Removes an item from the layer trees and frees its GAL groups (but does not touch
+    ///* m_allItems)
+    void removeFromLayers( VIEW_ITEM* aItem );
+
     /**
      * Function invalidateItem()
      * Manages dirty flags & redraw queueing when updating an item.
@@ -804,6 +839,9 @@ private:
 
     /// The next sequential drawing priority
     int m_nextDrawPriority;
+
+    /// Last revision given to an item geometry, see GetGeometryRevision()
+    unsigned int m_geometryRevision;
 };
 } // namespace KIGFX
 
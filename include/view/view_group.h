@@ -34,6 +34,7 @@
 #define VIEW_GROUP_H_
 
 #include <view/view_item.h>
+#include <math/vector2d.h>
 #include <deque>
 
 namespace KIGFX
@@ -117,6 +118,27 @@ public:
         m_layer = aLayer;
     }
 
+    /**
+     * Function SetOffset()
+     * Sets a translation applied by the GAL when the group is drawn. It lets items be previewed
+     * at a new position (e.g. while being dragged) without modifying and recaching them.
+     *
+     * @param aOffset is the translation, in internal units.
+     */
+    inline void SetOffset( const VECTOR2I& aOffset )
+    {
+        m_offset = aOffset;
+    }
+
+    /**
+     * Function GetOffset()
+     * Returns the translation applied when the group is drawn.
+     */
+    inline const VECTOR2I& GetOffset() const
+    {
+        return m_offset;
+    }
+
     /**
      * Function FreeItems()
      * Frees all the items that were added to the group.
@@ -130,6 +152,9 @@ protected:
     /// Layer on which the group is drawn
     int m_layer;
 
+    /// Translation applied to the items when the group is drawn
+    VECTOR2I m_offset;
+
 protected:
     /// Container for storing VIEW_ITEMs
     ITEMS m_groupItems;
@@ -62,6 +62,7 @@ class BOARD_ITEM;
 class PCB_LAYER_BOX_SELECTOR;
 class NETLIST;
 class REPORTER;
+class LAYER_REMAP;
 struct PARSE_ERROR;
 class IO_ERROR;
 class FP_LIB_TABLE;
@@ -1071,6 +1072,14 @@ public:
 
     void Swap_Layers( wxCommandEvent& event );
 
+    /**
+     * Function RemapLayers
+     * moves the tracks, vias, zone segments and graphic lines of the board to the layers
+     * given by aRemap, as a single undo entry which stores the table rather than copies of
+     * the items.
+     */
+    void RemapLayers( const LAYER_REMAP& aRemap );
+
     // Handling texts on the board
     void Rotate_Texte_Pcb( TEXTE_PCB* TextePcb, wxDC* DC );
     void FlipTextePcb( TEXTE_PCB* aTextePcb, wxDC* aDC );
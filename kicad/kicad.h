@@ -31,6 +31,8 @@
 #define KICAD_H
 
 
+#include <memory>
+#include <vector>
 #include <wx/process.h>
 
 #include <id.h>
@@ -42,6 +44,8 @@
 class LAUNCHER_PANEL;
 class TREEPROJECTFILES;
 class TREE_PROJECT_FRAME;
+class TASK_GROUP;
+class PROJECT_PRELOADER;
 
 // Enum to identify the type of files handled by Kicad manager
 //
@@ -123,6 +127,7 @@ enum id_kicad_frm {
     ID_SAVE_AND_ZIP_FILES,
     ID_READ_ZIP_ARCHIVE,
     ID_INIT_WATCHED_PATHS,
+    ID_PRELOAD_PROJECT,
 
     // Please, verify: the number of items in this list should be
     // less than ROOM_FOR_KICADMANAGER (see id.h)
@@ -262,6 +267,14 @@ public:
      */
     void OnChangeWatchedPaths(wxCommandEvent& aEvent );
 
+    /**
+     * Called by sending a event with id = ID_PRELOAD_PROJECT, see postPreloadEvent().
+     * Loads the KIFACEs of the project editors, one per event, then starts the
+     * background loading of the project data of their PROJECT_PRELOADERs.  The last event,
+     * sent by the last task, ends the preload.
+     */
+    void OnPreloadProject( wxCommandEvent& aEvent );
+
 
     void SetProjectFileName( const wxString& aFullProjectProFileName );
     const wxString GetProjectFileName();
@@ -301,7 +314,23 @@ private:
 
     void language_change( wxCommandEvent& event );
 
+    /// Queues the step @a aStep of the preload identified by @a aPreloadId.  Thread safe.
+    void postPreloadEvent( int aStep, long aPreloadId );
+
+    /**
+     * Function finishPreload
+     * ends the preload of the current project: waits for its tasks and hands the results
+     * over to the project.  Called when the tasks are done, before an editor is opened and
+     * when the project changes.  If tasks remain, a progress dialog lets the user cancel them.
+     * @param aCancel drops the tasks not yet started and their results.
+     */
+    void finishPreload( bool aCancel );
+
     bool m_active_project;
+
+    std::unique_ptr<TASK_GROUP>     m_preloadTasks;  ///< the project data loading in background
+    std::vector<PROJECT_PRELOADER*> m_preloaders;    ///< the KIFACEs taking part in the preload
+    long                            m_preloadId;     ///< identifies the current preload events
 };
 
 
@@ -34,6 +34,8 @@
 #include <gestfich.h>
 #include <kiway.h>
 #include <kiway_player.h>
+#include <project_preloader.h>
+#include <task_scheduler.h>
 #include <wildcards_and_files_ext.h>
 #include <bitmaps.h>
 #include <executable_names.h>
@@ -52,6 +54,7 @@ KICAD_MANAGER_FRAME::KICAD_MANAGER_FRAME( wxWindow* parent,
                     KICAD_DEFAULT_DRAWFRAME_STYLE, KICAD_MANAGER_FRAME_NAME )
 {
     m_active_project = false;
+    m_preloadId = 0;
     m_leftWinWidth = 60;
     m_manager_Hokeys_Descr = NULL;
 
@@ -117,6 +120,7 @@ KICAD_MANAGER_FRAME::KICAD_MANAGER_FRAME( wxWindow* parent,
 
 KICAD_MANAGER_FRAME::~KICAD_MANAGER_FRAME()
 {
+    finishPreload( true );
     m_auimgr.UnInit();
 }
 
@@ -137,6 +141,9 @@ void KICAD_MANAGER_FRAME::SetProjectFileName( const wxString& aFullProjectProFil
     if( !fn.IsAbsolute() )
         fn.MakeAbsolute();
 
+    // The preload tasks use the data of the current project
+    finishPreload( true );
+
     Prj().SetProjectFullName( fn.GetFullPath() );
 }
 
@@ -216,6 +223,8 @@ void KICAD_MANAGER_FRAME::OnCloseWindow( wxCloseEvent& Event )
     {
         int px, py;
 
+        finishPreload( true );
+
         UpdateFileHistory( GetProjectFileName(), &PgmTop().GetFileHistory() );
 
         if( !IsIconized() )   // save main frame position and size
@@ -291,6 +300,8 @@ void KICAD_MANAGER_FRAME::Execute( wxWindow* frame, const wxString& execFile,
 
 void KICAD_MANAGER_FRAME::RunEeschema( const wxString& aProjectSchematicFileName )
 {
+    finishPreload( false );
+
     KIWAY_PLAYER* frame = Kiway.Player( FRAME_SCH, false );
 
     // Please: note: DIALOG_EDIT_LIBENTRY_FIELDS_IN_LIB::initBuffers() calls
@@ -341,6 +352,8 @@ void KICAD_MANAGER_FRAME::OnRunEeschema( wxCommandEvent& event )
 
 void KICAD_MANAGER_FRAME::OnRunSchLibEditor( wxCommandEvent& event )
 {
+    finishPreload( false );
+
     KIWAY_PLAYER* frame = Kiway.Player( FRAME_SCH_LIB_EDITOR, false );
 
     if( !frame )
@@ -370,6 +383,8 @@ void KICAD_MANAGER_FRAME::OnRunSchLibEditor( wxCommandEvent& event )
 
 void KICAD_MANAGER_FRAME::RunPcbNew( const wxString& aProjectBoardFileName )
 {
+    finishPreload( false );
+
     KIWAY_PLAYER* frame;
 
     try
@@ -414,6 +429,8 @@ void KICAD_MANAGER_FRAME::OnRunPcbNew( wxCommandEvent& event )
 
 void KICAD_MANAGER_FRAME::OnRunPcbFpEditor( wxCommandEvent& event )
 {
+    finishPreload( false );
+
     KIWAY_PLAYER* frame = Kiway.Player( FRAME_PCB_MODULE_EDITOR, false );
 
     if( !frame )
@@ -79,6 +79,7 @@ BEGIN_EVENT_TABLE( KICAD_MANAGER_FRAME, EDA_BASE_FRAME )
 
     // Special functions
     EVT_MENU( ID_INIT_WATCHED_PATHS, KICAD_MANAGER_FRAME::OnChangeWatchedPaths )
+    EVT_MENU( ID_PRELOAD_PROJECT, KICAD_MANAGER_FRAME::OnPreloadProject )
 
     // Button events (in command frame), and menu events equivalent to buttons
     EVT_BUTTON( ID_TO_SCH, KICAD_MANAGER_FRAME::OnRunEeschema )
@@ -30,13 +30,18 @@
 
 #include <wx/dir.h>
 #include <wx/filename.h>
+#include <wx/progdlg.h>
 #include <wx/stdpaths.h>
 
 #include <build_version.h>
 #include <config_params.h>
 #include <confirm.h>
 #include <kiway.h>
+#include <kiface_ids.h>
+#include <macros.h>
 #include <project.h>
+#include <project_preloader.h>
+#include <task_scheduler.h>
 #include <wildcards_and_files_ext.h>
 
 #include "dialogs/dialog_template_selector.h"
@@ -349,10 +354,148 @@ void KICAD_MANAGER_FRAME::OnLoadProject( wxCommandEvent& event )
 
     wxPostEvent( this, cmd );
 
+    // Load the editors and the project libraries in background, so the editors open
+    // without delay.
+    postPreloadEvent( 0, m_preloadId );
+
     PrintPrjInfo();
 }
 
 
+void KICAD_MANAGER_FRAME::postPreloadEvent( int aStep, long aPreloadId )
+{
+    wxCommandEvent cmd( wxEVT_COMMAND_MENU_SELECTED, ID_PRELOAD_PROJECT );
+
+    cmd.SetInt( aStep );
+    cmd.SetExtraLong( aPreloadId );
+
+    // wxQueueEvent() rather than wxPostEvent(): the last step is posted by a worker thread
+    wxQueueEvent( this, cmd.Clone() );
+}
+
+
+void KICAD_MANAGER_FRAME::OnPreloadProject( wxCommandEvent& aEvent )
+{
+    // The KIFACEs are loaded from the main thread, as they initialize wx objects: one per
+    // event, so the frame stays responsive in between.
+    static const KIWAY::FACE_T preloadedFaces[] = { KIWAY::FACE_SCH, KIWAY::FACE_PCB };
+
+    // Steps past the KIFACEs: queueing the tasks, then the tasks are done
+    static const unsigned stepRun = DIM( preloadedFaces );
+    static const unsigned stepDone = stepRun + 1;
+
+    // Ignore the events of an ended preload (project closed, editor opened).
+    if( aEvent.GetExtraLong() != m_preloadId )
+        return;
+
+    unsigned step = aEvent.GetInt();
+
+    if( step == stepDone )
+    {
+        if( m_preloadTasks && m_preloadTasks->GetDone() == m_preloadTasks->GetTotal() )
+            finishPreload( false );
+
+        return;
+    }
+
+    if( m_preloadTasks )
+        return;
+
+    if( step < stepRun )
+    {
+        try
+        {
+            KIFACE* kiface = Kiway.KiFACE( preloadedFaces[step] );
+
+            if( kiface )
+            {
+                PROJECT_PRELOADER* preloader =
+                        (PROJECT_PRELOADER*) kiface->IfaceOrAddress( KIFACE_PROJECT_PRELOADER );
+
+                if( preloader )
+                    m_preloaders.push_back( preloader );
+            }
+        }
+        catch( const IO_ERROR& )
+        {
+            // Reported when the editor is launched
+        }
+
+        postPreloadEvent( step + 1, m_preloadId );
+        return;
+    }
+
+    m_preloadTasks.reset( new TASK_GROUP() );
+
+    long preloadId = m_preloadId;
+
+    // Ends the preload as soon as the tasks are done, so the preloaders restore the user locale
+    m_preloadTasks->SetProgressCallback( [this, preloadId]( size_t aDone, size_t aTotal ) {
+        if( aDone == aTotal )
+            postPreloadEvent( stepDone, preloadId );
+    } );
+
+    for( PROJECT_PRELOADER* preloader : m_preloaders )
+        preloader->PreloadProject( Kiway, *m_preloadTasks );
+
+    if( m_preloadTasks->GetTotal() == 0 )
+        finishPreload( false );
+}
+
+
+void KICAD_MANAGER_FRAME::finishPreload( bool aCancel )
+{
+    // Pending preload events are now obsolete
+    ++m_preloadId;
+
+    if( m_preloadTasks )
+    {
+        if( aCancel )
+        {
+            m_preloadTasks->Cancel();
+        }
+        else if( m_preloadTasks->GetDone() < m_preloadTasks->GetTotal() )
+        {
+            // An editor is about to open: let the user wait for the libraries it will use,
+            // or skip them, the editor then loads them itself.
+            wxProgressDialog dlg( _( "Loading Project Libraries" ), wxEmptyString,
+                                  m_preloadTasks->GetTotal(), this,
+                                  wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_AUTO_HIDE );
+
+            while( !m_preloadTasks->IsCancelled()
+                   && m_preloadTasks->GetDone() < m_preloadTasks->GetTotal() )
+            {
+                if( !dlg.Update( m_preloadTasks->GetDone() ) )
+                    m_preloadTasks->Cancel();
+                else
+                    wxMilliSleep( 50 );
+            }
+        }
+
+        wxBusyCursor dummy;
+
+        try
+        {
+            // Only the tasks already running are waited for once cancelled
+            m_preloadTasks->Wait();
+        }
+        catch( ... )
+        {
+            // The preload is only an optimization: what failed is loaded again by the editor
+        }
+
+        // In the reverse order of PreloadProject(): each preloader restores the locale
+        // which was in use when it started
+        for( auto it = m_preloaders.rbegin(); it != m_preloaders.rend(); ++it )
+            ( *it )->PreloadFinish( Kiway, m_preloadTasks->IsCancelled() );
+
+        m_preloadTasks.reset();
+    }
+
+    m_preloaders.clear();
+}
+
+
 /* Creates a new project folder, copy a template into this new folder.
  * and open this new project as working project
  */
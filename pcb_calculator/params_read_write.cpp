@@ -76,49 +76,61 @@ double DoubleFromString( const wxString& TextValue )
 }
 
 
-// Functions to Read/Write parameters in pcb_calculator main frame:
-// They are only wrapper to actual functions, so all transline functions do not
-// depend on Graphic User Interface
-void SetPropertyInDialog( enum PRMS_ID aPrmId, double value )
+/*
+ * Reads/Writes transline parameters in pcb_calculator main frame.
+ * It is only a wrapper to actual functions, so all transline functions do not
+ * depend on Graphic User Interface
+ */
+class DIALOG_TRANSLINE_IO : public TRANSLINE_IO
 {
-    PCB_CALCULATOR_FRAME * frame = (PCB_CALCULATOR_FRAME *) wxTheApp->GetTopWindow();
-    frame->SetPrmValue( aPrmId, value );
-}
+public:
+    double GetProperty( enum PRMS_ID aPrmId ) override
+    {
+        return frame()->GetPrmValue( aPrmId );
+    }
 
-/* Puts the text into the given result line.
-*/
-void SetResultInDialog( int line, const char* aText )
-{
-    PCB_CALCULATOR_FRAME * frame = (PCB_CALCULATOR_FRAME *) wxTheApp->GetTopWindow();
-    wxString msg = wxString::FromUTF8( aText );
-    frame->SetResult( line, msg );
-}
+    void SetProperty( enum PRMS_ID aPrmId, double aValue ) override
+    {
+        frame()->SetPrmValue( aPrmId, aValue );
+    }
 
-/* print aValue into the given result line.
-*/
-void SetResultInDialog( int aLineNumber, double aValue, const char* aText )
-{
-    PCB_CALCULATOR_FRAME * frame = (PCB_CALCULATOR_FRAME *) wxTheApp->GetTopWindow();
-    wxString msg = wxString::FromUTF8( aText );
-    wxString fullmsg;
-    fullmsg.Printf( wxT("%g "), aValue );
-    fullmsg += msg;
-    frame->SetResult( aLineNumber, fullmsg );
-}
+    // Has meaning only for params that have a radio button
+    bool IsSelected( enum PRMS_ID aPrmId ) override
+    {
+        return frame()->IsPrmSelected( aPrmId );
+    }
 
-/* Returns a named property value. */
-double GetPropertyInDialog( enum PRMS_ID aPrmId )
-{
-    PCB_CALCULATOR_FRAME * frame = (PCB_CALCULATOR_FRAME *) wxTheApp->GetTopWindow();
-    return frame->GetPrmValue( aPrmId );
-}
+    /* print aValue into the given result line.
+    */
+    void SetResult( int aLineNumber, double aValue, const char* aText ) override
+    {
+        wxString msg = wxString::FromUTF8( aText );
+        wxString fullmsg;
+        fullmsg.Printf( wxT("%g "), aValue );
+        fullmsg += msg;
+        frame()->SetResult( aLineNumber, fullmsg );
+    }
 
-// Returns true if the param aPrmId is selected
-// Has meaning only for params that have a radio button
-bool   IsSelectedInDialog( enum PRMS_ID aPrmId )
+    /* Puts the text into the given result line.
+    */
+    void SetResult( int aLineNumber, const char* aText ) override
+    {
+        frame()->SetResult( aLineNumber, wxString::FromUTF8( aText ) );
+    }
+
+private:
+    PCB_CALCULATOR_FRAME* frame()
+    {
+        return (PCB_CALCULATOR_FRAME *) wxTheApp->GetTopWindow();
+    }
+};
+
+
+TRANSLINE_IO* DialogTranslineIO()
 {
-    PCB_CALCULATOR_FRAME * frame = (PCB_CALCULATOR_FRAME *) wxTheApp->GetTopWindow();
-    return frame->IsPrmSelected( aPrmId );
+    static DIALOG_TRANSLINE_IO io;
+
+    return &io;
 }
 
 
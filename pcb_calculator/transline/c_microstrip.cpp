@@ -947,6 +947,7 @@ void C_MICROSTRIP::synthesize()
     double f1, f2, ft1, ft2, j11, j12, j21, j22, d_s_h, d_w_h, err;
     double eps = 1e-04;
     double w_h, s_h, le, lo;
+    int    iteration;
 
     /* Get and assign substrate parameters */
     get_c_microstrip_sub();
@@ -959,6 +960,7 @@ void C_MICROSTRIP::synthesize()
 
     /* Get and assign physical parameters */
     /* at present it is required only for getting strips length */
+    double prev_w = w, prev_s = s;  /* solution of the previous synthesis */
     get_c_microstrip_phys();
 
 
@@ -967,10 +969,20 @@ void C_MICROSTRIP::synthesize()
     Z0_o = Z0o;
 
     /* calculate width and use for initial value in Newton's method */
-    synth_width();
+    if( m_warmStart && m_hasSolution && prev_w > 0.0 && prev_s > 0.0 )
+    {
+        w = prev_w;
+        s = prev_s;
+    }
+    else
+    {
+        synth_width();
+    }
+
     w_h = w / h;
     s_h = s / h;
     f1  = f2 = 0;
+    iteration = 0;
 
     /* rather crude Newton-Rhapson */
     do {
@@ -994,7 +1006,7 @@ void C_MICROSTRIP::synthesize()
         err = sqrt( f1 * f1 + f2 * f2 );
 
         /* converged ? */
-    } while( err > 1e-04 );
+    } while( err > 1e-04 && ++iteration < 100 );
 
     /* denormalize computed width and spacing */
     s = s_h * h;
@@ -1012,6 +1024,7 @@ void C_MICROSTRIP::synthesize()
     setProperty( PHYS_LEN_PRM, l );
 
     calc();
+    m_hasSolution = true;
     /* print results in the subwindow */
     show_results();
 }
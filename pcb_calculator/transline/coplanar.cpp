@@ -220,9 +220,18 @@ void COPLANAR::synthesize()
 {
     double Z0_dest, Z0_current, Z0_result, increment, slope, error;
     int    iteration;
+    double prev_w = w, prev_s = s;  /* solution of the previous synthesis */
 
     getProperties();
 
+    if( m_warmStart && m_hasSolution )
+    {
+        if( isSelected( PHYS_WIDTH_PRM ) && prev_w > 0.0 )
+            w = prev_w;
+        else if( !isSelected( PHYS_WIDTH_PRM ) && prev_s > 0.0 )
+            s = prev_s;
+    }
+
     /* required value of Z0 */
     Z0_dest = Z0;
 
@@ -283,6 +292,7 @@ void COPLANAR::synthesize()
 
     /* compute coplanar parameters */
     calc();
+    m_hasSolution = true;
 
     /* print results in the subwindow */
     show_results();
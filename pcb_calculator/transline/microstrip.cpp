@@ -561,11 +561,15 @@ void MICROSTRIP::synthesize()
 
     /* Get and assign physical parameters */
     /* at present it is required only for getting strips length */
+    double prev_w = w;          /* solution of the previous synthesis */
     get_microstrip_phys();
 
 
     /* calculate width and use for initial value in Newton's method */
-    w = synth_width();
+    if( m_warmStart && m_hasSolution && prev_w > 0.0 )
+        w = prev_w;
+    else
+        w = synth_width();
 
     /* required value of Z0 */
     Z0_dest = Z0;
@@ -615,6 +619,7 @@ void MICROSTRIP::synthesize()
 
     /* compute microstrip parameters */
     calc();
+    m_hasSolution = true;
 
     /* print results in the subwindow */
     show_results();
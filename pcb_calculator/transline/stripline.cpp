@@ -155,9 +155,13 @@ void STRIPLINE::synthesize()
 {
     double Z0_dest, Z0_current, Z0_result, increment, slope, error;
     int    iteration;
+    double prev_w = w;      /* solution of the previous synthesis */
 
     getProperties();
 
+    if( m_warmStart && m_hasSolution && prev_w > 0.0 )
+        w = prev_w;
+
     /* required value of Z0 */
     Z0_dest = Z0;
 
@@ -204,6 +208,7 @@ void STRIPLINE::synthesize()
 
     /* compute parameters */
     calc();
+    m_hasSolution = true;
 
     /* print results in the subwindow */
     show_results();
@@ -37,25 +37,33 @@
 #endif
 
 
-// Functions to Read/Write parameters in pcb_calculator main frame:
-// They are wrapper to actual functions, so all transline functions do not
-// depend on Graphic User Interface
-void SetPropertyInDialog( enum PRMS_ID aPrmId, double value );
+TRANSLINE_PARAMS::TRANSLINE_PARAMS()
+{
+    for( int ii = 0; ii < DUMMY_PRM; ii++ )
+        m_Prms[ii] = 0.0;
 
-/* Puts the text into the given result line.
-*/
-void SetResultInDialog( int line, const char* text );
+    m_Selected = PHYS_WIDTH_PRM;
 
-/* print aValue into the given result line.
-*/
-void SetResultInDialog( int aLineNumber, double aValue, const char* aText );
+    for( int ii = 0; ii < TRANSLINE_RESULTS_COUNT; ii++ )
+        m_Results[ii] = std::numeric_limits<double>::quiet_NaN();
+}
 
-/* Returns a named property value. */
-double GetPropertyInDialog( enum PRMS_ID aPrmId );
 
-// Returns true if the param aPrmId is selected
-// Has meaning only for params that have a radio button
-bool   IsSelectedInDialog( enum PRMS_ID aPrmId );
+void TRANSLINE_PARAMS::SetResult( int aLine, double aValue, const char* aText )
+{
+    if( aLine >= 0 && aLine < TRANSLINE_RESULTS_COUNT )
+        m_Results[aLine] = aValue;
+}
+
+
+void TRANSLINE_PARAMS::SetResult( int aLine, const char* aText )
+{
+    if( aLine >= 0 && aLine < TRANSLINE_RESULTS_COUNT )
+    {
+        m_Results[aLine] = std::numeric_limits<double>::quiet_NaN();
+        m_ResultTexts[aLine] = aText;
+    }
+}
 
 
 /* Constructor creates a transmission line instance. */
@@ -63,6 +71,9 @@ TRANSLINE::TRANSLINE()
 {
     murC = 1.0;
     m_name = (const char*) 0;
+    m_io = NULL;
+    m_warmStart = false;
+    m_hasSolution = false;
 
     // Initialize these variables mainly to avoid warnings from a static analyzer
     f = 0.0;            // Frequency of operation
@@ -84,7 +95,7 @@ TRANSLINE::~TRANSLINE()
  */
 void TRANSLINE::setProperty( enum PRMS_ID aPrmId, double value )
 {
-    SetPropertyInDialog( aPrmId, value );
+    m_io->SetProperty( aPrmId, value );
 }
 
 /*
@@ -93,7 +104,7 @@ void TRANSLINE::setProperty( enum PRMS_ID aPrmId, double value )
  */
 bool TRANSLINE::isSelected( enum PRMS_ID aPrmId )
 {
-    return IsSelectedInDialog( aPrmId );
+    return m_io->IsSelected( aPrmId );
 }
 
 
@@ -101,18 +112,18 @@ bool TRANSLINE::isSelected( enum PRMS_ID aPrmId )
 */
 void TRANSLINE::setResult( int line, const char* text )
 {
-    SetResultInDialog( line, text );
+    m_io->SetResult( line, text );
 }
 void TRANSLINE::setResult( int line, double value, const char* text )
 {
-    SetResultInDialog( line, value, text );
+    m_io->SetResult( line, value, text );
 }
 
 
 /* Returns a property value. */
 double TRANSLINE::getProperty( enum PRMS_ID aPrmId )
 {
-    return GetPropertyInDialog( aPrmId );
+    return m_io->GetProperty( aPrmId );
 }
 
 /*
@@ -24,6 +24,8 @@
 #ifndef __TRANSLINE_H
 #define __TRANSLINE_H
 
+#include <string>
+
 // IDs for lines parameters used in calculation:
 // (Used to retrieve these parameters from UI.
 // DUMMY_PRM is used to skip a param line in dialogs. It is not really a parameter
@@ -56,6 +58,53 @@ enum PRMS_ID
     DUMMY_PRM
 };
 
+/**
+ * Class TRANSLINE_IO
+ * is where a TRANSLINE reads its parameters and writes its results: the pcb_calculator
+ * dialog, or a TRANSLINE_PARAMS record when lines are computed without GUI.
+ * All values are in normalized units (meter, Hz, Ohm, radian).
+ */
+class TRANSLINE_IO
+{
+public:
+    virtual ~TRANSLINE_IO() {}
+
+    virtual double GetProperty( enum PRMS_ID aPrmId ) = 0;
+    virtual void   SetProperty( enum PRMS_ID aPrmId, double aValue ) = 0;
+
+    /// Returns true if aPrmId is the parameter to synthesize, when the line has a choice
+    virtual bool   IsSelected( enum PRMS_ID aPrmId ) = 0;
+
+    virtual void   SetResult( int aLine, double aValue, const char* aText ) = 0;
+    virtual void   SetResult( int aLine, const char* aText ) = 0;
+};
+
+
+#define TRANSLINE_RESULTS_COUNT 7       // the max number of result lines of a TRANSLINE
+
+
+/**
+ * Class TRANSLINE_PARAMS
+ * stores the parameters and the results of one transmission line.
+ */
+class TRANSLINE_PARAMS : public TRANSLINE_IO
+{
+public:
+    TRANSLINE_PARAMS();
+
+    double GetProperty( enum PRMS_ID aPrmId ) override { return m_Prms[aPrmId]; }
+    void   SetProperty( enum PRMS_ID aPrmId, double aValue ) override { m_Prms[aPrmId] = aValue; }
+    bool   IsSelected( enum PRMS_ID aPrmId ) override { return aPrmId == m_Selected; }
+    void   SetResult( int aLine, double aValue, const char* aText ) override;
+    void   SetResult( int aLine, const char* aText ) override;
+
+    double      m_Prms[DUMMY_PRM];
+    PRMS_ID     m_Selected;                             ///< the parameter to synthesize
+    double      m_Results[TRANSLINE_RESULTS_COUNT];     ///< NaN for text only results
+    std::string m_ResultTexts[TRANSLINE_RESULTS_COUNT]; ///< text only results, e.g. modes
+};
+
+
 class TRANSLINE
 {
 public: TRANSLINE();
@@ -68,6 +117,18 @@ public: TRANSLINE();
     void   setResult( int, const char* );
     bool   isSelected( enum PRMS_ID aPrmId );
 
+    /// Sets where the line reads its parameters and writes its results
+    void   SetIO( TRANSLINE_IO* aIO ) { m_io = aIO; }
+    TRANSLINE_IO* GetIO() const { return m_io; }
+
+    /**
+     * Function SetWarmStart
+     * when enabled, synthesize() starts from the solution of the previous call instead of
+     * the initial guess of the line.  Useful when consecutive lines are close, e.g. when
+     * sweeping a parameter.
+     */
+    void   SetWarmStart( bool aEnable ) { m_warmStart = aEnable; }
+
     virtual void synthesize() { };
     virtual void analyze() { };
 
@@ -81,6 +142,12 @@ protected:
     double skin_depth();
     void   ellipke( double, double&, double& );
     double ellipk( double );
+
+    bool   m_warmStart;
+    bool   m_hasSolution;   ///< true once synthesize() ran, i.e. the physical values are a solution
+
+private:
+    TRANSLINE_IO* m_io;
 };
 
 #endif /* __TRANSLINE_H */
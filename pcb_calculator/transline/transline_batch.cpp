@@ -0,0 +1,252 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <transline_batch.h>
+#include <microstrip.h>
+#include <coplanar.h>
+#include <rectwaveguide.h>
+#include <coax.h>
+#include <c_microstrip.h>
+#include <stripline.h>
+#include <twistedpair.h>
+
+
+// Lines computed by a TRANSLINE instance at least, i.e. lines per cold synthesis
+#define MIN_CHUNK_SIZE 64
+
+
+static const char* prmNames[DUMMY_PRM] =
+{
+    "",             // UNKNOWN_ID
+    "er",           // EPSILONR_PRM
+    "tand",         // TAND_PRM
+    "rho",          // RHO_PRM
+    "h",            // H_PRM
+    "twists",       // TWISTEDPAIR_TWIST_PRM
+    "h_t",          // H_T_PRM
+    "a",            // STRIPLINE_A_PRM
+    "t",            // T_PRM
+    "rough",        // ROUGH_PRM
+    "mur",          // MUR_PRM
+    "er_env",       // TWISTEDPAIR_EPSILONR_ENV_PRM
+    "murc",         // MURC_PRM
+    "tanm",         // TANM_PRM
+    "f",            // FREQUENCY_PRM
+    "z0",           // Z0_PRM
+    "z0_e",         // Z0_E_PRM
+    "z0_o",         // Z0_O_PRM
+    "ang_l",        // ANG_L_PRM
+    "w",            // PHYS_WIDTH_PRM
+    "din",          // PHYS_DIAM_IN_PRM
+    "s",            // PHYS_S_PRM
+    "dout",         // PHYS_DIAM_OUT_PRM
+    "l",            // PHYS_LEN_PRM
+};
+
+
+const char* TranslinePrmName( PRMS_ID aPrmId )
+{
+    if( aPrmId <= UNKNOWN_ID || aPrmId >= DUMMY_PRM )
+        return "";
+
+    return prmNames[aPrmId];
+}
+
+
+PRMS_ID TranslinePrmFromName( const std::string& aName )
+{
+    for( int ii = UNKNOWN_ID + 1; ii < DUMMY_PRM; ii++ )
+    {
+        if( aName == prmNames[ii] )
+            return (PRMS_ID) ii;
+    }
+
+    return UNKNOWN_ID;
+}
+
+
+void TRANSLINE_KIND::SetDefaults( TRANSLINE_PARAMS& aParams ) const
+{
+    for( const PRM& prm : m_Prms )
+        aParams.m_Prms[prm.m_Id] = prm.m_Default;
+
+    aParams.m_Selected = m_Selected;
+}
+
+
+bool TRANSLINE_KIND::HasPrm( PRMS_ID aPrmId ) const
+{
+    for( const PRM& prm : m_Prms )
+    {
+        if( prm.m_Id == aPrmId )
+            return true;
+    }
+
+    return false;
+}
+
+
+const std::vector<TRANSLINE_KIND>& TranslineKinds()
+{
+    // Same defaults as transline_ident.cpp (FR4 substrate, copper conductor, 1 GHz)
+    #define COMMON_PRMS { EPSILONR_PRM, 4.6 }, { TAND_PRM, 2e-2 }, { RHO_PRM, 1.72e-8 }, \
+                        { FREQUENCY_PRM, 1e9 }
+    #define LINE_RESULTS "er_eff", "cond_loss", "diel_loss", "skin_depth"
+
+    static const std::vector<TRANSLINE_KIND> kinds =
+    {
+        { "microstrip", [] { return new MICROSTRIP(); },
+          { COMMON_PRMS, { H_PRM, 0.2e-3 }, { H_T_PRM, 1e17 }, { T_PRM, 35e-6 },
+            { ROUGH_PRM, 0.0 }, { MUR_PRM, 1.0 }, { MURC_PRM, 1.0 },
+            { PHYS_WIDTH_PRM, 0.2e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { LINE_RESULTS }, PHYS_WIDTH_PRM },
+
+        { "cpw", [] { return new COPLANAR(); },
+          { COMMON_PRMS, { H_PRM, 0.2e-3 }, { T_PRM, 35e-6 }, { MURC_PRM, 1.0 },
+            { PHYS_WIDTH_PRM, 0.2e-3 }, { PHYS_S_PRM, 0.2e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { LINE_RESULTS }, PHYS_WIDTH_PRM },
+
+        { "grounded_cpw", [] { return new GROUNDEDCOPLANAR(); },
+          { COMMON_PRMS, { H_PRM, 0.2e-3 }, { T_PRM, 35e-6 }, { MURC_PRM, 1.0 },
+            { PHYS_WIDTH_PRM, 0.2e-3 }, { PHYS_S_PRM, 0.2e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { LINE_RESULTS }, PHYS_WIDTH_PRM },
+
+        { "rectwaveguide", [] { return new RECTWAVEGUIDE(); },
+          { COMMON_PRMS, { MUR_PRM, 1.0 }, { TANM_PRM, 0.0 }, { MURC_PRM, 1.0 },
+            { PHYS_WIDTH_PRM, 10e-3 }, { PHYS_S_PRM, 5e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { "zf_h10", "er_eff", "cond_loss", "diel_loss", "te_modes", "tm_modes" },
+          PHYS_WIDTH_PRM },
+
+        { "coax", [] { return new COAX(); },
+          { COMMON_PRMS, { MUR_PRM, 1.0 }, { MURC_PRM, 1.0 },
+            { PHYS_DIAM_IN_PRM, 1e-3 }, { PHYS_DIAM_OUT_PRM, 8e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { "er_eff", "cond_loss", "diel_loss", "te_modes", "tm_modes" },
+          PHYS_DIAM_IN_PRM },
+
+        { "c_microstrip", [] { return new C_MICROSTRIP(); },
+          { COMMON_PRMS, { H_PRM, 0.2e-3 }, { H_T_PRM, 1e17 }, { T_PRM, 35e-6 },
+            { ROUGH_PRM, 0.0 }, { MURC_PRM, 1.0 },
+            { PHYS_WIDTH_PRM, 0.2e-3 }, { PHYS_S_PRM, 0.2e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_E_PRM, 50.0 }, { Z0_O_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { "er_eff_e", "er_eff_o", "cond_loss_e", "cond_loss_o", "diel_loss_e", "diel_loss_o",
+            "skin_depth" },
+          PHYS_WIDTH_PRM },
+
+        { "stripline", [] { return new STRIPLINE(); },
+          { COMMON_PRMS, { H_PRM, 0.2e-3 }, { STRIPLINE_A_PRM, 0.2e-3 }, { T_PRM, 35e-6 },
+            { MURC_PRM, 1.0 }, { PHYS_WIDTH_PRM, 0.2e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { LINE_RESULTS }, PHYS_WIDTH_PRM },
+
+        { "twistedpair", [] { return new TWISTEDPAIR(); },
+          { COMMON_PRMS, { TWISTEDPAIR_TWIST_PRM, 0.0 }, { MURC_PRM, 1.0 },
+            { TWISTEDPAIR_EPSILONR_ENV_PRM, 1.0 },
+            { PHYS_DIAM_IN_PRM, 1e-3 }, { PHYS_DIAM_OUT_PRM, 8e-3 }, { PHYS_LEN_PRM, 50e-3 },
+            { Z0_PRM, 50.0 }, { ANG_L_PRM, 0.0 } },
+          { LINE_RESULTS }, PHYS_DIAM_IN_PRM },
+    };
+
+    #undef COMMON_PRMS
+    #undef LINE_RESULTS
+
+    return kinds;
+}
+
+
+const TRANSLINE_KIND* FindTranslineKind( const std::string& aName )
+{
+    for( const TRANSLINE_KIND& kind : TranslineKinds() )
+    {
+        if( aName == kind.m_Name )
+            return &kind;
+    }
+
+    return NULL;
+}
+
+
+TRANSLINE_BATCH::TRANSLINE_BATCH( const TRANSLINE_KIND& aKind ) :
+    m_kind( aKind ),
+    m_threadCount( 1 ),
+    m_warmStart( false )
+{
+}
+
+
+void TRANSLINE_BATCH::Run( MODE aMode, std::vector<TRANSLINE_PARAMS>& aLines ) const
+{
+    size_t   count = aLines.size();
+    unsigned threads = m_threadCount;
+
+    if( threads == 0 )
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    // A few chunks per thread for load balancing, contiguous so warm starts follow the
+    // order of the table
+    size_t chunkSize = std::max<size_t>( MIN_CHUNK_SIZE, count / ( 4 * threads ) + 1 );
+    size_t chunkCount = ( count + chunkSize - 1 ) / chunkSize;
+    std::atomic<size_t> nextChunk( 0 );
+
+    auto worker = [&]()
+    {
+        for( size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++ )
+        {
+            std::unique_ptr<TRANSLINE> line( m_kind.m_Create() );
+            size_t end = std::min( count, ( chunk + 1 ) * chunkSize );
+
+            line->SetWarmStart( m_warmStart );
+
+            for( size_t ii = chunk * chunkSize; ii < end; ++ii )
+            {
+                line->SetIO( &aLines[ii] );
+
+                if( aMode == SYNTHESIZE )
+                    line->synthesize();
+                else
+                    line->analyze();
+            }
+        }
+    };
+
+    threads = (unsigned) std::min<size_t>( threads, chunkCount );
+
+    std::vector<std::thread> pool;
+
+    for( unsigned ii = 1; ii < threads; ++ii )
+        pool.emplace_back( worker );
+
+    worker();
+
+    for( std::thread& thread : pool )
+        thread.join();
+}
@@ -0,0 +1,111 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef TRANSLINE_BATCH_H
+#define TRANSLINE_BATCH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <transline.h>
+
+
+/**
+ * Struct TRANSLINE_KIND
+ * describes a type of transmission line for computations without GUI: the parameters and
+ * results the line uses, with the default values of the pcb_calculator dialog.
+ */
+struct TRANSLINE_KIND
+{
+    struct PRM
+    {
+        PRMS_ID m_Id;
+        double  m_Default;      ///< in normalized unit (meter, Hz, Ohm, radian)
+    };
+
+    const char*                 m_Name;         ///< e.g. "microstrip"
+    std::function<TRANSLINE*()> m_Create;
+    std::vector<PRM>            m_Prms;
+    std::vector<std::string>    m_Results;      ///< names of the result lines
+    PRMS_ID                     m_Selected;     ///< the parameter synthesized by default
+
+    /// Sets the parameters of aParams to their default value
+    void SetDefaults( TRANSLINE_PARAMS& aParams ) const;
+
+    bool HasPrm( PRMS_ID aPrmId ) const;
+};
+
+
+/// Returns the list of all the line types
+const std::vector<TRANSLINE_KIND>& TranslineKinds();
+
+/// Returns the line type named aName, or NULL
+const TRANSLINE_KIND* FindTranslineKind( const std::string& aName );
+
+/// Returns the name of aPrmId in tables, e.g. "w" for PHYS_WIDTH_PRM
+const char* TranslinePrmName( PRMS_ID aPrmId );
+
+/// Returns the parameter named aName in tables, or UNKNOWN_ID
+PRMS_ID TranslinePrmFromName( const std::string& aName );
+
+
+/**
+ * Class TRANSLINE_BATCH
+ * analyzes or synthesizes a table of transmission lines of the same type.
+ *
+ * The table is split in contiguous chunks, each one computed by its own TRANSLINE instance,
+ * possibly on several threads.  With warm starts, the synthesis of a line starts from the
+ * solution of the previous line of its chunk: tables sweeping a parameter should keep the
+ * swept parameter in the inner loop, so consecutive lines are close.
+ */
+class TRANSLINE_BATCH
+{
+public:
+    enum MODE
+    {
+        ANALYZE,
+        SYNTHESIZE
+    };
+
+    TRANSLINE_BATCH( const TRANSLINE_KIND& aKind );
+
+    /// Sets the number of threads, 0 to use one per hardware thread
+    void SetThreadCount( unsigned aCount ) { m_threadCount = aCount; }
+
+    void SetWarmStart( bool aEnable ) { m_warmStart = aEnable; }
+
+    /**
+     * Function Run
+     * computes all the lines of aLines.  The results and the computed parameters are stored
+     * in the lines.
+     */
+    void Run( MODE aMode, std::vector<TRANSLINE_PARAMS>& aLines ) const;
+
+private:
+    const TRANSLINE_KIND&   m_kind;
+    unsigned                m_threadCount;
+    bool                    m_warmStart;
+};
+
+#endif  // TRANSLINE_BATCH_H
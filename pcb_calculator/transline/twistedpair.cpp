@@ -116,9 +116,18 @@ void TWISTEDPAIR::synthesize()
 {
     double Z0_dest, Z0_current, Z0_result, increment, slope, error;
     int    iteration;
+    double prev_din = din, prev_dout = dout;    /* solution of the previous synthesis */
 
     getProperties();
 
+    if( m_warmStart && m_hasSolution )
+    {
+        if( isSelected( PHYS_DIAM_IN_PRM ) && prev_din > 0.0 )
+            din = prev_din;
+        else if( !isSelected( PHYS_DIAM_IN_PRM ) && prev_dout > 0.0 )
+            dout = prev_dout;
+    }
+
     /* required value of Z0 */
     Z0_dest = Z0;
 
@@ -179,6 +188,7 @@ void TWISTEDPAIR::synthesize()
 
     /* compute parameters */
     calc();
+    m_hasSolution = true;
 
     /* print results in the subwindow */
     show_results();
@@ -431,6 +431,9 @@ TRANSLINE_IDENT::TRANSLINE_IDENT( enum TRANSLINE_TYPE_ID aType )
     case END_OF_LIST_TYPE:      // Not really used
         break;
     }
+
+    if( m_TLine )
+        m_TLine->SetIO( DialogTranslineIO() );
 }
 
 TRANSLINE_IDENT::~TRANSLINE_IDENT()
@@ -129,4 +129,8 @@ public:
     void WriteConfig( wxConfigBase* aConfig );
 };
 
+
+/// The TRANSLINE_IO reading and writing the transline parameters in the main frame
+TRANSLINE_IO* DialogTranslineIO();
+
 #endif      //  TRANSLINE_IDENT_H
@@ -0,0 +1,386 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Computes tables of transmission lines with the solvers of pcb_calculator and writes them
+ * as CSV, one line per row with all the parameters and results of the line.
+ *
+ * The rows are the rows of the input CSV file (a header with parameter names, then values),
+ * or a single row of default values, times all the combinations of the swept parameters.
+ * The last swept parameter varies fastest.  All values are in normalized units (meter, Hz,
+ * Ohm, radian).
+ *
+ * Usage: transline_table TYPE analyze|synthesize [OPTIONS] [NAME=VALUE|NAME=FROM:TO:STEP]...
+ *  --input FILE    reads the rows from a CSV file
+ *  --output FILE   writes the table to FILE instead of the standard output
+ *  --solve NAME    the parameter to synthesize, for lines having a choice
+ *  --threads N     computes the table on N threads, 0 for all the hardware threads
+ *  --warm          starts each synthesis from the solution of the previous row
+ *
+ * e.g. transline_table microstrip synthesize --warm h=0.1e-3:1.6e-3:0.1e-3 z0=25:100:0.5
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <transline_batch.h>
+
+
+struct SWEEP
+{
+    PRMS_ID             m_Id;
+    std::vector<double> m_Values;
+};
+
+
+static bool parseNumber( const std::string& aText, double* aValue )
+{
+    const char* start = aText.c_str();
+    char*       end;
+
+    errno = 0;
+    *aValue = strtod( start, &end );
+
+    return end != start && *end == 0 && errno == 0;
+}
+
+
+static std::vector<std::string> splitCSV( const std::string& aLine )
+{
+    std::vector<std::string> fields;
+    std::stringstream        stream( aLine );
+    std::string              field;
+
+    while( std::getline( stream, field, ',' ) )
+    {
+        size_t first = field.find_first_not_of( " \t\r\"" );
+        size_t last = field.find_last_not_of( " \t\r\"" );
+
+        fields.push_back( first == std::string::npos ? "" : field.substr( first, last - first + 1 ) );
+    }
+
+    return fields;
+}
+
+
+/// Reads the rows of aFileName, each one starting from aDefaults
+static bool readInput( const std::string& aFileName, const TRANSLINE_KIND& aKind,
+                       const TRANSLINE_PARAMS& aDefaults, std::vector<TRANSLINE_PARAMS>& aRows )
+{
+    std::ifstream file( aFileName );
+    std::string   line;
+
+    if( !file || !std::getline( file, line ) )
+    {
+        std::cerr << "Cannot read '" << aFileName << "'" << std::endl;
+        return false;
+    }
+
+    std::vector<PRMS_ID> columns;
+
+    for( const std::string& name : splitCSV( line ) )
+    {
+        PRMS_ID id = TranslinePrmFromName( name );
+
+        // Result columns, e.g. of a table written by this program, are ignored
+        if( id != UNKNOWN_ID && !aKind.HasPrm( id ) )
+        {
+            std::cerr << "'" << name << "' is not a parameter of " << aKind.m_Name << std::endl;
+            return false;
+        }
+
+        columns.push_back( id );
+    }
+
+    for( int row = 2; std::getline( file, line ); ++row )
+    {
+        if( line.find_first_not_of( " \t\r" ) == std::string::npos )
+            continue;
+
+        std::vector<std::string> fields = splitCSV( line );
+        TRANSLINE_PARAMS         params = aDefaults;
+
+        for( size_t ii = 0; ii < fields.size() && ii < columns.size(); ++ii )
+        {
+            if( columns[ii] == UNKNOWN_ID )
+                continue;
+
+            if( !parseNumber( fields[ii], &params.m_Prms[columns[ii]] ) )
+            {
+                std::cerr << aFileName << ":" << row << ": invalid value '" << fields[ii]
+                          << "'" << std::endl;
+                return false;
+            }
+        }
+
+        aRows.push_back( params );
+    }
+
+    return true;
+}
+
+
+/// Parses NAME=VALUE or NAME=FROM:TO:STEP
+static bool parseSweep( const std::string& aArg, const TRANSLINE_KIND& aKind, SWEEP* aSweep )
+{
+    size_t equal = aArg.find( '=' );
+
+    if( equal == std::string::npos )
+        return false;
+
+    aSweep->m_Id = TranslinePrmFromName( aArg.substr( 0, equal ) );
+
+    if( aSweep->m_Id == UNKNOWN_ID || !aKind.HasPrm( aSweep->m_Id ) )
+    {
+        std::cerr << "'" << aArg.substr( 0, equal ) << "' is not a parameter of "
+                  << aKind.m_Name << std::endl;
+        return false;
+    }
+
+    std::string range = aArg.substr( equal + 1 );
+    size_t      colon1 = range.find( ':' );
+    size_t      colon2 = colon1 == std::string::npos ? colon1 : range.find( ':', colon1 + 1 );
+    double      from, to, step;
+
+    if( colon1 == std::string::npos )
+    {
+        if( !parseNumber( range, &from ) )
+            return false;
+
+        aSweep->m_Values.push_back( from );
+        return true;
+    }
+
+    if( colon2 == std::string::npos
+        || !parseNumber( range.substr( 0, colon1 ), &from )
+        || !parseNumber( range.substr( colon1 + 1, colon2 - colon1 - 1 ), &to )
+        || !parseNumber( range.substr( colon2 + 1 ), &step )
+        || step <= 0.0 || to < from )
+    {
+        return false;
+    }
+
+    // Computed from the index, accumulating the step would drift
+    long count = lround( floor( ( to - from ) / step + 1e-9 ) ) + 1;
+
+    for( long ii = 0; ii < count; ++ii )
+        aSweep->m_Values.push_back( from + ii * step );
+
+    return true;
+}
+
+
+static std::string formatValue( double aValue )
+{
+    char buffer[32];
+
+    if( std::isnan( aValue ) )
+        return "";
+
+    snprintf( buffer, sizeof( buffer ), "%.10g", aValue );
+    return buffer;
+}
+
+
+static void writeTable( std::ostream& aStream, const TRANSLINE_KIND& aKind,
+                        const std::vector<TRANSLINE_PARAMS>& aRows )
+{
+    for( const TRANSLINE_KIND::PRM& prm : aKind.m_Prms )
+        aStream << TranslinePrmName( prm.m_Id ) << ",";
+
+    for( size_t ii = 0; ii < aKind.m_Results.size(); ++ii )
+        aStream << aKind.m_Results[ii] << ( ii + 1 < aKind.m_Results.size() ? "," : "\n" );
+
+    for( const TRANSLINE_PARAMS& row : aRows )
+    {
+        std::string line;
+
+        for( const TRANSLINE_KIND::PRM& prm : aKind.m_Prms )
+            line += formatValue( row.m_Prms[prm.m_Id] ) + ",";
+
+        for( size_t ii = 0; ii < aKind.m_Results.size(); ++ii )
+        {
+            if( !row.m_ResultTexts[ii].empty() )
+                line += "\"" + row.m_ResultTexts[ii] + "\"";
+            else
+                line += formatValue( row.m_Results[ii] );
+
+            line += ii + 1 < aKind.m_Results.size() ? "," : "\n";
+        }
+
+        aStream << line;
+    }
+}
+
+
+static int usage( const char* aProgram )
+{
+    std::cerr << "Usage: " << aProgram << " TYPE analyze|synthesize [OPTIONS]"
+                 " [NAME=VALUE|NAME=FROM:TO:STEP]...\n"
+                 "  --input FILE    reads the rows from a CSV file\n"
+                 "  --output FILE   writes the table to FILE instead of the standard output\n"
+                 "  --solve NAME    the parameter to synthesize, for lines having a choice\n"
+                 "  --threads N     computes the table on N threads, 0 for all hardware threads\n"
+                 "  --warm          starts each synthesis from the solution of the previous row\n"
+                 "Types:";
+
+    for( const TRANSLINE_KIND& kind : TranslineKinds() )
+    {
+        std::cerr << "\n  " << kind.m_Name << ":";
+
+        for( const TRANSLINE_KIND::PRM& prm : kind.m_Prms )
+            std::cerr << " " << TranslinePrmName( prm.m_Id );
+    }
+
+    std::cerr << std::endl;
+    return 1;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+        return usage( argv[0] );
+
+    const TRANSLINE_KIND* kind = FindTranslineKind( argv[1] );
+
+    if( !kind )
+    {
+        std::cerr << "Unknown line type '" << argv[1] << "'" << std::endl;
+        return usage( argv[0] );
+    }
+
+    TRANSLINE_BATCH::MODE mode;
+
+    if( strcmp( argv[2], "analyze" ) == 0 )
+        mode = TRANSLINE_BATCH::ANALYZE;
+    else if( strcmp( argv[2], "synthesize" ) == 0 )
+        mode = TRANSLINE_BATCH::SYNTHESIZE;
+    else
+        return usage( argv[0] );
+
+    TRANSLINE_BATCH    batch( *kind );
+    TRANSLINE_PARAMS   defaults;
+    std::string        inputFile;
+    std::string        outputFile;
+    std::vector<SWEEP> sweeps;
+
+    kind->SetDefaults( defaults );
+
+    for( int i = 3; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        bool        hasValue = i + 1 < argc;
+
+        if( arg == "--input" && hasValue )
+        {
+            inputFile = argv[++i];
+        }
+        else if( arg == "--output" && hasValue )
+        {
+            outputFile = argv[++i];
+        }
+        else if( arg == "--solve" && hasValue )
+        {
+            defaults.m_Selected = TranslinePrmFromName( argv[++i] );
+
+            if( !kind->HasPrm( defaults.m_Selected ) )
+                return usage( argv[0] );
+        }
+        else if( arg == "--threads" && hasValue )
+        {
+            batch.SetThreadCount( (unsigned) atoi( argv[++i] ) );
+        }
+        else if( arg == "--warm" )
+        {
+            batch.SetWarmStart( true );
+        }
+        else
+        {
+            SWEEP sweep;
+
+            if( !parseSweep( arg, *kind, &sweep ) )
+            {
+                std::cerr << "Invalid argument '" << arg << "'" << std::endl;
+                return usage( argv[0] );
+            }
+
+            sweeps.push_back( sweep );
+        }
+    }
+
+    std::vector<TRANSLINE_PARAMS> rows;
+
+    if( inputFile.empty() )
+        rows.push_back( defaults );
+    else if( !readInput( inputFile, *kind, defaults, rows ) )
+        return 1;
+
+    // Expand the sweeps, the last one in the inner loop
+    for( const SWEEP& sweep : sweeps )
+    {
+        std::vector<TRANSLINE_PARAMS> expanded;
+
+        expanded.reserve( rows.size() * sweep.m_Values.size() );
+
+        for( const TRANSLINE_PARAMS& row : rows )
+        {
+            for( double value : sweep.m_Values )
+            {
+                expanded.push_back( row );
+                expanded.back().m_Prms[sweep.m_Id] = value;
+            }
+        }
+
+        rows.swap( expanded );
+    }
+
+    batch.Run( mode, rows );
+
+    if( outputFile.empty() )
+    {
+        writeTable( std::cout, *kind, rows );
+        return 0;
+    }
+
+    std::ofstream output( outputFile );
+
+    if( output )
+        writeTable( output, *kind, rows );
+
+    if( !output )
+    {
+        std::cerr << "Cannot write '" << outputFile << "'" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
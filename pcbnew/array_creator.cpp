@@ -28,15 +28,13 @@
 
 #include "array_creator.h"
 #include <board_commit.h>
+#include <task_scheduler.h>
 
 #include <dialogs/dialog_create_array.h>
 
 #ifdef PCBNEW_WITH_TRACKITEMS
 #include "drc_stuff.h"
 #include "trackitems/viastitching.h"
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif
 #endif
 
 void ARRAY_CREATOR::Invoke()
@@ -73,14 +71,14 @@ void ARRAY_CREATOR::Invoke()
             item = static_cast<MODULE*>( item )->GetParent();
         }
 
-#ifdef PCBNEW_WITH_TRACKITEMS
-        std::set<BOARD_ITEM*> newitems;
-#ifdef USE_OPENMP
-    #pragma omp parallel for schedule(dynamic)
-#endif
-#endif
+        const int arraySize = array_opts->GetArraySize();
+        std::vector<BOARD_ITEM*> newItems( arraySize, nullptr );
+        TASK_GROUP group;
+
+        // Creating and placing the copies is independent for each of them, so it is spread
+        // over the task pool. Everything touching the board or the commit stays sequential.
         // The first item in list is the original item. We do not modify it
-        for( int ptN = 1; ptN < array_opts->GetArraySize(); ptN++ )
+        group.ParallelFor( 1, arraySize, [&]( int ptN )
         {
             BOARD_ITEM* new_item;
 
@@ -99,25 +97,15 @@ void ARRAY_CREATOR::Invoke()
                 // the undo command needs saving old area, if it is merged.
             }
 
-            if( new_item )
-            {
-                array_opts->TransformItem( ptN, new_item, rotPoint );
+            if( !new_item )
+                return;
 
-#ifdef PCBNEW_WITH_TRACKITEMS
-                if( getBoard()->ViaStitching()->AddViaArrayDestroyConflicts( new_item, &m_parent ) )
-                    continue;
-                newitems.insert( new_item );
-#else
-                prePushAction( new_item );
-                commit.Add( new_item );
-                postPushAction( new_item );
-#endif
-            }
+            array_opts->TransformItem( ptN, new_item, rotPoint );
 
             // attempt to renumber items if the array parameters define
             // a complete numbering scheme to number by (as opposed to
             // implicit numbering by incrementing the items during creation
-            if( new_item && array_opts->NumberingStartIsSpecified() )
+            if( array_opts->NumberingStartIsSpecified() )
             {
                 // Renumber pads. Only new pad number renumbering has meaning,
                 // in the footprint editor.
@@ -127,16 +115,27 @@ void ARRAY_CREATOR::Invoke()
                     static_cast<D_PAD*>( new_item )->SetPadName( padName );
                 }
             }
-        }
 
-#ifdef PCBNEW_WITH_TRACKITEMS
-        for( auto newitem : newitems )
+            newItems[ptN] = new_item;
+        } );
+
+        for( int ptN = 1; ptN < arraySize; ptN++ )
         {
-            prePushAction( newitem );
-            commit.Add( newitem );
-            postPushAction( newitem );
-        }
+            BOARD_ITEM* new_item = newItems[ptN];
+
+            if( !new_item )
+                continue;
+
+#ifdef PCBNEW_WITH_TRACKITEMS
+            // Runs the DRC, which is not thread safe, and may delete the item
+            if( getBoard()->ViaStitching()->AddViaArrayDestroyConflicts( new_item, &m_parent ) )
+                continue;
 #endif
+
+            prePushAction( new_item );
+            commit.Add( new_item );
+            postPushAction( new_item );
+        }
     }
 
     commit.Push( _( "Create an array" ) );
@@ -799,6 +799,9 @@ void PCB_BASE_FRAME::OnModify()
     GetScreen()->SetModify();
     GetScreen()->SetSave();
 
+    if( GetBoard() )
+        GetBoard()->IncrementModificationStamp();
+
     if( IsGalCanvasActive() )
     {
         UpdateStatusBar();
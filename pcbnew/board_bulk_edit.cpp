@@ -0,0 +1,252 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+#include <wxBasePcbFrame.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <pcbnew.h>
+#include <drc_stuff.h>
+#include <board_commit.h>
+#include <board_bulk_edit.h>
+
+#include <set>
+
+
+BOARD_BULK_EDIT::BOARD_BULK_EDIT( PCB_BASE_FRAME* aFrame ) :
+    m_frame( aFrame )
+{
+}
+
+
+void BOARD_BULK_EDIT::GetTrackSizes( TRACK* aTrack, const BOARD_DESIGN_SETTINGS& aSettings,
+                                     bool aUseNetclassValue, int* aWidth, int* aDrill )
+{
+    NETINFO_ITEM* net = aUseNetclassValue ? aTrack->GetNet() : NULL;
+
+    *aWidth = net ? net->GetTrackWidth() : aSettings.GetCurrentTrackWidth();
+    *aDrill = -1;
+
+    if( aTrack->Type() != PCB_VIA_T )
+        return;
+
+    const VIA* via = static_cast<const VIA*>( aTrack );
+
+    // Micro vias have a size only defined in their netclass
+    // (no specific values defined by a table of specific value)
+    // Ensure the netclass is accessible:
+    if( via->GetViaType() == VIA_MICROVIA && net == NULL )
+        net = aTrack->GetNet();
+
+    if( net )
+    {
+        *aWidth = net->GetViaSize();
+        *aDrill = net->GetViaDrillSize();
+    }
+    else
+    {
+        *aWidth = aSettings.GetCurrentViaSize();
+        *aDrill = aSettings.GetCurrentViaDrill();
+    }
+
+    if( via->GetViaType() == VIA_MICROVIA && net )
+    {
+        *aWidth = net->GetMicroViaSize();
+        *aDrill = net->GetMicroViaDrillSize();
+    }
+}
+
+
+void BOARD_BULK_EDIT::AddTrackResize( TRACK* aTrack, bool aUseNetclassValue )
+{
+    int width, drill;
+
+    GetTrackSizes( aTrack, m_frame->GetDesignSettings(), aUseNetclassValue, &width, &drill );
+
+    if( width == aTrack->GetWidth() )
+    {
+        if( aTrack->Type() != PCB_VIA_T )
+            return;
+
+        // Old versions set a drill value <= 0, when the default netclass it used:
+        // the drill of these vias is always re-initialized
+        const VIA* via = static_cast<const VIA*>( aTrack );
+        int initialDrill = via->GetDrill() <= 0 ? -1 : via->GetDrillValue();
+
+        if( drill == initialDrill )
+            return;
+    }
+
+    m_trackChanges.push_back( { aTrack, width, drill, width > aTrack->GetWidth() } );
+}
+
+
+void BOARD_BULK_EDIT::AddPadEdit( D_PAD* aPad, const D_PAD* aPattern, double aOrientation )
+{
+    m_padChanges.push_back( { aPad, aPattern, aOrientation } );
+}
+
+
+int BOARD_BULK_EDIT::RejectDrcErrors( DRC* aDrc )
+{
+    TRACK* trackList = m_frame->GetBoard()->m_Track;
+    std::vector<int> initialWidths;
+    std::vector<bool> rejected( m_trackChanges.size(), false );
+    int rejectedCount = 0;
+
+    // Tracks are tested against the board as it will be after the edit
+    initialWidths.reserve( m_trackChanges.size() );
+
+    for( const TRACK_CHANGE& change : m_trackChanges )
+    {
+        initialWidths.push_back( change.m_track->GetWidth() );
+        change.m_track->SetWidth( change.m_width );
+    }
+
+    for( unsigned ii = 0; ii < m_trackChanges.size(); ii++ )
+    {
+        if( m_trackChanges[ii].m_wider
+            && aDrc->Drc( m_trackChanges[ii].m_track, trackList ) != OK_DRC )
+        {
+            rejected[ii] = true;
+            rejectedCount++;
+        }
+    }
+
+    for( unsigned ii = 0; ii < m_trackChanges.size(); ii++ )
+        m_trackChanges[ii].m_track->SetWidth( initialWidths[ii] );
+
+    if( rejectedCount )
+    {
+        unsigned kept = 0;
+
+        for( unsigned ii = 0; ii < m_trackChanges.size(); ii++ )
+        {
+            if( !rejected[ii] )
+                m_trackChanges[kept++] = m_trackChanges[ii];
+        }
+
+        m_trackChanges.resize( kept );
+    }
+
+    return rejectedCount;
+}
+
+
+void BOARD_BULK_EDIT::ApplyPadSettings( D_PAD* aPad, const D_PAD* aPattern, double aOrientation )
+{
+    MODULE* module = aPad->GetParent();
+
+    // Change characteristics:
+    aPad->SetAttribute( aPattern->GetAttribute() );
+    aPad->SetShape( aPattern->GetShape() );
+
+    aPad->SetLayerSet( aPattern->GetLayerSet() );
+
+    aPad->SetSize( aPattern->GetSize() );
+    aPad->SetDelta( aPattern->GetDelta() );
+    aPad->SetOffset( aPattern->GetOffset() );
+
+    aPad->SetDrillSize( aPattern->GetDrillSize() );
+    aPad->SetDrillShape( aPattern->GetDrillShape() );
+
+    aPad->SetOrientation( aOrientation + module->GetOrientation() );
+
+    // copy also local mask margins, because these parameters usually depend on
+    // pad sizes and layers
+    aPad->SetLocalSolderMaskMargin( aPattern->GetLocalSolderMaskMargin() );
+    aPad->SetLocalSolderPasteMargin( aPattern->GetLocalSolderPasteMargin() );
+    aPad->SetLocalSolderPasteMarginRatio( aPattern->GetLocalSolderPasteMarginRatio() );
+
+    if( aPad->GetShape() != PAD_SHAPE_TRAPEZOID )
+    {
+        aPad->SetDelta( wxSize( 0, 0 ) );
+    }
+
+    if( aPad->GetShape() == PAD_SHAPE_CIRCLE )
+    {
+        // Ensure pad size.y = pad size.x
+        int size = aPad->GetSize().x;
+        aPad->SetSize( wxSize( size, size ) );
+    }
+
+    switch( aPad->GetAttribute() )
+    {
+    case PAD_ATTRIB_SMD:
+    case PAD_ATTRIB_CONN:
+        aPad->SetDrillSize( wxSize( 0, 0 ) );
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void BOARD_BULK_EDIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
+{
+    if( Empty() )
+        return;
+
+    BOARD_COMMIT commit( m_frame );
+
+    for( const TRACK_CHANGE& change : m_trackChanges )
+    {
+        commit.Modify( change.m_track );
+        change.m_track->SetWidth( change.m_width );
+
+        if( change.m_track->Type() == PCB_VIA_T )
+        {
+            // Set new drill value. Note: currently microvias have only a default drill value
+            VIA* via = static_cast<VIA*>( change.m_track );
+
+            if( change.m_drill > 0 )
+                via->SetDrill( change.m_drill );
+            else
+                via->SetDrillDefault();
+        }
+    }
+
+    // A footprint is saved once, before the change of its first pad
+    std::set<MODULE*> modules;
+
+    for( const PAD_CHANGE& change : m_padChanges )
+    {
+        commit.Modify( change.m_pad );
+        ApplyPadSettings( change.m_pad, change.m_pattern, change.m_orientation );
+        modules.insert( change.m_pad->GetParent() );
+    }
+
+    for( MODULE* module : modules )
+        module->CalculateBoundingBox();
+
+    // Pads may have new layers or attributes: the connectivity is rebuilt once for all
+    if( !m_padChanges.empty() )
+        m_frame->GetBoard()->m_Status_Pcb &= ~( LISTE_RATSNEST_ITEM_OK | CONNEXION_OK );
+
+    m_trackChanges.clear();
+    m_padChanges.clear();
+
+    commit.Push( aMessage, aCreateUndoEntry );
+}
@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __BOARD_BULK_EDIT_H
+#define __BOARD_BULK_EDIT_H
+
+#include <vector>
+
+#include <wx/string.h>
+
+class BOARD_DESIGN_SETTINGS;
+class D_PAD;
+class DRC;
+class PCB_BASE_FRAME;
+class TRACK;
+
+/**
+ * Class BOARD_BULK_EDIT
+ *
+ * Edits many board items as a single change. The new state of every item is computed
+ * first, then Push() modifies all the items in one BOARD_COMMIT: one undo entry, and one
+ * update of the view, the ratsnest and the track items for the whole edit.
+ */
+class BOARD_BULK_EDIT
+{
+public:
+    BOARD_BULK_EDIT( PCB_BASE_FRAME* aFrame );
+
+    /**
+     * Function AddTrackResize
+     * queues the change of a track width, or a via diameter and drill, to the values of its
+     * netclass (aUseNetclassValue) or to the current values of the design settings. Nothing
+     * is queued if the item has already these sizes.
+     */
+    void AddTrackResize( TRACK* aTrack, bool aUseNetclassValue );
+
+    /**
+     * Function AddPadEdit
+     * queues the copy of the shape, size, drill, layers and margins of aPattern to aPad.
+     * @param aOrientation the orientation of aPad relative to its footprint
+     */
+    void AddPadEdit( D_PAD* aPad, const D_PAD* aPattern, double aOrientation );
+
+    /**
+     * Function RejectDrcErrors
+     * drops the queued track resizes which make a track wider and fail the DRC test. The
+     * tracks are tested once all the queued resizes are applied.
+     * @return the number of dropped resizes
+     */
+    int RejectDrcErrors( DRC* aDrc );
+
+    bool Empty() const
+    {
+        return m_trackChanges.empty() && m_padChanges.empty();
+    }
+
+    /**
+     * Function Push
+     * applies all the queued changes as a single commit, and clears the queue.
+     */
+    void Push( const wxString& aMessage, bool aCreateUndoEntry = true );
+
+    /**
+     * Function GetTrackSizes
+     * computes the width (or via diameter) and the via drill aTrack would have with the
+     * values of its netclass or the current values of aSettings.
+     * @param aDrill receives the via drill, -1 for the default drill of the via
+     */
+    static void GetTrackSizes( TRACK* aTrack, const BOARD_DESIGN_SETTINGS& aSettings,
+                               bool aUseNetclassValue, int* aWidth, int* aDrill );
+
+    /// Copies the settings of aPattern to aPad, see AddPadEdit()
+    static void ApplyPadSettings( D_PAD* aPad, const D_PAD* aPattern, double aOrientation );
+
+private:
+    struct TRACK_CHANGE
+    {
+        TRACK*  m_track;
+        int     m_width;
+        int     m_drill;
+        bool    m_wider;    ///< needs a DRC test
+    };
+
+    struct PAD_CHANGE
+    {
+        D_PAD*          m_pad;
+        const D_PAD*    m_pattern;
+        double          m_orientation;
+    };
+
+    PCB_BASE_FRAME*             m_frame;
+    std::vector<TRACK_CHANGE>   m_trackChanges;
+    std::vector<PAD_CHANGE>     m_padChanges;
+};
+
+#endif
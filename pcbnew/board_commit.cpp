@@ -31,12 +31,18 @@
 #include <board_commit.h>
 #include <tools/pcb_tool.h>
 
+#include <algorithm>
 #include <functional>
+#include <unordered_map>
 #ifdef PCBNEW_WITH_TRACKITEMS
 #include "trackitems/trackitems.h"
 #endif
 using namespace std::placeholders;
 
+// Objects keeping data derived from boards, notified about every commit
+static std::vector<BOARD_COMMIT_LISTENER*> commitListeners;
+
+
 BOARD_COMMIT::BOARD_COMMIT( PCB_TOOL* aTool )
 {
     m_toolMgr = aTool->GetManager();
@@ -65,6 +71,33 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
     PCB_BASE_FRAME* frame = (PCB_BASE_FRAME*) m_toolMgr->GetEditFrame();
     RN_DATA* ratsnest = board->GetRatsnest();
     std::set<EDA_ITEM*> savedModules;
+    BOARD_CHANGES changes;
+
+    // The board is modified item by item, but the data derived from it (view, ratsnest, track
+    // items) is updated afterwards, once for the whole commit.
+    std::vector<KIGFX::VIEW_ITEM*> viewAdded;
+    std::vector<KIGFX::VIEW_ITEM*> viewRemoved;
+    std::vector<BOARD_ITEM*> modified;
+
+    // The last view change of each item: true if it was removed, false if it was added.
+    // An item may be added or modified then removed, or removed then added again, in the
+    // same commit: only its last change counts.
+    std::unordered_map<KIGFX::VIEW_ITEM*, bool> lastRemoved;
+
+    auto addToView = [&viewAdded, &lastRemoved] ( KIGFX::VIEW_ITEM* aItem )
+    {
+        viewAdded.push_back( aItem );
+        lastRemoved[aItem] = false;
+    };
+
+    auto removeFromView = [&viewRemoved, &lastRemoved] ( KIGFX::VIEW_ITEM* aItem )
+    {
+        viewRemoved.push_back( aItem );
+        lastRemoved[aItem] = true;
+    };
+
+    // Module items removed in the module editor, freed once the listeners have seen them
+    std::vector<BOARD_ITEM*> deleted;
 
     if( Empty() )
         return;
@@ -131,7 +164,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                     if( boardItem->Type() == PCB_MODULE_T )
                     {
                         MODULE* mod = static_cast<MODULE*>( boardItem );
-                        mod->RunOnChildren( std::bind( &KIGFX::VIEW::Add, view, _1, -1 ) );
+                        mod->RunOnChildren( addToView );
                     }
                 }
                 else
@@ -143,7 +176,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                         board->m_Modules->Add( boardItem );
                 }
 
-                view->Add( boardItem );
+                addToView( boardItem );
+                changes.m_added.push_back( boardItem );
 
 #ifdef PCBNEW_WITH_TRACKITEMS
                 board->TrackItems()->GalRouteCommitAdd( boardItem, &undoList );
@@ -202,13 +236,15 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
 
                     if( remove )
                     {
-                        view->Remove( boardItem );
+                        removeFromView( boardItem );
+                        changes.m_removed.push_back( boardItem );
 
                         if( !( changeFlags & CHT_DONE ) )
                         {
                             MODULE* module = static_cast<MODULE*>( boardItem->GetParent() );
                             assert( module && module->Type() == PCB_MODULE_T );
-                            module->Delete( boardItem );
+                            module->Remove( boardItem );
+                            deleted.push_back( boardItem );
                         }
 
                         board->m_Status_Pcb = 0; // it is done in the legacy view (ratsnest perhaps?)
@@ -233,7 +269,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                 case PCB_MARKER_T:              // a marker used to show something
                 case PCB_ZONE_T:                // SEG_ZONE items are now deprecated
                 case PCB_ZONE_AREA_T:
-                    view->Remove( boardItem );
+                    removeFromView( boardItem );
+                    changes.m_removed.push_back( boardItem );
 
                     if( !( changeFlags & CHT_DONE ) )
                         board->Remove( boardItem );
@@ -248,9 +285,10 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
 
                     MODULE* module = static_cast<MODULE*>( boardItem );
                     module->ClearFlags();
-                    module->RunOnChildren( std::bind( &KIGFX::VIEW::Remove, view, _1 ) );
+                    module->RunOnChildren( removeFromView );
 
-                    view->Remove( module );
+                    removeFromView( module );
+                    changes.m_removed.push_back( module );
 
                     if( !( changeFlags & CHT_DONE ) )
                         board->Remove( module );
@@ -277,18 +315,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                     undoList.PushItem( itemWrapper );
                 }
 
-                if( boardItem->Type() == PCB_MODULE_T )
-                {
-                    MODULE* module = static_cast<MODULE*>( boardItem );
-                    module->RunOnChildren( [&view] ( BOARD_ITEM* aItem ) { view->Update( aItem ); } );
-                }
-
-#ifdef PCBNEW_WITH_TRACKITEMS
-                board->TrackItems()->Teardrops()->UpdateListAdd( boardItem );
-                board->TrackItems()->RoundedTracksCorners()->UpdateListAdd( boardItem );
-#endif
-                view->Update ( boardItem );
-                ratsnest->Update( boardItem );
+                modified.push_back( boardItem );
+                changes.m_modified.emplace_back( boardItem, static_cast<BOARD_ITEM*>( ent.m_copy ) );
                 break;
             }
 
@@ -298,11 +326,66 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
         }
     }
 
+    // Items whose last change is a removal are neither added to the view nor updated, and
+    // the module items are freed only if they were not added back.
+    auto isGone = [&lastRemoved] ( KIGFX::VIEW_ITEM* aItem )
+    {
+        auto it = lastRemoved.find( aItem );
+        return it != lastRemoved.end() && it->second;
+    };
+
+    modified.erase( std::remove_if( modified.begin(), modified.end(), isGone ), modified.end() );
+    viewAdded.erase( std::remove_if( viewAdded.begin(), viewAdded.end(), isGone ),
+                     viewAdded.end() );
+    deleted.erase( std::remove_if( deleted.begin(), deleted.end(),
+                                   [&isGone] ( BOARD_ITEM* aItem ) { return !isGone( aItem ); } ),
+                   deleted.end() );
+
+    // An item removed, added back and removed again is freed once
+    std::sort( deleted.begin(), deleted.end() );
+    deleted.erase( std::unique( deleted.begin(), deleted.end() ), deleted.end() );
+
+    std::vector<const BOARD_ITEM*> ratsnestUpdated( modified.begin(), modified.end() );
+
+    view->RemoveItems( viewRemoved );
+    view->AddItems( viewAdded );
+
+    for( BOARD_ITEM* item : modified )
+    {
+        if( item->Type() == PCB_MODULE_T )
+        {
+            MODULE* module = static_cast<MODULE*>( item );
+            module->RunOnChildren( [&view] ( BOARD_ITEM* aItem ) { view->Update( aItem ); } );
+        }
+
+        view->Update( item );
+
+#ifdef PCBNEW_WITH_TRACKITEMS
+        board->TrackItems()->Teardrops()->UpdateListAdd( item );
+        board->TrackItems()->RoundedTracksCorners()->UpdateListAdd( item );
+#endif
+    }
+
+    // One task per affected net
+    ratsnest->Update( ratsnestUpdated );
+
 #ifdef PCBNEW_WITH_TRACKITEMS
+    // Only the track items of the modified nets are updated, one task per net
     board->TrackItems()->RoundedTracksCorners()->UpdateListDo();
     board->TrackItems()->Teardrops()->UpdateListDo();
 #endif
 
+    // The board modification stamp is incremented before the listeners are notified, so
+    // they know which stamp their data is up to date with
+    frame->OnModify();
+
+    // Notify before the undo list is saved, as it may free items in the process
+    for( BOARD_COMMIT_LISTENER* listener : commitListeners )
+        listener->OnBoardCommit( board, changes );
+
+    for( BOARD_ITEM* item : deleted )
+        delete item;
+
     if( !m_editModules && aCreateUndoEntry )
         frame->SaveCopyInUndoList( undoList, UR_UNSPECIFIED );
 
@@ -310,7 +393,6 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
         toolMgr->PostEvent( { TC_MESSAGE, TA_MODEL_CHANGE, AS_GLOBAL } );
 
     ratsnest->Recalculate();
-    frame->OnModify();
     frame->UpdateMsgPanel();
 
     clear();
@@ -423,5 +505,30 @@ void BOARD_COMMIT::Revert()
 
     ratsnest->Recalculate();
 
+    // SwapData() replaces the children of modules, so the changes cannot be replayed
+    if( !m_changes.empty() )
+        InvalidateListeners( board );
+
     clear();
 }
+
+
+void BOARD_COMMIT::AddListener( BOARD_COMMIT_LISTENER* aListener )
+{
+    if( std::find( commitListeners.begin(), commitListeners.end(), aListener ) == commitListeners.end() )
+        commitListeners.push_back( aListener );
+}
+
+
+void BOARD_COMMIT::RemoveListener( BOARD_COMMIT_LISTENER* aListener )
+{
+    commitListeners.erase( std::remove( commitListeners.begin(), commitListeners.end(), aListener ),
+                           commitListeners.end() );
+}
+
+
+void BOARD_COMMIT::InvalidateListeners( BOARD* aBoard )
+{
+    for( BOARD_COMMIT_LISTENER* listener : commitListeners )
+        listener->OnBoardInvalidated( aBoard );
+}
@@ -27,12 +27,55 @@
 
 #include <commit.h>
 
+#include <utility>
+#include <vector>
+
+class BOARD;
 class BOARD_ITEM;
 class PICKED_ITEMS_LIST;
 class PCB_TOOL;
 class PCB_BASE_FRAME;
 class TOOL_MANAGER;
 
+/**
+ * Struct BOARD_CHANGES
+ *
+ * Items touched by a single commit. Removed items are still valid objects when
+ * the listeners are notified, modified items come with the copy taken before
+ * the modification.
+ */
+struct BOARD_CHANGES
+{
+    std::vector<BOARD_ITEM*> m_added;
+    std::vector<BOARD_ITEM*> m_removed;
+    std::vector<std::pair<BOARD_ITEM*, BOARD_ITEM*>> m_modified;
+
+    bool Empty() const
+    {
+        return m_added.empty() && m_removed.empty() && m_modified.empty();
+    }
+};
+
+/**
+ * Class BOARD_COMMIT_LISTENER
+ *
+ * Interface for objects keeping data derived from a board (e.g. the router world),
+ * which would rather apply the changes of each commit than rebuild everything.
+ */
+class BOARD_COMMIT_LISTENER
+{
+public:
+    virtual ~BOARD_COMMIT_LISTENER() {}
+
+    ///> Called after the changes of a commit have been applied to aBoard and its
+    ///> modification stamp incremented (see BOARD::GetModificationStamp()).
+    virtual void OnBoardCommit( BOARD* aBoard, const BOARD_CHANGES& aChanges ) = 0;
+
+    ///> Called when aBoard has been modified in a way that is not described by a
+    ///> list of changes (reverted commit, undo/redo), so derived data has to be resynced.
+    virtual void OnBoardInvalidated( BOARD* aBoard ) = 0;
+};
+
 class BOARD_COMMIT : public COMMIT
 {
 public:
@@ -43,6 +86,13 @@ public:
     virtual void Push( const wxString& aMessage = wxT( "A commit" ), bool aCreateUndoEntry = true ) override;
     virtual void Revert() override;
 
+    ///> Registers a listener to be notified about all commits, regardless of the board.
+    static void AddListener( BOARD_COMMIT_LISTENER* aListener );
+    static void RemoveListener( BOARD_COMMIT_LISTENER* aListener );
+
+    ///> Notifies the listeners that aBoard has been modified without a commit.
+    static void InvalidateListeners( BOARD* aBoard );
+
 private:
     TOOL_MANAGER* m_toolMgr;
     bool m_editModules;
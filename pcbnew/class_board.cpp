@@ -80,6 +80,7 @@ BOARD::BOARD() :
     m_fileFormatVersionAtLoad = LEGACY_BOARD_FILE_VERSION;
 
     m_Status_Pcb    = 0;                    // Status word: bit 1 = calculate.
+    m_modificationStamp = 0;
     SetColorsSettings( &g_ColorsSettings );
     m_nodeCount     = 0;                    // Number of connected pads.
     m_unconnectedNetCount   = 0;            // Number of unconnected nets.
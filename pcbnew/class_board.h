@@ -186,6 +186,8 @@ private:
 
     LAYER                   m_Layer[PCB_LAYER_ID_COUNT];
 
+    unsigned                m_modificationStamp;    ///< see GetModificationStamp()
+
                                                     // if true m_highLight_NetCode is used
     HIGH_LIGHT_INFO         m_highLight;                // current high light data
     HIGH_LIGHT_INFO         m_highLightPrevious;        // a previously stored high light data
@@ -258,6 +260,15 @@ public:
     /// Flags used in ratsnest calculation and update.
     int m_Status_Pcb;
 
+    /**
+     * Function GetModificationStamp
+     * @return a counter incremented each time the board is reported modified (see
+     * PCB_BASE_FRAME::OnModify()), to tell cheaply if it changed since a given time.
+     */
+    unsigned GetModificationStamp() const { return m_modificationStamp; }
+
+    void IncrementModificationStamp() { ++m_modificationStamp; }
+
     DLIST<BOARD_ITEM>           m_Drawings;              // linked list of lines & texts
     DLIST<MODULE>               m_Modules;               // linked list of MODULEs
     DLIST<TRACK>                m_Track;                 // linked list of TRACKs and VIAs
@@ -37,8 +37,8 @@
 #include <ratsnest_data.h>
 
 BOARD_CONNECTED_ITEM::BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype ) :
-    BOARD_ITEM( aParent, idtype ), m_netinfo( &NETINFO_LIST::ORPHANED_ITEM ),
-    m_Subnet( 0 ), m_ZoneSubnet( 0 )
+    BOARD_ITEM( aParent, idtype ), m_Subnet( 0 ), m_netinfo( &NETINFO_LIST::ORPHANED_ITEM ),
+    m_ZoneSubnet( 0 )
 {
 }
 
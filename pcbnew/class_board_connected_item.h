@@ -33,6 +33,7 @@
 
 #include <class_board_item.h>
 #include <class_netinfo.h>
+#include <compact_vector.h>
 
 class NETCLASS;
 class TRACK;
@@ -49,10 +50,17 @@ class BOARD_CONNECTED_ITEM : public BOARD_ITEM
 {
     friend class CONNECTIONS;
 
+private:
+    // Declared first so it can use the tail padding of BOARD_ITEM
+    int         m_Subnet;       /* In rastnest routines : for the current net, block number
+                                 * (number common to the current connected items found)
+                                 */
+
 public:
-    // These 2 members are used for temporary storage during connections calculations:
-    std::vector<TRACK*> m_TracksConnected;      // list of other tracks connected to me
-    std::vector<D_PAD*> m_PadsConnected;        // list of other pads connected to me
+    // These 2 members are used for temporary storage during connections calculations.
+    // They are empty most of the time, so they take a single pointer each.
+    COMPACT_VECTOR<TRACK*> m_TracksConnected;   // list of other tracks connected to me
+    COMPACT_VECTOR<D_PAD*> m_PadsConnected;     // list of other pads connected to me
 
     BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype );
 
@@ -199,10 +207,6 @@ protected:
     NETINFO_ITEM* m_netinfo;
 
 private:
-    int         m_Subnet;       /* In rastnest routines : for the current net, block number
-                                 * (number common to the current connected items found)
-                                 */
-
     int         m_ZoneSubnet;   // used in rastnest computations : for the current net,
                                 // handle cluster number in zone connection
 };
@@ -616,10 +616,17 @@ private:    // Private variable members:
 
     wxPoint     m_Pos;              ///< pad Position on board
 
+    // The enums are kept together to avoid padding between the members
+
     PAD_SHAPE_T m_padShape;         ///< Shape: PAD_SHAPE_CIRCLE, PAD_SHAPE_RECT,
                                     ///< PAD_SHAPE_OVAL, PAD_SHAPE_TRAPEZOID,
                                     ///< PAD_SHAPE_ROUNDRECT, PAD_SHAPE_POLYGON
 
+    PAD_DRILL_SHAPE_T m_drillShape; ///< PAD_DRILL_SHAPE_CIRCLE, PAD_DRILL_SHAPE_OBLONG
+
+    PAD_ATTR_T  m_Attribute;        ///< PAD_ATTRIB_NORMAL, PAD_ATTRIB_SMD,
+                                    ///< PAD_ATTRIB_CONN, PAD_ATTRIB_HOLE_NOT_PLATED
+
     int         m_SubRatsnest;      ///< variable used in rats nest computations
                                     ///< handle subnet (block) number in ratsnest connection
 
@@ -629,8 +636,6 @@ private:    // Private variable members:
 
     wxSize      m_Size;             ///< X and Y size ( relative to orient 0)
 
-    PAD_DRILL_SHAPE_T m_drillShape; ///< PAD_DRILL_SHAPE_CIRCLE, PAD_DRILL_SHAPE_OBLONG
-
     double      m_padRoundRectRadiusScale;  ///< scaling factor from smallest m_Size coord
                                             ///< to corner radius, default 0.25
 
@@ -659,8 +664,6 @@ private:    // Private variable members:
     wxPoint     m_Pos0;             ///< Initial Pad position (i.e. pad position relative to the
                                     ///< module anchor, orientation 0)
 
-    PAD_ATTR_T  m_Attribute;        ///< PAD_ATTRIB_NORMAL, PAD_ATTRIB_SMD,
-                                    ///< PAD_ATTRIB_CONN, PAD_ATTRIB_HOLE_NOT_PLATED
     double      m_Orient;           ///< in 1/10 degrees
 
     int         m_LengthPadToDie;   ///< Length net from pad to die, inside the package
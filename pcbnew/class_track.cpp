@@ -102,7 +102,6 @@ TRACK::TRACK( BOARD_ITEM* aParent, KICAD_T idtype ) :
 {
     m_Width = Millimeter2iu( 0.2 );
     start   = end = NULL;
-    m_Param = 0;
 }
 
 
@@ -168,12 +167,92 @@ VIA::VIA( BOARD_ITEM* aParent ) :
 
 #ifdef PCBNEW_WITH_TRACKITEMS
     m_thermal = 0;
-    m_thermal_zones.clear();
-    m_thermal_polys_zones.clear();
 #endif
 }
 
 
+#ifdef PCBNEW_WITH_TRACKITEMS
+VIA::VIA( const VIA& aOther ) :
+    TRACK( aOther ),
+    m_BottomLayer( aOther.m_BottomLayer ),
+    m_ViaType( aOther.m_ViaType ),
+    m_Drill( aOther.m_Drill ),
+    m_thermal( aOther.m_thermal )
+{
+    if( aOther.m_thermalZones )
+        m_thermalZones.reset( new THERMAL_ZONES( *aOther.m_thermalZones ) );
+}
+
+
+VIA& VIA::operator=( const VIA& aOther )
+{
+    if( this == &aOther )
+        return *this;
+
+    TRACK::operator=( aOther );
+    m_BottomLayer = aOther.m_BottomLayer;
+    m_ViaType = aOther.m_ViaType;
+    m_Drill = aOther.m_Drill;
+    m_thermal = aOther.m_thermal;
+    m_thermalZones.reset( aOther.m_thermalZones ? new THERMAL_ZONES( *aOther.m_thermalZones )
+                                                : nullptr );
+
+    return *this;
+}
+
+
+std::vector<ZONE_CONTAINER*>* VIA::GetThermalZones()
+{
+    static std::vector<ZONE_CONTAINER*> noZones;
+
+    return m_thermalZones ? &m_thermalZones->m_zones : &noZones;
+}
+
+
+void VIA::SetThermalZones( std::vector<ZONE_CONTAINER*>& aZones )
+{
+    if( !m_thermalZones )
+    {
+        if( aZones.empty() )
+            return;
+
+        m_thermalZones.reset( new THERMAL_ZONES );
+    }
+
+    m_thermalZones->m_zones.swap( aZones );
+
+    if( m_thermalZones->m_zones.empty() && m_thermalZones->m_polysZones.empty() )
+        m_thermalZones.reset();
+}
+
+
+std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*>* VIA::GetThermalPolysZones()
+{
+    static std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*> noPolysZones;
+
+    return m_thermalZones ? &m_thermalZones->m_polysZones : &noPolysZones;
+}
+
+
+void VIA::SetThermalPolysZones(
+        std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*>& aPolyZone )
+{
+    if( !m_thermalZones )
+    {
+        if( aPolyZone.empty() )
+            return;
+
+        m_thermalZones.reset( new THERMAL_ZONES );
+    }
+
+    m_thermalZones->m_polysZones.swap( aPolyZone );
+
+    if( m_thermalZones->m_zones.empty() && m_thermalZones->m_polysZones.empty() )
+        m_thermalZones.reset();
+}
+#endif
+
+
 EDA_ITEM* VIA::Clone() const
 {
     return new VIA( *this );
@@ -1513,10 +1592,7 @@ int TRACK::GetEndSegments( int aCount, TRACK** aStartTrace, TRACK** aEndTrace )
     ii = 0;
 
     for( ; ( Track != NULL ) && ( ii < aCount ); ii++, Track = Track->Next() )
-    {
-        TrackListEnd   = Track;
-        Track->m_Param = 0;
-    }
+        TrackListEnd = Track;
 
     // Calculate the extremes.
     NbEnds = 0;
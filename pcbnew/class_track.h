@@ -39,6 +39,7 @@
 
 #ifdef PCBNEW_WITH_TRACKITEMS
 #include <class_zone.h>
+#include <memory>
 #include <unordered_map>
 #endif
 
@@ -90,11 +91,14 @@ public:
         return aItem && PCB_TRACE_T == aItem->Type();
     }
 
+protected:
+    // Declared first so it can use the tail padding of BOARD_CONNECTED_ITEM
+    int         m_Width;            ///< Thickness of track, or via diameter
+
+public:
     BOARD_CONNECTED_ITEM* start;    // pointers to a connected item (pad or track)
     BOARD_CONNECTED_ITEM* end;
 
-    double      m_Param;            // Auxiliary variable ( used in some computations )
-
     TRACK( BOARD_ITEM* aParent, KICAD_T idtype = PCB_TRACE_T );
 
     // Do not create a copy constructor.  The one generated by the compiler is adequate.
@@ -342,7 +346,6 @@ protected:
     void DrawShortNetname( EDA_DRAW_PANEL* panel, wxDC* aDC, GR_DRAWMODE aDrawMode,
             COLOR4D aBgColor );
 
-    int         m_Width;            ///< Thickness of track, or via diameter
     wxPoint     m_Start;            ///< Line start point
     wxPoint     m_End;              ///< Line end point
 
@@ -393,7 +396,13 @@ public:
         return aItem && PCB_VIA_T == aItem->Type();
     }
 
+#ifdef PCBNEW_WITH_TRACKITEMS
+    // The stitching zones are owned by the via, so they have to be copied explicitly
+    VIA( const VIA& aOther );
+    VIA& operator=( const VIA& aOther );
+#else
     // Do not create a copy constructor.  The one generated by the compiler is adequate.
+#endif
 
     void Draw( EDA_DRAW_PANEL* panel, wxDC* DC,
                GR_DRAWMODE aDrawMode, const wxPoint& aOffset = ZeroOffset ) override;
@@ -455,18 +464,13 @@ public:
     //Stitch vias
     int GetThermalCode( void ) const { return m_thermal; }
     void SetThermalCode( const int aThermalCode ) { m_thermal = aThermalCode; }
-    std::vector<ZONE_CONTAINER*>* GetThermalZones( void ) {
-        return &m_thermal_zones;
-    }
-    void SetThermalZones( std::vector<ZONE_CONTAINER*>& aZones ) {
-        m_thermal_zones.swap(aZones);
-    }
-    std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*>* GetThermalPolysZones( void ) {
-        return &m_thermal_polys_zones;
-    }
-    void SetThermalPolysZones( std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*>& aPolyZone ) {
-        m_thermal_polys_zones.swap( aPolyZone );
-    }
+
+    // Vias which are not in a zone share empty lists: the returned lists must not be modified,
+    // use the setters (which swap the lists) instead.
+    std::vector<ZONE_CONTAINER*>* GetThermalZones( void );
+    void SetThermalZones( std::vector<ZONE_CONTAINER*>& aZones );
+    std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*>* GetThermalPolysZones( void );
+    void SetThermalPolysZones( std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*>& aPolyZone );
 #endif
 
     /**
@@ -515,9 +519,15 @@ private:
     int       m_Drill;          // for vias: via drill (- 1 for default value)
 
 #ifdef PCBNEW_WITH_TRACKITEMS
+    /// Zones connected to a stitching via, allocated only for the vias inside zones
+    struct THERMAL_ZONES
+    {
+        std::vector<ZONE_CONTAINER*> m_zones;
+        std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*> m_polysZones;
+    };
+
     int       m_thermal{0};
-    std::vector<ZONE_CONTAINER*> m_thermal_zones;
-    std::unordered_map<const SHAPE_POLY_SET::POLYGON*, ZONE_CONTAINER*> m_thermal_polys_zones;
+    std::unique_ptr<THERMAL_ZONES> m_thermalZones;
 #endif
 };
 
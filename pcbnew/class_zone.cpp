@@ -145,6 +145,15 @@ ZONE_CONTAINER::~ZONE_CONTAINER()
 }
 
 
+void ZONE_CONTAINER::SwapFill( ZONE_CONTAINER& aZone )
+{
+    std::swap( m_FilledPolysList, aZone.m_FilledPolysList );
+    std::swap( m_FillSegmList, aZone.m_FillSegmList );
+    std::swap( m_smoothedPoly, aZone.m_smoothedPoly );
+    std::swap( m_IsFilled, aZone.m_IsFilled );
+}
+
+
 EDA_ITEM* ZONE_CONTAINER::Clone() const
 {
     return new ZONE_CONTAINER( *this );
@@ -31,6 +31,7 @@
 #define CLASS_ZONE_H_
 
 
+#include <mutex>
 #include <vector>
 #include <gr_basic.h>
 #include <class_board_item.h>
@@ -50,6 +51,55 @@ class ZONE_CONTAINER;
 class MSG_PANEL_ITEM;
 
 
+/**
+ * Class ZONE_FILL_GUARD
+ * lets a zone fill run in the background while the board is edited: the fill reads the
+ * board items only inside a ZONE_FILL_GUARD::ACCESS scope, and gives up at its next board
+ * access once the guard is cancelled.  Cancel() returns as soon as the fill no longer reads
+ * the board, without waiting for the end of the fill.
+ */
+class ZONE_FILL_GUARD
+{
+public:
+    /// Thrown by ACCESS when the guard is cancelled: the fill is abandoned.
+    struct CANCELLED {};
+
+    /**
+     * Class ACCESS
+     * holds the guard while the fill reads the board.  A NULL guard does not lock anything.
+     */
+    class ACCESS
+    {
+    public:
+        ACCESS( ZONE_FILL_GUARD* aGuard )
+        {
+            if( aGuard )
+            {
+                m_lock = std::unique_lock<std::mutex>( aGuard->m_mutex );
+
+                if( aGuard->m_cancelled )
+                    throw CANCELLED();
+            }
+        }
+
+    private:
+        std::unique_lock<std::mutex> m_lock;
+    };
+
+    ZONE_FILL_GUARD() : m_cancelled( false ) {}
+
+    void Cancel()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_cancelled = true;
+    }
+
+private:
+    std::mutex  m_mutex;
+    bool        m_cancelled;    ///< guarded by m_mutex
+};
+
+
 /**
  * Struct SEGMENT
  * is a simple container used when filling areas with segments
@@ -313,6 +363,21 @@ public:
      */
     bool BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET* aOutlineBuffer = NULL );
 
+    /**
+     * Function SetFillGuard
+     * makes the fill functions read the board only while holding @a aGuard, to fill this zone
+     * in the background.  They then throw ZONE_FILL_GUARD::CANCELLED once the guard is
+     * cancelled.  NULL (the default) removes the guard.
+     */
+    void SetFillGuard( ZONE_FILL_GUARD* aGuard ) { m_fillGuard = aGuard; }
+
+    /**
+     * Function SwapFill
+     * exchanges the fill of this zone (filled polygons, fill segments, corner-smoothed outline
+     * and fill status) with the one of @a aZone, e.g. to take over the fill of a copy.
+     */
+    void SwapFill( ZONE_CONTAINER& aZone );
+
     /**
      * Function AddClearanceAreasPolygonsToPolysList
      * Add non copper areas polygons (pads and tracks with clearance)
@@ -719,6 +784,7 @@ private:
 
     SHAPE_POLY_SET*       m_Poly{nullptr};                ///< Outline of the zone.
     SHAPE_POLY_SET*       m_smoothedPoly{nullptr};        // Corner-smoothed version of m_Poly
+    ZONE_FILL_GUARD*      m_fillGuard{nullptr};           ///< see SetFillGuard()
     int                   m_cornerSmoothingType;
     unsigned int          m_cornerRadius;
 
@@ -28,6 +28,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+
 #include <fctsys.h>
 #include <common.h>
 #include <macros.h>
@@ -1055,10 +1057,6 @@ void PCB_BASE_FRAME::RecalculateAllTracksNetcode()
  */
 static bool SortTracksByNetCode( const TRACK* const & ref, const TRACK* const & compare )
 {
-    // For items having the same Net, keep the order in list
-    if( ref->GetNetCode() == compare->GetNetCode())
-        return ref->m_Param < compare->m_Param;
-
     return ref->GetNetCode() < compare->GetNetCode();
 }
 
@@ -1080,23 +1078,15 @@ static void RebuildTrackChain( BOARD* pcb )
     trackList.reserve( item_count );
 
     // Put track list in a temporary list to sort tracks by netcode
-    // We try to keep the initial order of track segments in list, when possible
-    // so we use m_Param (a member variable used for temporary storage)
-    // to temporary keep trace of the order of segments
-    // The sort function uses this variable to sort items that
-    // have the same net code.
-    // Without this, during sorting, the initial order is sometimes lost
-    // by the sort algorithm
     for( int ii = 0; ii < item_count; ++ii )
-    {
-        pcb->m_Track->m_Param = ii;
         trackList.push_back( pcb->m_Track.PopFront() );
-    }
 
     // the list is empty now
     wxASSERT( pcb->m_Track == NULL && pcb->m_Track.GetCount()==0 );
 
-    sort( trackList.begin(), trackList.end(), SortTracksByNetCode );
+    // The sort is stable, so the initial order of track segments having the same net code
+    // is kept
+    std::stable_sort( trackList.begin(), trackList.end(), SortTracksByNetCode );
 
 #ifdef PCBNEW_WITH_TRACKITEMS
     int prev_netcode = -1;
@@ -256,16 +256,9 @@ void DIALOG_GLOBAL_EDIT_TRACKS_AND_VIAS::OnOkClick( wxCommandEvent& event )
         break;
     }
 
-    if( change )
-    {
-        if( m_parent->IsGalCanvasActive() )
-        {
-            for( TRACK* track = m_parent->GetBoard()->m_Track; track != NULL; track = track->Next() )
-                m_parent->GetGalCanvas()->GetView()->Update( track, KIGFX::GEOMETRY );
-        }
-        else
-            m_parent->GetCanvas()->Refresh();
-    }
+    // The view of the GAL canvas is updated by the commit, for the changed items only
+    if( change && !m_parent->IsGalCanvasActive() )
+        m_parent->GetCanvas()->Refresh();
 
     // Call the default handler
     event.Skip();
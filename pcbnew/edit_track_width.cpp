@@ -37,6 +37,7 @@
 
 #include <pcbnew.h>
 #include <drc_stuff.h>
+#include <board_bulk_edit.h>
 
 #ifdef PCBNEW_WITH_TRACKITEMS
 #include "trackitems/trackitems.h"
@@ -57,55 +58,19 @@ bool PCB_EDIT_FRAME::SetTrackSegmentWidth( TRACK*             aTrackItem,
     int           initial_width, new_width;
     int           initial_drill = -1,new_drill = -1;
     bool          change_ok = false;
-    NETINFO_ITEM* net = NULL;
-
-    if( aUseNetclassValue )
-        net = aTrackItem->GetNet();
 
     initial_width = aTrackItem->GetWidth();
 
-    if( net )
-        new_width = net->GetTrackWidth();
-    else
-        new_width = GetDesignSettings().GetCurrentTrackWidth();
+    BOARD_BULK_EDIT::GetTrackSizes( aTrackItem, GetDesignSettings(), aUseNetclassValue,
+                                    &new_width, &new_drill );
 
     if( aTrackItem->Type() == PCB_VIA_T )
     {
         const VIA *via = static_cast<const VIA *>( aTrackItem );
 
-        // Micro vias have a size only defined in their netclass
-        // (no specific values defined by a table of specific value)
-        // Ensure the netclass is accessible:
-        if( via->GetViaType() == VIA_MICROVIA && net == NULL )
-            net = aTrackItem->GetNet();
-
         // Get the draill value, regardless it is default or specific
         initial_drill = via->GetDrillValue();
 
-        if( net )
-        {
-            new_width = net->GetViaSize();
-            new_drill = net->GetViaDrillSize();
-        }
-        else
-        {
-            new_width = GetDesignSettings().GetCurrentViaSize();
-            new_drill = GetDesignSettings().GetCurrentViaDrill();
-        }
-
-        if( via->GetViaType() == VIA_MICROVIA )
-        {
-            if( net )
-            {
-                new_width = net->GetMicroViaSize();
-                new_drill = net->GetMicroViaDrillSize();
-            }
-            else
-            {
-                // Should not occur
-            }
-        }
-
         // Old versions set a drill value <= 0, when the default netclass it used
         // but it could be better to set the drill value to the actual value
         // to avoid issues for existing vias, if the default drill value is modified
@@ -297,62 +262,54 @@ bool PCB_EDIT_FRAME::Change_Net_Tracks_And_Vias_Sizes( int aNetcode, bool aUseNe
      * aNetcode : the netcode of the net to edit
      * aUseNetclassValue = true to use netclass values, false to use current values
      */
-    TRACK* pt_segm;
-
     if( aNetcode <= 0 )
         return false;
 
-    // Examine segments
-    PICKED_ITEMS_LIST itemsListPicker;
-    bool change = false;
+    // Compute all the changes first, then apply them as a single commit
+    BOARD_BULK_EDIT edit( this );
 
-    for( pt_segm = GetBoard()->m_Track; pt_segm != NULL; pt_segm = pt_segm->Next() )
+    for( TRACK* pt_segm = GetBoard()->m_Track; pt_segm != NULL; pt_segm = pt_segm->Next() )
     {
         if( aNetcode != pt_segm->GetNetCode() )         // not in net
             continue;
 
         // we have found a item member of the net
-        if( SetTrackSegmentWidth( pt_segm, &itemsListPicker, aUseNetclassValue ) )
-            change = true;
+        edit.AddTrackResize( pt_segm, aUseNetclassValue );
     }
 
-    if( !change )
+    // make a DRC test for the segments made wider
+    if( g_Drc_On )
+        edit.RejectDrcErrors( m_drc );
+
+    if( edit.Empty() )
         return false;
 
-    // Some segment have changed: save them in undo list
-    SaveCopyInUndoList( itemsListPicker, UR_CHANGED );
+    edit.Push( _( "Change net tracks and vias sizes" ) );
     return true;
 }
 
 
 bool PCB_EDIT_FRAME::Reset_All_Tracks_And_Vias_To_Netclass_Values( bool aTrack, bool aVia )
 {
-    TRACK* pt_segm;
-
     // read and edit tracks and vias if required
-    PICKED_ITEMS_LIST itemsListPicker;
-    bool change = false;
+    BOARD_BULK_EDIT edit( this );
 
-    for( pt_segm = GetBoard()->m_Track; pt_segm != NULL; pt_segm = pt_segm->Next() )
+    for( TRACK* pt_segm = GetBoard()->m_Track; pt_segm != NULL; pt_segm = pt_segm->Next() )
     {
-        if( (pt_segm->Type() == PCB_VIA_T ) && aVia )
-        {
-            if( SetTrackSegmentWidth( pt_segm, &itemsListPicker, true ) )
-                change = true;
-        }
-
-        if( (pt_segm->Type() == PCB_TRACE_T ) && aTrack )
+        if( ( pt_segm->Type() == PCB_VIA_T && aVia )
+            || ( pt_segm->Type() == PCB_TRACE_T && aTrack ) )
         {
-            if( SetTrackSegmentWidth( pt_segm, &itemsListPicker, true ) )
-                change = true;
+            edit.AddTrackResize( pt_segm, true );
         }
     }
 
-    if( !change )
-        return false;
+    // make a DRC test for the segments made wider
+    if( g_Drc_On )
+        edit.RejectDrcErrors( m_drc );
 
-    // Some segment have changed: save them in undo list
-    SaveCopyInUndoList( itemsListPicker, UR_CHANGED );
+    if( edit.Empty() )
+        return false;
 
+    edit.Push( _( "Reset tracks and vias sizes to netclass values" ) );
     return true;
 }
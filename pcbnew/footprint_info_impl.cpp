@@ -35,9 +35,14 @@
 #include <macros.h>
 #include <make_unique.h>
 #include <pgm_base.h>
+#include <richio.h>
 #include <wildcards_and_files_ext.h>
 
-#include <thread>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/hashmap.h>
+
+#include <ctime>
 
 
 void FOOTPRINT_INFO_IMPL::load()
@@ -66,6 +71,298 @@ void FOOTPRINT_INFO_IMPL::load()
 }
 
 
+/// First line of the index file, to be changed with the file format
+#define INDEX_FILE_HEADER   "fp-info-cache 2"
+
+/// Number of days a library stays in the index without being listed
+#define INDEX_KEEP_DAYS     30
+
+
+/// @return the current day, counted from the epoch
+static long today()
+{
+    return (long) ( time( NULL ) / ( 24 * 60 * 60 ) );
+}
+
+
+wxString FOOTPRINT_INFO_INDEX::GetDefaultFileName()
+{
+    return wxFileName( GetKicadConfigPath(), wxT( "fp-info-cache" ) ).GetFullPath();
+}
+
+
+static unsigned long long fileStamp( const wxFileName& aFile )
+{
+    wxDateTime  modified = aFile.GetModificationTime();
+    wxULongLong size = aFile.GetSize();
+
+    unsigned long long stamp = modified.IsValid() ? modified.GetValue().GetValue() : 0;
+
+    stamp = stamp * 1000003ULL + ( size != wxInvalidSize ? size.GetValue() : 0 );
+    stamp = stamp * 1000003ULL + wxStringHash()( aFile.GetFullName() );
+
+    return stamp;
+}
+
+
+unsigned long long FOOTPRINT_INFO_INDEX::LibraryStamp( const wxString& aPath )
+{
+    unsigned long long stamp = 0;
+
+    if( wxFileName::DirExists( aPath ) )
+    {
+        wxDir    dir( aPath );
+        wxString name;
+
+        if( !dir.IsOpened() )
+            return 0;
+
+        // Sum the files stamps, so the result does not depend on the listing order
+        for( bool found = dir.GetFirst( &name, wxEmptyString, wxDIR_FILES );
+             found; found = dir.GetNext( &name ) )
+        {
+            stamp += fileStamp( wxFileName( aPath, name ) );
+        }
+    }
+    else if( wxFileName::FileExists( aPath ) )
+    {
+        stamp = fileStamp( wxFileName( aPath ) );
+    }
+    else
+    {
+        return 0;
+    }
+
+    // 0 is reserved for libraries which cannot be indexed
+    return stamp ? stamp : 1;
+}
+
+
+static std::string escapeField( const wxString& aField )
+{
+    std::string utf8 = TO_UTF8( aField );
+    std::string ret;
+
+    for( char c : utf8 )
+    {
+        switch( c )
+        {
+        case '\\': ret += "\\\\"; break;
+        case '\t':  ret += "\\t";  break;
+        case '\n':  ret += "\\n";  break;
+        case '\r':  ret += "\\r";  break;
+        default:    ret += c;      break;
+        }
+    }
+
+    return ret;
+}
+
+
+/// Splits a line of the index file in its tab separated fields
+static std::vector<wxString> splitFields( const char* aLine )
+{
+    std::vector<wxString> fields;
+    std::string           field;
+
+    for( const char* c = aLine; ; ++c )
+    {
+        if( *c == '\t' || *c == '\n' || *c == '\r' || *c == 0 )
+        {
+            fields.push_back( FROM_UTF8( field.c_str() ) );
+            field.clear();
+
+            if( *c != '\t' )
+                break;
+        }
+        else if( *c == '\\' && c[1] )
+        {
+            ++c;
+
+            switch( *c )
+            {
+            case 't': field += '\t'; break;
+            case 'n': field += '\n'; break;
+            case 'r': field += '\r'; break;
+            default:  field += *c;   break;
+            }
+        }
+        else
+        {
+            field += *c;
+        }
+    }
+
+    return fields;
+}
+
+
+void FOOTPRINT_INFO_INDEX::Load( const wxString& aFileName )
+{
+    m_libraries.clear();
+    m_modified = false;
+
+    if( !wxFileName::FileExists( aFileName ) )
+        return;
+
+    try
+    {
+        FILE_LINE_READER reader( aFileName );
+        LIBRARY*         library = NULL;
+
+        if( !reader.ReadLine() )
+            return;
+
+        // The whole line is compared: "fp-info-cache 10" is not "fp-info-cache 1"
+        std::vector<wxString> header = splitFields( reader.Line() );
+
+        if( header.size() != 1 || header[0] != INDEX_FILE_HEADER )
+            return;
+
+        while( reader.ReadLine() )
+        {
+            std::vector<wxString> fields = splitFields( reader.Line() );
+            long                  padCount, uniquePadCount;
+
+            if( fields[0] == "lib" && fields.size() == 5 )
+            {
+                library = &m_libraries[ fields[1] ];
+                library->m_type = fields[2];
+
+                if( !fields[3].ToULongLong( &library->m_stamp ) )
+                    library->m_stamp = 0;   // never matches, the library will be loaded
+
+                if( !fields[4].ToLong( &library->m_used ) )
+                    library->m_used = 0;    // dropped at the next save
+            }
+            else if( fields[0] == "fp" && fields.size() == 6 && library
+                     && fields[2].ToLong( &padCount ) && fields[3].ToLong( &uniquePadCount ) )
+            {
+                FOOTPRINT fp = { fields[1], fields[4], fields[5],
+                                 (int) padCount, (int) uniquePadCount };
+
+                library->m_footprints.push_back( fp );
+            }
+            else
+            {
+                // Broken file, it will be rebuilt
+                m_libraries.clear();
+                return;
+            }
+        }
+    }
+    catch( const IO_ERROR& )
+    {
+        m_libraries.clear();
+    }
+}
+
+
+void FOOTPRINT_INFO_INDEX::Save( const wxString& aFileName )
+{
+    if( !m_modified )
+        return;
+
+    long day = today();
+
+    for( auto it = m_libraries.begin(); it != m_libraries.end(); )
+    {
+        if( day - it->second.m_used > INDEX_KEEP_DAYS )
+            it = m_libraries.erase( it );
+        else
+            ++it;
+    }
+
+    // Write a temporary file and rename it, so another KiCad instance never reads
+    // a partially written index.  The temporary name is unique, so two instances
+    // saving at the same time do not write into the same file.
+    wxFileName fn( aFileName );
+    wxString tmpFileName = wxFileName::CreateTempFileName( fn.GetPathWithSep() + fn.GetName() );
+
+    if( tmpFileName.IsEmpty() )
+        THROW_IO_ERROR( wxString::Format( _( "Cannot write footprint index file '%s'" ),
+                                          GetChars( aFileName ) ) );
+
+    try
+    {
+        FILE_OUTPUTFORMATTER out( tmpFileName );
+
+        out.Print( 0, "%s\n", INDEX_FILE_HEADER );
+
+        for( const auto& library : m_libraries )
+        {
+            out.Print( 0, "lib\t%s\t%s\t%llu\t%ld\n",
+                       escapeField( library.first ).c_str(),
+                       escapeField( library.second.m_type ).c_str(),
+                       library.second.m_stamp,
+                       library.second.m_used );
+
+            for( const FOOTPRINT& fp : library.second.m_footprints )
+            {
+                out.Print( 0, "fp\t%s\t%d\t%d\t%s\t%s\n",
+                           escapeField( fp.m_fpname ).c_str(),
+                           fp.m_pad_count, fp.m_unique_pad_count,
+                           escapeField( fp.m_doc ).c_str(),
+                           escapeField( fp.m_keywords ).c_str() );
+            }
+        }
+    }
+    catch( const IO_ERROR& )
+    {
+        wxRemoveFile( tmpFileName );
+        throw;
+    }
+
+    if( !wxRenameFile( tmpFileName, aFileName, true ) )
+    {
+        wxRemoveFile( tmpFileName );
+        THROW_IO_ERROR( wxString::Format( _( "Cannot write footprint index file '%s'" ),
+                                          GetChars( aFileName ) ) );
+    }
+
+    m_modified = false;
+}
+
+
+const FOOTPRINT_INFO_INDEX::LIBRARY* FOOTPRINT_INFO_INDEX::Find( const wxString& aPath,
+        const wxString& aType, unsigned long long aStamp ) const
+{
+    if( aStamp == 0 )
+        return NULL;
+
+    auto it = m_libraries.find( aPath );
+
+    if( it == m_libraries.end() || it->second.m_type != aType || it->second.m_stamp != aStamp )
+        return NULL;
+
+    return &it->second;
+}
+
+
+void FOOTPRINT_INFO_INDEX::Store( const wxString& aPath, const LIBRARY& aLibrary )
+{
+    LIBRARY& library = m_libraries[aPath];
+
+    library = aLibrary;
+    library.m_used = today();
+    m_modified = true;
+}
+
+
+void FOOTPRINT_INFO_INDEX::MarkListed( const wxString& aPath )
+{
+    auto it = m_libraries.find( aPath );
+    long day = today();
+
+    // The file is written again at most once a day for this
+    if( it != m_libraries.end() && it->second.m_used != day )
+    {
+        it->second.m_used = day;
+        m_modified = true;
+    }
+}
+
+
 bool FOOTPRINT_LIST_IMPL::CatchErrors( std::function<void()> aFunc )
 {
     try
@@ -103,7 +400,9 @@ void FOOTPRINT_LIST_IMPL::loader_job()
     while( m_queue_in.pop( nickname ) )
     {
         CatchErrors( [this, &nickname]() {
-            m_lib_table->PrefetchLib( nickname );
+            if( !checkIndex( nickname ) )
+                m_lib_table->PrefetchLib( nickname );
+
             m_queue_out.push( nickname );
         } );
 
@@ -121,6 +420,25 @@ void FOOTPRINT_LIST_IMPL::loader_job()
 }
 
 
+bool FOOTPRINT_LIST_IMPL::checkIndex( const wxString& aNickname )
+{
+    const FP_LIB_TABLE_ROW* row = m_lib_table->FindRow( aNickname );
+
+    LIB_STATE state;
+    state.m_path = row->GetFullURI( true );
+    state.m_type = row->GetType();
+    state.m_stamp = FOOTPRINT_INFO_INDEX::LibraryStamp( state.m_path );
+
+    // m_index is not modified while the loader jobs run
+    state.m_indexed = m_index.Find( state.m_path, state.m_type, state.m_stamp );
+
+    MUTLOCK lock( m_lib_states_lock );
+    m_lib_states[aNickname] = state;
+
+    return state.m_indexed != NULL;
+}
+
+
 bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname )
 {
     FOOTPRINT_ASYNC_LOADER loader;
@@ -142,9 +460,11 @@ void FOOTPRINT_LIST_IMPL::StartWorkers( FP_LIB_TABLE* aTable, wxString const* aN
     m_count_finished.store( 0 );
     m_errors.clear();
     m_list.clear();
-    m_threads.clear();
+    m_prefetch.reset();
     m_queue_in.clear();
     m_queue_out.clear();
+    m_lib_states.clear();
+    m_index.Load( FOOTPRINT_INFO_INDEX::GetDefaultFileName() );
 
     if( aNickname )
         m_queue_in.push( *aNickname );
@@ -156,20 +476,28 @@ void FOOTPRINT_LIST_IMPL::StartWorkers( FP_LIB_TABLE* aTable, wxString const* aN
 
     m_loader->m_total_libs = m_queue_in.size();
 
+    // aNThreads jobs draining the queue bound the number of libraries fetched at once; they
+    // only get as many threads as the shared pool can spare.
+    m_prefetch.reset( new TASK_GROUP );
+
     for( unsigned i = 0; i < aNThreads; ++i )
-    {
-        m_threads.push_back( std::thread( &FOOTPRINT_LIST_IMPL::loader_job, this ) );
-    }
+        m_prefetch->Run( [this]() { loader_job(); } );
 }
 
 bool FOOTPRINT_LIST_IMPL::JoinWorkers()
 {
-    for( auto& i : m_threads )
-        i.join();
+    if( m_prefetch )
+        m_prefetch->Wait();
 
-    m_threads.clear();
+    m_prefetch.reset();
     m_queue_in.clear();
 
+    std::vector<wxString> nicknames;
+    wxString              nickname;
+
+    while( m_queue_out.pop( nickname ) )
+        nicknames.push_back( nickname );
+
     LOCALE_IO toggle_locale;
 
     // Parse the footprints in parallel. WARNING! This requires changing the locale, which is
@@ -179,56 +507,94 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     //
     // TODO: blast LOCALE_IO into the sun
 
-    SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
-    std::vector<std::thread>                    threads;
+    std::vector<std::vector<std::unique_ptr<FOOTPRINT_INFO>>> parsed( nicknames.size() );
+    std::vector<std::unique_ptr<FOOTPRINT_INFO_INDEX::LIBRARY>> indexed( nicknames.size() );
+    TASK_GROUP parse;
 
-    for( size_t i = 0; i < std::thread::hardware_concurrency() + 1; ++i )
-    {
-        threads.push_back( std::thread( [this, &queue_parsed]() {
-            wxString nickname;
+    // The loader jobs are done, m_lib_states can be read without locking
+    parse.ParallelFor( 0, nicknames.size(), [this, &nicknames, &parsed, &indexed]( int aLib ) {
+        const wxString& nickname = nicknames[aLib];
+        auto            state = m_lib_states.find( nickname );
 
-            while( this->m_queue_out.pop( nickname ) )
+        if( state != m_lib_states.end() && state->second.m_indexed )
+        {
+            // Unchanged library: no need to load it
+            for( const auto& fp : state->second.m_indexed->m_footprints )
             {
-                wxArrayString fpnames;
-
-                try
-                {
-                    this->m_lib_table->FootprintEnumerate( fpnames, nickname );
-                }
-                catch( const IO_ERROR& ioe )
-                {
-                    m_errors.move_push( std::make_unique<IO_ERROR>( ioe ) );
-                }
-                catch( const std::exception& se )
-                {
-                    // This is a round about way to do this, but who knows what THROW_IO_ERROR()
-                    // may be tricked out to do someday, keep it in the game.
-                    try
-                    {
-                        THROW_IO_ERROR( se.what() );
-                    }
-                    catch( const IO_ERROR& ioe )
-                    {
-                        m_errors.move_push( std::make_unique<IO_ERROR>( ioe ) );
-                    }
-                }
-
-                for( auto const& fpname : fpnames )
-                {
-                    FOOTPRINT_INFO* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
-                    queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
-                }
+                FOOTPRINT_INFO* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fp.m_fpname,
+                        fp.m_doc, fp.m_keywords, fp.m_pad_count, fp.m_unique_pad_count );
+                parsed[aLib].push_back( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
             }
-        } ) );
+
+            return;
+        }
+
+        wxArrayString fpnames;
+
+        bool ok = CatchErrors( [this, &nickname, &fpnames]() {
+            m_lib_table->FootprintEnumerate( fpnames, nickname );
+        } );
+
+        // Index the library only if all its footprints were loaded
+        std::unique_ptr<FOOTPRINT_INFO_INDEX::LIBRARY> library;
+
+        if( ok && state != m_lib_states.end() && state->second.m_stamp )
+        {
+            library.reset( new FOOTPRINT_INFO_INDEX::LIBRARY );
+            library->m_type = state->second.m_type;
+            library->m_stamp = state->second.m_stamp;
+        }
+
+        for( auto const& fpname : fpnames )
+        {
+            FOOTPRINT_INFO_IMPL* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
+
+            if( library && fpinfo->IsLoaded() )
+            {
+                FOOTPRINT_INFO_INDEX::FOOTPRINT fp = { fpname, fpinfo->GetDoc(),
+                        fpinfo->GetKeywords(), (int) fpinfo->GetPadCount(),
+                        (int) fpinfo->GetUniquePadCount() };
+
+                library->m_footprints.push_back( fp );
+            }
+            else
+            {
+                library.reset();
+            }
+
+            parsed[aLib].push_back( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
+        }
+
+        indexed[aLib] = std::move( library );
+    } );
+
+    for( auto& lib : parsed )
+    {
+        for( auto& fpi : lib )
+            m_list.push_back( std::move( fpi ) );
     }
 
-    for( auto& thr : threads )
-        thr.join();
+    for( unsigned ii = 0; ii < nicknames.size(); ++ii )
+    {
+        auto state = m_lib_states.find( nicknames[ii] );
+
+        if( state == m_lib_states.end() )
+            continue;
 
-    std::unique_ptr<FOOTPRINT_INFO> fpi;
+        if( indexed[ii] )
+            m_index.Store( state->second.m_path, *indexed[ii] );
+        else if( state->second.m_indexed )
+            m_index.MarkListed( state->second.m_path );
+    }
 
-    while( queue_parsed.pop( fpi ) )
-        m_list.push_back( std::move( fpi ) );
+    // Failing to update the index only costs time at the next session
+    try
+    {
+        m_index.Save( FOOTPRINT_INFO_INDEX::GetDefaultFileName() );
+    }
+    catch( const IO_ERROR& )
+    {
+    }
 
     std::sort( m_list.begin(), m_list.end(),
             []( std::unique_ptr<FOOTPRINT_INFO> const&     lhs,
@@ -251,6 +617,6 @@ FOOTPRINT_LIST_IMPL::FOOTPRINT_LIST_IMPL() : m_loader( nullptr )
 
 FOOTPRINT_LIST_IMPL::~FOOTPRINT_LIST_IMPL()
 {
-    for( auto& i : m_threads )
-        i.join();
+    if( m_prefetch )
+        m_prefetch->Wait();
 }
@@ -23,12 +23,14 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
-#include <thread>
 #include <vector>
 
 #include <footprint_info.h>
+#include <ki_mutex.h>
 #include <sync_queue.h>
+#include <task_scheduler.h>
 
 class LOCALE_IO;
 
@@ -50,19 +52,143 @@ public:
 #endif
     }
 
+    /// Constructor for a footprint whose data is already known (i.e. read from the index)
+    FOOTPRINT_INFO_IMPL( FOOTPRINT_LIST* aOwner, const wxString& aNickname,
+            const wxString& aFootprintName, const wxString& aDoc, const wxString& aKeywords,
+            int aPadCount, int aUniquePadCount )
+    {
+        m_owner = aOwner;
+        m_loaded = true;
+        m_nickname = aNickname;
+        m_fpname = aFootprintName;
+        m_num = 0;
+        m_pad_count = aPadCount;
+        m_unique_pad_count = aUniquePadCount;
+        m_doc = aDoc;
+        m_keywords = aKeywords;
+    }
+
+    bool IsLoaded() const
+    {
+        return m_loaded;
+    }
+
 protected:
     virtual void load() override;
 };
 
 
+/**
+ * Class FOOTPRINT_INFO_INDEX
+ * keeps the FOOTPRINT_INFO fields of the footprint libraries in a file, so the libraries
+ * which did not change on disk do not have to be loaded again to list their footprints.
+ *
+ * A library is identified by its full path and plugin type.  Its entries are valid as long
+ * as its stamp, built from the names, sizes and modification times of its files, does not
+ * change.  Libraries which are not local files or directories (e.g. GitHub) have no stamp
+ * and are never indexed.
+ *
+ * The index is shared by all the projects, whose library tables are not known here: a
+ * library not listed for some time is considered removed from all of them, and is dropped.
+ */
+class FOOTPRINT_INFO_INDEX
+{
+public:
+    struct FOOTPRINT
+    {
+        wxString m_fpname;
+        wxString m_doc;
+        wxString m_keywords;
+        int      m_pad_count;
+        int      m_unique_pad_count;
+    };
+
+    struct LIBRARY
+    {
+        wxString                m_type;
+        unsigned long long      m_stamp;
+        long                    m_used;         ///< day of the last listing, see Store()
+        std::vector<FOOTPRINT>  m_footprints;
+    };
+
+    FOOTPRINT_INFO_INDEX() : m_modified( false ) {}
+
+    /**
+     * @return the default index file, in the KiCad configuration directory.
+     */
+    static wxString GetDefaultFileName();
+
+    /**
+     * Function LibraryStamp
+     * @return the stamp of the library file or directory \a aPath, or 0 if it is neither
+     *         a file nor a directory.
+     */
+    static unsigned long long LibraryStamp( const wxString& aPath );
+
+    /**
+     * Function Load
+     * reads the index file.  A missing or broken file gives an empty index.
+     */
+    void Load( const wxString& aFileName );
+
+    /**
+     * Function Save
+     * writes the index file, if it was modified since Load().  The libraries not listed
+     * for a while are dropped.
+     * @throw IO_ERROR if the file cannot be written.
+     */
+    void Save( const wxString& aFileName );
+
+    /**
+     * Function Find
+     * @return the indexed library at \a aPath, or NULL if it is not indexed or if its type
+     *         or stamp changed.
+     */
+    const LIBRARY* Find( const wxString& aPath, const wxString& aType,
+                         unsigned long long aStamp ) const;
+
+    /**
+     * Function Store
+     * adds or replaces the library at \a aPath, listed today.
+     */
+    void Store( const wxString& aPath, const LIBRARY& aLibrary );
+
+    /**
+     * Function MarkListed
+     * records that the indexed library at \a aPath was listed today, so it is kept.
+     */
+    void MarkListed( const wxString& aPath );
+
+private:
+    std::map<wxString, LIBRARY> m_libraries;    ///< indexed libraries, by full path
+    bool                        m_modified;
+};
+
+
 class FOOTPRINT_LIST_IMPL : public FOOTPRINT_LIST
 {
-    FOOTPRINT_ASYNC_LOADER*  m_loader;
-    std::vector<std::thread> m_threads;
-    SYNC_QUEUE<wxString>     m_queue_in;
-    SYNC_QUEUE<wxString>     m_queue_out;
-    std::atomic_size_t       m_count_finished;
-    std::atomic_bool         m_first_to_finish;
+    /// On disk state of a library to read, found by the loader jobs
+    struct LIB_STATE
+    {
+        wxString                                m_path;
+        wxString                                m_type;
+        unsigned long long                      m_stamp;
+        const FOOTPRINT_INFO_INDEX::LIBRARY*    m_indexed;  ///< NULL if it must be loaded
+    };
+
+    FOOTPRINT_ASYNC_LOADER*     m_loader;
+    SYNC_QUEUE<wxString>        m_queue_in;
+    SYNC_QUEUE<wxString>        m_queue_out;
+    std::atomic_size_t          m_count_finished;
+    std::atomic_bool            m_first_to_finish;
+
+    FOOTPRINT_INFO_INDEX        m_index;
+    std::map<wxString, LIB_STATE> m_lib_states;    ///< by nickname, guarded by m_lib_states_lock
+    MUTEX                       m_lib_states_lock;
+
+    /// The library prefetch jobs, run on the shared TASK_SCHEDULER.  Declared last so it is
+    /// destroyed (i.e. waited for) before the queues the jobs use.
+    std::unique_ptr<TASK_GROUP> m_prefetch;
 
     /**
      * Call aFunc, pushing any IO_ERRORs and std::exceptions it throws onto m_errors.
@@ -83,6 +209,14 @@ protected:
      */
     void loader_job();
 
+    /**
+     * Function checkIndex
+     * records the on disk state of library \a aNickname in m_lib_states.
+     * @return true if the library is up to date in the index, so it does not need to be
+     *         prefetched.
+     */
+    bool checkIndex( const wxString& aNickname );
+
 public:
     FOOTPRINT_LIST_IMPL();
     virtual ~FOOTPRINT_LIST_IMPL();
@@ -83,12 +83,14 @@ Vary: Accept-Encoding
 #include <macros.h>
 #include <fp_lib_table.h>       // ExpandSubstitutions()
 #include <github_getliblist.h>
+#include <github_zip_cache.h>
 
 
 using namespace std;
 
 
 static const char* PRETTY_DIR = "allow_pretty_writing_to_this_dir";
+static const char* ZIP_CACHE_DIR = "cache_github_zip_in_this_dir";
 
 
 typedef boost::ptr_map<string, wxZipEntry>  MODULE_MAP;
@@ -171,7 +173,7 @@ void GITHUB_PLUGIN::PrefetchLib(
         m_zip_image.clear();
     }
 
-    remoteGetZip( aLibraryPath );
+    remoteGetZip( aLibraryPath, aProperties );
 }
 
 
@@ -361,12 +363,11 @@ void GITHUB_PLUGIN::FootprintLibOptions( PROPERTIES* aListToAppendTo ) const
         "format of the save is pretty.</p>"
         ));
 
-    /*
-    (*aListToAppendTo)["cache_github_zip_in_this_dir"] = UTF8( _(
+    (*aListToAppendTo)[ ZIP_CACHE_DIR ] = UTF8( _(
         "Set this property to a directory where the github *.zip file will be cached. "
-        "This should speed up subsequent visits to this library."
+        "This should speed up subsequent visits to this library.  The file is downloaded "
+        "again only when the library changed at github."
         ));
-    */
 }
 
 
@@ -427,7 +428,7 @@ void GITHUB_PLUGIN::cacheLib( const wxString& aLibraryPath, const PROPERTIES* aP
         m_gh_cache = new GH_CACHE();
 
         // INIT_LOGGER( "/tmp", "test.log" );
-        remoteGetZip( aLibraryPath );
+        remoteGetZip( aLibraryPath, aProperties );
         // UNINIT_LOGGER();
 
         m_lib_path = aLibraryPath;
@@ -463,6 +464,13 @@ bool GITHUB_PLUGIN::repoURL_zipURL( const wxString& aRepoURL, std::string* aZipU
 
     wxURI   repo( aRepoURL );
 
+    // A local zip file, typically a stand-in for the server when working offline
+    if( repo.GetScheme() == "file" && repo.HasPath() )
+    {
+        *aZipURL = aRepoURL.utf8_str();
+        return true;
+    }
+
     if( repo.HasServer() && repo.HasPath() )
     {
         // scheme might be "http" or if truly github.com then "https".
@@ -529,7 +537,7 @@ bool GITHUB_PLUGIN::repoURL_zipURL( const wxString& aRepoURL, std::string* aZipU
 }
 
 
-void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
+void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL, const PROPERTIES* aProperties )
 {
     std::string  zip_url;
 
@@ -542,19 +550,20 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL )
         THROW_IO_ERROR( msg );
     }
 
-    wxLogDebug( wxT( "Attempting to download: " ) + zip_url );
+    wxString cache_dir;
+    UTF8     option;
 
-    KICAD_CURL_EASY kcurl;      // this can THROW_IO_ERROR
+    if( aProperties && aProperties->Value( ZIP_CACHE_DIR, &option ) )
+        cache_dir = LIB_TABLE::ExpandSubstitutions( option );
 
-    kcurl.SetURL( zip_url.c_str() );
-    kcurl.SetUserAgent( "http://kicad-pcb.org" );
-    kcurl.SetHeader( "Accept", "application/zip" );
-    kcurl.SetFollowRedirects( true );
+    wxLogDebug( wxT( "Attempting to download: " ) + zip_url );
 
     try
     {
-        kcurl.Perform();
-        m_zip_image = kcurl.GetBuffer();
+        GH_ZIP_CACHE zip_cache( cache_dir );      // this can THROW_IO_ERROR
+
+        if( zip_cache.Fetch( zip_url, &m_zip_image ) )
+            wxLogDebug( wxT( "Using the cached zip file" ) );
     }
     catch( const IO_ERROR& ioe )
     {
@@ -155,6 +155,13 @@ struct GH_CACHE;
    pushing or denying the change. Ultimately you would owe the sender either a
    note of acceptance or denial by email.
 
+   <p>A Github library may also take the option <b>cache_github_zip_in_this_dir</b>,
+   a directory where the downloaded zip files are kept between sessions. When
+   it is given, the zip file is only downloaded again if it changed at github,
+   which is checked with its ETag or time stamp, and the cached copy is used
+   when github cannot be reached. The "Library Path" may also be a file:// URL
+   of a zip file, which is handy to work on a library without network access.
+
    @author Dick Hollenbeck
    @date Original date: 10-Sep-2013
 
@@ -217,11 +224,12 @@ protected:
 
     /**
      * Function remoteGetZip
-     * fetches a zip file image from a github repo synchronously.  The byte image
-     * is received into the m_input_stream. If the image has already been stored,
-     * do nothing.
+     * fetches a zip file image from a github repo synchronously, or from the directory
+     * given by the option "cache_github_zip_in_this_dir" if the repo did not change.
+     * The byte image is received into m_zip_image. If the image has already been
+     * stored, do nothing.
      */
-    void remoteGetZip( const wxString& aRepoURL );
+    void remoteGetZip( const wxString& aRepoURL, const PROPERTIES* aProperties );
 
     wxString    m_lib_path;     ///< from aLibraryPath, something like https://github.com/liftoff-sr/pretty_footprints
     std::string m_zip_image;    ///< byte image of the zip file in its entirety.
@@ -0,0 +1,274 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <kicad_curl/kicad_curl_easy.h>     // Include before any wx file
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <fctsys.h>
+#include <richio.h>
+#include <macros.h>
+#include <github_zip_cache.h>
+
+
+GH_ZIP_CACHE::GH_ZIP_CACHE( const wxString& aCacheDir ) :
+    m_dir( aCacheDir )
+{
+    if( m_dir.IsEmpty() )
+        return;
+
+    if( !wxFileName::DirExists( m_dir ) )
+        wxFileName::Mkdir( m_dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+    if( !wxFileName::IsDirWritable( m_dir ) )
+    {
+        wxString msg = wxString::Format( _( "Cannot write to the library cache directory '%s'." ),
+                                         GetChars( m_dir ) );
+        THROW_IO_ERROR( msg );
+    }
+}
+
+
+std::string GH_ZIP_CACHE::Hash( const std::string& aData )
+{
+    // 64 bit FNV-1a, the cache is not meant to resist deliberate collisions
+    uint64_t hash = 14695981039346656037ULL;
+
+    for( unsigned char c : aData )
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    return StrPrintf( "%016llx", (unsigned long long) hash );
+}
+
+
+wxString GH_ZIP_CACHE::entryPath( const std::string& aZipURL ) const
+{
+    return wxFileName( m_dir, FROM_UTF8( Hash( aZipURL ).c_str() ), "url" ).GetFullPath();
+}
+
+
+wxString GH_ZIP_CACHE::zipPath( const std::string& aZipHash ) const
+{
+    return wxFileName( m_dir, FROM_UTF8( aZipHash.c_str() ), "zip" ).GetFullPath();
+}
+
+
+bool GH_ZIP_CACHE::Fetch( const std::string& aZipURL, std::string* aZipImage )
+{
+    ENTRY cached;
+    bool  inCache = !m_dir.IsEmpty() && readEntry( aZipURL, &cached )
+                    && wxFileExists( zipPath( cached.m_zipHash ) );
+
+    KICAD_CURL_EASY kcurl;      // this can THROW_IO_ERROR
+
+    kcurl.SetURL( aZipURL.c_str() );
+    kcurl.SetUserAgent( "http://kicad-pcb.org" );
+    kcurl.SetHeader( "Accept", "application/zip" );
+    kcurl.SetFollowRedirects( true );
+    kcurl.SetFetchFileTime( true );
+
+    if( inCache )
+    {
+        if( !cached.m_etag.empty() )
+            kcurl.SetHeader( "If-None-Match", cached.m_etag );
+        else if( cached.m_fileTime >= 0 )
+            kcurl.SetIfModifiedSince( cached.m_fileTime );
+    }
+
+    try
+    {
+        kcurl.Perform();
+    }
+    catch( const IO_ERROR& )
+    {
+        // Offline, or the server is down: a possibly outdated library beats no library
+        if( inCache && readZip( cached.m_zipHash, aZipImage ) )
+        {
+            wxLogDebug( wxT( "Cannot reach '%s', using the cached archive" ), aZipURL.c_str() );
+            return true;
+        }
+
+        throw;
+    }
+
+    long code = kcurl.GetResponseCode();
+
+    if( inCache && ( code == 304 || kcurl.IsConditionUnmet() ) )
+    {
+        if( readZip( cached.m_zipHash, aZipImage ) )
+            return true;
+
+        wxString msg = wxString::Format( _( "Cannot read the cached archive of '%s'." ),
+                                         GetChars( FROM_UTF8( aZipURL.c_str() ) ) );
+        THROW_IO_ERROR( msg );
+    }
+
+    *aZipImage = kcurl.GetBuffer();
+
+    // Error pages are not cached, the caller reports them
+    if( !m_dir.IsEmpty() && code < 400 )
+    {
+        ENTRY fetched;
+
+        fetched.m_url = aZipURL;
+        fetched.m_etag = kcurl.GetResponseHeader( "ETag" );
+        fetched.m_fileTime = kcurl.GetFileTime();
+
+        store( inCache ? cached.m_zipHash : std::string(), fetched, *aZipImage );
+    }
+
+    return false;
+}
+
+
+bool GH_ZIP_CACHE::readEntry( const std::string& aZipURL, ENTRY* aEntry ) const
+{
+    wxFFile file( entryPath( aZipURL ), "rb" );
+    wxString content;
+
+    if( !file.IsOpened() || !file.ReadAll( &content, wxConvUTF8 ) )
+        return false;
+
+    aEntry->m_fileTime = -1;
+
+    // One "key value" pair per line
+    std::string text( TO_UTF8( content ) );
+    size_t      start = 0;
+
+    while( start < text.size() )
+    {
+        size_t end = text.find( '\n', start );
+
+        if( end == std::string::npos )
+            end = text.size();
+
+        size_t space = text.find( ' ', start );
+
+        if( space < end )
+        {
+            std::string key = text.substr( start, space - start );
+            std::string value = text.substr( space + 1, end - space - 1 );
+
+            if( key == "url" )
+                aEntry->m_url = value;
+            else if( key == "etag" )
+                aEntry->m_etag = value;
+            else if( key == "time" )
+                aEntry->m_fileTime = (time_t) strtoll( value.c_str(), NULL, 10 );
+            else if( key == "zip" )
+                aEntry->m_zipHash = value;
+        }
+
+        start = end + 1;
+    }
+
+    // Guard against hash collisions of the URLs
+    return aEntry->m_url == aZipURL && !aEntry->m_zipHash.empty();
+}
+
+
+void GH_ZIP_CACHE::writeEntry( const ENTRY& aEntry ) const
+{
+    wxString path = entryPath( aEntry.m_url );
+    wxString tmpPath = path + ".tmp";
+
+    std::string text = StrPrintf( "url %s\netag %s\ntime %lld\nzip %s\n",
+                                  aEntry.m_url.c_str(), aEntry.m_etag.c_str(),
+                                  (long long) aEntry.m_fileTime, aEntry.m_zipHash.c_str() );
+
+    wxFFile file( tmpPath, "wb" );
+
+    if( !file.IsOpened() || !file.Write( text.data(), text.size() ) || !file.Close() )
+    {
+        wxLogDebug( wxT( "Cannot write the library cache file '%s'" ), GetChars( tmpPath ) );
+        return;
+    }
+
+    // Never leave a partially written file behind, another instance may be reading it
+    wxRenameFile( tmpPath, path, true );
+}
+
+
+bool GH_ZIP_CACHE::readZip( const std::string& aZipHash, std::string* aZipImage ) const
+{
+    wxFFile file( zipPath( aZipHash ), "rb" );
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 )
+        return false;
+
+    aZipImage->resize( (size_t) length );
+
+    if( length && file.Read( &(*aZipImage)[0], (size_t) length ) != (size_t) length )
+    {
+        aZipImage->clear();
+        return false;
+    }
+
+    // The file name is the hash of the content, anything else is a corrupted file
+    return Hash( *aZipImage ) == aZipHash;
+}
+
+
+void GH_ZIP_CACHE::store( const std::string& aPreviousZipHash, ENTRY& aEntry,
+                          const std::string& aZipImage ) const
+{
+    aEntry.m_zipHash = Hash( aZipImage );
+
+    wxString path = zipPath( aEntry.m_zipHash );
+
+    // Content addressed: an archive already stored, e.g. by another URL, is kept as is
+    if( !wxFileExists( path ) )
+    {
+        wxString tmpPath = path + ".tmp";
+        wxFFile  file( tmpPath, "wb" );
+
+        if( !file.IsOpened() || !file.Write( aZipImage.data(), aZipImage.size() )
+            || !file.Close() )
+        {
+            wxLogDebug( wxT( "Cannot write the library cache file '%s'" ), GetChars( tmpPath ) );
+            return;
+        }
+
+        wxRenameFile( tmpPath, path, true );
+    }
+
+    writeEntry( aEntry );
+
+    // The previous archive of this URL is outdated.  Another URL might still refer to it,
+    // it would then be downloaded again on its next use.
+    if( !aPreviousZipHash.empty() && aPreviousZipHash != aEntry.m_zipHash )
+        wxRemoveFile( zipPath( aPreviousZipHash ) );
+}
@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GITHUB_ZIP_CACHE_H_
+#define GITHUB_ZIP_CACHE_H_
+
+#include <ctime>
+#include <string>
+#include <wx/string.h>
+
+
+/**
+ * Class GH_ZIP_CACHE
+ * downloads the zip archives of github (or github like) libraries and keeps them in a
+ * local directory, so a library which did not change upstream is not downloaded again
+ * in later sessions.
+ *
+ * Archives are stored under the hash of their content.  For each zip URL, a small text
+ * file named after the hash of the URL holds the hash of the archive and the validators
+ * sent by the server.  When the archive of a URL is in the cache, the request is made
+ * conditional: with "If-None-Match" if the server sent an ETag, with "If-Modified-Since"
+ * and the modification time of the archive otherwise.  file:// URLs are handled the same
+ * way using the time of the file, which makes a local copy of a library a stand-in for
+ * the server when testing.
+ *
+ * If the server cannot be reached, the cached archive is used.  Without a cache directory,
+ * archives are simply downloaded.
+ */
+class GH_ZIP_CACHE
+{
+public:
+    /**
+     * Constructor
+     * @param aCacheDir is the cache directory, it is created if needed.  Empty to disable
+     *  the cache.
+     */
+    GH_ZIP_CACHE( const wxString& aCacheDir = wxEmptyString );
+
+    /**
+     * Function Fetch
+     * gets the zip archive at aZipURL, from the cache if it did not change upstream.
+     *
+     * @param aZipURL is the URL of the archive
+     * @param aZipImage receives the archive, or the response of the server if it failed
+     * @return bool - true if the archive comes from the cache
+     * @throw IO_ERROR if the request failed and the archive is not in the cache
+     */
+    bool Fetch( const std::string& aZipURL, std::string* aZipImage );
+
+    const wxString& GetCacheDir() const { return m_dir; }
+
+    /**
+     * Function Hash
+     * returns a hexadecimal string identifying aData, used to name the cache files.
+     */
+    static std::string Hash( const std::string& aData );
+
+private:
+    struct ENTRY
+    {
+        std::string m_url;
+        std::string m_etag;         ///< ETag of the archive, if the server sent one
+        time_t      m_fileTime;     ///< modification time of the archive, -1 if unknown
+        std::string m_zipHash;      ///< hash of the archive content
+    };
+
+    wxString entryPath( const std::string& aZipURL ) const;
+    wxString zipPath( const std::string& aZipHash ) const;
+
+    bool readEntry( const std::string& aZipURL, ENTRY* aEntry ) const;
+    void writeEntry( const ENTRY& aEntry ) const;
+
+    bool readZip( const std::string& aZipHash, std::string* aZipImage ) const;
+    void store( const std::string& aPreviousZipHash, ENTRY& aEntry,
+                const std::string& aZipImage ) const;
+
+    wxString    m_dir;
+};
+
+#endif // GITHUB_ZIP_CACHE_H_
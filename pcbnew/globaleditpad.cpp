@@ -38,6 +38,7 @@
 
 #include <pcbnew.h>
 #include <dialog_global_pads_edition.h>
+#include <board_bulk_edit.h>
 
 /*
  * PCB_EDIT_FRAME::Function DlgGlobalChange_PadSettings
@@ -165,50 +166,9 @@ void PCB_BASE_FRAME::GlobalChange_PadSettings( D_PAD* aPad,
     MODULE* Module_Ref = module;
     double pad_orient = aPad->GetOrientation() - Module_Ref->GetOrientation();
 
-    // Prepare an undo list:
-    if( aSaveForUndo )
-    {
-        PICKED_ITEMS_LIST itemsList;
-
-        for( module = m_Pcb->m_Modules;  module;  module = module->Next() )
-        {
-            if( !aSameFootprints && (module != Module_Ref) )
-                continue;
-
-            if( module->GetFPID() != Module_Ref->GetFPID() )
-                continue;
-
-            bool   saveMe = false;
-
-            for( D_PAD* pad = module->PadsList();  pad;  pad = pad->Next() )
-            {
-                // Filters changes prohibited.
-                if( aPadShapeFilter && ( pad->GetShape() != aPad->GetShape() ) )
-                    continue;
-
-                double currpad_orient = pad->GetOrientation() - module->GetOrientation();
-
-                if( aPadOrientFilter && ( currpad_orient != pad_orient ) )
-                    continue;
-
-                if( aPadLayerFilter  &&  pad->GetLayerSet() != aPad->GetLayerSet() )
-                    continue;
-
-                saveMe = true;
-            }
-
-            if( saveMe )
-            {
-                ITEM_PICKER itemWrapper( module, UR_CHANGED );
+    // Collect the pads to change first, then change them in a single commit
+    BOARD_BULK_EDIT edit( this );
 
-                itemsList.PushItem( itemWrapper );
-            }
-        }
-
-        SaveCopyInUndoList( itemsList, UR_CHANGED );
-    }
-
-    // Update the current module and same others modules if requested.
     for( module = m_Pcb->m_Modules;  module;  module = module->Next() )
     {
         if( !aSameFootprints && (module != Module_Ref) )
@@ -217,14 +177,6 @@ void PCB_BASE_FRAME::GlobalChange_PadSettings( D_PAD* aPad,
         if( module->GetFPID() != Module_Ref->GetFPID() )
             continue;
 
-        // Erase module on screen
-        if( aRedraw )
-        {
-            module->SetFlags( DO_NOT_DRAW );
-            m_canvas->RefreshDrawingRect( module->GetBoundingBox() );
-            module->ClearFlags( DO_NOT_DRAW );
-        }
-
         for( D_PAD* pad = module->PadsList();  pad;  pad = pad->Next() )
         {
             // Filters changes prohibited.
@@ -234,64 +186,19 @@ void PCB_BASE_FRAME::GlobalChange_PadSettings( D_PAD* aPad,
             if( aPadOrientFilter &&  (pad->GetOrientation() - module->GetOrientation()) != pad_orient )
                 continue;
 
-            if( aPadLayerFilter )
-            {
-                if( pad->GetLayerSet() != aPad->GetLayerSet() )
-                    continue;
-                else
-                    m_Pcb->m_Status_Pcb &= ~( LISTE_RATSNEST_ITEM_OK | CONNEXION_OK);
-            }
-
-            // Change characteristics:
-            pad->SetAttribute( aPad->GetAttribute() );
-            pad->SetShape( aPad->GetShape() );
-
-            pad->SetLayerSet( aPad->GetLayerSet() );
-
-            pad->SetSize( aPad->GetSize() );
-            pad->SetDelta( aPad->GetDelta() );
-            pad->SetOffset( aPad->GetOffset() );
-
-            pad->SetDrillSize( aPad->GetDrillSize() );
-            pad->SetDrillShape( aPad->GetDrillShape() );
-
-            pad->SetOrientation( pad_orient + module->GetOrientation() );
-
-            // copy also local mask margins, because these parameters usually depend on
-            // pad sizes and layers
-            pad->SetLocalSolderMaskMargin( aPad->GetLocalSolderMaskMargin() );
-            pad->SetLocalSolderPasteMargin( aPad->GetLocalSolderPasteMargin() );
-            pad->SetLocalSolderPasteMarginRatio( aPad->GetLocalSolderPasteMarginRatio() );
-
-            if( pad->GetShape() != PAD_SHAPE_TRAPEZOID )
-            {
-                pad->SetDelta( wxSize( 0, 0 ) );
-            }
-
-            if( pad->GetShape() == PAD_SHAPE_CIRCLE )
-            {
-                // Ensure pad size.y = pad size.x
-                int size = pad->GetSize().x;
-                pad->SetSize( wxSize( size, size ) );
-            }
-
-            switch( pad->GetAttribute() )
-            {
-            case PAD_ATTRIB_SMD:
-            case PAD_ATTRIB_CONN:
-                pad->SetDrillSize( wxSize( 0, 0 ) );
-                break;
-
-            default:
-                break;
-            }
+            if( aPadLayerFilter  &&  pad->GetLayerSet() != aPad->GetLayerSet() )
+                continue;
+
+            edit.AddPadEdit( pad, aPad, pad_orient );
         }
+    }
 
-        module->CalculateBoundingBox();
+    if( edit.Empty() )
+        return;
 
-        if( aRedraw )
-            m_canvas->RefreshDrawingRect( module->GetBoundingBox() );
-    }
+    edit.Push( _( "Change pads settings" ), aSaveForUndo );
 
-    OnModify();
+    // The view of the GAL canvas is updated by the commit
+    if( aRedraw && !IsGalCanvasActive() )
+        m_canvas->Refresh();
 }
@@ -0,0 +1,193 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <fctsys.h>
+#include <class_board.h>
+#include <class_track.h>
+#include <layer_remap.h>
+#include <task_scheduler.h>
+
+#include <algorithm>
+
+
+LAYER_REMAP::LAYER_REMAP()
+{
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        m_map[layer] = ToLAYER_ID( layer );
+        m_sourceCount[layer] = 1;
+    }
+}
+
+
+LAYER_REMAP::LAYER_REMAP( const std::vector<int>& aTable ) :
+    LAYER_REMAP()
+{
+    wxASSERT( aTable.size() == PCB_LAYER_ID_COUNT );
+
+    for( unsigned layer = 0; layer < aTable.size() && layer < PCB_LAYER_ID_COUNT; ++layer )
+        Set( ToLAYER_ID( layer ), ToLAYER_ID( aTable[layer] ) );
+}
+
+
+void LAYER_REMAP::Set( PCB_LAYER_ID aLayer, PCB_LAYER_ID aNewLayer )
+{
+    wxCHECK( IsPcbLayer( aLayer ) && IsPcbLayer( aNewLayer ), /* void */ );
+
+    m_sourceCount[m_map[aLayer]]--;
+    m_map[aLayer] = aNewLayer;
+    m_sourceCount[aNewLayer]++;
+}
+
+
+bool LAYER_REMAP::IsIdentity() const
+{
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        if( isChanged( ToLAYER_ID( layer ) ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+std::vector<int> LAYER_REMAP::GetTable() const
+{
+    return std::vector<int>( m_map, m_map + PCB_LAYER_ID_COUNT );
+}
+
+
+LAYER_REMAP LAYER_REMAP::Inverse() const
+{
+    LAYER_REMAP inverse;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        PCB_LAYER_ID source = ToLAYER_ID( layer );
+
+        if( isChanged( source ) && !isAmbiguous( source ) )
+            inverse.Set( m_map[source], source );
+    }
+
+    return inverse;
+}
+
+
+bool LAYER_REMAP::IsAmbiguous( const BOARD_ITEM* aItem ) const
+{
+    if( aItem->Type() == PCB_VIA_T )
+    {
+        const VIA* via = static_cast<const VIA*>( aItem );
+
+        if( via->GetViaType() == VIA_THROUGH )
+            return false;
+
+        PCB_LAYER_ID top_layer, bottom_layer;
+
+        via->LayerPair( &top_layer, &bottom_layer );
+
+        return isAmbiguous( top_layer ) || isAmbiguous( bottom_layer );
+    }
+
+    PCB_LAYER_ID layer = aItem->GetLayer();
+
+    return IsPcbLayer( layer ) && isAmbiguous( layer );
+}
+
+
+std::vector<BOARD_ITEM*> LAYER_REMAP::Apply( const std::vector<BOARD_ITEM*>& aItems,
+                                             const std::vector<BOARD_ITEM*>& aSkipped ) const
+{
+    // One flag by item: the items are changed in parallel and collected in their order
+    std::vector<char> changed( aItems.size(), 0 );
+
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, aItems.size(), [&]( int ii )
+    {
+        BOARD_ITEM* item = aItems[ii];
+
+        if( !aSkipped.empty() && std::binary_search( aSkipped.begin(), aSkipped.end(), item ) )
+            return;
+
+        if( item->Type() == PCB_VIA_T )
+        {
+            VIA* via = static_cast<VIA*>( item );
+
+            if( via->GetViaType() == VIA_THROUGH )
+                return;
+
+            PCB_LAYER_ID top_layer, bottom_layer;
+
+            via->LayerPair( &top_layer, &bottom_layer );
+
+            if( !isChanged( top_layer ) && !isChanged( bottom_layer ) )
+                return;
+
+            via->SetLayerPair( m_map[top_layer], m_map[bottom_layer] );
+        }
+        else
+        {
+            PCB_LAYER_ID layer = item->GetLayer();
+
+            if( !IsPcbLayer( layer ) || !isChanged( layer ) )
+                return;
+
+            item->SetLayer( m_map[layer] );
+        }
+
+        changed[ii] = 1;
+    }, 1024 );
+
+    std::vector<BOARD_ITEM*> changedItems;
+
+    for( unsigned ii = 0; ii < aItems.size(); ++ii )
+    {
+        if( changed[ii] )
+            changedItems.push_back( aItems[ii] );
+    }
+
+    return changedItems;
+}
+
+
+std::vector<BOARD_ITEM*> LAYER_REMAP::GetItems( BOARD* aBoard )
+{
+    std::vector<BOARD_ITEM*> items;
+
+    for( TRACK* segm = aBoard->m_Track; segm; segm = segm->Next() )
+        items.push_back( segm );
+
+    for( TRACK* segm = aBoard->m_Zone; segm; segm = segm->Next() )
+        items.push_back( segm );
+
+    for( BOARD_ITEM* item = aBoard->m_Drawings; item; item = item->Next() )
+    {
+        if( item->Type() == PCB_LINE_T )
+            items.push_back( item );
+    }
+
+    return items;
+}
@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#ifndef __LAYER_REMAP_H
+#define __LAYER_REMAP_H
+
+#include <vector>
+
+#include <layers_id_colors_and_visibility.h>
+
+class BOARD;
+class BOARD_ITEM;
+
+/**
+ * Class LAYER_REMAP
+ *
+ * A layer translation table, applied at once to the tracks, vias, zone segments and
+ * graphic lines of a board.
+ *
+ * The table is also the undo entry of the change: the items are restored by the inverse
+ * table.  Only the items moved to a layer which receives other layers too cannot be
+ * restored by the table (see IsAmbiguous()), they have to be saved by copy.
+ */
+class LAYER_REMAP
+{
+public:
+    /// Creates the identity table
+    LAYER_REMAP();
+
+    /// Creates a table from its GetTable() image, as stored in an undo entry
+    LAYER_REMAP( const std::vector<int>& aTable );
+
+    void Set( PCB_LAYER_ID aLayer, PCB_LAYER_ID aNewLayer );
+
+    PCB_LAYER_ID Map( PCB_LAYER_ID aLayer ) const
+    {
+        return m_map[aLayer];
+    }
+
+    bool IsIdentity() const;
+
+    /// @return the new layer of each layer
+    std::vector<int> GetTable() const;
+
+    /**
+     * Function Inverse
+     * @return the table restoring the layers changed by this one. The layers receiving
+     * several layers are left unchanged.
+     */
+    LAYER_REMAP Inverse() const;
+
+    /**
+     * Function IsAmbiguous
+     * @return true if one of the layers of aItem is changed to a layer which receives other
+     * layers too: the item cannot be restored by Inverse().
+     */
+    bool IsAmbiguous( const BOARD_ITEM* aItem ) const;
+
+    /**
+     * Function Apply
+     * changes the layers of aItems in one parallel pass.  The layers of through vias are
+     * not changed.
+     * @param aSkipped are items to leave unchanged, sorted by address
+     * @return the changed items, in the order of aItems
+     */
+    std::vector<BOARD_ITEM*> Apply( const std::vector<BOARD_ITEM*>& aItems,
+                                    const std::vector<BOARD_ITEM*>& aSkipped =
+                                        std::vector<BOARD_ITEM*>() ) const;
+
+    /// @return the items of aBoard which have their layers remapped
+    static std::vector<BOARD_ITEM*> GetItems( BOARD* aBoard );
+
+private:
+    bool isChanged( PCB_LAYER_ID aLayer ) const
+    {
+        return m_map[aLayer] != aLayer;
+    }
+
+    bool isAmbiguous( PCB_LAYER_ID aLayer ) const
+    {
+        return isChanged( aLayer ) && m_sourceCount[m_map[aLayer]] > 1;
+    }
+
+    PCB_LAYER_ID    m_map[PCB_LAYER_ID_COUNT];
+    int             m_sourceCount[PCB_LAYER_ID_COUNT];  ///< number of layers mapped to a layer
+};
+
+#endif
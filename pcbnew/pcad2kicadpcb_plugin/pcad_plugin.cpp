@@ -69,8 +69,6 @@ const wxString PCAD_PLUGIN::GetFileExtension() const
 
 BOARD* PCAD_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPERTIES* aProperties )
 {
-    wxXmlDocument   xmlDoc;
-
     m_props = aProperties;
 
     m_board = aAppendToMe ? aAppendToMe : new BOARD();
@@ -83,8 +81,7 @@ BOARD* PCAD_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe, const P
 
     LOCALE_IO toggle;    // toggles on, then off, the C locale.
 
-    LoadInputFile( aFileName, &xmlDoc );
-    pcb.Parse( NULL, &xmlDoc, wxT( "PCB" ) );
+    pcb.Parse( NULL, aFileName, wxT( "PCB" ) );
     pcb.AddToBoard();
 
     return m_board;
@@ -92,6 +92,11 @@ PCB::PCB( BOARD* aBoard ) : PCB_MODULE( this, aBoard )
     m_layersMap[6].KiCadLayer  = F_SilkS;
     m_layersMap[7].KiCadLayer  = B_SilkS;
     m_timestamp_cnt = 0x10000000;
+
+    m_hasDesign   = false;
+    m_hasOutline  = false;
+    m_netsStarted = false;
+    m_netCode     = 1;
 }
 
 
@@ -133,31 +138,58 @@ int PCB::GetNetCode( wxString aNetName )
     return 0;
 }
 
-XNODE* PCB::FindCompDefName( XNODE* aNode, wxString aName )
+XNODE* PCB::FindCompDefName( const wxString& aName )
 {
-    XNODE*      result = NULL, * lNode;
-    wxString    propValue;
+    XNODE_MAP::const_iterator it = m_compDefs.find( aName );
+
+    return it != m_compDefs.end() ? it->second : NULL;
+}
 
-    lNode = FindNode( aNode, wxT( "compDef" ) );
 
-    while( lNode )
+XNODE* PCB::FindPatternDef( const wxString& aName )
+{
+    // patternDef sections take precedence over the patternDefExtended ones
+    XNODE_MAP::const_iterator it = m_patternDefs.find( aName );
+
+    if( it != m_patternDefs.end() )
+        return it->second;
+
+    it = m_patternDefsExtended.find( aName );
+
+    return it != m_patternDefsExtended.end() ? it->second : NULL;
+}
+
+
+void PCB::IndexLibraryNode( XNODE* aNode )
+{
+    wxString propValue;
+    XNODE*   originalName;
+
+    // The first definition of a name wins, as it did for the linear searches
+    if( aNode->GetName() == wxT( "patternDef" ) )
     {
-        if( lNode->GetName() == wxT( "compDef" ) )
-        {
-            lNode->GetAttribute( wxT( "Name" ), &propValue );
+        aNode->GetAttribute( wxT( "Name" ), &propValue );
+        m_patternDefs.insert( XNODE_MAP::value_type( ValidateName( propValue ), aNode ) );
 
-            if( propValue == aName )
-            {
-                result  = lNode;
-                lNode   = NULL;
-            }
-        }
+        originalName = FindNode( aNode, wxT( "originalName" ) );
 
-        if( lNode )
-            lNode = lNode->GetNext();
+        if( originalName )
+        {
+            propValue = wxEmptyString;
+            originalName->GetAttribute( wxT( "Name" ), &propValue );
+            m_patternDefs.insert( XNODE_MAP::value_type( ValidateName( propValue ), aNode ) );
+        }
+    }
+    else if( aNode->GetName() == wxT( "patternDefExtended" ) )
+    {
+        aNode->GetAttribute( wxT( "Name" ), &propValue );
+        m_patternDefsExtended.insert( XNODE_MAP::value_type( ValidateName( propValue ), aNode ) );
+    }
+    else if( aNode->GetName() == wxT( "compDef" ) )
+    {
+        aNode->GetAttribute( wxT( "Name" ), &propValue );
+        m_compDefs.insert( XNODE_MAP::value_type( propValue, aNode ) );
     }
-
-    return result;
 }
 
 
@@ -231,10 +263,9 @@ void PCB::SetTextProperty( XNODE*   aNode, TTEXTVALUE* aTextValue,
 }
 
 
-void PCB::DoPCBComponents( XNODE*           aNode,
-                           wxXmlDocument*   aXmlDoc,
-                           wxString         aActualConversion,
-                           wxStatusBar*     aStatusBar )
+void PCB::DoPCBComponent( XNODE*            aNode,
+                          wxString          aActualConversion,
+                          wxStatusBar*      aStatusBar )
 {
     XNODE*        lNode, * tNode, * mNode;
     PCB_MODULE*   mc;
@@ -243,179 +274,154 @@ void PCB::DoPCBComponents( XNODE*           aNode,
     PCB_KEEPOUT*  keepOut;
     wxString      cn, str, propValue;
 
-    lNode = aNode->GetChildren();
+    lNode = aNode;
+    mc = NULL;
 
-    while( lNode )
+    if( lNode->GetName() == wxT( "pattern" ) )
     {
-        mc = NULL;
+        FindNode( lNode, wxT( "patternRef" ) )->GetAttribute( wxT( "Name" ),
+                                                              &cn );
+        cn      = ValidateName( cn );
 
-        if( lNode->GetName() == wxT( "pattern" ) )
+        if( cn.Len() > 0 )
         {
-            FindNode( lNode, wxT( "patternRef" ) )->GetAttribute( wxT( "Name" ),
-                                                                  &cn );
-            cn      = ValidateName( cn );
-            tNode   = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "library" ) );
+            tNode = FindPatternDef( cn );
 
-            if( tNode && cn.Len() > 0 )
+            if( tNode )
             {
-                tNode = FindModulePatternDefName( tNode, cn );
+                mc = new PCB_MODULE( this, m_board );
 
-                if( tNode )
-                {
-                    mc = new PCB_MODULE( this, m_board );
+                mNode = FindNode( lNode, wxT( "patternGraphicsNameRef" ) );
+                if( mNode )
+                    mNode->GetAttribute( wxT( "Name" ), &mc->m_patGraphRefName );
 
-                    mNode = FindNode( lNode, wxT( "patternGraphicsNameRef" ) );
-                    if( mNode )
-                        mNode->GetAttribute( wxT( "Name" ), &mc->m_patGraphRefName );
+                mc->Parse( tNode, aStatusBar, m_defaultMeasurementUnit, aActualConversion );
+            }
+        }
 
-                    mc->Parse( tNode, aStatusBar, m_defaultMeasurementUnit, aActualConversion );
-                }
+        if( mc )
+        {
+            mc->m_compRef = cn;    // default - in new version of file it is updated later....
+            tNode = FindNode( lNode, wxT( "refDesRef" ) );
+
+            if( tNode )
+            {
+                tNode->GetAttribute( wxT( "Name" ), &mc->m_name.text );
+                SetTextProperty( lNode, &mc->m_name, mc->m_patGraphRefName, wxT(
+                                     "RefDes" ), aActualConversion );
+                SetTextProperty( lNode, &mc->m_value, mc->m_patGraphRefName, wxT(
+                                     "Value" ), aActualConversion );
             }
 
-            if( mc )
+            tNode = FindNode( lNode, wxT( "pt" ) );
+
+            if( tNode )
+                SetPosition( tNode->GetNodeContent(),
+                             m_defaultMeasurementUnit,
+                             &mc->m_positionX,
+                             &mc->m_positionY,
+                             aActualConversion );
+
+            tNode = FindNode( lNode, wxT( "rotation" ) );
+
+            if( tNode )
             {
-                mc->m_compRef = cn;    // default - in new version of file it is updated later....
-                tNode = FindNode( lNode, wxT( "refDesRef" ) );
+                str = tNode->GetNodeContent();
+                str.Trim( false );
+                mc->m_rotation = StrToInt1Units( str );
+            }
 
-                if( tNode )
-                {
-                    tNode->GetAttribute( wxT( "Name" ), &mc->m_name.text );
-                    SetTextProperty( lNode, &mc->m_name, mc->m_patGraphRefName, wxT(
-                                         "RefDes" ), aActualConversion );
-                    SetTextProperty( lNode, &mc->m_value, mc->m_patGraphRefName, wxT(
-                                         "Value" ), aActualConversion );
-                }
+            str = FindNodeGetContent( lNode, wxT( "isFlipped" ) );
 
-                tNode = FindNode( lNode, wxT( "pt" ) );
+            if( str == wxT( "True" ) )
+                mc->m_mirror = 1;
 
-                if( tNode )
-                    SetPosition( tNode->GetNodeContent(),
-                                 m_defaultMeasurementUnit,
-                                 &mc->m_positionX,
-                                 &mc->m_positionY,
-                                 aActualConversion );
+            XNODE_MAP::const_iterator compInst = m_compInsts.find( mc->m_name.text );
 
-                tNode = FindNode( lNode, wxT( "rotation" ) );
+            if( compInst != m_compInsts.end() )
+            {
+                tNode = compInst->second;
 
-                if( tNode )
+                if( FindNode( tNode, wxT( "compValue" ) ) )
                 {
-                    str = tNode->GetNodeContent();
-                    str.Trim( false );
-                    mc->m_rotation = StrToInt1Units( str );
+                    FindNode( tNode,
+                              wxT( "compValue" ) )->GetAttribute( wxT( "Name" ),
+                                                                  &mc->m_value.text );
+                    mc->m_value.text.Trim( false );
+                    mc->m_value.text.Trim( true );
                 }
 
-                str = FindNodeGetContent( lNode, wxT( "isFlipped" ) );
-
-                if( str == wxT( "True" ) )
-                    mc->m_mirror = 1;
-
-                tNode = aNode;
+                if( FindNode( tNode, wxT( "compRef" ) ) )
+                {
+                    FindNode( tNode,
+                              wxT( "compRef" ) )->GetAttribute( wxT( "Name" ),
+                                                                &mc->m_compRef );
+                    mc->m_compRef.Trim( false );
+                    mc->m_compRef.Trim( true );
+                }
+            }
 
-                while( tNode->GetName() != wxT( "www.lura.sk" ) )
-                    tNode = tNode->GetParent();
+            // map pins
+            tNode = FindCompDefName( mc->m_compRef );
 
-                tNode = FindNode( tNode, wxT( "netlist" ) );
+            if( tNode )
+            {
+                tNode = FindPinMap( tNode );
 
                 if( tNode )
                 {
-                    tNode = FindNode( tNode, wxT( "compInst" ) );
+                    mNode = tNode->GetChildren();
 
-                    while( tNode )
+                    while( mNode )
                     {
-                        tNode->GetAttribute( wxT( "Name" ), &propValue );
-
-                        if( propValue == mc->m_name.text )
+                        if( mNode->GetName() == wxT( "padNum" ) )
                         {
-                            if( FindNode( tNode, wxT( "compValue" ) ) )
-                            {
-                                FindNode( tNode,
-                                          wxT( "compValue" ) )->GetAttribute( wxT( "Name" ),
-                                                                              &mc->m_value.text );
-                                mc->m_value.text.Trim( false );
-                                mc->m_value.text.Trim( true );
-                            }
-
-                            if( FindNode( tNode, wxT( "compRef" ) ) )
-                            {
-                                FindNode( tNode,
-                                          wxT( "compRef" ) )->GetAttribute( wxT( "Name" ),
-                                                                            &mc->m_compRef );
-                                mc->m_compRef.Trim( false );
-                                mc->m_compRef.Trim( true );
-                            }
-
-                            tNode = NULL;
-                        }
-                        else
-                            tNode = tNode->GetNext();
-                    }
-                }
+                            str     = mNode->GetNodeContent();
+                            mNode   = mNode->GetNext();
 
-                // map pins
-                tNode   = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "library" ) );
-                tNode   = FindCompDefName( tNode, mc->m_compRef );
+                            if( !mNode )
+                                break;
 
-                if( tNode )
-                {
-                    tNode = FindPinMap( tNode );
+                            mNode->GetAttribute( wxT( "Name" ), &propValue );
+                            mc->SetPadName( str, propValue );
+                            mNode = mNode->GetNext();
+                        }
+                        else
+                        {
+                            mNode = mNode->GetNext();
 
-                    if( tNode )
-                    {
-                        mNode = tNode->GetChildren();
+                            if( !mNode )
+                                break;
 
-                        while( mNode )
-                        {
-                            if( mNode->GetName() == wxT( "padNum" ) )
-                            {
-                                str     = mNode->GetNodeContent();
-                                mNode   = mNode->GetNext();
-
-                                if( !mNode )
-                                    break;
-
-                                mNode->GetAttribute( wxT( "Name" ), &propValue );
-                                mc->SetPadName( str, propValue );
-                                mNode = mNode->GetNext();
-                            }
-                            else
-                            {
-                                mNode = mNode->GetNext();
-
-                                if( !mNode )
-                                    break;
-
-                                mNode = mNode->GetNext();
-                            }
+                            mNode = mNode->GetNext();
                         }
                     }
                 }
-
-                m_pcbComponents.Add( mc );
             }
-        }
-        else if( lNode->GetName() == wxT( "pad" ) )
-        {
-            pad = new PCB_PAD( this, m_board );
-            pad->Parse( lNode, m_defaultMeasurementUnit, aActualConversion );
-            m_pcbComponents.Add( pad );
-        }
-        else if( lNode->GetName() == wxT( "via" ) )
-        {
-            via = new PCB_VIA( this, m_board );
-            via->Parse( lNode, m_defaultMeasurementUnit, aActualConversion );
-            m_pcbComponents.Add( via );
-        }
-        else if( lNode->GetName() == wxT( "polyKeepOut" ) )
-        {
-            keepOut = new PCB_KEEPOUT( m_callbacks, m_board, 0 );
 
-            if( keepOut->Parse( lNode, m_defaultMeasurementUnit, aActualConversion ) )
-                m_pcbComponents.Add( keepOut );
-            else
-                delete keepOut;
+            m_pcbComponents.Add( mc );
         }
+    }
+    else if( lNode->GetName() == wxT( "pad" ) )
+    {
+        pad = new PCB_PAD( this, m_board );
+        pad->Parse( lNode, m_defaultMeasurementUnit, aActualConversion );
+        m_pcbComponents.Add( pad );
+    }
+    else if( lNode->GetName() == wxT( "via" ) )
+    {
+        via = new PCB_VIA( this, m_board );
+        via->Parse( lNode, m_defaultMeasurementUnit, aActualConversion );
+        m_pcbComponents.Add( via );
+    }
+    else if( lNode->GetName() == wxT( "polyKeepOut" ) )
+    {
+        keepOut = new PCB_KEEPOUT( m_callbacks, m_board, 0 );
 
-        lNode = lNode->GetNext();
+        if( keepOut->Parse( lNode, m_defaultMeasurementUnit, aActualConversion ) )
+            m_pcbComponents.Add( keepOut );
+        else
+            delete keepOut;
     }
 }
 
@@ -575,342 +581,349 @@ double PCB::GetDistance( wxRealPoint* aPoint1, wxRealPoint* aPoint2 )
                   ( aPoint1->y - aPoint2->y ) );
 }
 
-void PCB::GetBoardOutline( wxXmlDocument* aXmlDoc, wxString aActualConversion )
+void PCB::GetBoardOutline( XNODE* aNode, wxString aActualConversion )
 {
-    XNODE*       iNode, *lNode, *pNode;
-    long         PCadLayer = 0;
+    XNODE*       lNode, *pNode;
     int          x, y, i, j, targetInd;
     wxRealPoint* xchgPoint;
     double       minDistance, distance;
 
-    iNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "pcbDesign" ) );
+    lNode = aNode->GetChildren();
 
-    if( iNode )
+    while( lNode )
     {
-        // COMPONENTS AND OBJECTS
-        iNode = iNode->GetChildren();
-
-        while( iNode )
+        if( lNode->GetName() == wxT( "line" ) )
         {
-            // objects
-            if( iNode->GetName() == wxT( "layerContents" ) )
-            {
-                if( FindNode( iNode, wxT( "layerNumRef" ) ) )
-                    FindNode( iNode, wxT( "layerNumRef" ) )->GetNodeContent().ToLong( &PCadLayer );
+            pNode = FindNode( lNode, wxT( "pt" ) );
 
-                if( GetKiCadLayer( PCadLayer ) == Edge_Cuts )
-                {
-                    lNode = iNode->GetChildren();
-                    while( lNode )
-                    {
-                        if( lNode->GetName() == wxT( "line" ) )
-                        {
-                            pNode = FindNode( lNode, wxT( "pt" ) );
-
-                            if( pNode )
-                            {
-                                SetPosition( pNode->GetNodeContent(), m_defaultMeasurementUnit,
-                                             &x, &y, aActualConversion );
+            if( pNode )
+            {
+                SetPosition( pNode->GetNodeContent(), m_defaultMeasurementUnit,
+                             &x, &y, aActualConversion );
 
-                                if( FindOutlinePoint( &m_boardOutline, wxRealPoint( x, y) ) == -1 )
-                                    m_boardOutline.Add( new wxRealPoint( x, y ) );
-                            }
+                if( FindOutlinePoint( &m_boardOutline, wxRealPoint( x, y) ) == -1 )
+                    m_boardOutline.Add( new wxRealPoint( x, y ) );
+            }
 
-                            if( pNode )
-                                pNode = pNode->GetNext();
+            if( pNode )
+                pNode = pNode->GetNext();
 
-                            if( pNode )
-                            {
-                                SetPosition( pNode->GetNodeContent(), m_defaultMeasurementUnit,
-                                             &x, &y, aActualConversion );
+            if( pNode )
+            {
+                SetPosition( pNode->GetNodeContent(), m_defaultMeasurementUnit,
+                             &x, &y, aActualConversion );
 
-                                if( FindOutlinePoint( &m_boardOutline, wxRealPoint( x, y) ) == -1 )
-                                    m_boardOutline.Add( new wxRealPoint( x, y ) );
-                            }
-                        }
+                if( FindOutlinePoint( &m_boardOutline, wxRealPoint( x, y) ) == -1 )
+                    m_boardOutline.Add( new wxRealPoint( x, y ) );
+            }
+        }
 
-                        lNode = lNode->GetNext();
-                    }
+        lNode = lNode->GetNext();
+    }
 
-                    //m_boardOutline.Sort( cmpFunc );
-                    // sort vertices according to the distances between them
-                    if( m_boardOutline.GetCount() > 3 )
-                    {
-                        for( i = 0; i < (int) m_boardOutline.GetCount() - 1; i++ )
-                        {
-                            minDistance = GetDistance( m_boardOutline[i], m_boardOutline[i + 1] );
-                            targetInd = i + 1;
-
-                            for( j = i + 2; j < (int) m_boardOutline.GetCount(); j++ )
-                            {
-                                distance = GetDistance( m_boardOutline[i], m_boardOutline[j] );
-                                if( distance < minDistance )
-                                {
-                                    minDistance = distance;
-                                    targetInd = j;
-                                }
-                            }
-
-                            xchgPoint = m_boardOutline[i + 1];
-                            m_boardOutline[i + 1] = m_boardOutline[targetInd];
-                            m_boardOutline[targetInd] = xchgPoint;
-                        }
-                    }
+    //m_boardOutline.Sort( cmpFunc );
+    // sort vertices according to the distances between them
+    if( m_boardOutline.GetCount() > 3 )
+    {
+        for( i = 0; i < (int) m_boardOutline.GetCount() - 1; i++ )
+        {
+            minDistance = GetDistance( m_boardOutline[i], m_boardOutline[i + 1] );
+            targetInd = i + 1;
 
-                    break;
+            for( j = i + 2; j < (int) m_boardOutline.GetCount(); j++ )
+            {
+                distance = GetDistance( m_boardOutline[i], m_boardOutline[j] );
+                if( distance < minDistance )
+                {
+                    minDistance = distance;
+                    targetInd = j;
                 }
             }
 
-            iNode = iNode->GetNext();
+            xchgPoint = m_boardOutline[i + 1];
+            m_boardOutline[i + 1] = m_boardOutline[targetInd];
+            m_boardOutline[targetInd] = xchgPoint;
         }
     }
 }
 
-void PCB::Parse( wxStatusBar* aStatusBar, wxXmlDocument* aXmlDoc, wxString aActualConversion )
+bool PCB::ParseNode( XNODE* aNode, wxStatusBar* aStatusBar, const wxString& aActualConversion )
 {
-    XNODE*          aNode;//, *aaNode;
+    XNODE*          parent = aNode->GetParent();
+    XNODE*          lNode;
     PCB_NET*        net;
-    PCB_COMPONENT*  comp;
     PCB_MODULE*     module;
-    wxString        compRef, pinRef, layerName, layerType;
-    int             i, j, netCode;
+    wxString        propValue, layerName, layerType;
+    long            PCadLayer = 0;
 
-    // Defaut measurement units
-    aNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "asciiHeader" ) );
-
-    if( aNode )
+    if( !parent )
     {
-        aNode = FindNode( aNode, wxT( "fileUnits" ) );
-
-        if( aNode )
+        // End of file
+        if( m_hasDesign )
         {
-            m_defaultMeasurementUnit = aNode->GetNodeContent().Lower();
-            m_defaultMeasurementUnit.Trim( true );
-            m_defaultMeasurementUnit.Trim( false );
+            PostProcess();
         }
-    }
-
-    // Determine layers stackup
-    aNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "pcbDesign" ) );
-
-    /*if( aNode )
-    {
-        aNode = FindNode( aNode, wxT( "layersStackup" ) );
-
-        if( aNode )
+        else
         {
-            aNode = FindNode( aNode, wxT( "layerStackupData" ) );
+            // LIBRARY FILE
+            // aStatusBar->SetStatusText( wxT( "Processing LIBRARY FILE " ) );
 
-            while( aNode )
+            lNode = FindNode( aNode, wxT( "library" ) );
+
+            if( lNode )
             {
-                if( aNode->GetName() == wxT( "layerStackupData" ) )
+                lNode = FindNode( lNode, wxT( "compDef" ) );
+
+                while( lNode )
                 {
-                    aaNode = FindNode( aNode, wxT( "layerStackupName" ) );
+                    // aStatusBar->SetStatusText( wxT( "Processing COMPONENTS " ) );
 
-                    if( aaNode ) {
-                        aaNode->GetAttribute( wxT( "Name" ), &layerName );
-                        layerName = layerName.MakeUpper();
-                        m_layersStackup.Add( layerName );
+                    if( lNode->GetName() == wxT( "compDef" ) )
+                    {
+                        module = new PCB_MODULE( this, m_board );
+                        module->Parse( lNode, aStatusBar, m_defaultMeasurementUnit,
+                                       aActualConversion );
+                        m_pcbComponents.Add( module );
                     }
-                }
 
-                aNode = aNode->GetNext();
+                    lNode = lNode->GetNext();
+                }
             }
         }
-    }*/
 
-    if( aNode )
-    {
-        aNode = FindNode( aNode, wxT( "layerDef" ) );
+        return true;
+    }
 
-        while( aNode )
+    if( !parent->GetParent() )
+    {
+        // A top level section: the library and the component instances of the netlist are
+        // needed until the end of the file, everything else was converted already
+        if( aNode->GetName() == wxT( "asciiHeader" ) )
         {
-            if( aNode->GetName() == wxT( "layerDef" ) )
-            {
-                if( FindNode( aNode, wxT( "layerType" ) ) )
-                {
-                    layerType = FindNode( aNode,
-                                          wxT( "layerType" ) )->GetNodeContent().Trim( false );
+            // Defaut measurement units
+            lNode = FindNode( aNode, wxT( "fileUnits" ) );
 
-                    if( layerType == wxT( "Signal" ) || layerType == wxT( "Plane" ) )
-                    {
-                        aNode->GetAttribute( wxT( "Name" ), &layerName );
-                        layerName = layerName.MakeUpper();
-                        m_layersStackup.Add( layerName );
-                    }
-                }
+            if( lNode )
+            {
+                m_defaultMeasurementUnit = lNode->GetNodeContent().Lower();
+                m_defaultMeasurementUnit.Trim( true );
+                m_defaultMeasurementUnit.Trim( false );
             }
-
-            aNode = aNode->GetNext();
         }
-    }
-
-    // Layers mapping
-    aNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "pcbDesign" ) );
+        else if( aNode->GetName() == wxT( "pcbDesign" ) )
+        {
+            m_hasDesign = true;
 
-    if( aNode )
-    {
-        aNode = FindNode( aNode, wxT( "layerDef" ) );
+            // Plane layers are clipped by the board outline
+            for( XNODE* plane : m_pendingPlanes )
+                DoLayerContentsObjects( plane, NULL, &m_pcbComponents, aStatusBar,
+                                        m_defaultMeasurementUnit, aActualConversion );
 
-        while( aNode )
+            m_pendingPlanes.clear();
+        }
+        else if( aNode->GetName() == wxT( "library" ) || aNode->GetName() == wxT( "netlist" ) )
         {
-            if( aNode->GetName() == wxT( "layerDef" ) )
-                MapLayer( aNode );
-
-            aNode = aNode->GetNext();
+            return false;
         }
+
+        return true;
     }
 
-    GetBoardOutline( aXmlDoc, aActualConversion );
+    if( parent->GetParent()->GetParent() )
+    {
+        // Components and objects of the board
+        if( parent->GetName() == wxT( "multiLayer" )
+            && parent->GetParent()->GetName() == wxT( "pcbDesign" )
+            && !parent->GetParent()->GetParent()->GetParent() )
+        {
+            DoPCBComponent( aNode, aActualConversion, aStatusBar );
+            return true;
+        }
 
-    // NETLIST
-    // aStatusBar->SetStatusText( wxT( "Loading NETLIST " ) );
+        return false;
+    }
 
-    aNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "netlist" ) );
+    // Children of the top level sections
+    if( parent->GetName() == wxT( "library" ) )
+    {
+        IndexLibraryNode( aNode );
+        return false;
+    }
 
-    if( aNode )
+    if( parent->GetName() == wxT( "netlist" ) )
     {
-        aNode = FindNode( aNode, wxT( "net" ) );
+        // NETLIST
+        // aStatusBar->SetStatusText( wxT( "Loading NETLIST " ) );
 
-        netCode = 1;
+        if( aNode->GetName() == wxT( "net" ) )
+            m_netsStarted = true;
 
-        while( aNode )
+        // Every section from the first net on makes a net
+        if( m_netsStarted )
         {
-            net = new PCB_NET( netCode++ );
+            net = new PCB_NET( m_netCode++ );
             net->Parse( aNode );
             m_pcbNetlist.Add( net );
+        }
 
-            aNode = aNode->GetNext();
+        if( aNode->GetName() == wxT( "compInst" ) )
+        {
+            aNode->GetAttribute( wxT( "Name" ), &propValue );
+            m_compInsts.insert( XNODE_MAP::value_type( propValue, aNode ) );
+            return false;
         }
+
+        return true;
     }
 
+    if( parent->GetName() != wxT( "pcbDesign" ) )
+        return true;
+
     // BOARD FILE
     // aStatusBar->SetStatusText( wxT( "Loading BOARD DEFINITION " ) );
 
-    aNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "pcbDesign" ) );
-
-    if( aNode )
+    if( aNode->GetName() == wxT( "layerDef" ) )
     {
-        // COMPONENTS AND OBJECTS
-        aNode = aNode->GetChildren();
-
-        while( aNode )
+        // Layers stackup, the layer definitions precede the objects using them
+        if( FindNode( aNode, wxT( "layerType" ) ) )
         {
-            // Components/modules
-            if( aNode->GetName() == wxT( "multiLayer" ) )
-                DoPCBComponents( aNode, aXmlDoc, aActualConversion, aStatusBar );
-
-            // objects
-            if( aNode->GetName() == wxT( "layerContents" ) )
-                DoLayerContentsObjects( aNode, NULL, &m_pcbComponents, aStatusBar,
-                                        m_defaultMeasurementUnit, aActualConversion );
+            layerType = FindNode( aNode, wxT( "layerType" ) )->GetNodeContent().Trim( false );
 
-            aNode = aNode->GetNext();
+            if( layerType == wxT( "Signal" ) || layerType == wxT( "Plane" ) )
+            {
+                aNode->GetAttribute( wxT( "Name" ), &layerName );
+                layerName = layerName.MakeUpper();
+                m_layersStackup.Add( layerName );
+            }
         }
 
-        // POSTPROCESS -- SET NETLIST REFERENCES
-        // aStatusBar->SetStatusText( wxT( "Processing NETLIST " ) );
+        // Layers mapping
+        MapLayer( aNode );
+    }
+    else if( aNode->GetName() == wxT( "layerContents" ) )
+    {
+        if( FindNode( aNode, wxT( "layerNumRef" ) ) )
+            FindNode( aNode, wxT( "layerNumRef" ) )->GetNodeContent().ToLong( &PCadLayer );
 
-        for( i = 0; i < (int) m_pcbNetlist.GetCount(); i++ )
+        // The first board layer gives the outline
+        if( !m_hasOutline && GetKiCadLayer( PCadLayer ) == Edge_Cuts )
         {
-            net = m_pcbNetlist[i];
-
-            for( j = 0; j < (int) net->m_netNodes.GetCount(); j++ )
-            {
-                compRef = net->m_netNodes[j]->m_compRef;
-                compRef.Trim( false );
-                compRef.Trim( true );
-                pinRef = net->m_netNodes[j]->m_pinRef;
-                pinRef.Trim( false );
-                pinRef.Trim( true );
-                ConnectPinToNet( compRef, pinRef, net->m_name );
-            }
+            GetBoardOutline( aNode, aActualConversion );
+            m_hasOutline = true;
         }
 
-        // POSTPROCESS -- FLIP COMPONENTS
-        for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
+        if( !m_hasOutline && GetLayerType( PCadLayer ) == LAYER_TYPE_PLANE )
         {
-            if( m_pcbComponents[i]->m_objType == wxT( 'M' ) )
-                ( (PCB_MODULE*) m_pcbComponents[i] )->Flip();
+            m_pendingPlanes.push_back( aNode );
+            return false;
         }
 
-        // POSTPROCESS -- SET/OPTIMIZE NEW PCB POSITION
-        // aStatusBar->SetStatusText( wxT( "Optimizing BOARD POSITION " ) );
+        DoLayerContentsObjects( aNode, NULL, &m_pcbComponents, aStatusBar,
+                                m_defaultMeasurementUnit, aActualConversion );
+    }
+
+    return true;
+}
 
-        m_sizeX = 10000000;
-        m_sizeY = 0;
 
-        for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
-        {
-            comp = m_pcbComponents[i];
+void PCB::PostProcess()
+{
+    PCB_NET*        net;
+    PCB_COMPONENT*  comp;
+    wxString        compRef, pinRef;
+    int             i, j;
 
-            if( comp->m_positionY < m_sizeY )
-                m_sizeY = comp->m_positionY; // max Y
+    // POSTPROCESS -- SET NETLIST REFERENCES
+    // aStatusBar->SetStatusText( wxT( "Processing NETLIST " ) );
 
-            if( comp->m_positionX < m_sizeX && comp->m_positionX > 0 )
-                m_sizeX = comp->m_positionX; // Min X
+    for( i = 0; i < (int) m_pcbNetlist.GetCount(); i++ )
+    {
+        net = m_pcbNetlist[i];
+
+        for( j = 0; j < (int) net->m_netNodes.GetCount(); j++ )
+        {
+            compRef = net->m_netNodes[j]->m_compRef;
+            compRef.Trim( false );
+            compRef.Trim( true );
+            pinRef = net->m_netNodes[j]->m_pinRef;
+            pinRef.Trim( false );
+            pinRef.Trim( true );
+            ConnectPinToNet( compRef, pinRef, net->m_name );
         }
+    }
 
-        m_sizeY -= 10000;
-        m_sizeX -= 10000;
-        // aStatusBar->SetStatusText( wxT( " POSITIONING POSTPROCESS " ) );
+    // POSTPROCESS -- FLIP COMPONENTS
+    for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
+    {
+        if( m_pcbComponents[i]->m_objType == wxT( 'M' ) )
+            ( (PCB_MODULE*) m_pcbComponents[i] )->Flip();
+    }
 
-        for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
-            m_pcbComponents[i]->SetPosOffset( -m_sizeX, -m_sizeY );
+    // POSTPROCESS -- SET/OPTIMIZE NEW PCB POSITION
+    // aStatusBar->SetStatusText( wxT( "Optimizing BOARD POSITION " ) );
 
-        m_sizeX = 0;
-        m_sizeY = 0;
+    m_sizeX = 10000000;
+    m_sizeY = 0;
 
-        for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
-        {
-            comp = m_pcbComponents[i];
+    for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
+    {
+        comp = m_pcbComponents[i];
 
-            if( comp->m_positionY < m_sizeY )
-                m_sizeY = comp->m_positionY; // max Y
+        if( comp->m_positionY < m_sizeY )
+            m_sizeY = comp->m_positionY; // max Y
 
-            if( comp->m_positionX > m_sizeX )
-                m_sizeX = comp->m_positionX; // Min X
-        }
+        if( comp->m_positionX < m_sizeX && comp->m_positionX > 0 )
+            m_sizeX = comp->m_positionX; // Min X
+    }
 
-        // SHEET SIZE CALCULATION
-        m_sizeY = -m_sizeY;    // it is in absolute units
-        m_sizeX += 10000;
-        m_sizeY += 10000;
+    m_sizeY -= 10000;
+    m_sizeX -= 10000;
+    // aStatusBar->SetStatusText( wxT( " POSITIONING POSTPROCESS " ) );
 
-        // A4 is minimum $Descr A4 11700 8267
-        if( m_sizeX < 11700 )
-            m_sizeX = 11700;
+    for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
+        m_pcbComponents[i]->SetPosOffset( -m_sizeX, -m_sizeY );
 
-        if( m_sizeY < 8267 )
-            m_sizeY = 8267;
-    }
-    else
+    m_sizeX = 0;
+    m_sizeY = 0;
+
+    for( i = 0; i < (int) m_pcbComponents.GetCount(); i++ )
     {
-        // LIBRARY FILE
-        // aStatusBar->SetStatusText( wxT( "Processing LIBRARY FILE " ) );
+        comp = m_pcbComponents[i];
 
-        aNode = FindNode( (XNODE *)aXmlDoc->GetRoot(), wxT( "library" ) );
+        if( comp->m_positionY < m_sizeY )
+            m_sizeY = comp->m_positionY; // max Y
 
-        if( aNode )
-        {
-            aNode = FindNode( aNode, wxT( "compDef" ) );
+        if( comp->m_positionX > m_sizeX )
+            m_sizeX = comp->m_positionX; // Min X
+    }
 
-            while( aNode )
-            {
-                // aStatusBar->SetStatusText( wxT( "Processing COMPONENTS " ) );
+    // SHEET SIZE CALCULATION
+    m_sizeY = -m_sizeY;    // it is in absolute units
+    m_sizeX += 10000;
+    m_sizeY += 10000;
 
-                if( aNode->GetName() == wxT( "compDef" ) )
-                {
-                    module = new PCB_MODULE( this, m_board );
-                    module->Parse( aNode, aStatusBar, m_defaultMeasurementUnit,
-                                   aActualConversion );
-                    m_pcbComponents.Add( module );
-                }
+    // A4 is minimum $Descr A4 11700 8267
+    if( m_sizeX < 11700 )
+        m_sizeX = 11700;
 
-                aNode = aNode->GetNext();
-            }
-        }
-    }
+    if( m_sizeY < 8267 )
+        m_sizeY = 8267;
+}
+
+
+void PCB::Parse( wxStatusBar* aStatusBar, const wxString& aFileName, wxString aActualConversion )
+{
+    XNODE* root;
+
+    root = LoadInputFile( aFileName,
+                          [&]( XNODE* aNode )
+                          {
+                              return ParseNode( aNode, aStatusBar, aActualConversion );
+                          } );
+
+    // The root is consumed at the end of the file
+    wxASSERT( !root );
+    delete root;
 }
 
 
@@ -30,7 +30,10 @@
 #ifndef pcb_H_
 #define pcb_H_
 
+#include <vector>
+
 #include <wx/wx.h>
+#include <wx/hashmap.h>
 #include <xnode.h>
 
 #include <pcb_module.h>
@@ -58,33 +61,57 @@ public:
     wxString        GetLayerNetNameRef( int aPCadLayer ) override;
     int             GetNewTimestamp() override;
     int             GetNetCode( wxString aNetName ) override;
+    XNODE*          FindPatternDef( const wxString& aName ) override;
 
-    void            Parse( wxStatusBar* aStatusBar,
-                           wxXmlDocument* aXmlDoc,
-                           wxString     aActualConversion );
+    /**
+     * Function Parse
+     * reads the P-CAD ASCII file aFileName.  The file is converted while it is read:
+     * header, netlist and design objects are processed and freed as soon as they are
+     * complete, only the library (needed to instantiate the patterns) and the component
+     * instances of the netlist are kept until the end of the file.
+     */
+    void            Parse( wxStatusBar*    aStatusBar,
+                           const wxString& aFileName,
+                           wxString        aActualConversion );
 
     void            AddToBoard() override;
 
 private:
+    WX_DECLARE_STRING_HASH_MAP( XNODE*, XNODE_MAP );
+
     int             m_timestamp_cnt;
     wxArrayString   m_layersStackup;
 
-    XNODE*          FindCompDefName( XNODE* aNode, wxString aName );
+    XNODE_MAP       m_patternDefs;          // library patternDef by name and original name
+    XNODE_MAP       m_patternDefsExtended;  // library patternDefExtended by name
+    XNODE_MAP       m_compDefs;             // library compDef by name
+    XNODE_MAP       m_compInsts;            // netlist compInst by name
+    bool            m_hasDesign;            // a pcbDesign section was read
+    bool            m_hasOutline;           // the board outline was read
+    bool            m_netsStarted;
+    int             m_netCode;
+    std::vector<XNODE*> m_pendingPlanes;    // plane layers read before the board outline
+
+    bool            ParseNode( XNODE*          aNode,
+                               wxStatusBar*    aStatusBar,
+                               const wxString& aActualConversion );
+    void            IndexLibraryNode( XNODE* aNode );
+    void            PostProcess();
+    XNODE*          FindCompDefName( const wxString& aName );
     void            SetTextProperty( XNODE*         aNode,
                                      TTEXTVALUE*    aTextValue,
                                      wxString       aPatGraphRefName,
                                      wxString       aXmlName,
                                      wxString       aActualConversion );
-    void            DoPCBComponents( XNODE*         aNode,
-                                     wxXmlDocument* aXmlDoc,
-                                     wxString       aActualConversion,
-                                     wxStatusBar*   aStatusBar );
+    void            DoPCBComponent( XNODE*          aNode,
+                                    wxString        aActualConversion,
+                                    wxStatusBar*    aStatusBar );
     void            ConnectPinToNet( wxString aCr, wxString aPr, wxString aNetName );
     int             FindLayer( wxString aLayerName );
     void            MapLayer( XNODE* aNode );
     int             FindOutlinePoint( VERTICES_ARRAY* aOutline, wxRealPoint aPoint );
     double          GetDistance( wxRealPoint* aPoint1, wxRealPoint* aPoint2 );
-    void            GetBoardOutline( wxXmlDocument* aXmlDoc, wxString aActualConversion );
+    void            GetBoardOutline( XNODE* aNode, wxString aActualConversion );
 };
 
 } // namespace PCAD2KICAD
@@ -33,6 +33,8 @@
 #include <wx/wx.h>
 #include <layers_id_colors_and_visibility.h>
 
+class XNODE;
+
 enum LAYER_TYPE_T
 {
     LAYER_TYPE_SIGNAL,
@@ -58,6 +60,9 @@ namespace PCAD2KICAD
         virtual wxString      GetLayerNetNameRef( int aPCadLayer ) = 0;
         virtual int           GetNewTimestamp() = 0;
         virtual int           GetNetCode( wxString netName ) = 0;
+
+        /// Returns the library patternDef or patternDefExtended named aName, or NULL
+        virtual XNODE*        FindPatternDef( const wxString& aName ) = 0;
     };
 }
 
@@ -68,60 +68,6 @@ PCB_MODULE::~PCB_MODULE()
 }
 
 
-XNODE* PCB_MODULE::FindModulePatternDefName( XNODE* aNode, wxString aName )
-{
-    XNODE*      result, * lNode;
-    wxString    propValue1, propValue2;
-
-    result  = NULL;
-    lNode   = FindNode( aNode, wxT( "patternDef" ) );
-
-    while( lNode )
-    {
-        if( lNode->GetName() == wxT( "patternDef" ) )
-        {
-            lNode->GetAttribute( wxT( "Name" ), &propValue1 );
-            FindNode( lNode,
-                      wxT( "originalName" ) )->GetAttribute( wxT( "Name" ), &propValue2 );
-
-            if( ValidateName( propValue1 ) == aName
-                || ValidateName( propValue2 ) == aName )
-            {
-                result  = lNode;
-                lNode   = NULL;
-            }
-        }
-
-        if( lNode )
-            lNode = lNode->GetNext();
-    }
-
-    if( result == NULL )
-    {
-        lNode = FindNode( aNode, wxT( "patternDefExtended" ) );  // New file format
-
-        while( lNode )
-        {
-            if( lNode->GetName() == wxT( "patternDefExtended" ) )
-            {
-                lNode->GetAttribute( wxT( "Name" ), &propValue1 );
-
-                if( ValidateName( propValue1 ) == aName )
-                {
-                    result  = lNode;
-                    lNode   = NULL;
-                }
-            }
-
-            if( lNode )
-                lNode = lNode->GetNext();
-        }
-    }
-
-    return result;
-}
-
-
 XNODE* PCB_MODULE::FindPatternMultilayerSection( XNODE* aNode, wxString* aPatGraphRefName )
 {
     XNODE*      result, * pNode, * lNode;
@@ -147,7 +93,7 @@ XNODE* PCB_MODULE::FindPatternMultilayerSection( XNODE* aNode, wxString* aPatGra
             patName = ValidateName( propValue );
         }
 
-        lNode   = FindModulePatternDefName( lNode->GetParent(), patName );
+        lNode   = m_callbacks->FindPatternDef( patName );
         pNode   = lNode; // pattern;
     }
 
@@ -48,7 +48,6 @@ public:
     PCB_MODULE( PCB_CALLBACKS* aCallbacks, BOARD* aBoard );
     ~PCB_MODULE();
 
-    XNODE*      FindModulePatternDefName( XNODE* aNode, wxString aName );
 
     void        DoLayerContentsObjects( XNODE*                  aNode,
                                         PCB_MODULE*             aPCBModule,
@@ -36,11 +36,12 @@ namespace PCAD2KICAD {
 static KEYWORD empty_keywords[1] = {};
 static const char ACCEL_ASCII_KEYWORD[] = "ACCEL_ASCII";
 
-void LoadInputFile( wxString aFileName, wxXmlDocument* aXmlDoc )
+XNODE* LoadInputFile( wxString aFileName, const XNODE_HANDLER& aHandler )
 {
     char      line[sizeof( ACCEL_ASCII_KEYWORD )];
     int       tok;
-    XNODE*    iNode = NULL, *cNode = NULL;
+    XNODE*    root, *iNode = NULL, *cNode = NULL, *closedNode;
+    bool      started = false;
     wxString  str, propValue, content;
     wxCSConv  conv( wxT( "windows-1251" ) );
 
@@ -61,56 +62,89 @@ void LoadInputFile( wxString aFileName, wxXmlDocument* aXmlDoc )
     // lexer now owns fp, will close on exception or return
     DSNLEXER lexer( empty_keywords, 0, fp,  aFileName );
 
-    iNode = new XNODE( wxXML_ELEMENT_NODE, wxT( "www.lura.sk" ) );
+    root = iNode = new XNODE( wxXML_ELEMENT_NODE, wxT( "www.lura.sk" ) );
 
-    while( ( tok = lexer.NextTok() ) != DSN_EOF )
+    try
     {
-        if( tok == DSN_RIGHT )
-        {
-            iNode = iNode->GetParent();
-        }
-        else if( tok == DSN_LEFT )
+        while( ( tok = lexer.NextTok() ) != DSN_EOF )
         {
-            tok = lexer.NextTok();
-            str = wxEmptyString;
-            cNode = new XNODE( wxXML_ELEMENT_NODE, wxString( lexer.CurText(), conv ) );
-            iNode->AddChild( cNode );
-            iNode = cNode;
-        }
-        else if( cNode )
-        {
-            str = wxString( lexer.CurText(), conv );
-            if( tok == DSN_STRING )
+            if( tok == DSN_RIGHT )
             {
-                // update attribute
-                if( iNode->GetAttribute( wxT( "Name" ), &propValue ) )
+                if( iNode == root )
+                    THROW_IO_ERROR( wxT( "Unbalanced parentheses in file: " ) + aFileName );
+
+                closedNode = iNode;
+                iNode = iNode->GetParent();
+
+                if( aHandler( closedNode ) )
                 {
-                    iNode->DeleteAttribute( wxT( "Name" ) );
-                    iNode->AddAttribute( wxT( "Name" ), propValue + wxT( ' ' ) + str );
+                    // cNode is the last node created, closedNode itself or one of its children
+                    iNode->RemoveChild( closedNode );
+                    delete closedNode;
+                    cNode = NULL;
                 }
-                else
-                    iNode->AddAttribute( wxT( "Name" ), str );
             }
-            else if( str != wxEmptyString )
+            else if( tok == DSN_LEFT )
             {
-                // update node content
-                content = cNode->GetNodeContent() + wxT( ' ' ) + str;
-
-                if( cNode->GetChildren() )
-                    cNode->GetChildren()->SetContent( content );
-                else
-                    cNode->AddChild( new wxXmlNode( wxXML_TEXT_NODE,
-                                                    wxEmptyString,
-                                                    content ) );
+                tok = lexer.NextTok();
+                str = wxEmptyString;
+                cNode = new XNODE( wxXML_ELEMENT_NODE, wxString( lexer.CurText(), conv ) );
+                iNode->AddChild( cNode );
+                iNode = cNode;
+                started = true;
+            }
+            else if( started )
+            {
+                str = wxString( lexer.CurText(), conv );
+
+                if( tok == DSN_STRING )
+                {
+                    // update attribute
+                    if( iNode->GetAttribute( wxT( "Name" ), &propValue ) )
+                    {
+                        iNode->DeleteAttribute( wxT( "Name" ) );
+                        iNode->AddAttribute( wxT( "Name" ), propValue + wxT( ' ' ) + str );
+                    }
+                    else
+                        iNode->AddAttribute( wxT( "Name" ), str );
+                }
+                else if( cNode && str != wxEmptyString )
+                {
+                    // update node content
+                    content = cNode->GetNodeContent() + wxT( ' ' ) + str;
+
+                    if( cNode->GetChildren() )
+                        cNode->GetChildren()->SetContent( content );
+                    else
+                        cNode->AddChild( new wxXmlNode( wxXML_TEXT_NODE,
+                                                        wxEmptyString,
+                                                        content ) );
+                }
             }
         }
-    }
 
-    if( iNode )
+        if( aHandler( root ) )
+        {
+            delete root;
+            root = NULL;
+        }
+    }
+    catch( ... )
     {
-        aXmlDoc->SetRoot( iNode );
-        //aXmlDoc->Save( wxT( "test.xml" ) );
+        delete root;
+        throw;
     }
+
+    return root;
+}
+
+
+void LoadInputFile( wxString aFileName, wxXmlDocument* aXmlDoc )
+{
+    XNODE* root = LoadInputFile( aFileName, []( XNODE* ) { return false; } );
+
+    aXmlDoc->SetRoot( root );
+    //aXmlDoc->Save( wxT( "test.xml" ) );
 }
 
 } // namespace PCAD2KICAD
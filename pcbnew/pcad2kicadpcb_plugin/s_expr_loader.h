@@ -29,8 +29,31 @@
 #ifndef S_EXPR_LOADER_H_
 #define S_EXPR_LOADER_H_
 
+#include <functional>
+
+class XNODE;
+class wxXmlDocument;
+
 namespace PCAD2KICAD
 {
+    /**
+     * Called by the streaming LoadInputFile() for each node once it is complete, children
+     * before their parent.  Returns true if the node was consumed: it is then removed from
+     * the tree and deleted.
+     */
+    typedef std::function<bool( XNODE* aNode )> XNODE_HANDLER;
+
+    /**
+     * Function LoadInputFile
+     * reads a P-CAD ASCII file, handing each node to aHandler as soon as it is read so the
+     * caller can process the file section by section instead of keeping all of it in memory.
+     *
+     * @return XNODE* - the root node with the nodes which were not consumed, NULL if the
+     *  root itself was consumed.  The caller owns it.
+     * @throw IO_ERROR if the file cannot be read or is not a P-CAD ASCII file.
+     */
+    XNODE* LoadInputFile( wxString aFileName, const XNODE_HANDLER& aHandler );
+
     void LoadInputFile( wxString aFileName, wxXmlDocument* aXmlDoc );
 }
 
@@ -27,6 +27,8 @@
 #include <pcb_draw_panel_gal.h>
 #include <gal/graphics_abstraction_layer.h>
 #include <class_board.h>
+#include <ratsnest_data.h>
+#include <layer_remap.h>
 #include <view/view.h>
 
 
@@ -80,3 +82,27 @@ void PCB_BASE_EDIT_FRAME::SetBoard( BOARD* aBoard )
             m_toolManager->ResetTools( TOOL_BASE::MODEL_RELOAD );
     }
 }
+
+
+int PCB_BASE_EDIT_FRAME::applyLayerRemap( const LAYER_REMAP& aRemap,
+                                          const std::vector<BOARD_ITEM*>& aSkipped )
+{
+    std::vector<BOARD_ITEM*> changed = aRemap.Apply( LAYER_REMAP::GetItems( GetBoard() ),
+                                                     aSkipped );
+
+    KIGFX::VIEW* view = GetGalCanvas()->GetView();
+    std::vector<const BOARD_ITEM*> connected;
+
+    for( BOARD_ITEM* item : changed )
+    {
+        view->Update( item, KIGFX::LAYERS );
+
+        if( item->IsConnected() )
+            connected.push_back( item );
+    }
+
+    if( !connected.empty() )
+        GetBoard()->GetRatsnest()->Update( connected );
+
+    return changed.size();
+}
@@ -28,6 +28,7 @@
 #include <wxBasePcbFrame.h>
 
 class BOARD_ITEM_CONTAINER;
+class LAYER_REMAP;
 
 /**
  * Common, abstract interface for edit frames.
@@ -199,6 +200,17 @@ protected:
      * duplicateItem(BOARD_ITEM*, bool) above
      */
     virtual void duplicateItems( bool aIncrement ) = 0;
+
+    /**
+     * Function applyLayerRemap
+     * moves the board items to the layers given by aRemap, and updates the view and the
+     * ratsnest data of the changed items only: the view redraws only the layers they leave
+     * and join.  The ratsnest has still to be recalculated.
+     * @param aSkipped are items to leave unchanged, sorted by address
+     * @return the number of changed items
+     */
+    int applyLayerRemap( const LAYER_REMAP& aRemap,
+                         const std::vector<BOARD_ITEM*>& aSkipped = std::vector<BOARD_ITEM*>() );
 };
 
 #endif
@@ -258,7 +258,12 @@ class PCB_PARSER : public PCB_LEXER
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), NULL, 10 );
+        long val;
+
+        if( !CurInteger( val ) )
+            val = strtol( CurText(), NULL, 10 );
+
+        return (int) val;
     }
 
     inline int parseInt( const char* aExpected )
@@ -34,8 +34,11 @@
 #endif
 #include <fctsys.h>
 #include <pgm_base.h>
+#include <common.h>
 #include <kiface_i.h>
 #include <kiface_ids.h>
+#include <project_preloader.h>
+#include <task_scheduler.h>
 #include <confirm.h>
 #include <macros.h>
 #include <make_unique.h>
@@ -100,6 +103,53 @@ DLIST<TRACK> g_CurrentTrackList;
 
 namespace PCB {
 
+/**
+ * Class PCB_PROJECT_PRELOADER
+ * loads the footprint library table of the project and fills the caches of all its
+ * libraries in parallel, so the board editor, the footprint editor and the footprint
+ * browsers of the project find them already read.
+ */
+static class PCB_PROJECT_PRELOADER : public PROJECT_PRELOADER
+{
+public:
+    void PreloadProject( KIWAY& aKiway, TASK_GROUP& aTasks ) override
+    {
+        FP_LIB_TABLE* tbl = aKiway.Prj().PcbFootprintLibs();
+
+        // The "C" locale is held in this image until PreloadFinish(), so the LOCALE_IOs of
+        // the parsers only count and never switch the locale while another task parses.
+        m_locale.reset( new LOCALE_IO );
+
+        // Each row owns its plugin and so its cache: the rows can be read concurrently,
+        // as FOOTPRINT_LIST_IMPL does.
+        for( const wxString& nickname : tbl->GetLogicalLibs() )
+        {
+            aTasks.Run( [tbl, nickname]() {
+                wxArrayString footprints;
+
+                try
+                {
+                    tbl->FootprintEnumerate( footprints, nickname );
+                }
+                catch( const IO_ERROR& )
+                {
+                    // reported when an editor reads this library
+                }
+            } );
+        }
+    }
+
+    void PreloadFinish( KIWAY& aKiway, bool aCancelled ) override
+    {
+        // The caches belong to the table rows, there is nothing to hand over.
+        m_locale.reset();
+    }
+
+private:
+    std::unique_ptr<LOCALE_IO>  m_locale;   ///< "C" locale held while the tasks run
+} projectPreloader;
+
+
 static struct IFACE : public KIFACE_I
 {
     // Of course all are virtual overloads, implementations of the KIFACE.
@@ -181,6 +231,9 @@ static struct IFACE : public KIFACE_I
         case KIFACE_G_FOOTPRINT_TABLE:
             return (void*) new FP_LIB_TABLE( &GFootprintTable );
 
+        case KIFACE_PROJECT_PRELOADER:
+            return (void*) static_cast<PROJECT_PRELOADER*>( &projectPreloader );
+
         default:
             return nullptr;
         }
@@ -28,10 +28,6 @@
  * @brief Class that computes missing connections on a PCB.
  */
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif /* USE_OPENMP */
-
 #include <ratsnest_data.h>
 
 #include <class_board.h>
@@ -39,6 +35,7 @@
 #include <class_pad.h>
 #include <class_track.h>
 #include <class_zone.h>
+#include <task_scheduler.h>
 
 #include <functional>
 using namespace std::placeholders;
@@ -64,6 +61,15 @@ static uint64_t getDistance( const RN_NODE_PTR& aNode1, const RN_NODE_PTR& aNode
 }
 
 
+static uint64_t getDistance( const VECTOR2I& aPosition, const RN_NODE_PTR& aNode )
+{
+    int64_t x = ( aPosition.x - aNode->GetX() ) >> 16;
+    int64_t y = ( aPosition.y - aNode->GetY() ) >> 16;
+
+    return ( x * x + y * y );
+}
+
+
 static bool sortDistance( const RN_NODE_PTR& aOrigin, const RN_NODE_PTR& aNode1,
                    const RN_NODE_PTR& aNode2 )
 {
@@ -651,6 +657,32 @@ const RN_NODE_PTR RN_NET::GetClosestNode( const RN_NODE_PTR& aNode,
 }
 
 
+const RN_NODE_PTR RN_NET::GetClosestNode( const VECTOR2I& aPosition,
+                                          const RN_NODE_FILTER& aFilter ) const
+{
+    const RN_LINKS::RN_NODE_SET& nodes = m_links.GetNodes();
+
+    uint64_t minDistance = std::numeric_limits<uint64_t>::max();
+    RN_NODE_PTR closest;
+
+    for( const RN_NODE_PTR& node : nodes )
+    {
+        if( !aFilter( node ) )
+            continue;
+
+        uint64_t distance = getDistance( aPosition, node );
+
+        if( distance < minDistance )
+        {
+            minDistance = distance;
+            closest = node;
+        }
+    }
+
+    return closest;
+}
+
+
 std::list<RN_NODE_PTR> RN_NET::GetClosestNodes( const RN_NODE_PTR& aNode, int aNumber ) const
 {
     std::list<RN_NODE_PTR> closest;
@@ -1213,6 +1245,60 @@ bool RN_DATA::Update( const BOARD_ITEM* aItem )
 }
 
 
+void RN_DATA::Update( const std::vector<const BOARD_ITEM*>& aItems )
+{
+    std::unordered_map<int, std::vector<const BOARD_ITEM*> > netItems;
+    int maxNet = -1;
+
+    auto addToNet = [&]( const BOARD_ITEM* aItem, int aNet )
+    {
+        netItems[aNet].push_back( aItem );
+        maxNet = std::max( maxNet, aNet );
+    };
+
+    for( const BOARD_ITEM* item : aItems )
+    {
+        if( item->Type() == PCB_MODULE_T )
+        {
+            const MODULE* module = static_cast<const MODULE*>( item );
+
+            for( const D_PAD* pad = module->PadsList().GetFirst(); pad; pad = pad->Next() )
+            {
+                // Do not process orphaned items
+                if( pad->GetNetCode() > NETINFO_LIST::ORPHANED )
+                    addToNet( pad, pad->GetNetCode() );
+            }
+        }
+        else if( item->IsConnected() )
+        {
+            int net = static_cast<const BOARD_CONNECTED_ITEM*>( item )->GetNetCode();
+
+            if( net >= 0 )
+                addToNet( item, net );
+        }
+    }
+
+    // Resize once here: Add() and Remove() must not resize m_nets while other nets are
+    // being updated
+    if( maxNet >= (int) m_nets.size() )
+        m_nets.resize( maxNet + 1 );
+
+    std::vector<std::vector<const BOARD_ITEM*>*> nets;
+
+    for( auto& net : netItems )
+        nets.push_back( &net.second );
+
+    // Nets do not share any data, each one is updated by a single task
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, nets.size(), [this, &nets]( int i )
+    {
+        for( const BOARD_ITEM* item : *nets[i] )
+            Update( item );
+    } );
+}
+
+
 void RN_DATA::ProcessBoard()
 {
     int netCount = m_board->GetNetCount();
@@ -1275,22 +1361,14 @@ void RN_DATA::Recalculate( int aNet )
     PROF_COUNTER totalRealTime;
 #endif
 
-        unsigned int i;
+        TASK_GROUP group;
 
-#ifdef USE_OPENMP
-        #pragma omp parallel shared(netCount) private(i)
-        {
-            #pragma omp for schedule(guided, 1)
-#else /* USE_OPENMP */
+        // Start with net number 1, as 0 stands for not connected
+        group.ParallelFor( 1, netCount, [this]( int i )
         {
-#endif
-            // Start with net number 1, as 0 stands for not connected
-            for( i = 1; i < netCount; ++i )
-            {
-                if( m_nets[i].IsDirty() )
-                    updateNet( i );
-            }
-        }  /* end of parallel section */
+            if( m_nets[i].IsDirty() )
+                updateNet( i );
+        } );
 #ifdef PROFILE
     totalRealTime.Stop();
     wxLogDebug( "Recalculate all nets: %.1f ms", totalRealTime.msecs() );
@@ -491,6 +491,16 @@ public:
     const RN_NODE_PTR GetClosestNode( const RN_NODE_PTR& aNode,
                                       const RN_NODE_FILTER& aFilter ) const;
 
+    /**
+     * Function GetClosestNode()
+     * Returns a single node that lies in the shortest distance from a specific point and meets
+     * selected filter criterion.
+     * @param aPosition is the point for which the closest node is searched.
+     * @param aFilter is a functor that filters nodes.
+     */
+    const RN_NODE_PTR GetClosestNode( const VECTOR2I& aPosition,
+                                      const RN_NODE_FILTER& aFilter ) const;
+
     /**
      * Function GetClosestNodes()
      * Returns list of nodes sorted by the distance from a specific node.
@@ -655,7 +665,7 @@ public:
      * Default constructor
      * @param aBoard is the board to be processed in order to look for unconnected items.
      */
-    RN_DATA( const BOARD* aBoard ) : m_board( aBoard ) {}
+    RN_DATA( const BOARD* aBoard ) : m_board( aBoard ), m_simpleOffset( 0, 0 ) {}
 
     /**
      * Function Add()
@@ -682,6 +692,15 @@ public:
      */
     bool Update( const BOARD_ITEM* aItem );
 
+    /**
+     * Function Update()
+     * Updates the ratsnest data for a batch of items. Items are grouped by net and the nets
+     * are updated in parallel, so it is much faster than updating the items one by one.
+     * Items not previously added to the ratsnest are ignored.
+     * @param aItems are the items to be updated.
+     */
+    void Update( const std::vector<const BOARD_ITEM*>& aItems );
+
     /**
      * Function AddSimple()
      * Sets an item to be drawn in simple mode (i.e. one line per node, instead of full ratsnest).
@@ -706,6 +725,29 @@ public:
     {
         for( RN_NET& net : m_nets )
             net.ClearSimple();
+
+        m_simpleOffset = VECTOR2I( 0, 0 );
+    }
+
+    /**
+     * Function SetSimpleOffset()
+     * Sets the translation of the items drawn in simple mode, for items dragged without being
+     * moved yet. The simple ratsnest lines then start from the translated nodes. The offset
+     * is reset by ClearSimple().
+     * @param aOffset is the translation, in internal units.
+     */
+    void SetSimpleOffset( const VECTOR2I& aOffset )
+    {
+        m_simpleOffset = aOffset;
+    }
+
+    /**
+     * Function GetSimpleOffset()
+     * Returns the translation of the items drawn in simple mode.
+     */
+    const VECTOR2I& GetSimpleOffset() const
+    {
+        return m_simpleOffset;
     }
 
     /**
@@ -795,6 +837,9 @@ protected:
 
     ///> Stores information about ratsnest grouped by net numbers.
     std::vector<RN_NET> m_nets;
+
+    ///> Translation of the nodes drawn in simple mode.
+    VECTOR2I m_simpleOffset;
 };
 
 #endif /* RATSNEST_DATA_H */
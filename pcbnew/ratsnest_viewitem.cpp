@@ -62,6 +62,7 @@ void RATSNEST_VIEWITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
     auto rs = aView->GetPainter()->GetSettings();
     auto color = rs->GetColor( NULL, LAYER_RATSNEST );
     int highlightedNet = rs->GetHighlightNetCode();
+    const VECTOR2I& offset = m_data->GetSimpleOffset();
 
     // Dynamic ratsnest (for e.g. dragged items)
     for( int i = 1; i < m_data->GetNetCount(); ++i )
@@ -81,11 +82,13 @@ void RATSNEST_VIEWITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
             if( node->GetRefCount() > 1 )
                 continue;
 
-            RN_NODE_PTR dest = net.GetClosestNode( node, LINE_TARGET() );
+            // Dragged items are drawn translated, but not moved yet
+            VECTOR2I pos = VECTOR2I( node->GetX(), node->GetY() ) + offset;
+            RN_NODE_PTR dest = net.GetClosestNode( pos, LINE_TARGET() );
 
             if( dest )
             {
-                VECTOR2D origin( node->GetX(), node->GetY() );
+                VECTOR2D origin( pos );
                 VECTOR2D end( dest->GetX(), dest->GetY() );
 
                 gal->DrawLine( origin, end );
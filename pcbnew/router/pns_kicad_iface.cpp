@@ -33,6 +33,8 @@
 #include <unordered_set>
 #include <unordered_map>
 
+#include <boost/functional/hash.hpp>
+
 #include <view/view.h>
 #include <view/view_item.h>
 #include <view/view_group.h>
@@ -81,6 +83,16 @@ public:
     virtual int DpNetPolarity( int aNet ) override;
     virtual bool DpNetPair( PNS::ITEM* aItem, int& aNetP, int& aNetN ) override;
 
+    ///> Updates the cached local clearance of a pad added to or modified on the board.
+    void UpdatePad( const D_PAD* aPad );
+    void RemovePad( const D_PAD* aPad );
+
+    ///> Returns true if the net clearance cache covers a given net code.
+    bool HasNet( int aNetCode ) const
+    {
+        return aNetCode < (int) m_netClearanceCache.size();
+    }
+
 private:
     struct CLEARANCE_ENT
     {
@@ -137,18 +149,8 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard, PNS::ROUTER*
     // Build clearance cache for pads
     for( MODULE* mod = m_board->m_Modules; mod ; mod = mod->Next() )
     {
-        auto moduleClearance = mod->GetLocalClearance();
-
         for( D_PAD* pad = mod->PadsList(); pad; pad = pad->Next() )
-        {
-            int padClearance = pad->GetLocalClearance();
-
-            if( padClearance > 0 )
-                m_localClearanceCache[ pad ] = padClearance;
-
-            else if( moduleClearance > 0 )
-                m_localClearanceCache[ pad ] = moduleClearance;
-        }
+            UpdatePad( pad );
     }
 
     //printf("DefaultCL : %d\n",  m_board->GetDesignSettings().m_NetClasses.Find ("Default clearance")->GetClearance());
@@ -167,6 +169,26 @@ PNS_PCBNEW_RULE_RESOLVER::~PNS_PCBNEW_RULE_RESOLVER()
 }
 
 
+void PNS_PCBNEW_RULE_RESOLVER::UpdatePad( const D_PAD* aPad )
+{
+    int padClearance = aPad->GetLocalClearance();
+    int moduleClearance = aPad->GetParent() ? aPad->GetParent()->GetLocalClearance() : 0;
+
+    if( padClearance > 0 )
+        m_localClearanceCache[ aPad ] = padClearance;
+    else if( moduleClearance > 0 )
+        m_localClearanceCache[ aPad ] = moduleClearance;
+    else
+        m_localClearanceCache.erase( aPad );
+}
+
+
+void PNS_PCBNEW_RULE_RESOLVER::RemovePad( const D_PAD* aPad )
+{
+    m_localClearanceCache.erase( aPad );
+}
+
+
 int PNS_PCBNEW_RULE_RESOLVER::localPadClearance( const PNS::ITEM* aItem ) const
 {
     if( !aItem->Parent() || aItem->Parent()->Type() != PCB_PAD_T )
@@ -460,11 +482,18 @@ PNS_KICAD_IFACE::PNS_KICAD_IFACE()
     m_router = nullptr;
     m_debugDecorator = nullptr;
     m_dispOptions = nullptr;
+    m_worldOutdated = true;
+    m_syncedStamp = 0;
+    m_committing = false;
+
+    BOARD_COMMIT::AddListener( this );
 }
 
 
 PNS_KICAD_IFACE::~PNS_KICAD_IFACE()
 {
+    BOARD_COMMIT::RemoveListener( this );
+
     delete m_ruleResolver;
     delete m_debugDecorator;
 
@@ -521,6 +550,8 @@ std::unique_ptr<PNS::SOLID> PNS_KICAD_IFACE::syncPad( D_PAD* aPad )
 
     std::unique_ptr< PNS::SOLID > solid( new PNS::SOLID );
 
+    m_padSignatures[ aPad ] = padSignature( aPad );
+
     solid->SetLayers( layers );
     solid->SetNet( aPad->GetNetCode() );
     solid->SetParent( aPad );
@@ -757,6 +788,7 @@ std::unique_ptr<PNS::VIA> PNS_KICAD_IFACE::syncVia( VIA* aVia )
 void PNS_KICAD_IFACE::SetBoard( BOARD* aBoard )
 {
     m_board = aBoard;
+    m_worldOutdated = true;
     wxLogTrace( "PNS", "m_board = %p", m_board );
 }
 
@@ -769,6 +801,9 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
         return;
     }
 
+    m_world = aWorld;
+    m_padSignatures.clear();
+
     for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
     {
         for( D_PAD* pad = module->PadsList(); pad; pad = pad->Next() )
@@ -804,6 +839,348 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
 
     aWorld->SetRuleResolver( m_ruleResolver );
     aWorld->SetMaxClearance( 4 * worstClearance );
+
+    m_worldOutdated = false;
+    m_syncedStamp = m_board->GetModificationStamp();
+}
+
+
+bool PNS_KICAD_IFACE::isItemInSync( const PNS::ITEM* aItem, BOARD_CONNECTED_ITEM* aParent ) const
+{
+    if( aItem->Net() != aParent->GetNetCode() )
+        return false;
+
+    switch( aParent->Type() )
+    {
+    case PCB_PAD_T:
+    {
+        auto sig = m_padSignatures.find( static_cast<D_PAD*>( aParent ) );
+
+        return aItem->Kind() == PNS::ITEM::SOLID_T && sig != m_padSignatures.end()
+               && sig->second == padSignature( static_cast<D_PAD*>( aParent ) );
+    }
+
+    case PCB_TRACE_T:
+    {
+        if( aItem->Kind() != PNS::ITEM::SEGMENT_T )
+            return false;
+
+        const PNS::SEGMENT* seg = static_cast<const PNS::SEGMENT*>( aItem );
+        TRACK* track = static_cast<TRACK*>( aParent );
+
+        return seg->Seg().A == VECTOR2I( track->GetStart() )
+               && seg->Seg().B == VECTOR2I( track->GetEnd() )
+               && seg->Width() == track->GetWidth()
+               && seg->Layers() == LAYER_RANGE( track->GetLayer() )
+               && seg->IsLocked() == track->IsLocked();
+    }
+
+    case PCB_VIA_T:
+    {
+        if( aItem->Kind() != PNS::ITEM::VIA_T )
+            return false;
+
+        const PNS::VIA* via = static_cast<const PNS::VIA*>( aItem );
+        VIA* boardVia = static_cast<VIA*>( aParent );
+        PCB_LAYER_ID top, bottom;
+        boardVia->LayerPair( &top, &bottom );
+
+        return via->Pos() == VECTOR2I( boardVia->GetPosition() )
+               && via->Diameter() == boardVia->GetWidth()
+               && via->Drill() == boardVia->GetDrillValue()
+               && via->ViaType() == boardVia->GetViaType()
+               && via->Layers() == LAYER_RANGE( top, bottom )
+               && via->IsLocked() == boardVia->IsLocked();
+    }
+
+    default:
+        return false;
+    }
+}
+
+
+size_t PNS_KICAD_IFACE::padSignature( const D_PAD* aPad ) const
+{
+    size_t seed = 0;
+
+    // Everything syncPad() and the rule resolver take into account
+    boost::hash_combine( seed, aPad->GetPosition().x );
+    boost::hash_combine( seed, aPad->GetPosition().y );
+    boost::hash_combine( seed, aPad->GetOrientation() );
+    boost::hash_combine( seed, aPad->GetSize().x );
+    boost::hash_combine( seed, aPad->GetSize().y );
+    boost::hash_combine( seed, aPad->GetDelta().x );
+    boost::hash_combine( seed, aPad->GetDelta().y );
+    boost::hash_combine( seed, aPad->GetOffset().x );
+    boost::hash_combine( seed, aPad->GetOffset().y );
+    boost::hash_combine( seed, (int) aPad->GetShape() );
+    boost::hash_combine( seed, (int) aPad->GetAttribute() );
+    boost::hash_combine( seed, aPad->GetRoundRectRadiusRatio() );
+    boost::hash_combine( seed, aPad->GetLayerSet().to_string() );
+    boost::hash_combine( seed, aPad->GetNetCode() );
+    boost::hash_combine( seed, aPad->GetLocalClearance() );
+
+    if( aPad->GetParent() )
+        boost::hash_combine( seed, aPad->GetParent()->GetLocalClearance() );
+
+    return seed;
+}
+
+
+void PNS_KICAD_IFACE::addBoardItem( PNS::NODE* aWorld, BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+        for( D_PAD* pad = static_cast<MODULE*>( aItem )->PadsList(); pad; pad = pad->Next() )
+            addBoardItem( aWorld, pad );
+
+        break;
+
+    case PCB_PAD_T:
+    {
+        D_PAD* pad = static_cast<D_PAD*>( aItem );
+        std::unique_ptr< PNS::SOLID > solid = syncPad( pad );
+
+        if( m_ruleResolver )
+            m_ruleResolver->UpdatePad( pad );
+
+        if( solid )
+            aWorld->Add( std::move( solid ) );
+
+        break;
+    }
+
+    case PCB_TRACE_T:
+        aWorld->Add( syncTrack( static_cast<TRACK*>( aItem ) ) );
+        break;
+
+    case PCB_VIA_T:
+        aWorld->Add( syncVia( static_cast<VIA*>( aItem ) ) );
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE::removeBoardItem( PNS::NODE* aWorld, BOARD_ITEM* aItem,
+                                       BOARD_ITEM* aOldState )
+{
+    if( !aOldState )
+        aOldState = aItem;
+
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    {
+        // The copy of a modified module holds its pads in the same order
+        D_PAD* oldPad = static_cast<MODULE*>( aOldState )->PadsList();
+
+        for( D_PAD* pad = static_cast<MODULE*>( aItem )->PadsList(); pad; pad = pad->Next() )
+        {
+            removeBoardItem( aWorld, pad, oldPad ? oldPad : pad );
+
+            if( oldPad )
+                oldPad = oldPad->Next();
+        }
+
+        return;
+    }
+
+    case PCB_PAD_T:
+        m_padSignatures.erase( static_cast<D_PAD*>( aItem ) );
+
+        if( m_ruleResolver )
+            m_ruleResolver->RemovePad( static_cast<D_PAD*>( aItem ) );
+
+        break;
+
+    case PCB_TRACE_T:
+    case PCB_VIA_T:
+        break;
+
+    default:
+        return;
+    }
+
+    // Look the item up in the net it had when it was synced, a net holds only a few items
+    std::set<PNS::ITEM*> netItems;
+    aWorld->AllItemsInNet( static_cast<BOARD_CONNECTED_ITEM*>( aOldState )->GetNetCode(), netItems );
+
+    for( PNS::ITEM* item : netItems )
+    {
+        if( item->Parent() == aItem )
+            aWorld->Remove( item );
+    }
+}
+
+
+bool PNS_KICAD_IFACE::UpdateWorld( PNS::NODE* aWorld )
+{
+    if( !m_board || aWorld != m_world || !m_ruleResolver )
+        return false;
+
+    if( !m_worldOutdated )
+        return true;
+
+    // Design rules may have changed as well and rebuilding the resolver is cheap
+    // compared to the world itself.
+    delete m_ruleResolver;
+    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, m_router );
+    aWorld->SetRuleResolver( m_ruleResolver );
+    aWorld->SetMaxClearance( 4 * m_board->GetDesignSettings().GetBiggestClearanceValue() );
+
+    // Compare the stored items with the board instead of recreating all of them,
+    // parents are only used as keys as they may point to items deleted in the meantime.
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, PNS::ITEM*> worldItems;
+    PNS::NODE::ITEM_VECTOR items, outdated;
+    std::vector<BOARD_CONNECTED_ITEM*> missing;
+
+    aWorld->AllItems( items );
+    worldItems.reserve( items.size() );
+
+    for( PNS::ITEM* item : items )
+    {
+        if( !item->Parent() || !worldItems.emplace( item->Parent(), item ).second )
+            outdated.push_back( item );
+    }
+
+    auto checkItem = [&] ( BOARD_CONNECTED_ITEM* aParent )
+    {
+        auto it = worldItems.find( aParent );
+
+        if( it != worldItems.end() && isItemInSync( it->second, aParent ) )
+        {
+            worldItems.erase( it );
+            return;
+        }
+
+        missing.push_back( aParent );
+    };
+
+    for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    {
+        for( D_PAD* pad = module->PadsList(); pad; pad = pad->Next() )
+            checkItem( pad );
+    }
+
+    for( TRACK* t = m_board->m_Track; t; t = t->Next() )
+    {
+        if( t->Type() == PCB_TRACE_T || t->Type() == PCB_VIA_T )
+            checkItem( t );
+    }
+
+    // Whatever has not been matched belongs to items that were changed or removed
+    for( const auto& ent : worldItems )
+        outdated.push_back( ent.second );
+
+    for( PNS::ITEM* item : outdated )
+    {
+        if( item->Kind() == PNS::ITEM::SOLID_T )
+            m_padSignatures.erase( static_cast<const D_PAD*>( item->Parent() ) );
+
+        aWorld->Remove( item );
+    }
+
+    for( BOARD_CONNECTED_ITEM* parent : missing )
+        addBoardItem( aWorld, parent );
+
+    aWorld->ReleaseGarbage();
+
+    wxLogTrace( "PNS", "UpdateWorld: %d items removed, %d added",
+                (int) outdated.size(), (int) missing.size() );
+
+    m_worldOutdated = false;
+    m_syncedStamp = m_board->GetModificationStamp();
+    return true;
+}
+
+
+void PNS_KICAD_IFACE::OnBoardCommit( BOARD* aBoard, const BOARD_CHANGES& aChanges )
+{
+    if( aBoard != m_board || m_worldOutdated )
+        return;
+
+    // Changes pushed by the router itself are committed to the world by PNS::ROUTER
+    if( m_committing )
+    {
+        m_syncedStamp = aBoard->GetModificationStamp();
+        return;
+    }
+
+    if( !m_world || !m_ruleResolver || !m_router || m_router->GetWorld() != m_world
+            || m_router->RoutingInProgress() )
+    {
+        m_worldOutdated = true;
+        return;
+    }
+
+    // Items in nets created after the last sync require a new rule resolver
+    auto isNetKnown = [&] ( BOARD_ITEM* aItem )
+    {
+        if( aItem->Type() == PCB_MODULE_T )
+        {
+            for( D_PAD* pad = static_cast<MODULE*>( aItem )->PadsList(); pad; pad = pad->Next() )
+            {
+                if( !m_ruleResolver->HasNet( pad->GetNetCode() ) )
+                    return false;
+            }
+
+            return true;
+        }
+
+        return !aItem->IsConnected()
+               || m_ruleResolver->HasNet( static_cast<BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode() );
+    };
+
+    for( BOARD_ITEM* item : aChanges.m_removed )
+        removeBoardItem( m_world, item );
+
+    for( const auto& ent : aChanges.m_modified )
+    {
+        BOARD_ITEM* item = ent.first;
+
+        // Pads of a module keep their identity when the module is modified
+        removeBoardItem( m_world, item, ent.second );
+
+        if( !isNetKnown( item ) )
+        {
+            m_worldOutdated = true;
+            return;
+        }
+
+        addBoardItem( m_world, item );
+    }
+
+    for( BOARD_ITEM* item : aChanges.m_added )
+    {
+        if( !isNetKnown( item ) )
+        {
+            m_worldOutdated = true;
+            return;
+        }
+
+        addBoardItem( m_world, item );
+    }
+
+    m_world->ReleaseGarbage();
+    m_syncedStamp = aBoard->GetModificationStamp();
+}
+
+
+void PNS_KICAD_IFACE::OnBoardInvalidated( BOARD* aBoard )
+{
+    if( aBoard == m_board )
+        m_worldOutdated = true;
+}
+
+
+void PNS_KICAD_IFACE::CheckBoardModified()
+{
+    if( !m_board || m_board->GetModificationStamp() != m_syncedStamp )
+        m_worldOutdated = true;
 }
 
 
@@ -931,7 +1308,11 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 void PNS_KICAD_IFACE::Commit()
 {
     EraseView();
+
+    m_committing = true;
     m_commit->Push( wxT( "Added a track" ) );
+    m_committing = false;
+
     m_commit.reset( new BOARD_COMMIT( m_frame ) );
 }
 
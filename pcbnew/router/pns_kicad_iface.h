@@ -22,15 +22,17 @@
 #ifndef __PNS_KICAD_IFACE_H
 #define __PNS_KICAD_IFACE_H
 
+#include <unordered_map>
 #include <unordered_set>
 
+#include <board_commit.h>
+
 #include "pns_router.h"
 
 class PNS_PCBNEW_RULE_RESOLVER;
 class PNS_PCBNEW_DEBUG_DECORATOR;
 
 class BOARD;
-class BOARD_COMMIT;
 class DISPLAY_OPTIONS;
 
 namespace KIGFX
@@ -38,7 +40,7 @@ namespace KIGFX
     class VIEW;
 };
 
-class PNS_KICAD_IFACE : public PNS::ROUTER_IFACE {
+class PNS_KICAD_IFACE : public PNS::ROUTER_IFACE, public BOARD_COMMIT_LISTENER {
 public:
     PNS_KICAD_IFACE();
     ~PNS_KICAD_IFACE();
@@ -49,6 +51,14 @@ public:
     void SetBoard( BOARD* aBoard );
     void SetView( KIGFX::VIEW* aView );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
+
+    ///> Makes the next UpdateWorld() call compare the whole world against the board if the
+    ///> board was modified by other means than commits since the world was last synced.
+    void CheckBoardModified();
+
+    void OnBoardCommit( BOARD* aBoard, const BOARD_CHANGES& aChanges ) override;
+    void OnBoardInvalidated( BOARD* aBoard ) override;
     void EraseView() override;
     void HideItem( PNS::ITEM* aItem ) override;
     void DisplayItem( const PNS::ITEM* aItem, int aColor = 0, int aClearance = 0 ) override;
@@ -69,6 +79,11 @@ private:
     std::unique_ptr<PNS::SEGMENT> syncTrack( TRACK* aTrack );
     std::unique_ptr<PNS::VIA>     syncVia( VIA* aVia );
 
+    void addBoardItem( PNS::NODE* aWorld, BOARD_ITEM* aItem );
+    void removeBoardItem( PNS::NODE* aWorld, BOARD_ITEM* aItem, BOARD_ITEM* aOldState = nullptr );
+    bool isItemInSync( const PNS::ITEM* aItem, BOARD_CONNECTED_ITEM* aParent ) const;
+    size_t padSignature( const D_PAD* aPad ) const;
+
     KIGFX::VIEW* m_view;
     KIGFX::VIEW_GROUP* m_previewItems;
     std::unordered_set<BOARD_CONNECTED_ITEM*> m_hiddenItems;
@@ -79,6 +94,18 @@ private:
     PCB_EDIT_FRAME* m_frame;
     std::unique_ptr<BOARD_COMMIT> m_commit;
     DISPLAY_OPTIONS* m_dispOptions;
+
+    ///> Hashed pad parameters the solids in the world were created from
+    std::unordered_map<const D_PAD*, size_t> m_padSignatures;
+
+    ///> The world may not reflect the board and has to be checked before use
+    bool m_worldOutdated;
+
+    ///> Modification stamp of the board when the world was last synced with it
+    unsigned m_syncedStamp;
+
+    ///> The router is pushing its own changes, they are already present in the world
+    bool m_committing;
 };
 
 #endif
@@ -1231,6 +1231,15 @@ void NODE::KillChildren()
 }
 
 
+void NODE::AllItems( ITEM_VECTOR& aItems )
+{
+    aItems.reserve( aItems.size() + m_index->Size() );
+
+    for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
+        aItems.push_back( *i );
+}
+
+
 void NODE::AllItemsInNet( int aNet, std::set<ITEM*>& aItems )
 {
     INDEX::NET_ITEMS_LIST* l_cur = m_index->GetItemsForNet( aNet );
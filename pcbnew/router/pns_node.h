@@ -397,6 +397,15 @@ public:
     ///> Destroys all child nodes. Applicable only to the root node.
     void KillChildren();
 
+    ///> Frees the items removed from the root node. Applicable only to the root node.
+    void ReleaseGarbage()
+    {
+        releaseGarbage();
+    }
+
+    ///> Returns all items stored in this node (not including the ones inherited from the root).
+    void AllItems( ITEM_VECTOR& aItems );
+
     void AllItemsInNet( int aNet, std::set<ITEM*>& aItems );
 
     void ClearRanks( int aMarkerMask = MK_HEAD | MK_VIOLATION );
@@ -104,6 +104,16 @@ void ROUTER::SyncWorld()
 
 }
 
+
+void ROUTER::UpdateWorld()
+{
+    if( m_world && !RoutingInProgress() && m_iface->UpdateWorld( m_world.get() ) )
+        return;
+
+    SyncWorld();
+}
+
+
 void ROUTER::ClearWorld()
 {
     if( m_world )
@@ -84,6 +84,7 @@ enum ROUTER_MODE {
 
         virtual void SetRouter( ROUTER* aRouter ) = 0;
         virtual void SyncWorld( NODE* aNode ) = 0;
+        virtual bool UpdateWorld( NODE* aNode ) = 0;
         virtual void AddItem( ITEM* aItem ) = 0;
         virtual void RemoveItem( ITEM* aItem ) = 0;
         virtual void DisplayItem( const ITEM* aItem, int aColor = -1, int aClearance = -1 ) = 0;
@@ -121,6 +122,14 @@ public:
     void ClearWorld();
     void SyncWorld();
 
+    /**
+     * Function UpdateWorld()
+     * brings the existing world in sync with the board, applying only the differences.
+     * Falls back to a full SyncWorld() if there is no world yet or the interface cannot
+     * update it incrementally.
+     */
+    void UpdateWorld();
+
     void SetView( KIGFX::VIEW* aView );
 
     bool RoutingInProgress() const;
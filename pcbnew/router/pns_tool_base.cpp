@@ -99,6 +99,28 @@ TOOL_BASE::~TOOL_BASE()
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
     delete m_gridHelper;
+
+    m_startItem = nullptr;
+    m_endItem = nullptr;
+
+    // The router world is kept up to date by commit notifications, so when the tool
+    // is just started again for the same board only the differences have to be synced.
+    if( aReason == RUN && m_router && m_board == getModel<BOARD>() )
+    {
+        m_frame = getEditFrame<PCB_EDIT_FRAME>();
+        m_ctls = getViewControls();
+
+        // Catch up with the changes made outside of commits while the tool was inactive,
+        // if any: otherwise the world is already up to date and is not checked at all
+        m_iface->CheckBoardModified();
+        m_router->UpdateWorld();
+        m_router->LoadSettings( m_savedSettings );
+        m_router->UpdateSizes( m_savedSizes );
+
+        m_gridHelper = new GRID_HELPER( m_frame );
+        return;
+    }
+
     delete m_iface;
     delete m_router;
 
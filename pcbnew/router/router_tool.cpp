@@ -870,10 +870,16 @@ int ROUTER_TOOL::mainLoop( PNS::ROUTER_MODE aMode )
         {
             m_router->ClearWorld();
         }
-        else if( evt->Action() == TA_UNDO_REDO_POST || evt->Action() == TA_MODEL_CHANGE )
+        else if( evt->Action() == TA_UNDO_REDO_POST )
         {
             m_router->SyncWorld();
         }
+        else if( evt->Action() == TA_MODEL_CHANGE )
+        {
+            // Committed changes have been applied to the world already, unless
+            // they could not be applied incrementally
+            m_router->UpdateWorld();
+        }
         else if( evt->IsMotion() )
         {
             updateStartItem( *evt );
@@ -993,7 +999,7 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     Activate();
 
     m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
-    m_router->SyncWorld();
+    m_router->UpdateWorld();
     m_startItem = m_router->GetWorld()->FindItemByParent( item );
 
     if( m_startItem && m_startItem->IsLocked() )
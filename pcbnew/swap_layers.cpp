@@ -35,6 +35,9 @@
 #include <class_board.h>
 #include <class_track.h>
 #include <class_drawsegment.h>
+#include <ratsnest_data.h>
+#include <board_commit.h>
+#include <layer_remap.h>
 
 #include <pcbnew.h>
 
@@ -368,63 +371,59 @@ void PCB_EDIT_FRAME::Swap_Layers( wxCommandEvent& event )
     if( dlg.ShowModal() != 1 )
         return;     // (Canceled dialog box returns -1 instead)
 
-    // Change traces.
-    for( TRACK* segm = GetBoard()->m_Track;  segm;  segm = segm->Next() )
-    {
-        OnModify();
+    LAYER_REMAP remap;
 
-        if( segm->Type() == PCB_VIA_T )
-        {
-            VIA* via = (VIA*) segm;
+    for( unsigned i = 0; i < DIM( new_layer );  ++i )
+    {
+        if( new_layer[i] != NO_CHANGE )
+            remap.Set( ToLAYER_ID( i ), new_layer[i] );
+    }
 
-            if( via->GetViaType() == VIA_THROUGH )
-                continue;
+    RemapLayers( remap );
+}
 
-            PCB_LAYER_ID top_layer, bottom_layer;
 
-            via->LayerPair( &top_layer, &bottom_layer );
+void PCB_EDIT_FRAME::RemapLayers( const LAYER_REMAP& aRemap )
+{
+    if( aRemap.IsIdentity() )
+        return;
 
-            if( new_layer[bottom_layer] != NO_CHANGE )
-                bottom_layer = new_layer[bottom_layer];
+    // The undo entry is the table: only the items it cannot restore are saved by copy
+    PICKED_ITEMS_LIST* undoCmd = new PICKED_ITEMS_LIST();
 
-            if( new_layer[top_layer] != NO_CHANGE )
-                top_layer = new_layer[top_layer];
+    undoCmd->m_Status = UR_LAYER_REMAPPED;
+    undoCmd->m_LayerMap = aRemap.GetTable();
 
-            via->SetLayerPair( top_layer, bottom_layer );
-        }
-        else
+    for( BOARD_ITEM* item : LAYER_REMAP::GetItems( GetBoard() ) )
+    {
+        if( aRemap.IsAmbiguous( item ) )
         {
-            int jj = segm->GetLayer();
-
-            if( new_layer[jj] != NO_CHANGE )
-                segm->SetLayer( new_layer[jj] );
+            ITEM_PICKER picker( item, UR_CHANGED );
+            picker.SetLink( item->Clone() );
+            undoCmd->PushItem( picker );
         }
     }
 
-    // Change zones.
-    for( TRACK* segm = GetBoard()->m_Zone;  segm;  segm = segm->Next() )
+    if( applyLayerRemap( aRemap ) == 0 )
     {
-        OnModify();
-        int jj = segm->GetLayer();
-
-        if( new_layer[jj] != NO_CHANGE )
-            segm->SetLayer( new_layer[jj] );
+        undoCmd->ClearListAndDeleteItems();
+        delete undoCmd;
+        return;
     }
 
-    // Change other segments.
-    for( EDA_ITEM* item = GetBoard()->m_Drawings; item; item = item->Next() )
-    {
-        if( item->Type() == PCB_LINE_T )
-        {
-            OnModify();
+    GetScreen()->PushCommandToUndoList( undoCmd );
+    GetScreen()->ClearUndoORRedoList( GetScreen()->m_RedoList );
 
-            DRAWSEGMENT* drawsegm = (DRAWSEGMENT*) item;
-            int jj = drawsegm->GetLayer();
+    if( IsGalCanvasActive() )
+        GetBoard()->GetRatsnest()->Recalculate();
 
-            if( new_layer[jj] != NO_CHANGE )
-                drawsegm->SetLayer( new_layer[jj] );
-        }
-    }
+    // The board changed without a commit
+    BOARD_COMMIT::InvalidateListeners( GetBoard() );
+
+    OnModify();
 
-    m_canvas->Refresh( true );
+    if( IsGalCanvasActive() )
+        GetGalCanvas()->Refresh();
+    else
+        m_canvas->Refresh( true );
 }
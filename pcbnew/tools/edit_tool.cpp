@@ -68,10 +68,6 @@ using namespace std::placeholders;
 
 #include <board_commit.h>
 
-#ifdef PCBNEW_WITH_TRACKITEMS
-#include <trackitems/trackitems.h>
-#endif
-
 // Edit tool actions
 TOOL_ACTION PCB_ACTIONS::editFootprintInFpEditor( "pcbnew.InteractiveEdit.editFootprintInFpEditor",
         AS_GLOBAL, TOOL_ACTION::LegacyHotKey( HK_EDIT_MODULE_WITH_MODEDIT ),
@@ -174,7 +170,12 @@ void EDIT_TOOL::Reset( RESET_REASON aReason )
     m_dragging = false;
 
     if( aReason != RUN )
+    {
         m_commit.reset( new BOARD_COMMIT( this ) );
+
+        // The cached anchors refer to the items of the previous board or view
+        m_gridHelper.reset();
+    }
 }
 
 
@@ -278,7 +279,29 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
     // cumulative translation
     wxPoint totalMovement( 0, 0 );
 
-    GRID_HELPER grid( editFrame );
+    // translation not applied to the items yet: while dragging, only the selection is drawn
+    // with an offset, so the items are moved and recached once instead of at every step
+    wxPoint pendingMovement( 0, 0 );
+
+    auto applyPendingMovement = [&]()
+    {
+        if( pendingMovement == wxPoint( 0, 0 ) )
+            return;
+
+        for( auto item : selection )
+            static_cast<BOARD_ITEM*>( item )->Move( pendingMovement );
+
+        pendingMovement = wxPoint( 0, 0 );
+        selection.SetOffset( VECTOR2I( 0, 0 ) );
+        getView()->Update( &selection );
+    };
+
+    if( !m_gridHelper )
+        m_gridHelper.reset( new GRID_HELPER( editFrame ) );
+
+    GRID_HELPER& grid = *m_gridHelper;
+    grid.SetAuxAxes( false );     // set again once the drag origin is known
+
     OPT_TOOL_EVENT evt = aEvent;
 
     // Main loop: keep receiving events
@@ -297,27 +320,15 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
                 m_cursor = grid.BestSnapAnchor( evt->Position(), curr_item );
                 controls->ForceCursorPosition( true, m_cursor );
 
-                wxPoint movement = wxPoint( m_cursor.x, m_cursor.y ) - curr_item->GetPosition();
+                // The first item is drawn at its position shifted by the pending movement
+                wxPoint movement = wxPoint( m_cursor.x, m_cursor.y ) - curr_item->GetPosition()
+                                   - pendingMovement;
                 totalMovement += movement;
 
-                // Drag items to the current cursor position
-#ifdef PCBNEW_WITH_TRACKITEMS
-                editFrame->GetBoard()->TrackItems()->Teardrops()->UpdateListClear();
-                editFrame->GetBoard()->TrackItems()->RoundedTracksCorners()->UpdateListClear();
-                for( auto item : selection )
-                {
-                    editFrame->GetBoard()->TrackItems()->Teardrops()->UpdateListAdd( static_cast<BOARD_ITEM*>( item ) );
-                    editFrame->GetBoard()->TrackItems()->RoundedTracksCorners()->UpdateListAdd( static_cast<BOARD_ITEM*>( item ) );
-                    static_cast<BOARD_ITEM*>( item )->Move( movement + m_offset );
-                }
-                editFrame->GetBoard()->TrackItems()->RoundedTracksCorners()->UpdateListDo();
-                editFrame->GetBoard()->TrackItems()->Teardrops()->UpdateListDo();
-#else
-                for( auto item : selection )
-                {
-                    static_cast<BOARD_ITEM*>( item )->Move( movement + m_offset );
-                }
-#endif
+                // Drag the selection preview to the current cursor position. The items (and
+                // the track items attached to them) are updated by the commit on drop.
+                pendingMovement += movement + m_offset;
+                selection.SetOffset( VECTOR2I( pendingMovement ) );
             }
             else if( !m_dragging )    // Prepare to start dragging
             {
@@ -384,6 +395,9 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
         // Dispatch TOOL_ACTIONs
         else if( evt->Category() == TC_COMMAND )
         {
+            // Commands (rotate, flip, move exact...) work on the actual item positions
+            applyPendingMovement();
+
             wxPoint modPoint = getModificationPoint( selection );
 
             if( evt->IsAction( &PCB_ACTIONS::remove ) )
@@ -448,6 +462,20 @@ int EDIT_TOOL::Main( const TOOL_EVENT& aEvent )
     m_offset.x = 0;
     m_offset.y = 0;
 
+    // Items are restored from the commit anyway, there is no point in moving them
+    if( restore )
+    {
+        pendingMovement = wxPoint( 0, 0 );
+        selection.SetOffset( VECTOR2I( 0, 0 ) );
+    }
+    else
+    {
+        applyPendingMovement();
+    }
+
+    // The simple ratsnest of the selection is no longer drawn translated
+    getModel<BOARD>()->GetRatsnest()->SetSimpleOffset( VECTOR2I( 0, 0 ) );
+
     if( unselect || restore )
         m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
 
@@ -31,6 +31,7 @@
 
 class BOARD_COMMIT;
 class BOARD_ITEM;
+class GRID_HELPER;
 class SELECTION_TOOL;
 
 /**
@@ -199,6 +200,9 @@ private:
     }
 
     std::unique_ptr<BOARD_COMMIT> m_commit;
+
+    ///> Kept between the moves, so the snap anchors of the board items are cached
+    std::unique_ptr<GRID_HELPER> m_gridHelper;
 };
 
 #endif
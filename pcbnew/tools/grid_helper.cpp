@@ -23,6 +23,7 @@
  */
 
 #include <functional>
+#include <unordered_set>
 using namespace std::placeholders;
 
 #include <wxPcbStruct.h>
@@ -45,11 +46,75 @@ GRID_HELPER::GRID_HELPER( PCB_BASE_FRAME* aFrame ) :
     m_frame( aFrame )
 {
     m_diagonalAuxAxesEnable = true;
+
+    BOARD_COMMIT::AddListener( this );
 }
 
 
 GRID_HELPER::~GRID_HELPER()
 {
+    BOARD_COMMIT::RemoveListener( this );
+}
+
+
+void GRID_HELPER::OnBoardCommit( BOARD* aBoard, const BOARD_CHANGES& aChanges )
+{
+    if( m_anchorCache.empty() )
+        return;
+
+    // The view revisions catch the geometry changes, but removed items may be freed and
+    // their addresses reused, and the footprint anchors include the pads
+    if( !aChanges.m_removed.empty() )
+        dropRemovedAnchors( aChanges.m_removed );
+
+    for( const auto& modified : aChanges.m_modified )
+        invalidateAnchors( modified.first );
+}
+
+
+void GRID_HELPER::OnBoardInvalidated( BOARD* aBoard )
+{
+    m_anchorCache.clear();
+}
+
+
+void GRID_HELPER::invalidateAnchors( BOARD_ITEM* aItem )
+{
+    m_anchorCache.erase( aItem );
+
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        static_cast<MODULE*>( aItem )->RunOnChildren( [&] ( BOARD_ITEM* aChild )
+        {
+            m_anchorCache.erase( aChild );
+        } );
+    }
+    else if( aItem->Type() == PCB_PAD_T && aItem->GetParent() )
+    {
+        m_anchorCache.erase( static_cast<BOARD_ITEM*>( aItem->GetParent() ) );
+    }
+}
+
+
+void GRID_HELPER::dropRemovedAnchors( const std::vector<BOARD_ITEM*>& aRemoved )
+{
+    std::unordered_set<BOARD_ITEM*> removed( aRemoved.begin(), aRemoved.end() );
+
+    // Only the cached data is looked at: an entry goes if its item, its footprint or an item
+    // providing one of its anchors (e.g. a pad of a cached footprint) was removed
+    for( auto it = m_anchorCache.begin(); it != m_anchorCache.end(); )
+    {
+        const ITEM_ANCHORS& cached = it->second;
+        bool drop = removed.count( it->first ) || removed.count( cached.parent );
+
+        for( unsigned i = 0; !drop && i < cached.anchors.size(); ++i )
+            drop = removed.count( cached.anchors[i].item ) > 0;
+
+        if( drop )
+            it = m_anchorCache.erase( it );
+        else
+            ++it;
+    }
 }
 
 
@@ -220,28 +285,76 @@ VECTOR2I GRID_HELPER::BestSnapAnchor( const VECTOR2I& aOrigin, BOARD_ITEM* aDrag
 
     BOX2I bb( VECTOR2I( aOrigin.x - snapRange / 2, aOrigin.y - snapRange / 2 ), VECTOR2I( snapRange, snapRange ) );
 
-    clearAnchors();
+    LSET layers( aDraggedItem->GetLayer() );
+    const ANCHOR* nearest = NULL;
+    double minDist = std::numeric_limits<double>::max();
 
     for( BOARD_ITEM* item : queryVisible( bb ) )
     {
-        computeAnchors( item, aOrigin );
-    }
+        for( const ANCHOR& a : snapAnchors( item ) )
+        {
+            if( !layers[a.item->GetLayer()] )
+                continue;
 
-    LSET layers( aDraggedItem->GetLayer() );
-    ANCHOR* nearest = nearestAnchor( aOrigin, CORNER | SNAPPABLE, layers );
+            double dist = a.Distance( aOrigin );
+
+            if( dist < minDist )
+            {
+                minDist = dist;
+                nearest = &a;
+            }
+        }
+    }
 
     VECTOR2I nearestGrid = Align( aOrigin );
     double gridDist = ( nearestGrid - aOrigin ).EuclideanNorm();
 
-    if( nearest )
+    if( nearest && minDist < gridDist )
+        return nearest->pos;
+
+    return nearestGrid;
+}
+
+
+const std::vector<GRID_HELPER::ANCHOR>& GRID_HELPER::snapAnchors( BOARD_ITEM* aItem )
+{
+    unsigned int revision = m_frame->GetGalCanvas()->GetView()->GetGeometryRevision( aItem );
+    ITEM_ANCHORS& cached = m_anchorCache[aItem];
+
+    // Revision 0 means the item is not in the view, there is nothing to compare with
+    if( revision == 0 || cached.revision != revision )
     {
-        double snapDist = nearest->Distance( aOrigin );
+        clearAnchors();
 
-        if( nearest && snapDist < gridDist )
-            return nearest->pos;
+        // Only the outline anchors depend on the reference point, they are not snapped to
+        computeAnchors( aItem, VECTOR2I( aItem->GetPosition() ) );
+
+        cached.revision = revision;
+        cached.anchors.clear();
+
+        switch( aItem->Type() )
+        {
+        case PCB_PAD_T:
+        case PCB_MODULE_EDGE_T:
+        case PCB_MODULE_TEXT_T:
+            cached.parent = static_cast<BOARD_ITEM*>( aItem->GetParent() );
+            break;
+
+        default:
+            cached.parent = NULL;
+            break;
+        }
+
+        for( const ANCHOR& a : m_anchors )
+        {
+            if( ( a.flags & ( CORNER | SNAPPABLE ) ) == ( CORNER | SNAPPABLE ) )
+                cached.anchors.push_back( a );
+        }
+
+        clearAnchors();
     }
 
-    return nearestGrid;
+    return cached.anchors;
 }
 
 
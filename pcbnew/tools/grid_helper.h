@@ -25,6 +25,8 @@
 #ifndef __GRID_HELPER_H
 #define __GRID_HELPER_H
 
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <math/vector2d.h>
@@ -34,14 +36,20 @@
 
 #include <geometry/seg.h>
 
+#include <board_commit.h>
+
 class PCB_BASE_FRAME;
 
-class GRID_HELPER {
+class GRID_HELPER : public BOARD_COMMIT_LISTENER {
 public:
 
     GRID_HELPER( PCB_BASE_FRAME* aFrame );
     ~GRID_HELPER();
 
+    ///> Drops the cached snap anchors of the changed items.
+    void OnBoardCommit( BOARD* aBoard, const BOARD_CHANGES& aChanges ) override;
+    void OnBoardInvalidated( BOARD* aBoard ) override;
+
     void SetGrid( int aSize );
     void SetOrigin( const VECTOR2I& aOrigin );
 
@@ -82,8 +90,23 @@ private:
         //bool CanSnapItem( const BOARD_ITEM* aItem ) const;
     };
 
+    ///> Snap anchors of an item, valid as long as the item geometry revision in the view
+    ///> does not change.
+    struct ITEM_ANCHORS
+    {
+        ITEM_ANCHORS() : revision( 0 ), parent( NULL ) {}
+
+        unsigned int revision;
+        BOARD_ITEM* parent;         ///< footprint owning the item, if any
+        std::vector<ANCHOR> anchors;
+    };
+
     std::vector<ANCHOR> m_anchors;
 
+    ///> Snap anchors of the items met by BestSnapAnchor(), so they are not generated again
+    ///> on every mouse motion.
+    std::unordered_map<BOARD_ITEM*, ITEM_ANCHORS> m_anchorCache;
+
     std::set<BOARD_ITEM*> queryVisible( const BOX2I& aArea ) const;
 
     void addAnchor( const VECTOR2I& aPos, int aFlags = CORNER | SNAPPABLE, BOARD_ITEM* aItem = NULL )
@@ -95,6 +118,15 @@ private:
 
     void computeAnchors( BOARD_ITEM* aItem, const VECTOR2I& aRefPos );
 
+    ///> Returns the anchors of an item which can be snapped to, from the cache if possible.
+    const std::vector<ANCHOR>& snapAnchors( BOARD_ITEM* aItem );
+
+    ///> Removes an item and the items sharing its anchors from the cache.
+    void invalidateAnchors( BOARD_ITEM* aItem );
+
+    ///> Removes the deleted items from the cache, without dereferencing them (they may be freed).
+    void dropRemovedAnchors( const std::vector<BOARD_ITEM*>& aRemoved );
+
     void clearAnchors()
     {
         m_anchors.clear();
@@ -1089,12 +1089,20 @@ int PCB_EDITOR_CONTROL::UpdateSelectionRatsnest( const TOOL_EVENT& aEvent )
     // Update "simple" ratsnest, computed for currently modified items
     ratsnest->ClearSimple();
 
+    // A dragged selection is only drawn with an offset, its items are moved on drop: their
+    // ratsnest data is still valid, the simple ratsnest is drawn translated instead.
+    const VECTOR2I& offset = selection.GetOffset();
+
     for( auto item : selection )
     {
-        ratsnest->Update( static_cast<BOARD_ITEM*>( item ) );
+        if( offset == VECTOR2I( 0, 0 ) )
+            ratsnest->Update( static_cast<BOARD_ITEM*>( item ) );
+
         ratsnest->AddSimple( static_cast<BOARD_ITEM*>( item ) );
     }
 
+    ratsnest->SetSimpleOffset( offset );
+
     return 0;
 }
 
@@ -34,6 +34,7 @@ using namespace std::placeholders;
 #include "pcb_actions.h"
 #include "selection_tool.h"
 #include "point_editor.h"
+#include "zone_fill_preview.h"
 #include <board_commit.h>
 #include <bitmaps.h>
 
@@ -210,8 +211,14 @@ POINT_EDITOR::POINT_EDITOR() :
 }
 
 
+POINT_EDITOR::~POINT_EDITOR()
+{
+}
+
+
 void POINT_EDITOR::Reset( RESET_REASON aReason )
 {
+    m_fillPreview.reset();
     m_editPoints.reset();
     m_altConstraint.reset();
 }
@@ -279,6 +286,13 @@ int POINT_EDITOR::OnSelectionChange( const TOOL_EVENT& aEvent )
     bool modified = false;
     bool revert = false;
 
+    // Filled zones are refilled in the background while their outline is edited
+    if( item->Type() == PCB_ZONE_AREA_T && static_cast<ZONE_CONTAINER*>( item )->IsFilled() )
+    {
+        m_fillPreview.reset( new ZONE_FILL_PREVIEW( editFrame,
+                                                    static_cast<ZONE_CONTAINER*>( item ) ) );
+    }
+
     BOARD_COMMIT commit( editFrame );
 
     // Main loop: keep receiving events
@@ -287,6 +301,14 @@ int POINT_EDITOR::OnSelectionChange( const TOOL_EVENT& aEvent )
         if( revert )
             break;
 
+        // The background fill reads the board, so it has to be stopped before commands
+        // (possibly modifying the board) are handled
+        if( m_fillPreview && ( evt->Category() == TC_COMMAND
+                               || evt->Action() == TA_UNDO_REDO_PRE ) )
+        {
+            m_fillPreview->Cancel();
+        }
+
         if( !m_editPoints ||
             evt->Matches( m_selectionTool->ClearedEvent ) ||
             evt->Matches( m_selectionTool->UnselectedEvent ) ||
@@ -363,13 +385,22 @@ int POINT_EDITOR::OnSelectionChange( const TOOL_EVENT& aEvent )
         view->Remove( m_editPoints.get() );
 
         if( modified && revert )
+        {
+            if( m_fillPreview )
+                m_fillPreview->Cancel();
+
             commit.Revert();
+        }
         else
+        {
             finishItem();
+        }
 
         m_editPoints.reset();
     }
 
+    m_fillPreview.reset();
+
     return 0;
 }
 
@@ -469,9 +500,14 @@ void POINT_EDITOR::updateItem() const
     case PCB_ZONE_AREA_T:
     {
         ZONE_CONTAINER* zone = static_cast<ZONE_CONTAINER*>( item );
-        zone->ClearFilledPolysList();
         SHAPE_POLY_SET* outline = zone->Outline();
 
+        // The fill is kept until the background refill replaces it
+        if( m_fillPreview )
+            m_fillPreview->Request();
+        else
+            zone->ClearFilledPolysList();
+
         for( int i = 0; i < outline->TotalVertices(); ++i )
         {
             VECTOR2I point = m_editPoints->Point( i ).GetPosition();
@@ -550,7 +586,20 @@ void POINT_EDITOR::finishItem() const
 
         if( zone->IsFilled() )
         {
-            getEditFrame<PCB_EDIT_FRAME>()->Fill_Zone( zone );
+            PCB_EDIT_FRAME* frame = getEditFrame<PCB_EDIT_FRAME>();
+
+            // Refill only if the background fill did not catch up with the last edit; the
+            // board is then modified as if Fill_Zone() had been called
+            if( m_fillPreview && m_fillPreview->Finish() )
+            {
+                zone->GetBoard()->GetRatsnest()->Update( zone );
+                frame->OnModify();
+            }
+            else
+            {
+                frame->Fill_Zone( zone );
+            }
+
             zone->GetBoard()->GetRatsnest()->Recalculate( zone->GetNetCode() );
         }
     }
@@ -32,6 +32,7 @@
 
 
 class SELECTION_TOOL;
+class ZONE_FILL_PREVIEW;
 
 /**
  * Class POINT_EDITOR
@@ -42,6 +43,7 @@ class POINT_EDITOR : public TOOL_INTERACTIVE
 {
 public:
     POINT_EDITOR();
+    ~POINT_EDITOR();
 
     /// @copydoc TOOL_INTERACTIVE::Reset()
     void Reset( RESET_REASON aReason ) override;
@@ -78,6 +80,9 @@ private:
     // EDIT_POINT for alternative constraint mode
     EDIT_POINT m_altConstrainer;
 
+    ///> Background refill of the edited zone, if it is filled.
+    std::unique_ptr<ZONE_FILL_PREVIEW> m_fillPreview;
+
     ///> Updates item's points with edit points.
     void updateItem() const;
 
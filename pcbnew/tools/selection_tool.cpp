@@ -24,6 +24,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 #include <limits>
+#include <unordered_set>
 
 #include <functional>
 using namespace std::placeholders;
@@ -518,11 +519,24 @@ bool SELECTION_TOOL::selectMultiple()
             // Mark items within the selection box as selected
             std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> selectedItems;
 
+            // In high contrast mode only the items on the active layers are selectable,
+            // so the other layers do not need to be searched
+            std::function<bool( int )> layerFilter;
+            KIGFX::RENDER_SETTINGS* settings = view->GetPainter()->GetSettings();
+
+            if( settings->GetHighContrast() )
+            {
+                const std::set<unsigned int>& activeLayers = settings->GetActiveLayers();
+
+                layerFilter = [&activeLayers]( int aLayer )
+                {
+                    return activeLayers.count( aLayer ) > 0;
+                };
+            }
+
             // Filter the view items based on the selection box
             BOX2I selectionBox = area.ViewBBox();
-            view->Query( selectionBox, selectedItems );         // Get the list of selected items
-
-            std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR>::iterator it, it_end;
+            view->Query( selectionBox, selectedItems, layerFilter );   // Get the list of selected items
 
             int width = area.GetEnd().x - area.GetOrigin().x;
             int height = area.GetEnd().y - area.GetOrigin().y;
@@ -533,38 +547,44 @@ bool SELECTION_TOOL::selectMultiple()
 
             selectionRect.Normalize();
 
-            for( it = selectedItems.begin(), it_end = selectedItems.end(); it != it_end; ++it )
+            // Items are reported once for each of their layers, test each item only once
+            std::unordered_set<KIGFX::VIEW_ITEM*> tested;
+            tested.reserve( selectedItems.size() );
+
+            for( const KIGFX::VIEW::LAYER_ITEM_PAIR& candidate : selectedItems )
             {
-                BOARD_ITEM* item = static_cast<BOARD_ITEM*>( it->first );
+                BOARD_ITEM* item = static_cast<BOARD_ITEM*>( candidate.first );
 
-                if( !item || !selectable( item ) )
+                if( !item || !tested.insert( item ).second || !selectable( item ) )
                     continue;
 
                 /* Selection mode depends on direction of drag-selection:
                  * Left > Right : Select objects that are fully enclosed by selection
                  * Right > Left : Select objects that are crossed by selection
                  */
+                bool inside;
 
                 if( width >= 0 )
                 {
-                    if( selectionBox.Contains( item->ViewBBox() ) )
-                    {
-                        if( m_subtractive )
-                            unselect( item );
-                        else
-                            select( item );
-                    }
+                    inside = selectionBox.Contains( item->ViewBBox() );
                 }
                 else
                 {
-                    if( item->HitTest( selectionRect, false ) )
-                    {
-                        if( m_subtractive )
-                            unselect( item );
-                        else
-                            select( item );
-                    }
+                    // Tracks and vias are within their view bounding box: if the box is
+                    // enclosed, the item is crossed and the exact test can be skipped
+                    KICAD_T type = item->Type();
+
+                    inside = ( ( type == PCB_TRACE_T || type == PCB_VIA_T )
+                               && selectionBox.Contains( item->ViewBBox() ) )
+                             || item->HitTest( selectionRect, false );
+                }
 
+                if( inside )
+                {
+                    if( m_subtractive )
+                        unselect( item );
+                    else
+                        select( item );
                 }
             }
 
@@ -1595,57 +1615,34 @@ static EDA_RECT getRect( const BOARD_ITEM* aItem )
 }
 
 
-static double calcArea( const BOARD_ITEM* aItem )
-{
-    if( aItem->Type() == PCB_TRACE_T )
-    {
-        const TRACK* t = static_cast<const TRACK*>( aItem );
-        return ( t->GetWidth() + t->GetLength() ) * t->GetWidth();
-    }
-
-    return getRect( aItem ).GetArea();
-}
-
-
-static double calcMinArea( GENERAL_COLLECTOR& aCollector, KICAD_T aType )
+/// An item considered by guessSelectionCandidates(), with its geometry computed once
+struct SELECTION_CANDIDATE
 {
-    double best = std::numeric_limits<double>::max();
-
-    if( !aCollector.GetCount() )
-        return 0.0;
-
-    for( int i = 0; i < aCollector.GetCount(); i++ )
-    {
-        BOARD_ITEM* item = aCollector[i];
-        if( item->Type() == aType )
-            best = std::min( best, calcArea( item ) );
-    }
-
-    return best;
-}
+    BOARD_ITEM* item;
+    EDA_RECT    rect;
+    double      area;
+};
 
 
-static double calcMaxArea( GENERAL_COLLECTOR& aCollector, KICAD_T aType )
+static double calcArea( const BOARD_ITEM* aItem, const EDA_RECT& aRect )
 {
-    double best = 0.0;
-
-    for( int i = 0; i < aCollector.GetCount(); i++ )
+    if( aItem->Type() == PCB_TRACE_T )
     {
-        BOARD_ITEM* item = aCollector[i];
-        if( item->Type() == aType )
-            best = std::max( best, calcArea( item ) );
+        const TRACK* t = static_cast<const TRACK*>( aItem );
+        return ( t->GetWidth() + t->GetLength() ) * t->GetWidth();
     }
 
-    return best;
+    return aRect.GetArea();
 }
 
 
-static inline double calcCommonArea( const BOARD_ITEM* aItem, const BOARD_ITEM* aOther )
+static inline double calcCommonArea( const SELECTION_CANDIDATE* aItem,
+                                     const SELECTION_CANDIDATE* aOther )
 {
     if( !aItem || !aOther )
         return 0;
 
-    return getRect( aItem ).Common( getRect( aOther ) ).GetArea();
+    return aItem->rect.Common( aOther->rect ).GetArea();
 }
 
 
@@ -1708,116 +1705,188 @@ void SELECTION_TOOL::guessSelectionCandidates( GENERAL_COLLECTOR& aCollector ) c
         }
     }
 
-    if( aCollector.CountType( PCB_MODULE_TEXT_T ) > 0 )
+    // The geometry of every item is computed once.  The rules comparing pairs of items only
+    // scan the items sorted by area until the area ratio rules them out, and the rules which
+    // depend only on the smallest via are evaluated against it, so the number of candidates
+    // (many items may be stacked under the cursor) does not make them quadratic.
+    std::vector<SELECTION_CANDIDATE> candidates;
+    candidates.reserve( aCollector.GetCount() );
+
+    for( int i = 0; i < aCollector.GetCount(); ++i )
     {
-        for( int i = 0; i < aCollector.GetCount(); ++i )
+        BOARD_ITEM* item = aCollector[i];
+        EDA_RECT rect = getRect( item );
+
+        candidates.push_back( { item, rect, calcArea( item, rect ) } );
+    }
+
+    std::vector<const SELECTION_CANDIDATE*> texts;
+    std::vector<const SELECTION_CANDIDATE*> features;     // items which can hide a text
+    std::vector<const SELECTION_CANDIDATE*> modules;
+    std::vector<const SELECTION_CANDIDATE*> vias;
+
+    for( const SELECTION_CANDIDATE& candidate : candidates )
+    {
+        switch( candidate.item->Type() )
         {
-            if( TEXTE_MODULE* txt = dyn_cast<TEXTE_MODULE*>( aCollector[i] ) )
+        case PCB_MODULE_TEXT_T:
+            texts.push_back( &candidate );
+            break;
+
+        case PCB_MODULE_T:
+            modules.push_back( &candidate );
+            features.push_back( &candidate );
+            break;
+
+        case PCB_VIA_T:
+            vias.push_back( &candidate );
+            features.push_back( &candidate );
+            break;
+
+        case PCB_TRACE_T:
+        case PCB_PAD_T:
+        case PCB_LINE_T:
+            features.push_back( &candidate );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    auto byArea = []( const SELECTION_CANDIDATE* aFirst, const SELECTION_CANDIDATE* aSecond )
+    {
+        return aFirst->area < aSecond->area;
+    };
+
+    if( !texts.empty() )
+    {
+        std::sort( texts.begin(), texts.end(), byArea );
+        std::sort( features.begin(), features.end(), byArea );
+
+        for( const SELECTION_CANDIDATE* txt : texts )
+        {
+            // The text to feature area ratio decreases as the features get larger
+            for( const SELECTION_CANDIDATE* feature : features )
             {
-                double textArea = calcArea( txt );
+                if( calcRatio( txt->area, feature->area ) <= textToFeatureMinRatio )
+                    break;
 
-                for( int j = 0; j < aCollector.GetCount(); ++j )
+                double txtCommonRatio = calcRatio( calcCommonArea( txt, feature ), txt->area );
+
+                if( txtCommonRatio < commonAreaRatio )
                 {
-                    if( i == j )
-                        continue;
-
-                    BOARD_ITEM* item = aCollector[j];
-                    double itemArea = calcArea( item );
-                    double areaRatio = calcRatio( textArea, itemArea );
-                    double commonArea = calcCommonArea( txt, item );
-                    double itemCommonRatio = calcRatio( commonArea, itemArea );
-                    double txtCommonRatio = calcRatio( commonArea, textArea );
-
-                    if( item->Type() == PCB_MODULE_T && areaRatio < textToFootprintMinRatio &&
-                            itemCommonRatio < commonAreaRatio )
-                        rejected.insert( item );
-
-                    switch( item->Type() )
-                    {
-                        case PCB_TRACE_T:
-                        case PCB_PAD_T:
-                        case PCB_LINE_T:
-                        case PCB_VIA_T:
-                        case PCB_MODULE_T:
-                            if( areaRatio > textToFeatureMinRatio && txtCommonRatio < commonAreaRatio )
-                                rejected.insert( txt );
-                            break;
-                        default:
-                            break;
-                    }
+                    rejected.insert( txt->item );
+                    break;
+                }
+            }
+        }
+
+        for( const SELECTION_CANDIDATE* mod : modules )
+        {
+            // The text to footprint area ratio increases as the texts get larger
+            for( const SELECTION_CANDIDATE* txt : texts )
+            {
+                if( calcRatio( txt->area, mod->area ) >= textToFootprintMinRatio )
+                    break;
+
+                double itemCommonRatio = calcRatio( calcCommonArea( txt, mod ), mod->area );
+
+                if( itemCommonRatio < commonAreaRatio )
+                {
+                    rejected.insert( mod->item );
+                    break;
                 }
             }
         }
     }
 
-    if( aCollector.CountType( PCB_MODULE_T ) > 0 )
+    if( !modules.empty() )
     {
-        double minArea = calcMinArea( aCollector, PCB_MODULE_T );
-        double maxArea = calcMaxArea( aCollector, PCB_MODULE_T );
+        double minArea = std::numeric_limits<double>::max();
+        double maxArea = 0.0;
+
+        for( const SELECTION_CANDIDATE* mod : modules )
+        {
+            minArea = std::min( minArea, mod->area );
+            maxArea = std::max( maxArea, mod->area );
+        }
 
         if( calcRatio( minArea, maxArea ) <= footprintAreaRatio )
         {
-            for( int i = 0; i < aCollector.GetCount(); ++i )
+            for( const SELECTION_CANDIDATE* mod : modules )
             {
-                if( MODULE* mod = dyn_cast<MODULE*>( aCollector[i] ) )
-                {
-                    double normalizedArea = calcRatio( calcArea( mod ), maxArea );
+                double normalizedArea = calcRatio( mod->area, maxArea );
 
-                    if( normalizedArea > footprintAreaRatio )
-                        rejected.insert( mod );
-                }
+                if( normalizedArea > footprintAreaRatio )
+                    rejected.insert( mod->item );
             }
         }
     }
 
     if( aCollector.CountType( PCB_PAD_T ) > 0 )
     {
-        for( int i = 0; i < aCollector.GetCount(); ++i )
+        // Pads of the same footprint share the coverage ratio
+        std::set<MODULE*> checked;
+
+        for( const SELECTION_CANDIDATE& candidate : candidates )
         {
-            if( D_PAD* pad = dyn_cast<D_PAD*>( aCollector[i] ) )
+            if( D_PAD* pad = dyn_cast<D_PAD*>( candidate.item ) )
             {
-                double ratio = pad->GetParent()->PadCoverageRatio();
+                MODULE* mod = pad->GetParent();
+
+                if( !checked.insert( mod ).second )
+                    continue;
 
-                if( ratio < modulePadMinCoverRatio )
-                    rejected.insert( pad->GetParent() );
+                if( mod->PadCoverageRatio() < modulePadMinCoverRatio )
+                    rejected.insert( mod );
             }
         }
     }
 
-    if( aCollector.CountType( PCB_VIA_T ) > 0 )
+    if( !vias.empty() )
     {
-        for( int i = 0; i < aCollector.GetCount(); ++i )
+        // The smallest via rejects the most pads and footprints, the narrowest via of a net
+        // the most tracks of the net
+        double minViaArea = std::numeric_limits<double>::max();
+        std::map<int, int> minViaWidth;
+
+        for( const SELECTION_CANDIDATE* candidate : vias )
         {
-            if( VIA* via = dyn_cast<VIA*>( aCollector[i] ) )
-            {
-                double viaArea = calcArea( via );
+            const VIA* via = static_cast<const VIA*>( candidate->item );
+            auto it = minViaWidth.find( via->GetNetCode() );
 
-                for( int j = 0; j < aCollector.GetCount(); ++j )
-                {
-                    if( i == j )
-                        continue;
+            minViaArea = std::min( minViaArea, candidate->area );
 
-                    BOARD_ITEM* item = aCollector[j];
-                    double areaRatio = calcRatio( viaArea, calcArea( item ) );
+            if( it == minViaWidth.end() )
+                minViaWidth[via->GetNetCode()] = via->GetWidth();
+            else
+                it->second = std::min( it->second, via->GetWidth() );
+        }
 
-                    if( item->Type() == PCB_MODULE_T && areaRatio < modulePadMinCoverRatio )
-                        rejected.insert( item );
+        for( const SELECTION_CANDIDATE& candidate : candidates )
+        {
+            BOARD_ITEM* item = candidate.item;
+            double areaRatio = calcRatio( minViaArea, candidate.area );
 
-                    if( item->Type() == PCB_PAD_T && areaRatio < padViaAreaRatio )
-                        rejected.insert( item );
+            if( item->Type() == PCB_MODULE_T && areaRatio < modulePadMinCoverRatio )
+                rejected.insert( item );
 
-                    if( TRACK* track = dyn_cast<TRACK*>( item ) )
-                    {
-                        if( track->GetNetCode() != via->GetNetCode() )
-                            continue;
+            if( item->Type() == PCB_PAD_T && areaRatio < padViaAreaRatio )
+                rejected.insert( item );
 
-                        double lenRatio = (double) ( track->GetLength() + track->GetWidth() ) /
-                                          (double) via->GetWidth();
+            if( TRACK* track = dyn_cast<TRACK*>( item ) )
+            {
+                auto it = minViaWidth.find( track->GetNetCode() );
 
-                        if( lenRatio > trackViaLengthRatio )
-                            rejected.insert( track );
-                    }
-                }
+                if( it == minViaWidth.end() )
+                    continue;
+
+                double lenRatio = (double) ( track->GetLength() + track->GetWidth() ) /
+                                  (double) it->second;
+
+                if( lenRatio > trackViaLengthRatio )
+                    rejected.insert( track );
             }
         }
     }
@@ -1829,11 +1898,11 @@ void SELECTION_TOOL::guessSelectionCandidates( GENERAL_COLLECTOR& aCollector ) c
         double maxLength = 0.0;
         double minLength = std::numeric_limits<double>::max();
         double maxArea = 0.0;
-        const TRACK* maxTrack = nullptr;
+        const SELECTION_CANDIDATE* maxTrack = nullptr;
 
-        for( int i = 0; i < aCollector.GetCount(); ++i )
+        for( const SELECTION_CANDIDATE& candidate : candidates )
         {
-            if( TRACK* track = dyn_cast<TRACK*>( aCollector[i] ) )
+            if( TRACK* track = dyn_cast<TRACK*>( candidate.item ) )
             {
                 maxLength = std::max( track->GetLength(), maxLength );
                 maxLength = std::max( (double) track->GetWidth(), maxLength );
@@ -1845,16 +1914,16 @@ void SELECTION_TOOL::guessSelectionCandidates( GENERAL_COLLECTOR& aCollector ) c
                 if( area > maxArea )
                 {
                     maxArea = area;
-                    maxTrack = track;
+                    maxTrack = &candidate;
                 }
             }
         }
 
         if( maxLength > 0.0 && minLength / maxLength < trackTrackLengthRatio && nTracks > 1 )
         {
-            for( int i = 0; i < aCollector.GetCount(); ++i )
-             {
-                if( TRACK* track = dyn_cast<TRACK*>( aCollector[i] ) )
+            for( const SELECTION_CANDIDATE& candidate : candidates )
+            {
+                if( TRACK* track = dyn_cast<TRACK*>( candidate.item ) )
                 {
                     double ratio = std::max( (double) track->GetWidth(), track->GetLength() ) / maxLength;
 
@@ -1864,23 +1933,23 @@ void SELECTION_TOOL::guessSelectionCandidates( GENERAL_COLLECTOR& aCollector ) c
             }
         }
 
-        for( int j = 0; j < aCollector.GetCount(); ++j )
+        for( const SELECTION_CANDIDATE* mod : modules )
         {
-            if( MODULE* mod = dyn_cast<MODULE*>( aCollector[j] ) )
-            {
-                double ratio = calcRatio( maxArea, mod->GetFootprintRect().GetArea() );
+            double ratio = calcRatio( maxArea, mod->area );
 
-                if( ratio < modulePadMinCoverRatio && calcCommonArea( maxTrack, mod ) < commonAreaRatio )
-                    rejected.insert( mod );
-            }
+            if( ratio < modulePadMinCoverRatio && calcCommonArea( maxTrack, mod ) < commonAreaRatio )
+                rejected.insert( mod->item );
         }
     }
 
     if( (unsigned) aCollector.GetCount() > rejected.size() )  // do not remove everything
     {
-        for( BOARD_ITEM* item : rejected )
+        aCollector.Empty();
+
+        for( const SELECTION_CANDIDATE& candidate : candidates )
         {
-            aCollector.Remove( item );
+            if( !rejected.count( candidate.item ) )
+                aCollector.Append( candidate.item );
         }
     }
 }
@@ -2038,7 +2107,12 @@ const BOX2I SELECTION::ViewBBox() const
         }
     }
 
-    return BOX2I( eda_bbox.GetOrigin(), eda_bbox.GetSize() );
+    BOX2I bbox( eda_bbox.GetOrigin(), eda_bbox.GetSize() );
+
+    // Items being dragged are drawn at their pending position
+    bbox.Move( GetOffset() );
+
+    return bbox;
 }
 
 
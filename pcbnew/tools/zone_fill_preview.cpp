@@ -0,0 +1,227 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "zone_fill_preview.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#include <wxBasePcbFrame.h>
+#include <class_draw_panel_gal.h>
+#include <class_board.h>
+#include <class_zone.h>
+#include <view/view.h>
+#include <task_scheduler.h>
+
+/// Time without a new request after which the fill starts
+static const int FILL_DEBOUNCE_MS = 150;
+
+wxDEFINE_EVENT( EVT_ZONE_FILL_DONE, wxCommandEvent );
+
+
+/**
+ * A fill running on the task scheduler.  It is shared by the preview and the task, so a
+ * cancelled fill can end after the preview dropped it.
+ */
+struct ZONE_FILL_PREVIEW::FILL_JOB
+{
+    FILL_JOB() :
+        m_generation( 0 ),
+        m_failed( false ),
+        m_done( false )
+    {}
+
+    long                            m_generation;   ///< identifies the completion event
+    std::unique_ptr<ZONE_CONTAINER> m_snapshot;     ///< copy of the zone being filled
+    ZONE_FILL_GUARD                 m_guard;        ///< cancelled with the fill
+
+    std::mutex                      m_mutex;
+    std::condition_variable         m_finished;
+    bool                            m_failed;       ///< guarded by m_mutex
+    bool                            m_done;         ///< guarded by m_mutex
+};
+
+
+ZONE_FILL_PREVIEW::ZONE_FILL_PREVIEW( PCB_BASE_FRAME* aFrame, ZONE_CONTAINER* aZone ) :
+    m_frame( aFrame ),
+    m_zone( aZone ),
+    m_timer( this ),
+    m_requested( false ),
+    m_upToDate( false ),
+    m_generation( 0 )
+{
+    Connect( wxEVT_TIMER, wxTimerEventHandler( ZONE_FILL_PREVIEW::onTimer ), NULL, this );
+    Connect( EVT_ZONE_FILL_DONE, wxCommandEventHandler( ZONE_FILL_PREVIEW::onFillDone ),
+             NULL, this );
+}
+
+
+ZONE_FILL_PREVIEW::~ZONE_FILL_PREVIEW()
+{
+    Cancel();
+}
+
+
+void ZONE_FILL_PREVIEW::Request()
+{
+    m_requested = true;
+    m_upToDate = false;
+
+    // Restarted on every request, so the fill starts once the outline stops changing
+    m_timer.StartOnce( FILL_DEBOUNCE_MS );
+}
+
+
+bool ZONE_FILL_PREVIEW::Finish()
+{
+    m_timer.Stop();
+
+    if( m_job && !m_requested )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_job->m_mutex );
+            m_job->m_finished.wait( lock, [this]() { return m_job->m_done; } );
+        }
+
+        applyFill();
+    }
+
+    Cancel();
+
+    return m_upToDate;
+}
+
+
+void ZONE_FILL_PREVIEW::Cancel()
+{
+    m_timer.Stop();
+    m_requested = false;
+
+    if( m_job )
+    {
+        // The task stops reading the board, ends on its own and drops its result.  A
+        // completion event it already queued is ignored, as it no longer matches m_job.
+        m_job->m_guard.Cancel();
+        m_job.reset();
+    }
+}
+
+
+void ZONE_FILL_PREVIEW::startFill()
+{
+    m_requested = false;
+
+    std::shared_ptr<FILL_JOB> job = std::make_shared<FILL_JOB>();
+
+    job->m_generation = ++m_generation;
+
+    // The outline is copied now, the edited zone may be changed while the copy is filled
+    job->m_snapshot.reset( new ZONE_CONTAINER( *m_zone ) );
+    job->m_snapshot->ClearFilledPolysList();
+    job->m_snapshot->FillSegments().clear();
+    job->m_snapshot->SetFillGuard( &job->m_guard );
+
+    BOARD* board = m_frame->GetBoard();
+
+    m_job = job;
+
+    // Submitted without a TASK_GROUP, which would have to be waited for when cancelled
+    DefaultTaskScheduler().Submit( [this, job, board]()
+    {
+        bool failed = false;
+
+        try
+        {
+            if( !job->m_snapshot->BuildFilledSolidAreasPolygons( board ) )
+                failed = true;
+        }
+        catch( ... )    // ZONE_FILL_GUARD::CANCELLED included
+        {
+            failed = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( job->m_mutex );
+            job->m_failed = failed;
+            job->m_done = true;
+        }
+
+        job->m_finished.notify_all();
+
+        try
+        {
+            // The preview is alive as long as the guard is not cancelled
+            ZONE_FILL_GUARD::ACCESS access( &job->m_guard );
+
+            wxCommandEvent* event = new wxCommandEvent( EVT_ZONE_FILL_DONE );
+            event->SetExtraLong( job->m_generation );
+            wxQueueEvent( this, event );
+        }
+        catch( const ZONE_FILL_GUARD::CANCELLED& )
+        {
+        }
+    } );
+}
+
+
+void ZONE_FILL_PREVIEW::applyFill()
+{
+    std::shared_ptr<FILL_JOB> job = std::move( m_job );
+
+    {
+        std::lock_guard<std::mutex> lock( job->m_mutex );
+
+        if( job->m_failed )
+            return;
+    }
+
+    // An outdated fill is still closer to the new outline than the previous one, show it.
+    // The corner-smoothed outline rebuilt by the fill is taken over too: DRC uses it.
+    m_zone->SwapFill( *job->m_snapshot );
+
+    m_upToDate = !m_requested;
+
+    m_frame->GetGalCanvas()->GetView()->Update( m_zone, KIGFX::ALL );
+    m_frame->GetGalCanvas()->Refresh();
+}
+
+
+void ZONE_FILL_PREVIEW::onTimer( wxTimerEvent& aEvent )
+{
+    // The running fill is outdated, the request is served when it is done
+    if( !m_job )
+        startFill();
+}
+
+
+void ZONE_FILL_PREVIEW::onFillDone( wxCommandEvent& aEvent )
+{
+    if( !m_job || aEvent.GetExtraLong() != m_job->m_generation )
+        return;
+
+    // The task posted the event once done
+    applyFill();
+
+    if( m_requested && !m_timer.IsRunning() )
+        startFill();
+}
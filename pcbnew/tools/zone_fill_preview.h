@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef TOOLS_ZONE_FILL_PREVIEW__H_
+#define TOOLS_ZONE_FILL_PREVIEW__H_
+
+#include <wx/event.h>
+#include <wx/timer.h>
+
+#include <memory>
+
+class PCB_BASE_FRAME;
+class ZONE_CONTAINER;
+
+/**
+ * Class ZONE_FILL_PREVIEW
+ *
+ * Refills a zone in the background while its outline is being edited, so the effect of the
+ * edit can be seen without blocking the editor.
+ *
+ * Refill requests are debounced: once no request came for a short while, the zone is copied
+ * and the copy is filled on the task scheduler.  When the fill is done, its result is swapped
+ * into the edited zone.  At most one fill runs at a time, the results of cancelled fills are
+ * dropped.
+ *
+ * The fill reads the other board items under a ZONE_FILL_GUARD, so Cancel() has to be called
+ * before they are modified.  It does not wait for the end of the fill: a cancelled fill stops
+ * reading the board at once and finishes on its own.
+ */
+class ZONE_FILL_PREVIEW : public wxEvtHandler
+{
+public:
+    ZONE_FILL_PREVIEW( PCB_BASE_FRAME* aFrame, ZONE_CONTAINER* aZone );
+    ~ZONE_FILL_PREVIEW();
+
+    /**
+     * Function Request
+     * schedules a refill of the zone with its current outline.
+     */
+    void Request();
+
+    /**
+     * Function Finish
+     * waits for the fill of the last requested outline, if it is running, and applies it.
+     * A request which did not start yet is dropped.
+     * @return true if the zone fill matches its outline.
+     */
+    bool Finish();
+
+    /**
+     * Function Cancel
+     * drops the pending request and the result of the running fill, if any.  Returns once
+     * the running fill no longer reads the board, without waiting for it to end.
+     */
+    void Cancel();
+
+    ///> Returns true if the zone fill has been updated since the last request.
+    bool IsUpToDate() const { return m_upToDate; }
+
+private:
+    struct FILL_JOB;
+
+    void startFill();
+    void applyFill();
+
+    void onTimer( wxTimerEvent& aEvent );
+    void onFillDone( wxCommandEvent& aEvent );
+
+    PCB_BASE_FRAME*                 m_frame;
+    ZONE_CONTAINER*                 m_zone;         ///< the edited zone
+
+    wxTimer                         m_timer;        ///< debounces the requests
+    bool                            m_requested;    ///< a request waits for the next fill
+    bool                            m_upToDate;
+
+    std::shared_ptr<FILL_JOB>       m_job;          ///< the running fill, shared with its task
+    long                            m_generation;   ///< counts the fills started
+};
+
+#endif /* TOOLS_ZONE_FILL_PREVIEW__H_ */
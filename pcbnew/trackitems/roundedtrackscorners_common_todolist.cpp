@@ -23,6 +23,9 @@
 
 #include "roundedtrackscorners.h"
 #include <view/view.h>
+#include <task_scheduler.h>
+
+#include <map>
 
 using namespace TrackNodeItem;
 
@@ -104,23 +107,62 @@ void ROUNDED_TRACKS_CORNERS::UpdateList_DrawTracks( EDA_DRAW_PANEL* aPanel, wxDC
 
 void ROUNDED_TRACKS_CORNERS::UpdateListDo( void )
 {
+    // Corners only modify the tracks of their own net, so every net is updated by its own
+    // task. A corner between tracks of different nets (a short) could race with both nets, it
+    // is updated afterwards. The view is not thread safe, it is updated last.
+    struct NET_ITEMS
+    {
+        std::vector<ROUNDED_CORNER_TRACK*>  tracks;
+        std::vector<ROUNDED_TRACKS_CORNER*> corners;
+    };
+
+    std::map<int, NET_ITEMS> netItems;
+    std::vector<ROUNDED_TRACKS_CORNER*> shorted;
+
     if( m_update_tracks_list )
         for( auto r_t: *m_update_tracks_list )
-            r_t->ResetVisibleEndpoints();
+            netItems[r_t->GetNetCode()].tracks.push_back( r_t );
 
     if( m_update_list )
-    {
-        for( ROUNDED_TRACKS_CORNER* corner : *m_update_list )
-            if( corner && corner->GetList() )
-                corner->ResetVisibleEndpoints();
         for( ROUNDED_TRACKS_CORNER* corner : *m_update_list )
             if( corner && corner->GetList() )
             {
-                corner->Update();
-                if( m_EditFrame && m_EditFrame->IsGalCanvasActive() )
-                    m_EditFrame->GetGalCanvas()->GetView()->Update( corner );
+                TRACK* first = corner->GetTrackSeg();
+                TRACK* second = corner->GetTrackSegSecond();
+
+                if( first && second && first->GetNetCode() != second->GetNetCode() )
+                    shorted.push_back( corner );
+                else
+                    netItems[first ? first->GetNetCode() : corner->GetNetCode()].corners.push_back( corner );
             }
+
+    std::vector<NET_ITEMS*> nets;
+
+    for( auto& net : netItems )
+        nets.push_back( &net.second );
+
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, nets.size(), [&nets]( int i )
+    {
+        for( auto r_t: nets[i]->tracks )
+            r_t->ResetVisibleEndpoints();
+        for( ROUNDED_TRACKS_CORNER* corner : nets[i]->corners )
+            corner->ResetVisibleEndpoints();
+        for( ROUNDED_TRACKS_CORNER* corner : nets[i]->corners )
+            corner->Update();
+    } );
+
+    for( ROUNDED_TRACKS_CORNER* corner : shorted )
+    {
+        corner->ResetVisibleEndpoints();
+        corner->Update();
     }
+
+    if( m_update_list && m_EditFrame && m_EditFrame->IsGalCanvasActive() )
+        for( ROUNDED_TRACKS_CORNER* corner : *m_update_list )
+            if( corner && corner->GetList() )
+                m_EditFrame->GetGalCanvas()->GetView()->Update( corner );
 }
 
 void ROUNDED_TRACKS_CORNERS::UpdateListDo( EDA_DRAW_PANEL* aPanel, wxDC* aDC, GR_DRAWMODE aDrawMode, bool aErase )
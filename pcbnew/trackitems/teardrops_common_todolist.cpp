@@ -23,6 +23,9 @@
 
 #include "teardrops.h"
 #include <view/view.h>
+#include <task_scheduler.h>
+
+#include <map>
 
 using namespace TrackNodeItem;
 
@@ -58,13 +61,35 @@ void TEARDROPS::UpdateListAdd( const BOARD_ITEM* aBoardItem )
 
 void TEARDROPS::UpdateListDo( void )
 {
-    if( m_update_list )
-        for( TEARDROP* tear : *m_update_list )
-        {
+    if( !m_update_list )
+        return;
+
+    // Teardrops only depend on items of their own net, so every net is updated by its
+    // own task. The view is not thread safe, it is updated afterwards.
+    std::map<int, std::vector<TEARDROP*>> netTears;
+
+    for( TEARDROP* tear : *m_update_list )
+    {
+        TRACK* track = tear->GetTrackSeg();
+        netTears[track ? track->GetNetCode() : tear->GetNetCode()].push_back( tear );
+    }
+
+    std::vector<std::vector<TEARDROP*>*> nets;
+
+    for( auto& net : netTears )
+        nets.push_back( &net.second );
+
+    TASK_GROUP group;
+
+    group.ParallelFor( 0, nets.size(), [&nets]( int i )
+    {
+        for( TEARDROP* tear : *nets[i] )
             tear->Update();
-            if( m_EditFrame && m_EditFrame->IsGalCanvasActive() )
-                m_EditFrame->GetGalCanvas()->GetView()->Update( tear );
-        }
+    } );
+
+    if( m_EditFrame && m_EditFrame->IsGalCanvasActive() )
+        for( TEARDROP* tear : *m_update_list )
+            m_EditFrame->GetGalCanvas()->GetView()->Update( tear );
 }
 
 void TEARDROPS::UpdateListDo( EDA_DRAW_PANEL* aPanel,
@@ -1070,20 +1070,15 @@ void TRACKITEMS::SortTracks( void )
         tracks.reserve( num_items );
 
         for( int n = 0; n < num_items; ++n )
-        {
-            m_Board->m_Track->m_Param = n;
             tracks.push_back( m_Board->m_Track.PopFront() );
-        }
 
         auto rule = [] ( const TRACK* ref, const TRACK* cmp )
         {
-            if( ref->GetNetCode() == cmp->GetNetCode())
-                return ref->m_Param < cmp->m_Param;
-
             return ref->GetNetCode() < cmp->GetNetCode();
         };
 
-        std::sort( tracks.begin(), tracks.end(), rule );
+        // Stable, to keep the order of the segments of a net
+        std::stable_sort( tracks.begin(), tracks.end(), rule );
 
         for( int n = 0; n < num_items;  ++n )
         {
@@ -24,9 +24,7 @@
 #include "viastitching.h"
 #include "trackitems.h"
 
-#ifdef USE_OPENMP
-#include <omp.h>
-#endif
+#include <task_scheduler.h>
 
 using namespace ViaStitching;
 
@@ -736,18 +734,17 @@ void VIASTITCHING::FillAndConnectZones(  wxWindow* aActiveWindow, PCB_EDIT_FRAME
     if( progressDialog )
         progressDialog->Update( ++progress_counter, _( "Filling zones..." ) );
 
-#ifdef USE_OPENMP
-    #pragma omp parallel for schedule(dynamic)
-#endif
+    TASK_GROUP fillGroup;
+
 #ifdef NEWCONALGO
-    for( int n = 0; n < zones.size(); ++n )
+    fillGroup.ParallelFor( 0, zones.size(), [&]( int n )
     {
         ZONE_CONTAINER* zone = zones[n];
         zone->ClearFilledPolysList();
         zone->UnFill();
         zone->BuildFilledSolidAreasPolygons( const_cast<BOARD*>(m_Board), nullptr, false );
         zone->SetIsFilled( true );
-    }
+    } );
 
 #ifndef MYCONALGO
     for( auto zone : zones )
@@ -755,13 +752,13 @@ void VIASTITCHING::FillAndConnectZones(  wxWindow* aActiveWindow, PCB_EDIT_FRAME
 #endif
 
 #else
-    for( int m = 0; m < zones.size(); ++m )
+    fillGroup.ParallelFor( 0, zones.size(), [&]( int m )
     {
         ZONE_CONTAINER* zone = zones[m];
         zone->ClearFilledPolysList();
         zone->UnFill();
         zone->BuildFilledSolidAreasPolygons( const_cast<BOARD*>(m_Board) );
-    }
+    } );
 #endif
 
     if( progressDialog )
@@ -775,10 +772,9 @@ void VIASTITCHING::FillAndConnectZones(  wxWindow* aActiveWindow, PCB_EDIT_FRAME
     if( progressDialog )
         progressDialog->Update( ++progress_counter, _( "Cleaning insulated areas..." ) );
 
-#ifdef USE_OPENMP
-    #pragma omp parallel for schedule(dynamic)
-#endif
-    for( int n = 0; n < zones.size(); ++n )
+    TASK_GROUP cleanGroup;
+
+    cleanGroup.ParallelFor( 0, zones.size(), [&]( int n )
     {
         ZONE_CONTAINER* zone = zones[n];
         PCB_LAYER_ID zone_layer = zone->GetLayer();
@@ -839,8 +835,15 @@ void VIASTITCHING::FillAndConnectZones(  wxWindow* aActiveWindow, PCB_EDIT_FRAME
                 const SHAPE_POLY_SET* polylist = &zone->GetFilledPolysList();
                 const_cast<SHAPE_POLY_SET*>(polylist)->DeletePolygon( idx );
             }
+        }
+    } );
 
-            if( aEditFrame->IsGalCanvasActive() )
+    // The view is not thread safe, refresh it once all the zones are cleaned
+    if( aEditFrame->IsGalCanvasActive() )
+    {
+        for( auto zone : zones )
+        {
+            if( IsCopperLayer( zone->GetLayer() ) )
                 aEditFrame->GetGalCanvas()->GetView()->Update( zone, KIGFX::ALL );
         }
     }
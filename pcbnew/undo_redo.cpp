@@ -25,6 +25,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <functional>
 using namespace std::placeholders;
 #include <fctsys.h>
@@ -46,6 +47,8 @@ using namespace std::placeholders;
 #include <class_edge_mod.h>
 
 #include <ratsnest_data.h>
+#include <board_commit.h>
+#include <layer_remap.h>
 
 #include <tools/selection_tool.h>
 #include <tool/tool_manager.h>
@@ -401,6 +404,21 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
 
     bool build_item_list = true;    // if true the list of existing items must be rebuilt
 
+    // A layer remap is restored by its table, except the items saved in the list by copy
+    if( aList->m_Status == UR_LAYER_REMAPPED )
+    {
+        LAYER_REMAP remap( aList->m_LayerMap );
+        std::vector<BOARD_ITEM*> saved;
+
+        for( unsigned ii = 0; ii < aList->GetCount(); ii++ )
+            saved.push_back( (BOARD_ITEM*) aList->GetPickedItem( ii ) );
+
+        std::sort( saved.begin(), saved.end() );
+
+        if( applyLayerRemap( aRedoCommand ? remap : remap.Inverse(), saved ) )
+            reBuild_ratsnest = true;
+    }
+
     // Restore changes in reverse order
     for( int ii = aList->GetCount() - 1; ii >= 0 ; ii-- )
     {
@@ -625,6 +643,9 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
                 ratsnest->Recalculate();
         }
     }
+
+    // Items may have been swapped or freed, so data derived from the board is no longer valid
+    BOARD_COMMIT::InvalidateListeners( GetBoard() );
 }
 
 
@@ -454,7 +454,11 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb )
 #endif
 
     tmp.RemoveAllContours();
-    buildFeatureHoleList( aPcb, holes );
+
+    {
+        ZONE_FILL_GUARD::ACCESS access( m_fillGuard );
+        buildFeatureHoleList( aPcb, holes );
+    }
 
 #ifdef DEBUG
     if(g_DumpZonesWhenFilling)
@@ -489,17 +493,25 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb )
 
     m_FilledPolysList = areas_fractured;
 
-    // Remove insulated islands:
-    if( GetNetCode() > 0 )
-        TestForCopperIslandAndRemoveInsulatedIslands( aPcb );
+    // Remove insulated islands (the net code is read from the board too):
+    {
+        ZONE_FILL_GUARD::ACCESS access( m_fillGuard );
+
+        if( GetNetCode() > 0 )
+            TestForCopperIslandAndRemoveInsulatedIslands( aPcb );
+    }
 
     SHAPE_POLY_SET thermalHoles;
 
     // Test thermal stubs connections and add polygons to remove unconnected stubs.
     // (this is a refinement for thermal relief shapes)
-    if( GetNetCode() > 0 )
-        BuildUnconnectedThermalStubsPolygonList( thermalHoles, aPcb, this,
-                                                 correctionFactor, s_thermalRot );
+    {
+        ZONE_FILL_GUARD::ACCESS access( m_fillGuard );
+
+        if( GetNetCode() > 0 )
+            BuildUnconnectedThermalStubsPolygonList( thermalHoles, aPcb, this,
+                                                     correctionFactor, s_thermalRot );
+    }
 
     // remove copper areas corresponding to not connected stubs
     if( !thermalHoles.IsEmpty() )
@@ -526,6 +538,8 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb )
 
         m_FilledPolysList = th_fractured;
 
+        ZONE_FILL_GUARD::ACCESS access( m_fillGuard );
+
         if( GetNetCode() > 0 )
             TestForCopperIslandAndRemoveInsulatedIslands( aPcb );
     }
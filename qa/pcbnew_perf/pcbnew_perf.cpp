@@ -0,0 +1,463 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Performance regression suite of the pcbnew board code, run without any frame.
+ *
+ * Each board is loaded, optionally tiled SCALE x SCALE times to get a large synthetic
+ * board, then the following steps are timed, keeping the best of RUNS runs:
+ *   load           PCB_IO::Load() of the file
+ *   connectivity   legacy track/pad connections (CONNECTIONS), as done when recalculating
+ *                  the track net codes
+ *   ratsnest       RN_DATA::ProcessBoard() and Recalculate() on a new ratsnest
+ *   layer_remap    LAYER_REMAP::Apply() of a front/back copper swap, and of the swap back
+ *   zone_fill      ZONE_CONTAINER::BuildFilledSolidAreasPolygons() of all copper zones
+ *   plot_gerber    PLOT_CONTROLLER plot of all enabled layers to Gerber files
+ *   save           PCB_IO::Save() of the board
+ *
+ * Results are written as "name<TAB>milliseconds" lines, to stdout and to the --output file.
+ * A previous output given as --baseline is the timing budget: a step more than TOLERANCE
+ * times slower than its baseline is reported and makes the program exit with 1.
+ *
+ * Usage: qa_pcbnew_perf [--runs RUNS] [--scale SCALE] [--output FILE]
+ *                       [--baseline FILE] [--tolerance TOLERANCE] BOARD...
+ */
+
+#include <fctsys.h>
+#include <convert_to_biu.h>
+#include <pgm_base.h>
+#include <kiway.h>
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <connect.h>
+#include <ratsnest_data.h>
+#include <layer_remap.h>
+#include <io_mgr.h>
+#include <plotcontroller.h>
+#include <pcb_plot_params.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <wx/filename.h>
+#include <wx/init.h>
+#include <wx/utils.h>
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/// The board code only needs a PGM_BASE to exist, nothing is run from it
+static struct PGM_PERF : public PGM_BASE
+{
+    bool OnPgmInit() override { return true; }
+    void OnPgmExit() override {}
+    void MacOpenFile( const wxString& aFileName ) override {}
+} program;
+
+
+struct RESULT
+{
+    std::string m_name;
+    double      m_ms;
+};
+
+
+/**
+ * Function timeBest
+ * runs aStep aRuns times, aSetup (not timed) before each run, and returns the time of the
+ * fastest run in milliseconds.
+ */
+static double timeBest( int aRuns, const std::function<void()>& aSetup,
+                        const std::function<void()>& aStep )
+{
+    double best = -1.0;
+
+    for( int i = 0; i < aRuns; ++i )
+    {
+        if( aSetup )
+            aSetup();
+
+        auto start = CLOCK::now();
+        aStep();
+        double ms = std::chrono::duration<double, std::milli>( CLOCK::now() - start ).count();
+
+        if( best < 0.0 || ms < best )
+            best = ms;
+    }
+
+    return best;
+}
+
+
+/**
+ * Function tileBoard
+ * makes aBoard a synthetic large board by adding aScale x aScale - 1 copies of its
+ * footprints, tracks, zones and drawings next to each other.  The copies keep their nets.
+ */
+static void tileBoard( BOARD* aBoard, int aScale )
+{
+    EDA_RECT bbox = aBoard->ComputeBoundingBox( false );
+    int      pitchX = bbox.GetWidth() + Millimeter2iu( 5 );
+    int      pitchY = bbox.GetHeight() + Millimeter2iu( 5 );
+
+    std::vector<MODULE*>         modules;
+    std::vector<TRACK*>          tracks;
+    std::vector<ZONE_CONTAINER*> zones;
+    std::vector<BOARD_ITEM*>     drawings;
+
+    for( MODULE* module : aBoard->Modules() )
+        modules.push_back( module );
+
+    for( TRACK* track : aBoard->Tracks() )
+        tracks.push_back( track );
+
+    for( int i = 0; i < aBoard->GetAreaCount(); ++i )
+        zones.push_back( aBoard->GetArea( i ) );
+
+    for( BOARD_ITEM* drawing : aBoard->Drawings() )
+        drawings.push_back( drawing );
+
+    for( int ix = 0; ix < aScale; ++ix )
+    {
+        for( int iy = 0; iy < aScale; ++iy )
+        {
+            if( ix == 0 && iy == 0 )
+                continue;
+
+            wxPoint offset( ix * pitchX, iy * pitchY );
+
+            for( MODULE* module : modules )
+            {
+                MODULE* copy = new MODULE( *module );
+                copy->Move( offset );
+                aBoard->Add( copy, ADD_APPEND );
+            }
+
+            for( TRACK* track : tracks )
+            {
+                TRACK* copy = static_cast<TRACK*>( track->Clone() );
+                copy->Move( offset );
+                aBoard->Add( copy );    // kept sorted by net, the connectivity needs it
+            }
+
+            for( ZONE_CONTAINER* zone : zones )
+            {
+                ZONE_CONTAINER* copy = new ZONE_CONTAINER( *zone );
+                copy->Move( offset );
+                aBoard->Add( copy );
+            }
+
+            for( BOARD_ITEM* drawing : drawings )
+            {
+                BOARD_ITEM* copy = static_cast<BOARD_ITEM*>( drawing->Clone() );
+                copy->Move( offset );
+                aBoard->Add( copy, ADD_APPEND );
+            }
+        }
+    }
+
+    aBoard->BuildListOfNets();
+}
+
+
+/// What PCB_BASE_FRAME::RecalculateAllTracksNetcode() does to find the connections
+static void buildConnections( BOARD* aBoard )
+{
+    for( TRACK* track : aBoard->Tracks() )
+    {
+        track->m_TracksConnected.clear();
+        track->m_PadsConnected.clear();
+        track->start = NULL;
+        track->end = NULL;
+    }
+
+    CONNECTIONS connections( aBoard );
+    connections.BuildPadsList();
+    connections.BuildTracksCandidatesList( aBoard->m_Track );
+    connections.SearchTracksConnectedToPads();
+
+    for( TRACK* track : aBoard->Tracks() )
+    {
+        connections.SearchConnectedTracks( track );
+        connections.GetConnectedTracks( track );
+    }
+}
+
+
+static void fillZones( BOARD* aBoard )
+{
+    for( int i = 0; i < aBoard->GetAreaCount(); ++i )
+    {
+        ZONE_CONTAINER* zone = aBoard->GetArea( i );
+
+        zone->ClearFilledPolysList();
+        zone->UnFill();
+
+        if( !zone->GetIsKeepout() )
+            zone->BuildFilledSolidAreasPolygons( aBoard );
+    }
+}
+
+
+static void plotGerbers( BOARD* aBoard, const wxString& aOutputDir )
+{
+    PLOT_CONTROLLER plotter( aBoard );
+
+    plotter.GetPlotOptions().SetOutputDirectory( aOutputDir );
+
+    for( LSEQ seq = aBoard->GetEnabledLayers().Seq(); seq; ++seq )
+    {
+        plotter.SetLayer( *seq );
+
+        if( plotter.OpenPlotfile( aBoard->GetLayerName( *seq ), PLOT_FORMAT_GERBER,
+                                  wxEmptyString ) )
+            plotter.PlotLayer();
+
+        plotter.ClosePlot();
+    }
+}
+
+
+/**
+ * Function benchBoard
+ * times all the steps for the board file aFileName, adds them to aResults.
+ * @return false if the board cannot be loaded.
+ */
+static bool benchBoard( const wxString& aFileName, int aScale, int aRuns,
+                        const wxString& aWorkDir, std::vector<RESULT>& aResults )
+{
+    std::string name = TO_UTF8( wxFileName( aFileName ).GetName() );
+    BOARD*      board = NULL;
+
+    if( aScale > 1 )
+        name += "_x" + std::to_string( aScale );
+
+    auto add = [&]( const char* aStep, double aMs )
+    {
+        aResults.push_back( { name + "/" + aStep, aMs } );
+        std::cout << aResults.back().m_name << "\t" << aMs << std::endl;
+    };
+
+    try
+    {
+        add( "load", timeBest( aRuns,
+                [&]() { delete board; board = NULL; },
+                [&]() { board = IO_MGR::Load( IO_MGR::KICAD, aFileName ); } ) );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << TO_UTF8( ioe.What() ) << std::endl;
+        return false;
+    }
+
+    if( aScale > 1 )
+        tileBoard( board, aScale );
+
+    // The plot and save file names are derived from the board file name
+    board->SetFileName( wxFileName( aWorkDir, wxFileName( aFileName ).GetFullName() ).GetFullPath() );
+
+    std::cerr << name << ": " << board->m_Modules.GetCount() << " footprints, "
+              << board->m_Track.GetCount() << " tracks, " << board->GetAreaCount() << " zones, "
+              << board->GetNetCount() << " nets" << std::endl;
+
+    add( "connectivity", timeBest( aRuns, nullptr, [&]() { buildConnections( board ); } ) );
+
+    add( "ratsnest", timeBest( aRuns, nullptr, [&]()
+            {
+                RN_DATA ratsnest( board );
+                ratsnest.ProcessBoard();
+                ratsnest.Recalculate();
+            } ) );
+
+    add( "layer_remap", timeBest( aRuns, nullptr, [&]()
+            {
+                LAYER_REMAP swap;
+                swap.Set( F_Cu, B_Cu );
+                swap.Set( B_Cu, F_Cu );
+
+                std::vector<BOARD_ITEM*> items = LAYER_REMAP::GetItems( board );
+                swap.Apply( items );
+                swap.Inverse().Apply( items );
+            } ) );
+
+    add( "zone_fill", timeBest( aRuns, nullptr, [&]() { fillZones( board ); } ) );
+
+    add( "plot_gerber", timeBest( aRuns, nullptr, [&]() { plotGerbers( board, aWorkDir ); } ) );
+
+    add( "save", timeBest( aRuns, nullptr, [&]()
+            {
+                IO_MGR::Save( IO_MGR::KICAD, board->GetFileName(), board );
+            } ) );
+
+    delete board;
+    return true;
+}
+
+
+static bool readResults( const std::string& aFileName, std::map<std::string, double>& aResults )
+{
+    std::ifstream file( aFileName );
+    std::string   name;
+    double        ms;
+
+    if( !file )
+        return false;
+
+    while( file >> name >> ms )
+        aResults[name] = ms;
+
+    return true;
+}
+
+
+/**
+ * Function checkBaseline
+ * compares aResults with the baseline timings, prints the ratios.
+ * @return the number of steps slower than aTolerance times their baseline.
+ */
+static int checkBaseline( const std::vector<RESULT>& aResults,
+                          const std::map<std::string, double>& aBaseline, double aTolerance )
+{
+    int failures = 0;
+
+    std::cout << std::endl << "Comparison with the baseline (tolerance " << aTolerance << "x)"
+              << std::endl;
+
+    for( const RESULT& result : aResults )
+    {
+        auto it = aBaseline.find( result.m_name );
+
+        if( it == aBaseline.end() || it->second <= 0.0 )
+        {
+            std::cout << result.m_name << ": no baseline" << std::endl;
+            continue;
+        }
+
+        double ratio = result.m_ms / it->second;
+        bool   slow = ratio > aTolerance;
+
+        std::cout << result.m_name << ": " << result.m_ms << " ms, baseline " << it->second
+                  << " ms, " << ratio << "x" << ( slow ? "  REGRESSION" : "" ) << std::endl;
+
+        if( slow )
+            ++failures;
+    }
+
+    return failures;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer;
+
+    std::vector<wxString> boards;
+    std::string           outputFile;
+    std::string           baselineFile;
+    int                   runs = 3;
+    int                   scale = 1;
+    double                tolerance = 1.3;
+    bool                  usage = false;
+
+    for( int i = 1; i < argc && !usage; ++i )
+    {
+        std::string arg = argv[i];
+
+        if( arg == "--runs" && i + 1 < argc )
+            runs = atoi( argv[++i] );
+        else if( arg == "--scale" && i + 1 < argc )
+            scale = atoi( argv[++i] );
+        else if( arg == "--output" && i + 1 < argc )
+            outputFile = argv[++i];
+        else if( arg == "--baseline" && i + 1 < argc )
+            baselineFile = argv[++i];
+        else if( arg == "--tolerance" && i + 1 < argc )
+            tolerance = atof( argv[++i] );
+        else if( arg.compare( 0, 2, "--" ) != 0 )
+            boards.push_back( FROM_UTF8( argv[i] ) );
+        else
+            usage = true;
+    }
+
+    if( usage || boards.empty() || runs <= 0 || scale <= 0 || tolerance <= 0.0 )
+    {
+        std::cout << "Usage: " << argv[0] << " [--runs RUNS] [--scale SCALE] [--output FILE]"
+                     " [--baseline FILE] [--tolerance TOLERANCE] BOARD..." << std::endl;
+        return 2;
+    }
+
+    // Sets the PGM_BASE used by the board code, as the kiway does when loading the kiface
+    int kifaceVersion = 0;
+    KIFACE_GETTER( &kifaceVersion, KIFACE_VERSION, &program );
+
+    wxString workDir = wxFileName( wxFileName::GetTempDir(),
+                                   wxString::Format( "qa_pcbnew_perf_%lu",
+                                                     wxGetProcessId() ) ).GetFullPath();
+    wxFileName::Mkdir( workDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+    std::vector<RESULT> results;
+    bool                ok = true;
+
+    for( const wxString& board : boards )
+        ok = benchBoard( board, scale, runs, workDir, results ) && ok;
+
+    wxFileName::Rmdir( workDir, wxPATH_RMDIR_RECURSIVE );
+
+    if( !outputFile.empty() )
+    {
+        std::ofstream file( outputFile );
+
+        for( const RESULT& result : results )
+            file << result.m_name << "\t" << result.m_ms << "\n";
+
+        if( !file )
+        {
+            std::cerr << "Cannot write " << outputFile << std::endl;
+            ok = false;
+        }
+    }
+
+    if( !baselineFile.empty() )
+    {
+        std::map<std::string, double> baseline;
+
+        if( !readResults( baselineFile, baseline ) )
+        {
+            std::cerr << "Cannot read " << baselineFile << std::endl;
+            return 2;
+        }
+
+        if( checkBaseline( results, baseline, tolerance ) > 0 )
+            return 1;
+    }
+
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,288 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <task_scheduler.h>
+
+/**
+ * Class GATE
+ * blocks the tasks calling Pass() until Open() is called, to keep a worker busy.
+ */
+class GATE
+{
+public:
+    GATE() : m_open( false ) {}
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_open = true;
+        m_opened.notify_all();
+    }
+
+    void Pass()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_opened.wait( lock, [this]() { return m_open; } );
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_opened;
+    bool                    m_open;
+};
+
+
+BOOST_AUTO_TEST_SUITE( TaskGroup )
+
+/**
+ * Checks that all the tasks run once, and that the progress counters match.
+ */
+BOOST_AUTO_TEST_CASE( RunAll )
+{
+    TASK_SCHEDULER scheduler( 4 );
+    TASK_GROUP group( scheduler );
+    std::atomic<int> count( 0 );
+
+    for( int i = 0; i < 1000; ++i )
+        group.Run( [&count]() { count++; } );
+
+    group.Wait();
+
+    BOOST_CHECK_EQUAL( count.load(), 1000 );
+    BOOST_CHECK_EQUAL( group.GetDone(), 1000u );
+    BOOST_CHECK_EQUAL( group.GetTotal(), 1000u );
+}
+
+
+/**
+ * Checks that ParallelFor() visits every index exactly once.
+ */
+BOOST_AUTO_TEST_CASE( ParallelForVisitsAll )
+{
+    TASK_SCHEDULER scheduler( 4 );
+    TASK_GROUP group( scheduler );
+    std::vector<std::atomic<int>> visits( 10000 );
+
+    for( auto& visit : visits )
+        visit = 0;
+
+    group.ParallelFor( 0, visits.size(), [&visits]( int i ) { visits[i]++; }, 16 );
+
+    bool once = true;
+
+    for( auto& visit : visits )
+        once = once && visit == 1;
+
+    BOOST_CHECK( once );
+    BOOST_CHECK_EQUAL( group.GetDone(), visits.size() );
+}
+
+
+/**
+ * Checks that the first exception thrown by a task is rethrown by Wait(), once, and that
+ * it cancels the tasks not started yet.
+ */
+BOOST_AUTO_TEST_CASE( ExceptionPropagation )
+{
+    TASK_SCHEDULER scheduler( 1 );
+    TASK_GROUP group( scheduler );
+    GATE gate;
+    std::atomic<int> count( 0 );
+
+    // The only worker runs the failing task, the other tasks are queued behind it
+    group.Run( [&gate]() {
+        gate.Pass();
+        throw std::runtime_error( "task failure" );
+    } );
+
+    for( int i = 0; i < 10; ++i )
+        group.Run( [&count]() { count++; } );
+
+    gate.Open();
+
+    // Wait() would run the queued tasks itself: let the failure cancel them first
+    while( !group.IsCancelled() )
+        std::this_thread::yield();
+
+    BOOST_CHECK_THROW( group.Wait(), std::runtime_error );
+    BOOST_CHECK_NO_THROW( group.Wait() );
+    BOOST_CHECK_EQUAL( count.load(), 0 );
+}
+
+
+/**
+ * Checks that an exception thrown by ParallelFor() on the calling thread is rethrown too.
+ */
+BOOST_AUTO_TEST_CASE( ParallelForException )
+{
+    TASK_SCHEDULER scheduler( 2 );
+    TASK_GROUP group( scheduler );
+
+    BOOST_CHECK_THROW( group.ParallelFor( 0, 1000, []( int i ) {
+                           if( i == 500 )
+                               throw std::runtime_error( "index failure" );
+                       } ),
+                       std::runtime_error );
+
+    BOOST_CHECK( group.IsCancelled() );
+}
+
+
+/**
+ * Checks that groups waited for from the tasks of another group complete, even when every
+ * worker is waiting for such a nested group.
+ */
+BOOST_AUTO_TEST_CASE( NestedWait )
+{
+    TASK_SCHEDULER scheduler( 2 );
+    TASK_GROUP outer( scheduler );
+    std::atomic<int> count( 0 );
+
+    for( int i = 0; i < 16; ++i )
+    {
+        outer.Run( [&scheduler, &count]() {
+            TASK_GROUP inner( scheduler );
+
+            for( int j = 0; j < 16; ++j )
+                inner.Run( [&count]() { count++; } );
+
+            inner.Wait();
+        } );
+    }
+
+    outer.Wait();
+
+    BOOST_CHECK_EQUAL( count.load(), 16 * 16 );
+}
+
+
+/**
+ * Checks that nested ParallelFor() calls complete.
+ */
+BOOST_AUTO_TEST_CASE( NestedParallelFor )
+{
+    TASK_SCHEDULER scheduler( 2 );
+    TASK_GROUP outer( scheduler );
+    std::atomic<int> count( 0 );
+
+    outer.ParallelFor( 0, 32, [&scheduler, &count]( int ) {
+        TASK_GROUP inner( scheduler );
+
+        inner.ParallelFor( 0, 32, [&count]( int ) { count++; } );
+    } );
+
+    BOOST_CHECK_EQUAL( count.load(), 32 * 32 );
+}
+
+
+/**
+ * Checks that a thread waiting for a group runs the pending tasks of this group only.
+ */
+BOOST_AUTO_TEST_CASE( WaitRunsOwnTasksOnly )
+{
+    TASK_SCHEDULER scheduler( 1 );
+    TASK_GROUP other( scheduler );
+    TASK_GROUP group( scheduler );
+    GATE gate;
+    std::atomic<bool> otherDone( false );
+    std::thread::id taskThread;
+
+    // Keep the only worker busy, with a task of the other group queued behind
+    other.Run( [&gate]() { gate.Pass(); } );
+    other.Run( [&otherDone]() { otherDone = true; } );
+
+    group.Run( [&taskThread]() { taskThread = std::this_thread::get_id(); } );
+    group.Wait();
+
+    BOOST_CHECK( taskThread == std::this_thread::get_id() );
+    BOOST_CHECK( !otherDone );
+
+    gate.Open();
+    other.Wait();
+
+    BOOST_CHECK( otherDone );
+}
+
+
+/**
+ * Checks that the tasks not started when the group is cancelled are skipped.
+ */
+BOOST_AUTO_TEST_CASE( Cancel )
+{
+    TASK_SCHEDULER scheduler( 1 );
+    TASK_GROUP group( scheduler );
+    GATE gate;
+    std::atomic<bool> started( false );
+    std::atomic<int> count( 0 );
+
+    group.Run( [&started, &gate]() {
+        started = true;
+        gate.Pass();
+    } );
+
+    for( int i = 0; i < 10; ++i )
+        group.Run( [&count]() { count++; } );
+
+    while( !started )
+        std::this_thread::yield();
+
+    group.Cancel();
+    gate.Open();
+    group.Wait();
+
+    BOOST_CHECK( group.IsCancelled() );
+    BOOST_CHECK_EQUAL( count.load(), 0 );
+    BOOST_CHECK_EQUAL( group.GetDone(), 1u );
+}
+
+
+/**
+ * Checks that cancelling a group from inside ParallelFor() skips the remaining indices.
+ */
+BOOST_AUTO_TEST_CASE( CancelParallelFor )
+{
+    TASK_SCHEDULER scheduler( 2 );
+    TASK_GROUP group( scheduler );
+    std::atomic<int> count( 0 );
+
+    group.ParallelFor( 0, 100000, [&group, &count]( int i ) {
+        if( i == 0 )
+            group.Cancel();
+
+        count++;
+    } );
+
+    BOOST_CHECK( group.IsCancelled() );
+    BOOST_CHECK_LT( count.load(), 100000 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measures the time the Github plugin takes to get a library zip file and index its
+ * footprints, without cache, with an empty cache (cold) and with an up to date cache (warm).
+ *
+ * The library is a zip file URL or a local zip file, e.g. a repo downloaded from
+ * https://github.com/KiCad/<library>.pretty/archive/master.zip.  Serving the directory of
+ * the zip file with "python3 -m http.server" gives a stand-in for github which honours
+ * If-Modified-Since, without network access.
+ *
+ * Usage: github_cache_benchmark ZIP_URL_OR_FILE [RUNS]
+ */
+
+#include <kicad_curl/kicad_curl_easy.h>     // Include before any wx file
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <wx/filename.h>
+#include <wx/filesys.h>
+#include <wx/init.h>
+#include <wx/mstream.h>
+#include <wx/utils.h>
+#include <wx/zipstrm.h>
+
+#include <richio.h>
+#include <macros.h>
+#include <github_zip_cache.h>
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/// Does what GITHUB_PLUGIN::cacheLib() does with the zip image, returns the footprint count
+static int indexFootprints( const std::string& aZipImage )
+{
+    wxMemoryInputStream mis( aZipImage.data(), aZipImage.size() );
+    wxZipInputStream    zis( mis, wxConvUTF8 );
+    const wxString      kicad_mod( "kicad_mod" );
+    int                 count = 0;
+
+    while( wxZipEntry* entry = zis.GetNextEntry() )
+    {
+        if( wxFileName( entry->GetName() ).GetExt() == kicad_mod )
+            ++count;
+
+        delete entry;
+    }
+
+    return count;
+}
+
+
+/**
+ * Function bench
+ * loads the library aRuns times, clearing the cache before each run if aCold, and prints
+ * the average time.  An empty aCacheDir disables the cache.
+ */
+static bool bench( const std::string& aName, const std::string& aZipURL,
+                   const wxString& aCacheDir, bool aCold, int aRuns )
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    CLOCK::duration total( 0 );
+    int             footprints = 0;
+    int             cacheHits = 0;
+
+    for( int i = 0; i < aRuns; ++i )
+    {
+        if( aCold && wxFileName::DirExists( aCacheDir ) )
+            wxFileName::Rmdir( aCacheDir, wxPATH_RMDIR_RECURSIVE );
+
+        std::string zipImage;
+        auto        start = CLOCK::now();
+
+        try
+        {
+            GH_ZIP_CACHE cache( aCacheDir );
+
+            if( cache.Fetch( aZipURL, &zipImage ) )
+                ++cacheHits;
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            std::cout << aName << ": " << TO_UTF8( ioe.What() ) << std::endl;
+            return false;
+        }
+
+        footprints = indexFootprints( zipImage );
+        total += CLOCK::now() - start;
+    }
+
+    double ms = duration_cast<microseconds>( total ).count() / 1000.0 / aRuns;
+
+    std::cout << aName << ": " << ms << " ms/load, " << footprints << " footprints, "
+              << cacheHits << "/" << aRuns << " from cache" << std::endl;
+
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer;
+
+    if( argc < 2 )
+    {
+        std::cout << "Usage: " << argv[0] << " ZIP_URL_OR_FILE [RUNS]" << std::endl;
+        return 1;
+    }
+
+    std::string zipURL = argv[1];
+    int         runs = argc > 2 ? atoi( argv[2] ) : 10;
+
+    if( zipURL.find( "://" ) == std::string::npos )
+    {
+        wxFileName zipFile( FROM_UTF8( argv[1] ) );
+        zipFile.MakeAbsolute();
+        zipURL = TO_UTF8( wxFileSystem::FileNameToURL( zipFile ) );
+    }
+
+    if( runs <= 0 )
+        runs = 1;
+
+    wxString cacheDir = wxFileName( wxFileName::GetTempDir(),
+                                    wxString::Format( "github_cache_benchmark_%lu",
+                                                      wxGetProcessId() ) ).GetFullPath();
+
+    std::cout << "Library " << zipURL << ", " << runs << " runs" << std::endl;
+
+    bool ok = bench( "no cache", zipURL, wxEmptyString, false, runs )
+              && bench( "cold cache", zipURL, cacheDir, true, runs )
+              && bench( "warm cache", zipURL, cacheDir, false, runs );
+
+    wxFileName::Rmdir( cacheDir, wxPATH_RMDIR_RECURSIVE );
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Reports the memory used per board item for tracks, vias and pads: the object size and the
+ * heap used by the legacy connectivity lists (filled as for a typical board), comparing the
+ * COMPACT_VECTOR used by the items with a std::vector.
+ *
+ * Usage: item_memory_benchmark [ITEM_COUNT]
+ */
+
+#include <class_track.h>
+#include <class_pad.h>
+#include <class_module.h>
+#include <compact_vector.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+
+/// Returns the heap currently in use, or 0 when it cannot be measured
+static size_t heapInUse()
+{
+#ifdef __GLIBC__
+    return mallinfo().uordblks;
+#else
+    return 0;
+#endif
+}
+
+
+/**
+ * Function listHeapPerItem
+ * fills aCount connection lists with aTracks track pointers and aPads pad pointers each,
+ * as the legacy connectivity does, and returns the heap used per item.
+ */
+template <template <typename> class LIST>
+static double listHeapPerItem( size_t aCount, int aTracks, int aPads )
+{
+    struct CONNECTIONS
+    {
+        LIST<TRACK*> m_tracks;
+        LIST<D_PAD*> m_pads;
+    };
+
+    std::vector<CONNECTIONS> items( aCount );
+    size_t base = heapInUse();
+
+    for( CONNECTIONS& item : items )
+    {
+        for( int i = 0; i < aTracks; ++i )
+            item.m_tracks.push_back( nullptr );
+
+        for( int i = 0; i < aPads; ++i )
+            item.m_pads.push_back( nullptr );
+    }
+
+    size_t after = heapInUse();
+
+    if( after < base )
+        return 0.0;
+
+    return double( after - base ) / aCount;
+}
+
+
+template <typename T>
+using STD_VECTOR = std::vector<T>;
+
+
+static void report( const char* aName, size_t aSize, double aCompactHeap, double aStdHeap )
+{
+    std::cout << std::left << std::setw( 8 ) << aName
+              << std::right << std::setw( 8 ) << aSize
+              << std::setw( 14 ) << std::fixed << std::setprecision( 1 ) << aCompactHeap
+              << std::setw( 14 ) << aSize + aCompactHeap
+              << std::setw( 16 ) << aStdHeap
+              << std::endl;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    long count = 100000;
+
+    if( argc > 1 )
+        count = strtol( argv[1], nullptr, 10 );
+
+    if( count <= 0 )
+    {
+        std::cout << "Usage: " << argv[0] << " [ITEM_COUNT]" << std::endl;
+        return 1;
+    }
+
+    // Typical connections: a track segment touches two other segments (or a pad at one end),
+    // a via a few segments, a pad is only connected through the tracks pointing to it
+    double trackHeap = listHeapPerItem<COMPACT_VECTOR>( count, 2, 0 );
+    double viaHeap = listHeapPerItem<COMPACT_VECTOR>( count, 3, 0 );
+    double padHeap = listHeapPerItem<COMPACT_VECTOR>( count, 0, 0 );
+
+    std::cout << "Board item memory, " << count << " items per kind" << std::endl;
+
+    if( heapInUse() == 0 )
+        std::cout << "(heap usage cannot be measured on this platform)" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "item      sizeof   lists heap   bytes/item   std::vector heap" << std::endl;
+
+    report( "TRACK", sizeof( TRACK ), trackHeap, listHeapPerItem<STD_VECTOR>( count, 2, 0 ) );
+    report( "VIA", sizeof( VIA ), viaHeap, listHeapPerItem<STD_VECTOR>( count, 3, 0 ) );
+    report( "D_PAD", sizeof( D_PAD ), padHeap, listHeapPerItem<STD_VECTOR>( count, 0, 0 ) );
+
+    std::cout << std::endl;
+    std::cout << "sizeof( COMPACT_VECTOR ): " << sizeof( COMPACT_VECTOR<TRACK*> )
+              << ", sizeof( std::vector ): " << sizeof( std::vector<TRACK*> ) << std::endl;
+    std::cout << "sizeof( MODULE ): " << sizeof( MODULE ) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2018 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measures the throughput of the steps the TOOL_MANAGER goes through to dispatch an event:
+ * starting a state handler coroutine, waking up a tool waiting for an event (wait list
+ * assignment, matching, resuming the coroutine) and queueing posted events.
+ *
+ * Usage: tool_dispatch_benchmark [EVENT_COUNT]
+ */
+
+#include <tool/coroutine.h>
+#include <tool/tool_event.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using CLOCK = std::chrono::steady_clock;
+
+typedef COROUTINE<int, const TOOL_EVENT&> TOOL_COROUTINE;
+
+
+static void report( const std::string& aName, long aCount, CLOCK::time_point aStart )
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    double ns = duration_cast<nanoseconds>( CLOCK::now() - aStart ).count();
+
+    std::cout << aName << ": " << ns / aCount << " ns/event, "
+              << long( aCount / ( ns * 1e-9 ) ) << " events/s" << std::endl;
+}
+
+
+/// A state handler returning immediately, as actions run from hotkeys usually do
+static void benchStartHandler( long aCount )
+{
+    TOOL_EVENT event( TC_COMMAND, TA_ACTION );
+    auto start = CLOCK::now();
+
+    for( long i = 0; i < aCount; ++i )
+    {
+        TOOL_COROUTINE cofunc( []( const TOOL_EVENT& ) { return 0; } );
+        cofunc.Call( event );
+    }
+
+    report( "start handler", aCount, start );
+}
+
+
+/// An interactive tool loop waiting for mouse motion, woken up by every event
+static void benchWakeUp( long aCount )
+{
+    TOOL_EVENT_LIST waitEvents;
+    const TOOL_EVENT_LIST conditions( TOOL_EVENT( TC_ANY, TA_ANY ) );
+    bool pendingWait = false;
+    long handled = 0;
+    TOOL_COROUTINE* cofunc = nullptr;
+
+    // What TOOL_INTERACTIVE::Wait() and TOOL_MANAGER::ScheduleWait() do on the tool side
+    TOOL_COROUTINE loop( [&]( const TOOL_EVENT& )
+    {
+        for( ;; )
+        {
+            pendingWait = true;
+            waitEvents = conditions;
+            cofunc->KiYield();
+            ++handled;
+        }
+
+        return 0;
+    } );
+
+    cofunc = &loop;
+    loop.Call( TOOL_EVENT() );
+
+    TOOL_EVENT motion( TC_MOUSE, TA_MOUSE_MOTION, 0 );
+    auto start = CLOCK::now();
+
+    for( long i = 0; i < aCount; ++i )
+    {
+        // TOOL_MANAGER::dispatchInternal()
+        if( pendingWait && waitEvents.Matches( motion ) )
+        {
+            pendingWait = false;
+            waitEvents.clear();
+            loop.Resume();
+        }
+    }
+
+    report( "wake up waiting tool", aCount, start );
+
+    if( handled != aCount )
+        std::cout << "  error: " << handled << " events handled" << std::endl;
+}
+
+
+/// Events posted while handling another one, e.g. model change notifications
+static void benchEventQueue( long aCount )
+{
+    TOOL_EVENT_QUEUE queue;
+    TOOL_EVENT posted( TC_MESSAGE, TA_MODEL_CHANGE, AS_GLOBAL );
+    TOOL_EVENT event;
+    long popped = 0;
+    auto start = CLOCK::now();
+
+    for( long i = 0; i < aCount; ++i )
+    {
+        queue.Push( posted );
+        queue.Push( posted );
+
+        while( queue.Pop( event ) )
+            ++popped;
+    }
+
+    report( "post and pop event", 2 * aCount, start );
+
+    if( popped != 2 * aCount )
+        std::cout << "  error: " << popped << " events popped" << std::endl;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    long count = 1000000;
+
+    if( argc > 1 )
+        count = strtol( argv[1], nullptr, 10 );
+
+    if( count <= 0 )
+    {
+        std::cout << "Usage: " << argv[0] << " [EVENT_COUNT]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Tool event dispatch, " << count << " events" << std::endl;
+
+    benchStartHandler( count / 10 );
+    benchWakeUp( count );
+    benchEventQueue( count );
+
+    return 0;
+}
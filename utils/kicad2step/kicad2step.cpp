@@ -49,6 +49,7 @@ private:
     bool     m_useGridOrigin;
     bool     m_useDrillOrigin;
     bool     m_includeVirtual;
+    bool     m_timing;
     wxString m_filename;
     wxString m_outputFile;
     double   m_xOrigin;
@@ -78,6 +79,9 @@ static const wxCmdLineEntryDesc cmdLineDesc[] =
         { wxCMD_LINE_SWITCH, NULL, "no-virtual",
             _( "exclude 3D models for components with 'virtual' attribute" ).mb_str(),
             wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
+        { wxCMD_LINE_SWITCH, NULL, "timing",
+            _( "report the time spent in each phase of the export" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
         { wxCMD_LINE_SWITCH, "h", NULL, _( "display this message" ).mb_str(),
             wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
         { wxCMD_LINE_NONE }
@@ -96,6 +100,7 @@ bool KICAD2MCAD::OnInit()
     m_useGridOrigin = false;
     m_useDrillOrigin = false;
     m_includeVirtual = true;
+    m_timing = false;
     m_inch = false;
     m_xOrigin = 0.0;
     m_yOrigin = 0.0;
@@ -134,6 +139,9 @@ bool KICAD2MCAD::OnCmdLineParsed( wxCmdLineParser& parser )
     if( parser.Found( "no-virtual" ) )
         m_includeVirtual = false;
 
+    if( parser.Found( "timing" ) )
+        m_timing = true;
+
     wxString tstr;
 
     if( parser.Found( "user-origin", &tstr ) )
@@ -271,5 +279,20 @@ int KICAD2MCAD::OnRun()
         }
     }
 
+    if( m_timing )
+    {
+        std::ostringstream ostr;
+        double total = 0.0;
+
+        for( const auto& phase : pcb.GetTimings() )
+        {
+            ostr << "  " << phase.first << ": " << phase.second << " s\n";
+            total += phase.second;
+        }
+
+        ostr << "  total: " << total << " s\n";
+        wxLogMessage( "%s\n", ostr.str().c_str() );
+    }
+
     return 0;
 }
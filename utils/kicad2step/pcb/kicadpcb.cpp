@@ -25,6 +25,7 @@
 #include <wx/filename.h>
 #include <wx/log.h>
 #include <wx/stdpaths.h>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -37,6 +38,14 @@
 #include "oce_utils.h"
 
 
+using CLOCK = std::chrono::steady_clock;
+
+static double secondsSince( CLOCK::time_point aStart )
+{
+    return std::chrono::duration<double>( CLOCK::now() - aStart ).count();
+}
+
+
 /*
  * GetKicadConfigPath() is taken from KiCad's common.cpp source:
  * Copyright (C) 2014-2015 Jean-Pierre Charras, jp.charras at wanadoo.fr
@@ -141,9 +150,18 @@ bool KICADPCB::ReadFile( const wxString& aFileName )
 
     try
     {
-        SEXPR::PARSER parser;
+        // the tree is only needed while reading the board data, free it all at once after
+        SEXPR::SEXPR_ARENA arena;
+        SEXPR::PARSER parser( &arena );
         std::string infile( fname.GetFullPath().ToUTF8() );
-        SEXPR::SEXPR* data = parser.ParseFromFile( infile );
+
+        auto start = CLOCK::now();
+        std::string content = SEXPR::PARSER::GetFileContents( infile );
+        m_timings.emplace_back( "read file", secondsSince( start ) );
+
+        start = CLOCK::now();
+        SEXPR::SEXPR* data = parser.Parse( content );
+        m_timings.emplace_back( "parse", secondsSince( start ) );
 
         if( NULL == data )
         {
@@ -154,9 +172,12 @@ bool KICADPCB::ReadFile( const wxString& aFileName )
             return false;
         }
 
+        start = CLOCK::now();
+
         if( !parsePCB( data ) )
             return false;
 
+        m_timings.emplace_back( "read board data", secondsSince( start ) );
     }
     catch( std::exception& e )
     {
@@ -185,7 +206,11 @@ bool KICADPCB::WriteSTEP( const wxString& aFileName, bool aOverwrite )
     if( m_pcb )
     {
         std::string filename( aFileName.ToUTF8() );
-        return m_pcb->WriteSTEP( filename, aOverwrite );
+        auto start = CLOCK::now();
+        bool ok = m_pcb->WriteSTEP( filename, aOverwrite );
+
+        m_timings.emplace_back( "write STEP", secondsSince( start ) );
+        return ok;
     }
 
     return false;
@@ -198,7 +223,11 @@ bool KICADPCB::WriteIGES( const wxString& aFileName, bool aOverwrite )
     if( m_pcb )
     {
         std::string filename( aFileName.ToUTF8() );
-        return m_pcb->WriteIGES( filename, aOverwrite );
+        auto start = CLOCK::now();
+        bool ok = m_pcb->WriteIGES( filename, aOverwrite );
+
+        m_timings.emplace_back( "write IGES", secondsSince( start ) );
+        return ok;
     }
 
     return false;
@@ -496,10 +525,19 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual )
         m_pcb->AddOutlineSegment( &lcurve );
     }
 
+    auto start = CLOCK::now();
+
     for( auto i : m_modules )
         i->ComposePCB( m_pcb, &m_resolver, origin, aComposeVirtual );
 
-    if( !m_pcb->CreatePCB() )
+    m_timings.emplace_back( "load models and holes", secondsSince( start ) );
+    start = CLOCK::now();
+
+    bool created = m_pcb->CreatePCB();
+
+    m_timings.emplace_back( "create board (outline and holes)", secondsSince( start ) );
+
+    if( !created )
     {
         std::ostringstream ostr;
         ostr << "** " << __FILE__ << ":" << __FUNCTION__ << ":" << __LINE__ << "\n";
@@ -31,6 +31,7 @@
 
 #include <wx/string.h>
 #include <string>
+#include <utility>
 #include <vector>
 #include "3d_resolver.h"
 #include "base.h"
@@ -70,6 +71,9 @@ private:
     std::vector< KICADMODULE* > m_modules;
     std::vector< KICADCURVE* >  m_curves;
 
+    // name and duration (seconds) of the phases run so far
+    std::vector< std::pair< std::string, double > > m_timings;
+
     bool parsePCB( SEXPR::SEXPR* data );
     bool parseGeneral( SEXPR::SEXPR* data );
     bool parseSetup( SEXPR::SEXPR* data );
@@ -99,6 +103,11 @@ public:
         m_useDrillOrigin = aUseOrigin;
     }
 
+    const std::vector< std::pair< std::string, double > >& GetTimings() const
+    {
+        return m_timings;
+    }
+
     bool ReadFile( const wxString& aFileName );
     bool ComposePCB( bool aComposeVirtual = true );
     bool WriteSTEP( const wxString& aFileName, bool aOverwrite );
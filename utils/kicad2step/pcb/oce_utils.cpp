@@ -60,6 +60,8 @@
 #include <BRepPrimAPI_MakePrism.hxx>
 #include <BRepPrimAPI_MakeCylinder.hxx>
 #include <BRepAlgoAPI_Cut.hxx>
+#include <BRepBndLib.hxx>
+#include <Bnd_Box.hxx>
 
 #include <TopoDS.hxx>
 #include <TopoDS_Wire.hxx>
@@ -618,6 +620,116 @@ void PCBMODEL::SetPCBThickness( double aThickness )
 }
 
 
+// Subtracts the holes from aBoard.  Cutting the holes one by one from the growing board
+// takes a time quadratic in the number of holes (minutes for thousands of vias).  Instead,
+// the holes are sorted into compounds of holes which do not overlap, found by sweeping their
+// bounding boxes along X, and each compound is cut at once: the tool of a boolean operation
+// must not interfere with itself.  Boards usually need one or two cuts.
+static void cutHoles( TopoDS_Shape& aBoard, const std::vector< TopoDS_Shape >& aHoles )
+{
+    struct HOLE
+    {
+        const TopoDS_Shape* shape;
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+    };
+
+    struct BATCH
+    {
+        TopoDS_Compound                     compound;
+        std::vector< const TopoDS_Shape* >  shapes;
+        std::vector< const HOLE* >          active;     // holes the sweep line may still hit
+    };
+
+    std::vector< HOLE > holes;
+    holes.reserve( aHoles.size() );
+
+    for( const TopoDS_Shape& shape : aHoles )
+    {
+        Bnd_Box box;
+        BRepBndLib::Add( shape, box );
+
+        if( box.IsVoid() )
+            continue;
+
+        HOLE hole;
+        hole.shape = &shape;
+        box.Get( hole.xmin, hole.ymin, hole.zmin, hole.xmax, hole.ymax, hole.zmax );
+        holes.push_back( hole );
+    }
+
+    std::sort( holes.begin(), holes.end(),
+               []( const HOLE& aLeft, const HOLE& aRight )
+               {
+                   return aLeft.xmin < aRight.xmin;
+               } );
+
+    std::list< BATCH > batches;     // BATCH::active points to holes, which do not move
+    TopoDS_Builder builder;
+
+    for( const HOLE& hole : holes )
+    {
+        BATCH* target = NULL;
+
+        for( BATCH& batch : batches )
+        {
+            // holes ending left of this one cannot overlap it or any of the next ones
+            batch.active.erase( std::remove_if( batch.active.begin(), batch.active.end(),
+                                                [&hole]( const HOLE* aOther )
+                                                {
+                                                    return aOther->xmax < hole.xmin;
+                                                } ),
+                                batch.active.end() );
+
+            // the remaining holes overlap this one along X
+            bool overlaps = std::any_of( batch.active.begin(), batch.active.end(),
+                                         [&hole]( const HOLE* aOther )
+                                         {
+                                             return aOther->ymax >= hole.ymin
+                                                    && aOther->ymin <= hole.ymax;
+                                         } );
+
+            if( !overlaps )
+            {
+                target = &batch;
+                break;
+            }
+        }
+
+        if( !target )
+        {
+            batches.emplace_back();
+            target = &batches.back();
+            builder.MakeCompound( target->compound );
+        }
+
+        builder.Add( target->compound, *hole.shape );
+        target->shapes.push_back( hole.shape );
+        target->active.push_back( &hole );
+    }
+
+    for( const BATCH& batch : batches )
+    {
+        BRepAlgoAPI_Cut cut( aBoard, batch.compound );
+
+        if( cut.IsDone() && !cut.Shape().IsNull() )
+        {
+            aBoard = cut.Shape();
+            continue;
+        }
+
+        // fall back to the slow but robust path
+        std::ostringstream ostr;
+        ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+        ostr << "  * could not subtract " << batch.shapes.size();
+        ostr << " holes at once, subtracting them one by one\n";
+        wxLogMessage( "%s\n", ostr.str().c_str() );
+
+        for( const TopoDS_Shape* shape : batch.shapes )
+            aBoard = BRepAlgoAPI_Cut( aBoard, *shape );
+    }
+}
+
+
 // create the PCB (board only) model using the current outlines and drill holes
 bool PCBMODEL::CreatePCB()
 {
@@ -751,8 +863,7 @@ bool PCBMODEL::CreatePCB()
     }
 
     // subtract cutouts (if any)
-    for( auto i : m_cutouts )
-        board = BRepAlgoAPI_Cut( board, i );
+    cutHoles( board, m_cutouts );
 
     // push the board to the data structure
     m_pcb_label = m_assy->AddComponent( m_assy_label, board );
@@ -16,7 +16,9 @@
  */
 
 #include "sexpr/sexpr.h"
+#include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <iterator>
 #include <stdexcept>
 #include <iomanip>
@@ -25,15 +27,70 @@
 namespace SEXPR
 {
     SEXPR::SEXPR( SEXPR_TYPE aType, size_t aLineNumber ) :
-        m_type( aType ), m_lineNumber( aLineNumber )
+        m_type( aType ), m_inArena( false ), m_lineNumber( aLineNumber )
     {
     }
 
     SEXPR::SEXPR(SEXPR_TYPE aType) :
-        m_type( aType ), m_lineNumber( 1 )
+        m_type( aType ), m_inArena( false ), m_lineNumber( 1 )
     {
     }
 
+    // Large enough for a few thousand nodes
+    static const size_t ARENA_BLOCK_SIZE = 256 * 1024;
+
+    SEXPR_ARENA::SEXPR_ARENA() :
+        m_next( nullptr ), m_available( 0 )
+    {
+    }
+
+    SEXPR_ARENA::~SEXPR_ARENA()
+    {
+        // Lists must not see their arena children once destroyed, whatever the order
+        for( auto node : m_nodes )
+        {
+            if( node->IsList() )
+            {
+                SEXPR_VECTOR& children = static_cast<SEXPR_LIST*>( node )->m_children;
+
+                children.erase( std::remove_if( children.begin(), children.end(),
+                                                []( SEXPR* aChild )
+                                                {
+                                                    return aChild->IsInArena();
+                                                } ),
+                                children.end() );
+            }
+        }
+
+        for( auto node : m_nodes )
+            node->~SEXPR();
+
+        for( auto block : m_blocks )
+            ::operator delete( block );
+    }
+
+    void* SEXPR_ARENA::allocate( size_t aSize )
+    {
+        // Keep every node aligned for any member type
+        const size_t align = alignof( std::max_align_t );
+        aSize = ( aSize + align - 1 ) / align * align;
+
+        if( aSize > m_available )
+        {
+            size_t blockSize = std::max( aSize, ARENA_BLOCK_SIZE );
+
+            m_blocks.push_back( static_cast<char*>( ::operator new( blockSize ) ) );
+            m_next = m_blocks.back();
+            m_available = blockSize;
+        }
+
+        void* storage = m_next;
+        m_next += aSize;
+        m_available -= aSize;
+
+        return storage;
+    }
+
     SEXPR_VECTOR const * SEXPR::GetChildren() const
     {
         if( m_type != SEXPR_TYPE::SEXPR_TYPE_LIST )
@@ -203,7 +260,8 @@ namespace SEXPR
     {
         for( auto child : m_children )
         {
-            delete child;
+            if( !child->IsInArena() )
+                delete child;
         }
 
         m_children.clear();
@@ -19,7 +19,9 @@
 #define SEXPR_H_
 
 #include <cstdint>
+#include <new>
 #include <string>
+#include <utility>
 #include <vector>
 #include "sexpr/isexprable.h"
 #include "sexpr/sexpr_exception.h"
@@ -43,8 +45,11 @@ namespace SEXPR
 
     class SEXPR
     {
+        friend class SEXPR_ARENA;
+
     protected:
         SEXPR_TYPE m_type;
+        bool m_inArena;     // owned by a SEXPR_ARENA, must not be deleted
         SEXPR( SEXPR_TYPE aType, size_t aLineNumber );
         SEXPR( SEXPR_TYPE aType );
         size_t m_lineNumber;
@@ -69,6 +74,7 @@ namespace SEXPR
         SEXPR_LIST* GetList();
         std::string AsString( size_t aLevel = 0);
         size_t GetLineNumber() { return m_lineNumber; }
+        bool IsInArena() const { return m_inArena; }
     };
 
     struct SEXPR_INTEGER : public SEXPR
@@ -115,6 +121,41 @@ namespace SEXPR
             SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_SYMBOL, aLineNumber ), m_value( aValue ) {};
     };
 
+    /**
+     * SEXPR_ARENA owns the nodes of the trees built by a PARSER using it.  The nodes are
+     * allocated in large blocks and destroyed all at once with the arena, which is much
+     * faster than allocating and deleting each node of a large tree (a board file holds
+     * millions of them).  Nodes of an arena must not be deleted; lists of an arena can
+     * still be given heap allocated children, the lists delete them.
+     */
+    class SEXPR_ARENA
+    {
+    public:
+        SEXPR_ARENA();
+        ~SEXPR_ARENA();
+
+        template <typename T, typename... Args>
+        T* Create( Args&&... aArgs )
+        {
+            void* storage = allocate( sizeof( T ) );
+            T* node = new( storage ) T( std::forward<Args>( aArgs )... );
+            node->m_inArena = true;
+            m_nodes.push_back( node );
+            return node;
+        }
+
+    private:
+        SEXPR_ARENA( const SEXPR_ARENA& ) = delete;
+        SEXPR_ARENA& operator=( const SEXPR_ARENA& ) = delete;
+
+        void* allocate( size_t aSize );
+
+        std::vector< char* > m_blocks;
+        char* m_next;               // free space in the last block
+        size_t m_available;
+        std::vector< SEXPR* > m_nodes;
+    };
+
     struct _OUT_STRING
     {
         bool _Symbol;
@@ -30,7 +30,25 @@ namespace SEXPR
 {
     const std::string PARSER::whitespaceCharacters = " \t\n\r\b\f\v";
 
-    PARSER::PARSER() : m_lineNumber( 1 )
+    // The characters of whitespaceCharacters
+    static inline bool isWhitespace( char aChar )
+    {
+        switch( aChar )
+        {
+        case ' ': case '\t': case '\n': case '\r': case '\b': case '\f': case '\v':
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    static inline bool isAtomEnd( char aChar )
+    {
+        return isWhitespace( aChar ) || aChar == '(' || aChar == ')';
+    }
+
+    PARSER::PARSER( SEXPR_ARENA* aArena ) : m_lineNumber( 1 ), m_arena( aArena )
     {
     }
 
@@ -81,21 +99,21 @@ namespace SEXPR
             if( *it == '\n' )
                 m_lineNumber++;
 
-            if( whitespaceCharacters.find(*it) != std::string::npos )
+            if( isWhitespace( *it ) )
                 continue;
 
             if( *it == '(' )
             {
                 std::advance( it, 1 );
 
-                SEXPR_LIST* list = new SEXPR_LIST( m_lineNumber );
+                SEXPR_LIST* list = newNode<SEXPR_LIST>( m_lineNumber );
                 while( it != aString.end() && *it != ')' )
                 {
                     //there may be newlines in between atoms of a list, so detect these here
                     if( *it == '\n' )
                         m_lineNumber++;
 
-                    if( whitespaceCharacters.find(*it) != std::string::npos )
+                    if( isWhitespace( *it ) )
                     {
                         std::advance( it, 1 );
                         continue;
@@ -121,7 +139,7 @@ namespace SEXPR
 
                 if( closingPos != std::string::npos )
                 {
-                    SEXPR_STRING* str = new SEXPR_STRING(
+                    SEXPR_STRING* str = newNode<SEXPR_STRING>(
                         aString.substr( startPos, closingPos - startPos ),m_lineNumber );
                     std::advance( it, closingPos - startPos + 2 );
 
@@ -134,46 +152,42 @@ namespace SEXPR
             }
             else
             {
-                size_t startPos = std::distance( aString.begin(), it );
-                size_t closingPos = aString.find_first_of( whitespaceCharacters + "()", startPos );
+                // Scan the atom once, noting if it looks like a number
+                const char* start = &*it;
+                const char* end = aString.data() + aString.size();
+                const char* pos = start;
+                bool numeric = true;
+                bool hasDot = false;
+
+                for( ; pos != end && !isAtomEnd( *pos ); ++pos )
+                {
+                    if( *pos == '.' )
+                        hasDot = true;
+                    else if( ( *pos < '0' || *pos > '9' ) && !( *pos == '-' && pos == start ) )
+                        numeric = false;
+                }
+
+                if( pos == end )
+                    throw PARSE_EXCEPTION( "format error" );
 
-                std::string tmp = aString.substr( startPos, closingPos - startPos );
+                size_t length = pos - start;
 
+                // A lone '-' is a symbol
+                if( *start == '-' && length == 1 )
+                    numeric = false;
 
-                if( closingPos != std::string::npos )
-                {
-                    if( tmp.find_first_not_of( "0123456789." ) == std::string::npos ||
-                        ( tmp.size() > 1 && tmp[0] == '-'
-                          && tmp.find_first_not_of( "0123456789.", 1 ) == std::string::npos ) )
-                    {
-                        SEXPR* res;
-
-                        if( tmp.find( '.' ) != std::string::npos )
-                        {
-                            res = new SEXPR_DOUBLE( strtod( tmp.c_str(), NULL ), m_lineNumber );
-                            //floating point type
-                        }
-                        else
-                        {
-                            res = new SEXPR_INTEGER(
-                                strtoll( tmp.c_str(), NULL, 0 ), m_lineNumber );
-                        }
-
-                        std::advance( it, closingPos - startPos );
-                        return res;
-                    }
-                    else
-                    {
-                        SEXPR_SYMBOL* str = new SEXPR_SYMBOL( tmp, m_lineNumber );
-                        std::advance( it, closingPos - startPos );
+                SEXPR* res;
 
-                        return str;
-                    }
-                }
+                // The atom is followed by a delimiter, so strtod() and strtoll() stop at its end
+                if( numeric && hasDot )
+                    res = newNode<SEXPR_DOUBLE>( strtod( start, NULL ), m_lineNumber );
+                else if( numeric )
+                    res = newNode<SEXPR_INTEGER>( strtoll( start, NULL, 0 ), m_lineNumber );
                 else
-                {
-                    throw PARSE_EXCEPTION( "format error" );
-                }
+                    res = newNode<SEXPR_SYMBOL>( std::string( start, length ), m_lineNumber );
+
+                std::advance( it, length );
+                return res;
             }
         }
 
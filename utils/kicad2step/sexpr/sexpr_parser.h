@@ -28,7 +28,11 @@ namespace SEXPR
     class PARSER
     {
     public:
-        PARSER();
+        /**
+         * @param aArena owns the nodes of the parsed trees if given, the trees are heap
+         * allocated and owned by the caller otherwise.
+         */
+        PARSER( SEXPR_ARENA* aArena = nullptr );
         ~PARSER();
         SEXPR* Parse( const std::string &aString );
         SEXPR* ParseFromFile( const std::string &aFilename );
@@ -36,8 +40,19 @@ namespace SEXPR
 
     private:
         SEXPR* parseString( const std::string& aString, std::string::const_iterator& it );
+
+        template <typename T, typename... Args>
+        T* newNode( Args&&... aArgs )
+        {
+            if( m_arena )
+                return m_arena->Create<T>( std::forward<Args>( aArgs )... );
+
+            return new T( std::forward<Args>( aArgs )... );
+        }
+
         static const std::string whitespaceCharacters;
         int m_lineNumber;
+        SEXPR_ARENA* m_arena;
     };
 }
 